@@ -17,6 +17,19 @@ namespace PokemonAutomation{
 
 
 
+static thread_local size_t thread_pool_owner = 0;
+
+size_t current_thread_pool_owner(){
+    return thread_pool_owner;
+}
+ThreadPoolOwnerScope::ThreadPoolOwnerScope(size_t owner)
+    : m_previous(thread_pool_owner)
+{
+    thread_pool_owner = owner;
+}
+ThreadPoolOwnerScope::~ThreadPoolOwnerScope(){
+    thread_pool_owner = m_previous;
+}
 
 
 
@@ -48,6 +61,18 @@ WallDuration ComputationThreadPool::cpu_time() const{
 void ComputationThreadPool::ensure_threads(size_t threads){
     m_core->ensure_threads(threads);
 }
+void ComputationThreadPool::configure_owner(
+    size_t owner, double weight,
+    size_t first_cpu, size_t cpu_count
+){
+    m_core->configure_owner(owner, weight, first_cpu, cpu_count);
+}
+void ComputationThreadPool::remove_owner(size_t owner){
+    m_core->remove_owner(owner);
+}
+WallDuration ComputationThreadPool::owner_cpu_time(size_t owner) const{
+    return m_core->owner_cpu_time(owner);
+}
 //void ParallelTaskRunner::wait_for_everything(){
 //    m_core->wait_for_everything();
 //}
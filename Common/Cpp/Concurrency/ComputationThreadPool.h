@@ -11,11 +11,28 @@
  *  Because the # of threads is capped, it is safe to spam this thread pool with
  *  lots of smaller tasks.
  *
+ *
+ *      Owners
+ *
+ *  Every task belongs to an "owner", which is the owner of the thread that
+ *  dispatched it. (see ThreadPoolOwnerScope) Pool threads take the owner of
+ *  the task they are running, so nested dispatches keep the same owner.
+ *
+ *  When the pool is contended, owners get CPU time in proportion to their
+ *  weights rather than first-come-first-serve. So one owner spamming the pool
+ *  cannot starve the others. The pool also keeps track of how much CPU time
+ *  each owner has used.
+ *
+ *  Owner 0 is the default for threads that don't belong to anyone. Other
+ *  owners must be configured before use. Tasks of unconfigured owners are
+ *  treated as owner 0.
+ *
  */
 
 #ifndef PokemonAutomation_ComputationThreadPool_H
 #define PokemonAutomation_ComputationThreadPool_H
 
+#include <memory>
 #include <functional>
 #include "Common/Cpp/Time.h"
 #include "Common/Cpp/Containers/Pimpl.h"
@@ -26,6 +43,23 @@ class AsyncTask;
 class ComputationThreadPoolCore;
 
 
+//  The thread pool owner of the current thread.
+size_t current_thread_pool_owner();
+
+//  Set the thread pool owner of the current thread for the lifetime of this
+//  object.
+class ThreadPoolOwnerScope{
+public:
+    ThreadPoolOwnerScope(size_t owner);
+    ~ThreadPoolOwnerScope();
+    ThreadPoolOwnerScope(const ThreadPoolOwnerScope&) = delete;
+    void operator=(const ThreadPoolOwnerScope&) = delete;
+
+private:
+    size_t m_previous;
+};
+
+
 class ComputationThreadPool final{
 public:
     ComputationThreadPool(
@@ -41,6 +75,29 @@ public:
 
     void ensure_threads(size_t threads);
 
+
+public:
+    //  Owners
+
+    //  Add or update an owner.
+    //  "weight" is the share of the pool the owner gets under contention.
+    //  If "cpu_count" is non-zero, the owner's tasks are run only on logical
+    //  processors [first_cpu, first_cpu + cpu_count). (Linux only)
+    void configure_owner(
+        size_t owner, double weight,
+        size_t first_cpu = 0, size_t cpu_count = 0
+    );
+
+    //  Remove an owner. Its queued tasks are moved to the back of owner 0's
+    //  queue, and any tasks it dispatches later are treated as owner 0. They
+    //  keep running, but at owner 0's weight and CPUs, and their time is
+    //  counted to owner 0. Removing owner 0 does nothing.
+    void remove_owner(size_t owner);
+
+    //  Total time the pool has spent running tasks of this owner. Tasks are
+    //  counted when they finish.
+    WallDuration owner_cpu_time(size_t owner) const;
+
     void stop();
 
 //    void wait_for_everything();
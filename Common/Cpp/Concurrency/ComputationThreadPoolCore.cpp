@@ -7,6 +7,8 @@
 #include <thread>
 #include "Common/Cpp/PanicDump.h"
 #include "ReverseLockGuard.h"
+#include "ThreadAffinity.h"
+#include "ComputationThreadPool.h"
 #include "ComputationThreadPoolCore.h"
 
 //#include <iostream>
@@ -24,9 +26,12 @@ ComputationThreadPoolCore::ComputationThreadPoolCore(
 )
     : m_new_thread_callback(std::move(new_thread_callback))
     , m_max_threads(max_threads == 0 ? std::thread::hardware_concurrency() : max_threads)
+    , m_queued(0)
+    , m_virtual_clock(0)
     , m_stopping(false)
     , m_busy_count(0)
 {
+    m_owners[0];
     for (size_t c = 0; c < starting_threads; c++){
         spawn_thread();
     }
@@ -49,12 +54,15 @@ void ComputationThreadPoolCore::stop() {
     // DO NOT JOIN AGAIN IN DESTRUCTOR
     m_threads.clear();
 
-    for (auto& task : m_queue){
-        task->report_cancelled();
-    }
+    for (auto& owner : m_owners){
+        for (AsyncTask* task : owner.second.queue){
+            task->report_cancelled();
+        }
 
-    // DO NOT CLEAR AGAIN IN DESTRUCTOR
-    m_queue.clear();
+        // DO NOT CLEAR AGAIN IN DESTRUCTOR
+        owner.second.queue.clear();
+    }
+    m_queued = 0;
 
 }
 
@@ -83,6 +91,106 @@ void ComputationThreadPoolCore::ensure_threads(size_t threads){
         spawn_thread();
     }
 }
+
+
+
+void ComputationThreadPoolCore::configure_owner(
+    size_t owner, double weight,
+    size_t first_cpu, size_t cpu_count
+){
+    std::lock_guard<std::mutex> lg(m_lock);
+    auto ret = m_owners.try_emplace(owner);
+    OwnerData& data = ret.first->second;
+    if (ret.second){
+        //  Start new owners at the current time so they don't get to catch up
+        //  on everything that ran before they existed.
+        data.virtual_time = m_virtual_clock;
+    }
+    data.weight = std::max(weight, 0.01);
+    data.first_cpu = first_cpu;
+    data.cpu_count = cpu_count;
+}
+void ComputationThreadPoolCore::remove_owner(size_t owner){
+    if (owner == 0){
+        return;
+    }
+    std::lock_guard<std::mutex> lg(m_lock);
+    auto iter = m_owners.find(owner);
+    if (iter == m_owners.end()){
+        return;
+    }
+    std::deque<AsyncTask*>& queue = m_owners[0].queue;
+    for (AsyncTask* task : iter->second.queue){
+        queue.emplace_back(task);
+    }
+    m_owners.erase(iter);
+}
+WallDuration ComputationThreadPoolCore::owner_cpu_time(size_t owner) const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    auto iter = m_owners.find(owner);
+    return iter == m_owners.end()
+        ? WallDuration::zero()
+        : iter->second.cpu_time;
+}
+
+
+
+void ComputationThreadPoolCore::enqueue(AsyncTask* task){
+    auto iter = m_owners.find(current_thread_pool_owner());
+    if (iter == m_owners.end()){
+        iter = m_owners.find(0);
+    }
+    OwnerData& owner = iter->second;
+
+    //  Don't let an owner bank time while it had nothing to run. Otherwise it
+    //  would lock everyone else out when it comes back.
+    if (owner.queue.empty()){
+        owner.virtual_time = std::max(owner.virtual_time, m_virtual_clock);
+    }
+
+    owner.queue.emplace_back(task)->report_started();
+    m_queued++;
+}
+bool ComputationThreadPoolCore::pop_task(QueuedTask& task){
+    std::map<size_t, OwnerData>::iterator best = m_owners.end();
+    for (auto iter = m_owners.begin(); iter != m_owners.end(); ++iter){
+        if (iter->second.queue.empty()){
+            continue;
+        }
+        if (best == m_owners.end() || iter->second.virtual_time < best->second.virtual_time){
+            best = iter;
+        }
+    }
+    if (best == m_owners.end()){
+        return false;
+    }
+
+    OwnerData& owner = best->second;
+    m_virtual_clock = std::max(m_virtual_clock, owner.virtual_time);
+
+    task.task = owner.queue.front();
+    task.owner = best->first;
+    task.first_cpu = owner.first_cpu;
+    task.cpu_count = owner.cpu_count;
+    owner.queue.pop_front();
+    m_queued--;
+    return true;
+}
+void ComputationThreadPoolCore::charge(size_t owner, WallDuration runtime){
+    auto iter = m_owners.find(owner);
+    if (iter == m_owners.end()){
+        iter = m_owners.find(0);
+    }
+    OwnerData& data = iter->second;
+    data.cpu_time += runtime;
+    data.virtual_time += std::chrono::duration_cast<std::chrono::microseconds>(runtime).count() / data.weight;
+}
+WallDuration ComputationThreadPoolCore::run_task(const QueuedTask& task){
+    ThreadPoolOwnerScope owner(task.owner);
+    WallClock start = current_time();
+    task.task->run();
+    return current_time() - start;
+}
 #if 0
 void ComputationThreadPoolCore::wait_for_everything(){
     std::unique_lock<std::mutex> lg(m_lock);
@@ -99,11 +207,11 @@ std::unique_ptr<AsyncTask> ComputationThreadPoolCore::blocking_dispatch(std::fun
         std::unique_lock<std::mutex> lg(m_lock);
 
         m_dispatch_cv.wait(lg, [this]{
-            return m_queue.size() + m_busy_count < m_max_threads;
+            return m_queued + m_busy_count < m_max_threads;
         });
 
         //  Enqueue task.
-        m_queue.emplace_back(task.get())->report_started();
+        enqueue(task.get());
         spawn_threads();
 
 #if 0
@@ -128,14 +236,14 @@ std::unique_ptr<AsyncTask> ComputationThreadPoolCore::try_dispatch(std::function
     {
         std::lock_guard<std::mutex> lg(m_lock);
 
-        if (m_queue.size() + m_busy_count >= m_max_threads){
+        if (m_queued + m_busy_count >= m_max_threads){
             return nullptr;
         }
 
         task.reset(new AsyncTask(std::move(func)));
 
         //  Enqueue task.
-        m_queue.emplace_back(task.get())->report_started();
+        enqueue(task.get());
 
         spawn_threads();
     }
@@ -182,18 +290,20 @@ void ComputationThreadPoolCore::run_in_parallel(
         //  Enqueue all the tasks.
         std::unique_lock<std::mutex> lg(m_lock);
         for (std::unique_ptr<AsyncTask>& task : tasks){
-            m_queue.emplace_back(task.get())->report_started();
+            enqueue(task.get());
             m_thread_cv.notify_one();
         }
         spawn_threads();
 
         //  Use this thread to process the queue until our tasks are done.
-        while (!m_queue.empty() && !tasks.back()->is_finished()){
-            AsyncTask* task = m_queue.front();
-            m_queue.pop_front();
-
-            ReverseLockGuard<std::mutex> lg0(m_lock);
-            task->run();
+        QueuedTask task;
+        while (!tasks.back()->is_finished() && pop_task(task)){
+            WallDuration runtime;
+            {
+                ReverseLockGuard<std::mutex> lg0(m_lock);
+                runtime = run_task(task);
+            }
+            charge(task.owner, runtime);
         }
     }
 
@@ -221,7 +331,7 @@ void ComputationThreadPoolCore::spawn_thread(){
     }
 }
 void ComputationThreadPoolCore::spawn_threads(){
-    while (m_threads.size() < std::min(m_queue.size() + m_busy_count, m_max_threads)){
+    while (m_threads.size() < std::min(m_queued + m_busy_count, m_max_threads)){
         spawn_thread();
     }
 }
@@ -237,8 +347,9 @@ void ComputationThreadPoolCore::thread_loop(ThreadData& data){
     std::unique_lock<std::mutex> lg(m_lock);
     m_busy_count++;
     while (!m_stopping){
-//        cout << "m_queue... " << m_queue.size() << endl;
-        if (m_queue.empty()){
+//        cout << "m_queue... " << m_queued << endl;
+        QueuedTask task;
+        if (!pop_task(task)){
             data.runtime.stop();
             m_busy_count--;
             m_dispatch_cv.notify_all();
@@ -250,11 +361,21 @@ void ComputationThreadPoolCore::thread_loop(ThreadData& data){
             continue;
         }
 
-        AsyncTask* task = m_queue.front();
-        m_queue.pop_front();
+        WallDuration runtime;
+        {
+            ReverseLockGuard<std::mutex> lg0(m_lock);
 
-        ReverseLockGuard<std::mutex> lg0(m_lock);
-        task->run();
+            //  Move to the owner's processors. This is a syscall, so only do
+            //  it when they change.
+            if (task.first_cpu != data.first_cpu || task.cpu_count != data.cpu_count){
+                set_thread_affinity(task.first_cpu, task.cpu_count);
+                data.first_cpu = task.first_cpu;
+                data.cpu_count = task.cpu_count;
+            }
+
+            runtime = run_task(task);
+        }
+        charge(task.owner, runtime);
     }
 }
 
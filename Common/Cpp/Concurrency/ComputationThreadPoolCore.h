@@ -18,6 +18,7 @@
 
 #include <functional>
 #include <deque>
+#include <map>
 #include "Common/Cpp/CpuUtilization/CpuUtilization.h"
 #include "Common/Cpp/Stopwatch.h"
 #include "Common/Cpp/Concurrency/Thread.h"
@@ -51,6 +52,14 @@ public:
     void stop();
 //    void wait_for_everything();
 
+    void configure_owner(
+        size_t owner, double weight,
+        size_t first_cpu, size_t cpu_count
+    );
+    //  Moves the owner's queued tasks to owner 0. (see ComputationThreadPool)
+    void remove_owner(size_t owner);
+    WallDuration owner_cpu_time(size_t owner) const;
+
 
 public:
     //  As of this writing, tasks dispatched earlier are not allowed to block
@@ -78,8 +87,38 @@ private:
         Thread thread;
         ThreadHandle handle;
         Stopwatch runtime;
+
+        //  Current affinity of the thread. Only touched by the thread itself.
+        size_t first_cpu = 0;
+        size_t cpu_count = 0;
+    };
+    struct OwnerData{
+        double weight = 1.0;
+        size_t first_cpu = 0;
+        size_t cpu_count = 0;
+
+        //  Time used divided by weight. The owner with the smallest one runs
+        //  next.
+        double virtual_time = 0;
+        WallDuration cpu_time = WallDuration::zero();
+
+        std::deque<AsyncTask*> queue;
+    };
+    struct QueuedTask{
+        AsyncTask* task;
+        size_t owner;
+        size_t first_cpu;
+        size_t cpu_count;
     };
 
+    //  These must be called under the lock.
+    void enqueue(AsyncTask* task);
+    bool pop_task(QueuedTask& task);
+    void charge(size_t owner, WallDuration runtime);
+
+    //  This must be called outside the lock.
+    WallDuration run_task(const QueuedTask& task);
+
     void spawn_thread();
     void spawn_threads();
     void thread_loop(ThreadData& data);
@@ -90,7 +129,10 @@ private:
 
     std::function<void()> m_new_thread_callback;
     size_t m_max_threads;
-    std::deque<AsyncTask*> m_queue;
+
+    std::map<size_t, OwnerData> m_owners;
+    size_t m_queued;
+    double m_virtual_clock;
 
     std::deque<ThreadData> m_threads;
 
@@ -4,6 +4,8 @@
  *
  */
 
+#include "SpinPause.h"
+#include "ComputationThreadPool.h"
 #include "PeriodicScheduler.h"
 
 #include <iostream>
@@ -74,9 +76,33 @@ void* PeriodicScheduler::request_next_event(WallClock timestamp){
         //  Now remove the current event.
         m_schedule.erase(iter0);
 
+        iter1->second.parked = false;
         return event.event;
     }
 }
+void PeriodicScheduler::park_event(void* event, WallClock not_before, WallClock deadline){
+    auto iter = m_events.find(event);
+    if (iter == m_events.end()){
+        return;
+    }
+
+    //  Give it a new id so the run that is already scheduled gets skipped.
+    m_schedule.emplace(deadline, SingleEvent{m_callback_id, event});
+    iter->second.id = m_callback_id++;
+    iter->second.parked = true;
+    iter->second.not_before = not_before;
+}
+void PeriodicScheduler::release_parked_events(WallClock timestamp){
+    for (auto& item : m_events){
+        PeriodicEvent& event = item.second;
+        if (!event.parked){
+            continue;
+        }
+        m_schedule.emplace(std::max(event.not_before, timestamp), SingleEvent{m_callback_id, item.first});
+        event.id = m_callback_id++;
+        event.parked = false;
+    }
+}
 
 
 
@@ -106,7 +132,10 @@ private:
 
 PeriodicRunner::PeriodicRunner(AsyncDispatcher& dispatcher)
     : m_dispatcher(dispatcher)
+    , m_thread_pool_owner(0)
     , m_pending_waits(0)
+    , m_release_requests(0)
+    , m_idle(false)
 {}
 bool PeriodicRunner::add_event(void* event, std::chrono::milliseconds period, WallClock start){
     throw_if_cancelled();
@@ -136,6 +165,25 @@ void PeriodicRunner::remove_event(void* event){
         m_utilization.push_idle();
     }
 }
+void PeriodicRunner::park_event(void* event, WallClock not_before, WallClock deadline){
+    //  Already under the lock since we're inside "run()".
+    m_scheduler.park_event(event, not_before, deadline);
+}
+void PeriodicRunner::release_parked_events(){
+    m_release_requests.fetch_add(1);
+
+    //  If the runner isn't idle, it will see the request before it waits.
+    //  Otherwise it may be waiting or just about to. Once we get the lock, it
+    //  is definitely waiting and the notification can't be missed.
+    while (m_idle.load()){
+        if (m_lock.try_lock()){
+            m_cv.notify_all();
+            m_lock.unlock();
+            return;
+        }
+        pause();
+    }
+}
 bool PeriodicRunner::cancel(std::exception_ptr exception) noexcept{
     if (Cancellable::cancel(std::move(exception))){
         return true;
@@ -145,10 +193,12 @@ bool PeriodicRunner::cancel(std::exception_ptr exception) noexcept{
     return false;
 }
 void PeriodicRunner::thread_loop(){
+    ThreadPoolOwnerScope owner(m_thread_pool_owner.load(std::memory_order_relaxed));
     bool is_back_to_back = false;
     std::unique_lock<std::mutex> lg(m_lock);
     WallClock last_check_timestamp = current_time();
     WallDuration idle_since_last_check = WallDuration(0);
+    uint64_t releases_seen = m_release_requests.load();
     while (true){
         if (cancelled()){
             return;
@@ -169,6 +219,12 @@ void PeriodicRunner::thread_loop(){
         idle_since_last_check = WallDuration(0);
 //        cout << m_utilization.utilization() << endl;
 
+        uint64_t releases = m_release_requests.load();
+        if (releases != releases_seen){
+            releases_seen = releases;
+            m_scheduler.release_parked_events(now);
+        }
+
         void* event = m_scheduler.request_next_event(now);
 
         //  Event is available now. Run it.
@@ -186,12 +242,21 @@ void PeriodicRunner::thread_loop(){
             return;
         }
 
+        //  Announce that we're about to wait before the last check for
+        //  releases. See "release_parked_events()".
+        m_idle.store(true);
+        if (m_release_requests.load() != releases_seen){
+            m_idle.store(false);
+            continue;
+        }
+
         WallClock start = current_time();
         if (next < WallClock::max()){
             m_cv.wait_until(lg, next);
         }else{
             m_cv.wait(lg);
         }
+        m_idle.store(false);
         WallClock end = current_time();
         idle_since_last_check += end - start;
     }
@@ -41,11 +41,23 @@ public:
     //  If nothing is before the current timestamp, return nullptr.
     void* request_next_event(WallClock timestamp = current_time());
 
+    //  Stop running "event" on its period. Instead, it runs at the first
+    //  "release_parked_events()" but no earlier than "not_before", or at
+    //  "deadline" if nothing releases it first.
+    //  After that, it goes back to running on its period.
+    void park_event(void* event, WallClock not_before, WallClock deadline);
+
+    //  Reschedule all parked events to run as soon as they are allowed to.
+    void release_parked_events(WallClock timestamp = current_time());
+
 private:
     //  "id" is needed to solve the ABA problem if the same pointer is removed/re-added.
+    //  It is also changed to orphan the scheduled run of a parked event.
     struct PeriodicEvent{
         uint64_t id;
         std::chrono::milliseconds period;
+        bool parked = false;
+        WallClock not_before = WallClock::min();
     };
     struct SingleEvent{
         uint64_t id;
@@ -72,11 +84,27 @@ public:
 
     double current_utilization() const;
 
+    //  Thread pool owner of the runner thread. (see ThreadPoolOwnerScope)
+    //  This is applied when the thread starts, so set it before adding any
+    //  events.
+    void set_thread_pool_owner(size_t owner){
+        m_thread_pool_owner.store(owner, std::memory_order_relaxed);
+    }
+
 protected:
     PeriodicRunner(AsyncDispatcher& dispatcher);
     bool add_event(void* event, std::chrono::milliseconds period, WallClock start = current_time());
     void remove_event(void* event);
 
+    //  Only call this from inside "run()" on the event that is being run.
+    //  See "PeriodicScheduler::park_event()".
+    void park_event(void* event, WallClock not_before, WallClock deadline);
+
+    //  Release all parked events. This can be called from any thread. It
+    //  never waits for a running event to finish, so it is safe to call from
+    //  latency-sensitive threads.
+    void release_parked_events();
+
     //  Run the event. "is_back_to_back" is true if there was no wait between
     //  this event and the previous one.
     //  This can be used is a performance hint to the child class to reuse
@@ -91,8 +119,11 @@ protected:
 
 private:
     AsyncDispatcher& m_dispatcher;
+    std::atomic<size_t> m_thread_pool_owner;
 
     std::atomic<size_t> m_pending_waits;
+    std::atomic<uint64_t> m_release_requests;
+    std::atomic<bool> m_idle;
     std::mutex m_lock;
     std::condition_variable m_cv;
 
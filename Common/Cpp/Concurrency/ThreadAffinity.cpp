@@ -0,0 +1,50 @@
+/*  Thread Affinity
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include <thread>
+#include "ThreadAffinity.h"
+
+#if defined(__linux)
+#include <sched.h>
+#endif
+
+namespace PokemonAutomation{
+
+
+#if defined(__linux)
+
+bool set_thread_affinity(size_t first_cpu, size_t cpu_count){
+    size_t cpus = std::thread::hardware_concurrency();
+    if (cpu_count == 0){
+        first_cpu = 0;
+        cpu_count = cpus;
+    }
+    if (first_cpu >= cpus || cpu_count > CPU_SETSIZE){
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    size_t end = std::min(first_cpu + cpu_count, cpus);
+    for (size_t c = first_cpu; c < end; c++){
+        CPU_SET(c, &set);
+    }
+
+    //  On Linux, pid 0 is the calling thread, not the whole process.
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+#else
+
+bool set_thread_affinity(size_t, size_t){
+    return false;
+}
+
+#endif
+
+
+}
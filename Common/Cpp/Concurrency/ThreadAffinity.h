@@ -0,0 +1,25 @@
+/*  Thread Affinity
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_ThreadAffinity_H
+#define PokemonAutomation_ThreadAffinity_H
+
+#include <stddef.h>
+
+namespace PokemonAutomation{
+
+
+//  Restrict the calling thread to the logical processors
+//  [first_cpu, first_cpu + cpu_count). If "cpu_count" is zero, let it run on
+//  all of them again.
+//
+//  Only implemented on Linux. Returns false if it isn't supported or if it
+//  fails.
+bool set_thread_affinity(size_t first_cpu, size_t cpu_count);
+
+
+}
+#endif
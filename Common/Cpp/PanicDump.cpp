@@ -4,6 +4,7 @@
  * 
  */
 
+#include <atomic>
 #include "Common/Cpp/Exceptions.h"
 #include "PrettyPrint.h"
 #include "PanicDump.h"
@@ -12,7 +13,20 @@ namespace PokemonAutomation{
 
 
 
+std::atomic<void (*)()> panic_dump_hook(nullptr);
+
+void set_panic_dump_hook(void (*hook)()){
+    panic_dump_hook.store(hook, std::memory_order_release);
+}
+
 void panic_dump(const char* location, const char* message){
+    void (*hook)() = panic_dump_hook.load(std::memory_order_acquire);
+    if (hook != nullptr){
+        try{
+            hook();
+        }catch (...){}
+    }
+
     std::string body;
     body += "\xef\xbb\xbf"; //  UTF-8 BOM
 //    body += "Panic Dump:\r\n";
@@ -14,6 +14,10 @@ namespace PokemonAutomation{
 
 void panic_dump(const char* location, const char* message);
 
+//  Set a function to run at the start of every panic dump. This is used to
+//  flush buffered logs before we go down.
+void set_panic_dump_hook(void (*hook)());
+
 void run_with_catch(const char* location, std::function<void()>&& lambda);
 
 
@@ -0,0 +1,73 @@
+/*  Round Trip Tracker
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Smoothed round-trip time of a request/response link. This is the same
+ *  estimator TCP uses (RFC 6298): an EMA of the samples (1/8 gain) and an EMA
+ *  of their deviation (1/4 gain).
+ *
+ *  Do not feed it samples from retransmitted messages. The reply could be to
+ *  any of the copies, so the sample is ambiguous. (Karn's algorithm)
+ *
+ *  Writers must be serialized by the caller. Readers are thread-safe.
+ *
+ */
+
+#ifndef PokemonAutomation_RoundTripTracker_H
+#define PokemonAutomation_RoundTripTracker_H
+
+#include <stdint.h>
+#include <atomic>
+#include "Time.h"
+
+namespace PokemonAutomation{
+
+
+class RoundTripTracker{
+public:
+    void add_sample(WallDuration round_trip){
+        int64_t sample = std::chrono::duration_cast<std::chrono::microseconds>(round_trip).count();
+        if (sample < 0){
+            return;
+        }
+
+        int64_t smoothed = m_smoothed_us.load(std::memory_order_relaxed);
+        int64_t deviation;
+        if (smoothed < 0){
+            smoothed = sample;
+            deviation = sample / 2;
+        }else{
+            deviation = m_deviation_us.load(std::memory_order_relaxed);
+            int64_t error = sample - smoothed;
+            deviation += ((error < 0 ? -error : error) - deviation) / 4;
+            smoothed += error / 8;
+        }
+
+        m_deviation_us.store(deviation, std::memory_order_relaxed);
+        m_smoothed_us.store(smoothed, std::memory_order_release);
+        m_samples.store(m_samples.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    uint64_t samples() const{
+        return m_samples.load(std::memory_order_relaxed);
+    }
+
+    //  Zero if there are no samples yet.
+    WallDuration smoothed() const{
+        int64_t smoothed = m_smoothed_us.load(std::memory_order_acquire);
+        return std::chrono::microseconds(smoothed < 0 ? 0 : smoothed);
+    }
+    WallDuration deviation() const{
+        return std::chrono::microseconds(m_deviation_us.load(std::memory_order_relaxed));
+    }
+
+private:
+    std::atomic<int64_t> m_smoothed_us{-1};
+    std::atomic<int64_t> m_deviation_us{0};
+    std::atomic<uint64_t> m_samples{0};
+};
+
+
+
+}
+#endif
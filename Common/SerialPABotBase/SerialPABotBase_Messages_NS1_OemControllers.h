@@ -78,6 +78,24 @@ typedef struct{
 } PABB_PACK pabb_Message_Command_NS1_OemController_FullState;
 
 
+//  Multiple button states packed into a single command. The device executes
+//  them back-to-back in order and finishes the command after the last one.
+//  Only "count" entries are sent over the wire.
+//
+//  Supported starting from protocol PABB_PROTOCOL_VERSION_BATCHED_REPORTS.
+#define PABB_MSG_COMMAND_NS1_OEM_CONTROLLER_BUTTONS_BATCH   0xa2
+#define PABB_NS1_OEM_CONTROLLER_BUTTONS_BATCH_MAX           4
+typedef struct{
+    uint16_t milliseconds;
+    pabb_NintendoSwitch_OemController_State0x30_Buttons buttons;
+} PABB_PACK pabb_NS1_OemController_ButtonsBatchEntry;
+typedef struct{
+    seqnum_t seqnum;
+    uint8_t count;
+    pabb_NS1_OemController_ButtonsBatchEntry entries[PABB_NS1_OEM_CONTROLLER_BUTTONS_BATCH_MAX];
+} PABB_PACK pabb_Message_Command_NS1_OemController_ButtonsBatch;
+
+
 
 
 #ifdef __cplusplus
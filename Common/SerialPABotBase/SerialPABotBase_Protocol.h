@@ -148,6 +148,14 @@ extern "C" {
 //  Must be a power-of-two.
 #define PABB_DEVICE_MINIMUM_QUEUE_SIZE  4
 
+//  First protocol version that understands batched controller reports.
+//  (PABB_MSG_COMMAND_NS1_OEM_CONTROLLER_BUTTONS_BATCH)
+//  Older devices reject unknown message types with a fatal error. So the
+//  host must not send them unless the device reports at least this version.
+//  No released firmware reports this version yet, so until one does the host
+//  never sends batched reports.
+#define PABB_PROTOCOL_VERSION_BATCHED_REPORTS   2025120801
+
 typedef uint32_t seqnum_t;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -11,9 +11,12 @@
 #include <vector>
 #include "Common/Cpp/Color.h"
 #include "Common/Cpp/Containers/AlignedVector.h"
+#include "Spectrum/SpectrumBands.h"
 
 namespace PokemonAutomation{
 
+class AudioMatchingEngine;
+
 //  The result of one FFT computation, an array of the magnitudes of different
 //  frequencies.
 //  Each spectrum is computed using a sliding window on the incoming audio stream.
@@ -30,11 +33,28 @@ public:
     //  higher frequencies.
     std::shared_ptr<const AlignedVector<float>> magnitudes;
 
+    //  Compact copies of the bands requested with AudioFeed::add_spectrum_band().
+    //  nullptr if the feed didn't publish any.
+    std::shared_ptr<const std::vector<BandSpectrum>> bands;
+
     AudioSpectrum(uint64_t s, size_t rate, std::shared_ptr<const AlignedVector<float>> m)
         : stamp(s)
         , sample_rate(rate)
         , magnitudes(std::move(m))
     {}
+
+    //  Return the published copy of "band". nullptr if it isn't there.
+    std::shared_ptr<const AlignedVector<float>> find_band(const SpectrumBand& band) const{
+        if (!bands){
+            return nullptr;
+        }
+        for (const BandSpectrum& item : *bands){
+            if (item.band == band){
+                return item.magnitudes;
+            }
+        }
+        return nullptr;
+    }
 };
 
 //  Define basic interface of an audio feed to be used by programs or other services.
@@ -52,8 +72,28 @@ public:
     //  Returned spectrums are ordered from newest (largest timestamp) to oldest (smallest timestamp) in the vector.
     virtual std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums) = 0;
 
+    //  Same as above, but overwrite "spectrums" instead of returning a new
+    //  vector. Use these from periodic callers to reuse the buffer.
+    virtual void read_spectrums_since(uint64_t starting_seqnum, std::vector<AudioSpectrum>& spectrums){
+        spectrums = spectrums_since(starting_seqnum);
+    }
+    virtual void read_spectrums_latest(size_t num_last_spectrums, std::vector<AudioSpectrum>& spectrums){
+        spectrums = spectrums_latest(num_last_spectrums);
+    }
+
     //  Add visual overlay to the spectrums starting at `starting_stamp` and before `end_stamp` with `color`.
     virtual void add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color) = 0;
+
+    //  Ask the feed to publish a compact copy of "band" with every spectrum.
+    //  (see AudioSpectrum::bands) Requests are reference counted. Feeds that
+    //  don't support this ignore it and consumers fall back to the full spectrum.
+    virtual void add_spectrum_band([[maybe_unused]] const SpectrumBand& band){}
+    virtual void remove_spectrum_band([[maybe_unused]] const SpectrumBand& band){}
+
+    //  The spectrogram matching engine shared by all the audio detectors on
+    //  this feed. Return nullptr if the feed doesn't have one. In that case
+    //  each detector uses its own.
+    virtual AudioMatchingEngine* matching_engine(){ return nullptr; }
 };
 
 
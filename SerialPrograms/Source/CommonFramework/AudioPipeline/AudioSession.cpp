@@ -7,6 +7,7 @@
 #include "Common/Cpp/AbstractLogger.h"
 #include "CommonFramework/GlobalServices.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonTools/Audio/AudioMatchingEngine.h"
 #include "Backends/AudioPassthroughPairQtThread.h"
 #include "AudioPipelineOptions.h"
 #include "AudioSession.h"
@@ -46,6 +47,7 @@ void AudioSession::remove_spectrum_listener(AudioSpectrumHolder::Listener& liste
 AudioSession::AudioSession(Logger& logger, AudioOption& option)
      : m_logger(logger)
      , m_option(option)
+     , m_matching_engine(new AudioMatchingEngine())
      , m_devices(new AudioPassthroughPairQtThread(logger))
 {
     AudioSession::reset();
@@ -282,9 +284,24 @@ std::vector<AudioSpectrum> AudioSession::spectrums_since(uint64_t starting_seqnu
 std::vector<AudioSpectrum> AudioSession::spectrums_latest(size_t num_last_spectrums){
     return m_spectrum_holder.spectrums_latest(num_last_spectrums);
 }
+AudioMatchingEngine* AudioSession::matching_engine(){
+    return m_matching_engine.get();
+}
+void AudioSession::read_spectrums_since(uint64_t starting_seqnum, std::vector<AudioSpectrum>& spectrums){
+    m_spectrum_holder.read_spectrums_since(starting_seqnum, spectrums);
+}
+void AudioSession::read_spectrums_latest(size_t num_last_spectrums, std::vector<AudioSpectrum>& spectrums){
+    m_spectrum_holder.read_spectrums_latest(num_last_spectrums, spectrums);
+}
 void AudioSession::add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color){
     m_spectrum_holder.add_overlay(starting_seqnum, end_seqnum, color);
 }
+void AudioSession::add_spectrum_band(const SpectrumBand& band){
+    m_spectrum_holder.add_spectrum_band(band);
+}
+void AudioSession::remove_spectrum_band(const SpectrumBand& band){
+    m_spectrum_holder.remove_spectrum_band(band);
+}
 
 
 void AudioSession::on_fft(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> fft_output){
@@ -79,7 +79,12 @@ public:
     virtual void reset() override;
     virtual std::vector<AudioSpectrum> spectrums_since(uint64_t starting_seqnum) override;
     virtual std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums) override;
+    virtual void read_spectrums_since(uint64_t starting_seqnum, std::vector<AudioSpectrum>& spectrums) override;
+    virtual void read_spectrums_latest(size_t num_last_spectrums, std::vector<AudioSpectrum>& spectrums) override;
     virtual void add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color) override;
+    virtual void add_spectrum_band(const SpectrumBand& band) override;
+    virtual void remove_spectrum_band(const SpectrumBand& band) override;
+    virtual AudioMatchingEngine* matching_engine() override;
 
 
 private:
@@ -97,6 +102,7 @@ private:
     Logger& m_logger;
     AudioOption& m_option;
     AudioSpectrumHolder m_spectrum_holder;
+    std::unique_ptr<AudioMatchingEngine> m_matching_engine;
     std::unique_ptr<AudioPassthroughPair> m_devices;
 
     mutable std::mutex m_lock;
@@ -26,7 +26,11 @@ AudioSpectrumHolder::AudioSpectrumHolder()
 //    , m_freq_visualization_block_boundaries(m_num_freq_visualization_blocks + 1)
 //    , m_spectrograph(m_num_freq_visualization_blocks, m_num_freq_windows)
     , m_freqVisStamps(m_num_freq_windows)
+    , m_ring(RING_SIZE, AudioSpectrum(0, 0, nullptr))
+    , m_ring_end(0)
 {
+    static_assert(RING_SIZE >= 40, "Ring must hold the full history.");
+
     // We will display frequencies in log scale, so need to convert
     // log scale: 0, 1/m_numFreqVisBlocks, 2/m_numFreqVisBlocks, ..., 1.0
     // to linear scale:
@@ -106,19 +110,18 @@ void AudioSpectrumHolder::remove_listener(Listener& listener){
 }
 
 void AudioSpectrumHolder::clear(){
+    {
+        //  Stamps keep counting up from where they were in case the audio
+        //  widget is used again to store new spectrums.
+        WriteSpinLock lg(m_ring_lock, "AudioSpectrumHolder::clear()");
+        m_ring_begin = m_ring_end.load(std::memory_order_relaxed);
+    }
     {
         std::lock_guard<std::mutex> lg(m_state_lock);
 
         m_freqVisStamps.assign(m_freqVisStamps.size(), SIZE_MAX);
 
         {
-            // update m_spectrum_stamp_start in case the audio widget is used
-            // again to store new spectrums.
-            if (m_spectrums.size() > 0){
-                m_spectrum_stamp_start = m_spectrums.front().stamp + 1;
-            }
-            m_spectrums.clear();
-
             m_spectrograph->clear();
             m_last_spectrum.timestamp = current_time();
             memset(m_last_spectrum.values.data(), 0, m_last_spectrum.values.size() * sizeof(float));
@@ -159,83 +162,98 @@ PA_FORCE_INLINE uint32_t jetColorMap(float v){
 void AudioSpectrumHolder::push_spectrum(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> fft_output){
     WallClock timestamp = current_time();
 
+    //  Cut out the bands the detectors asked for before publishing so that
+    //  they are never seen without them.
+    std::shared_ptr<const std::vector<BandSpectrum>> bands = m_bands.extract(*fft_output);
+
+    uint64_t stamp;
+    AudioSpectrum evicted(0, 0, nullptr);
     {
-        std::lock_guard<std::mutex> lg(m_state_lock);
+        WriteSpinLock lg(m_ring_lock, "AudioSpectrumHolder::push_spectrum()");
+        stamp = m_ring_end.load(std::memory_order_relaxed);
+        AudioSpectrum& slot = m_ring[stamp % RING_SIZE];
+        evicted = std::move(slot);
+        slot = AudioSpectrum(stamp, sample_rate, fft_output);
+        slot.bands = std::move(bands);
+        m_ring_end.store(stamp + 1, std::memory_order_release);
+        if (m_ring_begin + RING_SIZE <= stamp){
+            m_ring_begin = stamp + 1 - RING_SIZE;
+        }
+    }
+    //  The evicted spectrum is freed here outside the lock.
 
-        const AlignedVector<float>& output = *fft_output;
+    //  Nobody is looking at the spectrograph. Skip all the visualization work.
+    if (m_listeners.empty() && !m_saveFreqToDisk.load(std::memory_order_relaxed)){
+        return;
+    }
 
-        {
-            const size_t stamp = (m_spectrums.size() > 0) ? m_spectrums.front().stamp + 1 : m_spectrum_stamp_start;
-            m_spectrums.emplace_front(stamp, sample_rate, fft_output);
-            if (m_spectrums.size() > m_spectrum_history_length){
-                m_spectrums.pop_back();
-            }
+    update_visualization(timestamp, stamp, *fft_output);
+    m_listeners.run_method(&Listener::state_changed);
+}
+void AudioSpectrumHolder::update_visualization(
+    WallClock timestamp, uint64_t stamp,
+    const AlignedVector<float>& output
+){
+    std::lock_guard<std::mutex> lg(m_state_lock);
 
-            // std::cout << "Load FFT output , stamp " << spectrum->stamp << std::endl;
-            m_freqVisStamps[m_nextFFTWindowIndex] = stamp;
+    // std::cout << "Load FFT output , stamp " << spectrum->stamp << std::endl;
+    m_freqVisStamps[m_nextFFTWindowIndex] = stamp;
+
+    //  Scale the by the square root of the transform length.
+    //  For random noise input, the frequency domain will have an average
+    //  magnitude of sqrt(transform length).
+    float scale = std::sqrt(0.25f / (float)output.size());
+
+//    //  Divide by output size. Since samples can never be larger than 1.0, the
+//    //  frequency domain can never be larger than the FFT length. So we scale by
+//    //  the FFT length to guarantee that it also stays less than 1.0.
+//    float scale = 0.5f / (float)output.size();
+
+    // For one window, use how many blocks to show all frequencies:
+    float previous = 0;
+    m_last_spectrum.timestamp = timestamp;
+    for (size_t i = 0; i < m_freq_visualization_block_boundaries.size() - 1; i++){
+        float mag = 0.0f;
+        for(size_t j = m_freq_visualization_block_boundaries[i]; j < m_freq_visualization_block_boundaries[i+1]; j++){
+            mag += output[j];
         }
 
-        //  Scale the by the square root of the transform length.
-        //  For random noise input, the frequency domain will have an average
-        //  magnitude of sqrt(transform length).
-        float scale = std::sqrt(0.25f / (float)output.size());
-
-//        //  Divide by output size. Since samples can never be larger than 1.0, the
-//        //  frequency domain can never be larger than the FFT length. So we scale by
-//        //  the FFT length to guarantee that it also stays less than 1.0.
-//        float scale = 0.5f / (float)output.size();
-
-//        float skew_factor = 999.;
-//        float skew_scale = 1.f / (float)std::log1pf(skew_factor);
-
-        // For one window, use how many blocks to show all frequencies:
-        float previous = 0;
-        m_last_spectrum.timestamp = timestamp;
-        for (size_t i = 0; i < m_freq_visualization_block_boundaries.size() - 1; i++){
-            float mag = 0.0f;
-            for(size_t j = m_freq_visualization_block_boundaries[i]; j < m_freq_visualization_block_boundaries[i+1]; j++){
-                mag += output[j];
-            }
+        size_t width = m_freq_visualization_block_boundaries[i+1] - m_freq_visualization_block_boundaries[i];
 
-            size_t width = m_freq_visualization_block_boundaries[i+1] - m_freq_visualization_block_boundaries[i];
+        if (width == 0){
+            mag = previous;
+        }else{
+            mag /= width;
+            mag *= scale;
 
-            if (width == 0){
-                mag = previous;
-            }else{
-                mag /= width;
-                mag *= scale;
+            mag = std::sqrt(mag);
 
-                mag = std::sqrt(mag);
-//                mag = std::log1pf(mag * skew_factor) * skew_scale;
-//                mag = std::log1pf(std::sqrtf(mag)) * std::log1pf(1);
-//                mag = std::sqrt(2*mag - mag*mag);
-//                float m1 = 1 - mag;
-//                mag = std::sqrtf(1 - m1*m1);
+            // Clamp to [0.0, 1.0]
+            mag = std::min(mag, 1.0f);
+            mag = std::max(mag, 0.0f);
+        }
 
-                // Clamp to [0.0, 1.0]
-                mag = std::min(mag, 1.0f);
-                mag = std::max(mag, 0.0f);
-            }
+        m_last_spectrum.values[i] = mag;
+        m_last_spectrum.colors[i] = jetColorMap(mag);
+        previous = mag;
+    }
+//    cout << "AudioSpectrumHolder::push_spectrum" << endl;
+    m_spectrograph->push_spectrum(m_last_spectrum.colors.data());
+    m_nextFFTWindowIndex = (m_nextFFTWindowIndex+1) % m_num_freq_windows;
 
-            m_last_spectrum.values[i] = mag;
-            m_last_spectrum.colors[i] = jetColorMap(mag);
-            previous = mag;
-        }
-//        cout << "AudioSpectrumHolder::push_spectrum" << endl;
-        m_spectrograph->push_spectrum(m_last_spectrum.colors.data());
-        m_nextFFTWindowIndex = (m_nextFFTWindowIndex+1) % m_num_freq_windows;
-//        std::cout << "Computed FFT! "  << magSum << std::endl;
-
-        if (m_saveFreqToDisk){
-            for(size_t i = 0; i < m_num_freqs; i++){
-                m_freqStream << output[i] << " ";
-            }
-            m_freqStream << std::endl;
+    if (m_saveFreqToDisk.load(std::memory_order_relaxed)){
+        for(size_t i = 0; i < m_num_freqs; i++){
+            m_freqStream << output[i] << " ";
         }
+        m_freqStream << std::endl;
     }
-    m_listeners.run_method(&Listener::state_changed);
 }
 void AudioSpectrumHolder::add_overlay(uint64_t starting_stamp, uint64_t end_stamp, Color color){
+    //  Overlays are only drawn on the spectrograph. If nobody is showing it,
+    //  there's nothing to prune them against either.
+    if (m_listeners.empty()){
+        return;
+    }
     {
         std::lock_guard<std::mutex> lg(m_state_lock);
 
@@ -257,33 +275,42 @@ void AudioSpectrumHolder::add_overlay(uint64_t starting_stamp, uint64_t end_stam
     m_listeners.run_method(&Listener::state_changed);
 }
 
-std::vector<AudioSpectrum> AudioSpectrumHolder::spectrums_since(uint64_t starting_stamp){
-    std::vector<AudioSpectrum> spectrums;
-
-    std::lock_guard<std::mutex> lg(m_state_lock);
+void AudioSpectrumHolder::read_range(uint64_t begin, uint64_t end, std::vector<AudioSpectrum>& spectrums) const{
+    //  Must call under the ring lock.
+    end = std::min(end, m_ring_end.load(std::memory_order_relaxed));
+    uint64_t history_begin = end < m_spectrum_history_length ? 0 : end - m_spectrum_history_length;
+    begin = std::max(begin, std::max(history_begin, m_ring_begin));
+    for (uint64_t stamp = end; stamp-- > begin;){
+        spectrums.emplace_back(m_ring[stamp % RING_SIZE]);
+    }
+}
+void AudioSpectrumHolder::read_spectrums_since(uint64_t starting_stamp, std::vector<AudioSpectrum>& spectrums) const{
+    spectrums.clear();
 
-    for (const auto& ptr : m_spectrums){
-        if (ptr.stamp >= starting_stamp){
-            spectrums.emplace_back(ptr);
-        }else{
-            break;
-        }
+    //  Nothing new. Don't bother with the lock.
+    if (starting_stamp >= m_ring_end.load(std::memory_order_acquire)){
+        return;
     }
+
+    ReadSpinLock lg(m_ring_lock, "AudioSpectrumHolder::read_spectrums_since()");
+    read_range(starting_stamp, UINT64_MAX, spectrums);
+}
+void AudioSpectrumHolder::read_spectrums_latest(size_t num_latest_spectrums, std::vector<AudioSpectrum>& spectrums) const{
+    spectrums.clear();
+
+    ReadSpinLock lg(m_ring_lock, "AudioSpectrumHolder::read_spectrums_latest()");
+    uint64_t end = m_ring_end.load(std::memory_order_relaxed);
+    uint64_t begin = end < num_latest_spectrums ? 0 : end - num_latest_spectrums;
+    read_range(begin, end, spectrums);
+}
+std::vector<AudioSpectrum> AudioSpectrumHolder::spectrums_since(uint64_t starting_stamp){
+    std::vector<AudioSpectrum> spectrums;
+    read_spectrums_since(starting_stamp, spectrums);
     return spectrums;
 }
 std::vector<AudioSpectrum> AudioSpectrumHolder::spectrums_latest(size_t num_latest_spectrums){
     std::vector<AudioSpectrum> spectrums;
-
-    std::lock_guard<std::mutex> lg(m_state_lock);
-
-    size_t i = 0;
-    for (const auto& ptr : m_spectrums){
-        if (i == num_latest_spectrums){
-            break;
-        }
-        spectrums.push_back(ptr);
-        i++;
-    }
+    read_spectrums_latest(num_latest_spectrums, spectrums);
     return spectrums;
 }
 AudioSpectrumHolder::SpectrumSnapshot AudioSpectrumHolder::get_last_spectrum() const{
@@ -347,12 +374,12 @@ AudioSpectrumHolder::SpectrographSnapshot AudioSpectrumHolder::get_spectrograph(
 void AudioSpectrumHolder::saveAudioFrequenciesToDisk(bool enable){
     std::lock_guard<std::mutex> lg(m_state_lock);
     if (enable){
-        if (m_saveFreqToDisk == false){
-            m_saveFreqToDisk = enable;
+        if (!m_saveFreqToDisk.load(std::memory_order_relaxed)){
             m_freqStream.open("./frequencies.txt");
+            m_saveFreqToDisk.store(true, std::memory_order_relaxed);
         }
-    }else if (m_saveFreqToDisk){
-        m_saveFreqToDisk = enable;
+    }else if (m_saveFreqToDisk.load(std::memory_order_relaxed)){
+        m_saveFreqToDisk.store(false, std::memory_order_relaxed);
         m_freqStream.close();
     }
 }
@@ -10,9 +10,11 @@
 #include <list>
 #include <set>
 #include <mutex>
+#include <atomic>
 #include <fstream>
 #include "Common/Cpp/Time.h"
 #include "Common/Cpp/ListenerSet.h"
+#include "Common/Cpp/Concurrency/SpinLock.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
 #include "Spectrograph.h"
@@ -20,6 +22,21 @@
 namespace PokemonAutomation{
 
 
+//  The spectrums used for inference live in a ring indexed by stamp. It has a
+//  single writer (the audio thread) and any number of readers. Readers only
+//  take a read lock, so they never block each other, and a reader with
+//  nothing new returns without taking the lock at all.
+//
+//  Reads are not zero-copy. Each slot owns its magnitudes through a
+//  shared_ptr and the writer releases a slot as soon as it is overwritten, so
+//  a view into the ring could be left pointing at freed buffers. Readers
+//  copy the AudioSpectrum entries (one refcount bump per spectrum, no sample
+//  data) into a vector they own and reuse, which is also what the detectors'
+//  process_spectrums() takes.
+//
+//  The visualization (spectrograph, last spectrum, overlays) is separate and
+//  is only computed while there is at least one listener attached. So when no
+//  audio display is open, pushing a spectrum is just a ring insert.
 class AudioSpectrumHolder{
 public:
     struct Listener{
@@ -41,6 +58,10 @@ public:
     void push_spectrum(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> fft_output);
     void add_overlay(uint64_t starting_stamp, uint64_t end_stamp, Color color);
 
+    //  Bands to cut out of every pushed spectrum. (see AudioSpectrum::bands)
+    void add_spectrum_band(const SpectrumBand& band){ m_bands.add(band); }
+    void remove_spectrum_band(const SpectrumBand& band){ m_bands.remove(band); }
+
 
 public:
     //  Asynchronous and thread-safe getters.
@@ -48,6 +69,11 @@ public:
     std::vector<AudioSpectrum> spectrums_since(uint64_t starting_stamp);
     std::vector<AudioSpectrum> spectrums_latest(size_t num_latest_spectrums);
 
+    //  Same as above, but write into "spectrums" so the caller can reuse the
+    //  buffer. Newest first.
+    void read_spectrums_since(uint64_t starting_stamp, std::vector<AudioSpectrum>& spectrums) const;
+    void read_spectrums_latest(size_t num_latest_spectrums, std::vector<AudioSpectrum>& spectrums) const;
+
     struct SpectrumSnapshot{
         WallClock timestamp;
         std::vector<float> values;
@@ -68,6 +94,14 @@ public:
     void saveAudioFrequenciesToDisk(bool enable);
 
 
+private:
+    void update_visualization(
+        WallClock timestamp, uint64_t stamp,
+        const AlignedVector<float>& output
+    );
+    void read_range(uint64_t begin, uint64_t end, std::vector<AudioSpectrum>& spectrums) const;
+
+
 private:
     // Num frequencies to store for the output of one fft computation.
     const size_t m_num_freqs;
@@ -89,17 +123,22 @@ private:
     // The index of the next window in m_freqVisBlocks.
     size_t m_nextFFTWindowIndex = 0;
 
-    // record the past FFT output frequencies to serve as the interface
+    // Record the past FFT output frequencies to serve as the interface
     // of audio inference for automation programs.
-    // The head of the list is the most recent FFT window, while the tail
-    // is the oldest in history.
-    std::list<AudioSpectrum> m_spectrums;
-    size_t m_spectrum_history_length = 40;
-    // The initial timestamp for the incoming spectrums.
-    size_t m_spectrum_stamp_start = 0;
+    // Spectrum with stamp "s" is at m_ring[s % RING_SIZE]. The valid stamps
+    // are [m_ring_begin, m_ring_end) and at most m_spectrum_history_length
+    // of the newest ones are returned.
+    static constexpr size_t RING_SIZE = 64;
+    const size_t m_spectrum_history_length = 40;
+    mutable SpinLockMRSW m_ring_lock;
+    std::vector<AudioSpectrum> m_ring;
+    uint64_t m_ring_begin = 0;
+    std::atomic<uint64_t> m_ring_end;
+
+    SpectrumBandSet m_bands;
 
     // Develop purpose: used to save received frequencies to disk
-    bool m_saveFreqToDisk = false;
+    std::atomic<bool> m_saveFreqToDisk = false;
     std::ofstream m_freqStream;
 
     // The inference boxes <box starting stamp, box end stamp, box color>
@@ -0,0 +1,104 @@
+/*  Spectrum Bands
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Kernels/Kernels_Alignment.h"
+#include "SpectrumBands.h"
+
+namespace PokemonAutomation{
+
+
+
+std::shared_ptr<AlignedVector<float>> extract_spectrum_band(
+    const SpectrumBand& band, const float* magnitudes
+){
+    const size_t size = band.output_size();
+    const size_t padded = Kernels::align_int_up<PA_ALIGNMENT>(size * sizeof(float)) / sizeof(float);
+
+    auto ret = std::make_shared<AlignedVector<float>>(padded);
+    float* out = ret->data();
+
+    const float* in = magnitudes + band.start;
+    if (band.decimation <= 1){
+        memcpy(out, in, size * sizeof(float));
+    }else{
+        //  Keep the same summation order as the templates are built with so
+        //  that the values are bit-identical.
+        const float divisor = (float)band.decimation;
+        for (size_t c = 0; c < size; c++){
+            float sum = in[0];
+            for (size_t i = 1; i < band.decimation; i++){
+                sum += in[i];
+            }
+            out[c] = sum / divisor;
+            in += band.decimation;
+        }
+    }
+    memset(out + size, 0, (padded - size) * sizeof(float));
+
+    return ret;
+}
+
+
+
+void SpectrumBandSet::add(const SpectrumBand& band){
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_refcounts[band]++ == 0){
+        rebuild_list();
+    }
+}
+void SpectrumBandSet::remove(const SpectrumBand& band){
+    std::lock_guard<std::mutex> lg(m_lock);
+    auto iter = m_refcounts.find(band);
+    if (iter == m_refcounts.end()){
+        return;
+    }
+    if (--iter->second == 0){
+        m_refcounts.erase(iter);
+        rebuild_list();
+    }
+}
+void SpectrumBandSet::rebuild_list(){
+    if (m_refcounts.empty()){
+        m_list.reset();
+        return;
+    }
+    auto list = std::make_shared<std::vector<SpectrumBand>>();
+    list->reserve(m_refcounts.size());
+    for (const auto& item : m_refcounts){
+        list->emplace_back(item.first);
+    }
+    m_list = std::move(list);
+}
+
+std::shared_ptr<const std::vector<BandSpectrum>> SpectrumBandSet::extract(const AlignedVector<float>& magnitudes) const{
+    std::shared_ptr<const std::vector<SpectrumBand>> list;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        list = m_list;
+    }
+    if (!list){
+        return nullptr;
+    }
+
+    auto ret = std::make_shared<std::vector<BandSpectrum>>();
+    ret->reserve(list->size());
+    for (const SpectrumBand& band : *list){
+        if (band.decimation == 0 || band.start >= band.end || band.end > magnitudes.size()){
+            continue;
+        }
+        ret->emplace_back(BandSpectrum{band, extract_spectrum_band(band, magnitudes.data())});
+    }
+    if (ret->empty()){
+        return nullptr;
+    }
+    return ret;
+}
+
+
+
+}
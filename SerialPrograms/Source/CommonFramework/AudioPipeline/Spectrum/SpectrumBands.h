@@ -0,0 +1,94 @@
+/*  Spectrum Bands
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Most audio detectors only look at part of the spectrum. (e.g. everything
+ *  above some low-frequency cut-off and below 20KHz, sometimes averaged down.)
+ *  Detectors register the bands they need with the audio feed and the feed
+ *  publishes a compact copy of each band along with every full spectrum. So the
+ *  matching only touches the bins it actually uses.
+ *
+ */
+
+#ifndef PokemonAutomation_AudioPipeline_SpectrumBands_H
+#define PokemonAutomation_AudioPipeline_SpectrumBands_H
+
+#include <memory>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include "Common/Cpp/Containers/AlignedVector.h"
+
+namespace PokemonAutomation{
+
+
+
+//  A range of FFT bins [start, end) of the full spectrum.
+//  If "decimation" > 1, every "decimation" consecutive bins are averaged into
+//  one. "end - start" must be a multiple of "decimation".
+struct SpectrumBand{
+    size_t start = 0;
+    size_t end = 0;
+    size_t decimation = 1;
+
+    size_t output_size() const{
+        return (end - start) / decimation;
+    }
+
+    bool operator==(const SpectrumBand& x) const{
+        return start == x.start && end == x.end && decimation == x.decimation;
+    }
+    bool operator<(const SpectrumBand& x) const{
+        return std::tie(start, end, decimation) < std::tie(x.start, x.end, x.decimation);
+    }
+};
+
+
+//  A band cut out of a full spectrum.
+struct BandSpectrum{
+    SpectrumBand band;
+
+    //  "band.output_size()" values, padded with zeros to PA_ALIGNMENT.
+    std::shared_ptr<const AlignedVector<float>> magnitudes;
+};
+
+
+//  Cut "band" out of the full spectrum "magnitudes".
+//  The returned buffer is padded with zeros to PA_ALIGNMENT.
+std::shared_ptr<AlignedVector<float>> extract_spectrum_band(
+    const SpectrumBand& band, const float* magnitudes
+);
+
+
+
+//  The set of bands requested by all the consumers of an audio feed.
+//  Requests are reference counted.
+//
+//  This class is thread-safe.
+class SpectrumBandSet{
+public:
+    void add(const SpectrumBand& band);
+    void remove(const SpectrumBand& band);
+
+    //  Cut every requested band out of the full spectrum "magnitudes".
+    //  Bands that don't fit in "magnitudes" are skipped.
+    //  Return nullptr if there are no bands to publish.
+    std::shared_ptr<const std::vector<BandSpectrum>> extract(const AlignedVector<float>& magnitudes) const;
+
+private:
+    void rebuild_list();
+
+private:
+    mutable std::mutex m_lock;
+    std::map<SpectrumBand, size_t> m_refcounts;
+
+    //  Snapshot of the keys of "m_refcounts". Replaced on every change so that
+    //  the audio thread can iterate it without holding the lock.
+    std::shared_ptr<const std::vector<SpectrumBand>> m_list;
+};
+
+
+
+}
+#endif
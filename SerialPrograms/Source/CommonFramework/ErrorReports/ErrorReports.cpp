@@ -11,6 +11,7 @@
 #include "Common/Cpp/Json/JsonArray.h"
 #include "Common/Cpp/Json/JsonObject.h"
 #include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "Controllers/ControllerTrace.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/GlobalServices.h"
@@ -32,6 +33,7 @@ namespace PokemonAutomation{
 
 const std::string& ERROR_LOGS_NAME = "Logs.log";
 const std::string& ERROR_DUMP_NAME = "Minidump.dmp";
+const std::string& ERROR_CONTROLLER_TRACE_NAME = "ControllerTrace.bin";
 const std::string& ERROR_PATH_UNSENT = "ErrorReportsLocal";
 const std::string& ERROR_PATH_SENT = "ErrorReportsSent";
 
@@ -149,6 +151,12 @@ SendableErrorReport::SendableErrorReport(
         }
         m_logs_name = ERROR_LOGS_NAME;
     }
+    if (!global_controller_trace().empty()){
+        try{
+            global_controller_trace().snapshot().save(m_directory + ERROR_CONTROLLER_TRACE_NAME);
+            m_files.emplace_back(ERROR_CONTROLLER_TRACE_NAME);
+        }catch (FileException&){}
+    }
     if (stream_history){
         if (stream_history->save(m_directory + "Video.mp4")){
             m_video_name = "Video.mp4";
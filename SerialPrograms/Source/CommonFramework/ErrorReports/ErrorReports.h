@@ -27,6 +27,7 @@ class StreamHistorySession;
 // Filename constants for error report components
 extern const std::string& ERROR_LOGS_NAME;        // "Logs.log" - The log file in each error report
 extern const std::string& ERROR_DUMP_NAME;        // "Minidump.dmp" - The minidump file if available
+extern const std::string& ERROR_CONTROLLER_TRACE_NAME;  // "ControllerTrace.bin" - Recent controller timing events
 extern const std::string& ERROR_PATH_UNSENT;      // "ErrorReportsLocal" - Directory path for unsent error reports
 extern const std::string& ERROR_PATH_SENT;        // "ErrorReportsSent" - Directory path for sent error reports
 
@@ -59,7 +60,8 @@ public:
 
 // Represents a complete error report that can be saved locally and sent to developers.
 // Each report is stored in its own timestamped directory (e.g., ErrorReportsLocal/20250216-155318967416/)
-// containing: Screenshot.png, Logs.log, Report.json, and optionally Video.mp4 and Minidump.dmp
+// containing: Screenshot.png, Logs.log, Report.json, and optionally Video.mp4, Minidump.dmp
+// and ControllerTrace.bin
 class SendableErrorReport{
 public:
     // Default constructor: Creates an empty error report with timestamp and directory
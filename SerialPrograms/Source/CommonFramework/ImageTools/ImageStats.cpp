@@ -9,6 +9,7 @@
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "ImageBoxes.h"
+#include "SummedAreaTable.h"
 #include "ImageStats.h"
 
 #include <iostream>
@@ -19,25 +20,37 @@ namespace PokemonAutomation{
 
 
 
-FloatPixel image_average(const ImageViewRGB32& image){
+namespace{
+
+Kernels::PixelSums pixel_sums(const ImageViewRGB32& image){
+    const SummedAreaTable* table = SummedAreaTableScope::current();
+    ImagePixelBox box;
+    if (table != nullptr && table->locate(box, image)){
+        return table->sums(box);
+    }
+
     Kernels::PixelSums sums;
     Kernels::pixel_sum_sqr(
         sums, image.width(), image.height(),
         image.data(), image.bytes_per_row(),
         image.data(), image.bytes_per_row()
     );
+    return sums;
+}
+
+}
+
+
+
+FloatPixel image_average(const ImageViewRGB32& image){
+    Kernels::PixelSums sums = pixel_sums(image);
 
     FloatPixel sum((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
 
     return sum / (double)sums.count;
 }
 FloatPixel image_stddev(const ImageViewRGB32& image){
-    Kernels::PixelSums sums;
-    Kernels::pixel_sum_sqr(
-        sums, image.width(), image.height(),
-        image.data(), image.bytes_per_row(),
-        image.data(), image.bytes_per_row()
-    );
+    Kernels::PixelSums sums = pixel_sums(image);
 
     FloatPixel sum((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
     FloatPixel sqr((double)sums.sqrR, (double)sums.sqrG, (double)sums.sqrB);
@@ -51,12 +64,7 @@ FloatPixel image_stddev(const ImageViewRGB32& image){
     );
 }
 ImageStats image_stats(const ImageViewRGB32& image){
-    Kernels::PixelSums sums;
-    Kernels::pixel_sum_sqr(
-        sums, image.width(), image.height(),
-        image.data(), image.bytes_per_row(),
-        image.data(), image.bytes_per_row()
-    );
+    Kernels::PixelSums sums = pixel_sums(image);
 
     FloatPixel sum((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
     FloatPixel sqr((double)sums.sqrR, (double)sums.sqrG, (double)sums.sqrB);
@@ -85,6 +93,44 @@ ImageStats image_stats(const ImageViewRGB32& image){
 
 
 
+namespace{
+
+//  Sums of the rows and columns that "image_border_stats()" reads. Only
+//  possible if all of them are opaque since that function doesn't skip
+//  transparent pixels.
+bool border_sums_from_table(FloatPixel& sum, FloatPixel& sqr_sum, const ImageViewRGB32& image){
+    const SummedAreaTable* table = SummedAreaTableScope::current();
+    ImagePixelBox box;
+    if (table == nullptr || !table->locate(box, image)){
+        return false;
+    }
+
+    size_t h = image.height();
+    const ImagePixelBox lines[] = {
+        {box.min_x, box.min_y, box.max_x, box.min_y + 1},
+        {box.min_x, box.max_y - 1, box.max_x, box.max_y},
+        {box.min_x, box.min_y, box.min_x + 1, box.max_y},
+    };
+    for (const ImagePixelBox& line : lines){
+        Kernels::PixelSums sums = table->sums(line);
+        if (sums.count != line.width() * line.height()){
+            return false;
+        }
+        sum += FloatPixel((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
+        sqr_sum += FloatPixel((double)sums.sqrR, (double)sums.sqrG, (double)sums.sqrB);
+    }
+
+    //  The last loop of "image_border_stats()" reads pixel (0, h - 1) h times.
+    FloatPixel p(image.pixel(0, h - 1));
+    FloatPixel times((double)h, (double)h, (double)h);
+    sum += p * times;
+    sqr_sum += p * p * times;
+
+    return true;
+}
+
+}
+
 ImageStats image_border_stats(const ImageViewRGB32& image){
     size_t w = image.width();
     size_t h = image.height();
@@ -95,25 +141,27 @@ ImageStats image_border_stats(const ImageViewRGB32& image){
     FloatPixel sum;
     FloatPixel sqr_sum;
 
-    for (size_t c = 0; c < w; c++){
-        FloatPixel p(image.pixel(c, 0));
-        sum += p;
-        sqr_sum += p * p;
-    }
-    for (size_t c = 0; c < w; c++){
-        FloatPixel p(image.pixel(c, h - 1));
-        sum += p;
-        sqr_sum += p * p;
-    }
-    for (size_t r = 0; r < h; r++){
-        FloatPixel p(image.pixel(0, r));
-        sum += p;
-        sqr_sum += p * p;
-    }
-    for (size_t r = 0; r < h; r++){
-        FloatPixel p(image.pixel(0, h - 1));
-        sum += p;
-        sqr_sum += p * p;
+    if (!border_sums_from_table(sum, sqr_sum, image)){
+        for (size_t c = 0; c < w; c++){
+            FloatPixel p(image.pixel(c, 0));
+            sum += p;
+            sqr_sum += p * p;
+        }
+        for (size_t c = 0; c < w; c++){
+            FloatPixel p(image.pixel(c, h - 1));
+            sum += p;
+            sqr_sum += p * p;
+        }
+        for (size_t r = 0; r < h; r++){
+            FloatPixel p(image.pixel(0, r));
+            sum += p;
+            sqr_sum += p * p;
+        }
+        for (size_t r = 0; r < h; r++){
+            FloatPixel p(image.pixel(0, h - 1));
+            sum += p;
+            sqr_sum += p * p;
+        }
     }
 
     size_t total = 2 * (w + h);
@@ -27,6 +27,9 @@ struct ImageStats{
 
 
 //  Pixels with alpha < 128 are ignored.
+//
+//  These are constant-time lookups if "image" is part of the image of the
+//  active SummedAreaTableScope on this thread.
 FloatPixel image_average(const ImageViewRGB32& image);
 FloatPixel image_stddev(const ImageViewRGB32& image);
 ImageStats image_stats(const ImageViewRGB32& image);
@@ -0,0 +1,141 @@
+/*  Summed-Area Table
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "SummedAreaTable.h"
+
+namespace PokemonAutomation{
+
+
+SummedAreaTable::~SummedAreaTable() = default;
+SummedAreaTable::SummedAreaTable()
+    : m_data(nullptr)
+    , m_bytes_per_row(0)
+    , m_width(0)
+    , m_height(0)
+{}
+SummedAreaTable::SummedAreaTable(const ImageViewRGB32& image)
+    : SummedAreaTable()
+{
+    build(image);
+}
+
+void SummedAreaTable::build(const ImageViewRGB32& image){
+    size_t width = image.width();
+    size_t height = image.height();
+
+    //  The 32-bit sums wrap around. Box sums are only exact below 2^24 pixels.
+    if (width * height >= ((size_t)1 << 24)){
+        throw InternalProgramError(
+            nullptr, PA_CURRENT_FUNCTION,
+            "Image is too large: " + std::to_string(width) + " x " + std::to_string(height)
+        );
+    }
+
+    m_data = (const char*)image.data();
+    m_bytes_per_row = image.bytes_per_row();
+
+    size_t stride = Kernels::pixel_integral_stride(width);
+    size_t plane = stride * (height + 1);
+    if (m_width != width || m_height != height){
+        m_width = width;
+        m_height = height;
+        m_sums = AlignedVector<uint32_t>(4 * plane);
+        m_sqrs = AlignedVector<uint64_t>(3 * plane);
+
+        m_table.stride = stride;
+        m_table.count = m_sums.data() + 0 * plane;
+        m_table.sumR = m_sums.data() + 1 * plane;
+        m_table.sumG = m_sums.data() + 2 * plane;
+        m_table.sumB = m_sums.data() + 3 * plane;
+        m_table.sqrR = m_sqrs.data() + 0 * plane;
+        m_table.sqrG = m_sqrs.data() + 1 * plane;
+        m_table.sqrB = m_sqrs.data() + 2 * plane;
+
+        //  Row 0 and column 0 never change.
+        uint32_t* sums[] = {m_table.count, m_table.sumR, m_table.sumG, m_table.sumB};
+        uint64_t* sqrs[] = {m_table.sqrR, m_table.sqrG, m_table.sqrB};
+        for (uint32_t* ptr : sums){
+            memset(ptr, 0, stride * sizeof(uint32_t));
+            for (size_t r = 1; r <= height; r++){
+                ptr[r * stride] = 0;
+            }
+        }
+        for (uint64_t* ptr : sqrs){
+            memset(ptr, 0, stride * sizeof(uint64_t));
+            for (size_t r = 1; r <= height; r++){
+                ptr[r * stride] = 0;
+            }
+        }
+    }
+
+    Kernels::pixel_integral(
+        m_table, width, height,
+        image.data(), image.bytes_per_row()
+    );
+}
+
+Kernels::PixelSums SummedAreaTable::sums(const ImagePixelBox& box) const{
+    size_t stride = m_table.stride;
+    size_t a = box.min_y * stride + box.min_x;
+    size_t b = box.min_y * stride + box.max_x;
+    size_t c = box.max_y * stride + box.min_x;
+    size_t d = box.max_y * stride + box.max_x;
+
+    Kernels::PixelSums sums;
+    sums.count = (uint32_t)(m_table.count[d] - m_table.count[b] - m_table.count[c] + m_table.count[a]);
+    sums.sumR = (uint32_t)(m_table.sumR[d] - m_table.sumR[b] - m_table.sumR[c] + m_table.sumR[a]);
+    sums.sumG = (uint32_t)(m_table.sumG[d] - m_table.sumG[b] - m_table.sumG[c] + m_table.sumG[a]);
+    sums.sumB = (uint32_t)(m_table.sumB[d] - m_table.sumB[b] - m_table.sumB[c] + m_table.sumB[a]);
+    sums.sqrR = m_table.sqrR[d] - m_table.sqrR[b] - m_table.sqrR[c] + m_table.sqrR[a];
+    sums.sqrG = m_table.sqrG[d] - m_table.sqrG[b] - m_table.sqrG[c] + m_table.sqrG[a];
+    sums.sqrB = m_table.sqrB[d] - m_table.sqrB[b] - m_table.sqrB[c] + m_table.sqrB[a];
+    return sums;
+}
+
+bool SummedAreaTable::locate(ImagePixelBox& box, const ImageViewRGB32& view) const{
+    if (m_data == nullptr || view.bytes_per_row() != m_bytes_per_row){
+        return false;
+    }
+    const char* ptr = (const char*)view.data();
+    if (ptr < m_data){
+        return false;
+    }
+    size_t offset = ptr - m_data;
+    if (offset % sizeof(uint32_t) != 0){
+        return false;
+    }
+    size_t min_y = offset / m_bytes_per_row;
+    size_t min_x = offset % m_bytes_per_row / sizeof(uint32_t);
+    if (min_x + view.width() > m_width || min_y + view.height() > m_height){
+        return false;
+    }
+    box = ImagePixelBox(min_x, min_y, min_x + view.width(), min_y + view.height());
+    return true;
+}
+
+
+
+static thread_local const SummedAreaTable* current_summed_area_table = nullptr;
+
+SummedAreaTableScope::SummedAreaTableScope(const SummedAreaTable* table)
+    : m_previous(current_summed_area_table)
+{
+    current_summed_area_table = table;
+}
+SummedAreaTableScope::~SummedAreaTableScope(){
+    current_summed_area_table = m_previous;
+}
+const SummedAreaTable* SummedAreaTableScope::current(){
+    return current_summed_area_table;
+}
+
+
+
+}
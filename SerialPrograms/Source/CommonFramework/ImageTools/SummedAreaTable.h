@@ -0,0 +1,84 @@
+/*  Summed-Area Table
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Per-channel sums and sums of squares of an image that can be looked up
+ *  for any box in constant time.
+ *
+ *  Building the table reads the entire image once and takes 40 bytes per
+ *  pixel. It only pays off if many boxes of the same image are measured.
+ *  Run the "Kernels_SummedAreaTable" test to see where that is on a machine.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_SummedAreaTable_H
+#define PokemonAutomation_CommonFramework_SummedAreaTable_H
+
+#include "Common/Cpp/Containers/AlignedVector.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqr.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelIntegral.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+
+namespace PokemonAutomation{
+
+class ImageViewRGB32;
+
+
+class SummedAreaTable{
+public:
+    ~SummedAreaTable();
+    SummedAreaTable();
+    SummedAreaTable(const ImageViewRGB32& image);
+
+    //  Rebuild the table from "image". The memory is reused if "image" is the
+    //  same size as the last one.
+    //  "image" must outlive the table or the next call to this function.
+    void build(const ImageViewRGB32& image);
+
+    size_t width() const{ return m_width; }
+    size_t height() const{ return m_height; }
+
+    //  Same as "Kernels::pixel_sum_sqr()" on "box" of the image with the image
+    //  as its own alpha mask. "box" must be inside the image.
+    Kernels::PixelSums sums(const ImagePixelBox& box) const;
+
+    //  If "view" is part of the image this table was built from, set "box" to
+    //  where it is in the image and return true.
+    bool locate(ImagePixelBox& box, const ImageViewRGB32& view) const;
+
+private:
+    const char* m_data;
+    size_t m_bytes_per_row;
+    size_t m_width;
+    size_t m_height;
+
+    Kernels::PixelIntegral m_table;
+    AlignedVector<uint32_t> m_sums;
+    AlignedVector<uint64_t> m_sqrs;
+};
+
+
+
+//  While one of these is alive, "image_average()", "image_stddev()",
+//  "image_stats()" and "image_border_stats()" called on this thread look up
+//  any view into the image of "table" from "table" instead of reading its
+//  pixels. Scopes can be nested. A null "table" turns the lookups off.
+class SummedAreaTableScope{
+public:
+    SummedAreaTableScope(const SummedAreaTable* table);
+    ~SummedAreaTableScope();
+
+    SummedAreaTableScope(const SummedAreaTableScope&) = delete;
+    void operator=(const SummedAreaTableScope&) = delete;
+
+    //  The table of the innermost scope on this thread.
+    static const SummedAreaTable* current();
+
+private:
+    const SummedAreaTable* m_previous;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,102 @@
+/*  Tile Change Map
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include "Kernels/ImageStats/Kernels_ImagePixelSumAbsDiff.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "TileChangeMap.h"
+
+namespace PokemonAutomation{
+
+
+TileChangeMap::TileChangeMap(double threshold)
+    : m_threshold(threshold)
+    , m_timestamp(WallClock::min())
+    , m_tiles_x(0)
+    , m_tiles_y(0)
+    , m_changed_tiles(0)
+{}
+
+void TileChangeMap::update(std::shared_ptr<const ImageRGB32> frame, WallClock timestamp){
+    size_t width = frame->width();
+    size_t height = frame->height();
+    size_t tiles_x = (width + TILE_SIZE - 1) / TILE_SIZE;
+    size_t tiles_y = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+    m_timestamp = timestamp;
+
+    if (!m_previous ||
+        m_previous->width() != width ||
+        m_previous->height() != height
+    ){
+        m_previous = std::move(frame);
+        m_tiles_x = tiles_x;
+        m_tiles_y = tiles_y;
+        m_changed_tiles = tiles_x * tiles_y;
+        m_sums.resize(tiles_x);
+        m_last_change.assign(tiles_x * tiles_y, timestamp);
+        return;
+    }
+
+    //  The alpha channels are opaque in both, so only RGB contribute.
+    double tile_threshold = m_threshold * 3 * TILE_SIZE * TILE_SIZE;
+
+    const ImageRGB32& previous = *m_previous;
+    m_changed_tiles = 0;
+    for (size_t r = 0; r < tiles_y; r++){
+        size_t min_y = r * TILE_SIZE;
+        size_t rows = std::min(TILE_SIZE, height - min_y);
+
+        std::fill(m_sums.begin(), m_sums.end(), 0);
+        Kernels::sum_abs_diff_tiles(
+            m_sums.data(), TILE_SIZE,
+            width, rows,
+            (const uint32_t*)((const char*)previous.data() + min_y * previous.bytes_per_row()), previous.bytes_per_row(),
+            (const uint32_t*)((const char*)frame->data() + min_y * frame->bytes_per_row()), frame->bytes_per_row()
+        );
+
+        //  Tiles on the right and bottom edges may be partial. Scale their
+        //  thresholds down to match.
+        WallClock* last_change = m_last_change.data() + r * tiles_x;
+        for (size_t c = 0; c < tiles_x; c++){
+            size_t columns = std::min(TILE_SIZE, width - c * TILE_SIZE);
+            double threshold = tile_threshold * (double)(rows * columns) / (TILE_SIZE * TILE_SIZE);
+            if ((double)m_sums[c] > threshold){
+                last_change[c] = timestamp;
+                m_changed_tiles++;
+            }
+        }
+    }
+
+    m_previous = std::move(frame);
+}
+
+WallClock TileChangeMap::last_change(const ImageFloatBox& box) const{
+    if (m_last_change.empty()){
+        return WallClock::max();
+    }
+
+    ImagePixelBox pixels = floatbox_to_pixelbox(m_previous->width(), m_previous->height(), box);
+    size_t min_x = std::min(pixels.min_x / TILE_SIZE, m_tiles_x - 1);
+    size_t min_y = std::min(pixels.min_y / TILE_SIZE, m_tiles_y - 1);
+    size_t max_x = std::min((pixels.max_x + TILE_SIZE - 1) / TILE_SIZE, m_tiles_x);
+    size_t max_y = std::min((pixels.max_y + TILE_SIZE - 1) / TILE_SIZE, m_tiles_y);
+    max_x = std::max(max_x, min_x + 1);
+    max_y = std::max(max_y, min_y + 1);
+
+    WallClock latest = WallClock::min();
+    for (size_t r = min_y; r < max_y; r++){
+        const WallClock* last_change = m_last_change.data() + r * m_tiles_x;
+        for (size_t c = min_x; c < max_x; c++){
+            latest = std::max(latest, last_change[c]);
+        }
+    }
+    return latest;
+}
+
+
+
+}
@@ -0,0 +1,70 @@
+/*  Tile Change Map
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Track which parts of a video stream have changed.
+ *
+ *  The frame is split into square tiles. Each new frame is compared against
+ *  the previous one and every tile remembers the timestamp of the last frame
+ *  in which it changed. A region that has no tile newer than some frame has
+ *  not changed since that frame.
+ *
+ *  Changes are only measured between consecutive frames. So a region that
+ *  drifts slowly enough to stay under the threshold on every frame will
+ *  never be seen as changed.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_TileChangeMap_H
+#define PokemonAutomation_CommonFramework_TileChangeMap_H
+
+#include <memory>
+#include <vector>
+#include "Common/Cpp/Time.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+
+namespace PokemonAutomation{
+
+class ImageRGB32;
+
+
+class TileChangeMap{
+public:
+    static constexpr size_t TILE_SIZE = 16;
+
+    //  A tile has changed if the average absolute difference of its R, G and
+    //  B channels against the previous frame is more than "threshold".
+    TileChangeMap(double threshold);
+
+    void set_threshold(double threshold){ m_threshold = threshold; }
+
+    //  Compare "frame" against the last frame given to this function.
+    //  The first frame and any frame with a new resolution change all tiles.
+    void update(std::shared_ptr<const ImageRGB32> frame, WallClock timestamp);
+
+    //  Timestamp of the last frame given to "update()".
+    WallClock timestamp() const{ return m_timestamp; }
+
+    //  Timestamp of the last frame in which any tile under "box" changed.
+    //  Returns WallClock::max() if there is no frame yet.
+    WallClock last_change(const ImageFloatBox& box) const;
+
+    //  Number of tiles that changed in the last call to "update()".
+    size_t changed_tiles() const{ return m_changed_tiles; }
+
+private:
+    double m_threshold;
+    std::shared_ptr<const ImageRGB32> m_previous;
+    WallClock m_timestamp;
+
+    size_t m_tiles_x;
+    size_t m_tiles_y;
+    size_t m_changed_tiles;
+    std::vector<uint64_t> m_sums;
+    std::vector<WallClock> m_last_change;
+};
+
+
+
+}
+#endif
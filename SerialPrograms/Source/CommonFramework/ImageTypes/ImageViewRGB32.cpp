@@ -26,8 +26,24 @@ ImageRGB32 ImageViewRGB32::copy() const{
 bool ImageViewRGB32::save(const std::string& path) const{
     return to_QImage_ref().save(QString::fromStdString(path));
 }
-ImageRGB32 ImageViewRGB32::scale_to(size_t width, size_t height) const{
-    return scaled_to_QImage(width, height);
+ImageRGB32 ImageViewRGB32::scale_to(size_t width, size_t height, Kernels::ImageScaleFilter filter) const{
+    ImageRGB32 ret;
+    scale_to(ret, width, height, filter);
+    return ret;
+}
+void ImageViewRGB32::scale_to(ImageRGB32& output, size_t width, size_t height, Kernels::ImageScaleFilter filter) const{
+    if (m_ptr == nullptr || width == 0 || height == 0){
+        output = ImageRGB32();
+        return;
+    }
+    if (output.width() != width || output.height() != height){
+        output = ImageRGB32(width, height);
+    }
+    Kernels::scale_image(
+        filter,
+        m_ptr, m_bytes_per_row, m_width, m_height,
+        output.data(), output.bytes_per_row(), width, height
+    );
 }
 
 
@@ -52,12 +68,16 @@ QImage ImageViewRGB32::to_QImage_owning() const{
     return to_QImage_ref().copy();
 }
 QImage ImageViewRGB32::scaled_to_QImage(size_t width, size_t height) const{
-    QImage tmp((const uchar*)m_ptr, (int)m_width, (int)m_height, (int)m_bytes_per_row, QImage::Format_ARGB32);
-    if (m_width == width && m_height == height){
-        return tmp.copy();
+    if (m_ptr == nullptr || width == 0 || height == 0){
+        return QImage();
     }
-    return tmp.scaled((int)width, (int)height);
-//    return tmp.scaled((int)width, (int)height, Qt::IgnoreAspectRatio, Qt::TransformationMode::SmoothTransformation);
+    QImage ret((int)width, (int)height, QImage::Format_ARGB32);
+    Kernels::scale_image(
+        Kernels::ImageScaleFilter::NEAREST,
+        m_ptr, m_bytes_per_row, m_width, m_height,
+        (uint32_t*)ret.bits(), ret.bytesPerLine(), width, height
+    );
+    return ret;
 }
 cv::Mat ImageViewRGB32::to_opencv_Mat() const{
     return cv::Mat{ static_cast<int>(m_height), static_cast<int>(m_width), CV_8UC4, (cv::Scalar*)m_ptr, m_bytes_per_row };
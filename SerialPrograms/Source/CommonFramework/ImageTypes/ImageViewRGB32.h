@@ -8,6 +8,7 @@
 #define PokemonAutomation_CommonFramework_ImageViewRGB32_H
 
 #include <string>
+#include "Kernels/ImageScale/Kernels_ImageScale.h"
 #include "ImageViewPlanar32.h"
 
 class QImage;
@@ -47,7 +48,20 @@ public:
 public:
     ImageRGB32 copy() const;
     bool save(const std::string& path) const;
-    ImageRGB32 scale_to(size_t width, size_t height) const;
+
+    //  Resample to "width" x "height". The default filter follows the
+    //  sampling of QImage::scaled() with Qt::FastTransformation.
+    ImageRGB32 scale_to(
+        size_t width, size_t height,
+        Kernels::ImageScaleFilter filter = Kernels::ImageScaleFilter::NEAREST
+    ) const;
+
+    //  Same as above, but write into "output". If "output" is already the
+    //  right size, its buffer is reused.
+    void scale_to(
+        ImageRGB32& output, size_t width, size_t height,
+        Kernels::ImageScaleFilter filter = Kernels::ImageScaleFilter::NEAREST
+    ) const;
 
 public:
     //  QImage
@@ -4,9 +4,12 @@
  *
  */
 
+#include <memory>
+#include <sstream>
 #include <QCoreApplication>
 #include <QMenuBar>
 #include <QDir>
+#include "Common/Cpp/PanicDump.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Windows/DpiScaler.h"
@@ -22,8 +25,13 @@
 namespace PokemonAutomation{
 
 
+static void flush_global_logger(){
+    static_cast<FileWindowLogger&>(global_logger_raw()).flush();
+}
 Logger& global_logger_raw(){
     static FileWindowLogger logger(USER_FILE_PATH() + (QCoreApplication::applicationName() + ".log").toStdString());
+    static bool panic_hook_set = (set_panic_dump_hook(flush_global_logger), true);
+    (void)panic_hook_set;
     return logger;
 }
 
@@ -46,11 +54,25 @@ FileWindowLogger::~FileWindowLogger(){
         m_cv.notify_all();
     }
     m_thread.join();
+
+    //  Write out anything that was pushed after the logger thread's last pass.
+    process_pending();
+    m_file.flush();
 }
 FileWindowLogger::FileWindowLogger(const std::string& path)
     : m_file(QString::fromStdString(path))
     , m_max_queue_size(LOG_HISTORY_LINES)
+    , m_head(nullptr)
+    , m_queue_size(0)
+    , m_pushed(0)
+    , m_overflows(0)
+    , m_unflushed_bytes(0)
+    , m_last_flush(current_time())
+    , m_reported_overflows(0)
     , m_stopping(false)
+    , m_flush_requested(false)
+    , m_written(0)
+    , m_processed(0)
 {
     bool exists = m_file.exists();
     bool opened = m_file.open(QIODevice::WriteOnly | QIODevice::Append);
@@ -74,27 +96,66 @@ void FileWindowLogger::operator-=(FileWindowLoggerWindow& widget){
     m_windows.erase(&widget);
 }
 
+void FileWindowLogger::wait_for_space(){
+    //  Slow path: The queue is full. Record who got stalled and wait.
+    std::unique_lock<std::mutex> lg(m_lock);
+    if (m_queue_size.load(std::memory_order_acquire) < m_max_queue_size){
+        return;
+    }
+    m_overflows_per_thread[std::this_thread::get_id()]++;
+    m_overflows.fetch_add(1, std::memory_order_relaxed);
+    m_cv.wait(lg, [this]{
+        return m_stopping || m_queue_size.load(std::memory_order_acquire) < m_max_queue_size;
+    });
+}
+void FileWindowLogger::push(Node* node){
+    if (m_queue_size.load(std::memory_order_relaxed) >= m_max_queue_size){
+        wait_for_space();
+    }
+    m_queue_size.fetch_add(1, std::memory_order_relaxed);
+
+    //  Error reports read this right after logging the failure. So it has to
+    //  be up to date when log() returns.
+    {
+        std::lock_guard<std::mutex> lg(m_last_log_lock);
+        m_last_log_tracker += node->msg;
+    }
+
+    Node* head = m_head.load(std::memory_order_relaxed);
+    do{
+        node->next = head;
+    }while (!m_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+    m_pushed.fetch_add(1, std::memory_order_release);
+
+    //  Queue was empty. The logger thread may be sleeping.
+    if (head == nullptr){
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_cv.notify_all();
+    }
+}
 void FileWindowLogger::log(const std::string& msg, Color color){
 //    auto scope_check = m_sanitizer.check_scope();
-    std::unique_lock<std::mutex> lg(m_lock);
-    m_last_log_tracker += msg;
-    m_cv.wait(lg, [this]{ return m_queue.size() < m_max_queue_size; });
-    m_queue.emplace_back(msg, color);
-    m_cv.notify_all();
+    push(new Node{nullptr, msg, color});
 }
 void FileWindowLogger::log(std::string&& msg, Color color){
 //    auto scope_check = m_sanitizer.check_scope();
-    std::unique_lock<std::mutex> lg(m_lock);
-    m_last_log_tracker += msg;
-    m_cv.wait(lg, [this]{ return m_queue.size() < m_max_queue_size; });
-    m_queue.emplace_back(std::move(msg), color);
-    m_cv.notify_all();
+    push(new Node{nullptr, std::move(msg), color});
 }
 std::vector<std::string> FileWindowLogger::get_last() const{
 //    auto scope_check = m_sanitizer.check_scope();
-    std::unique_lock<std::mutex> lg(m_lock);
+    std::lock_guard<std::mutex> lg(m_last_log_lock);
     return m_last_log_tracker.snapshot();
 }
+void FileWindowLogger::flush(std::chrono::milliseconds timeout) const{
+    uint64_t target = m_pushed.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lg(m_lock);
+    m_flush_requested = true;
+    m_cv.notify_all();
+    m_cv.wait_for(lg, timeout, [&]{
+        return m_stopping || m_written >= target;
+    });
+}
 
 
 std::string FileWindowLogger::normalize_newlines(const std::string& msg){
@@ -164,43 +225,120 @@ QString FileWindowLogger::to_window_str(const std::string& msg, Color color){
 
     return QString::fromStdString(str);
 }
-void FileWindowLogger::internal_log(const std::string& msg, Color color){
+size_t FileWindowLogger::process_pending(){
 //    auto scope_check = m_sanitizer.check_scope();
-    std::string line = normalize_newlines(msg);
-    {
+
+    //  Take everything at once and reverse it back into arrival order.
+    Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+    Node* list = nullptr;
+    while (node != nullptr){
+        Node* next = node->next;
+        node->next = list;
+        list = node;
+        node = next;
+    }
+
+    std::vector<QString> window_lines;
+    size_t count = 0;
+    bool has_error = false;
+    while (list != nullptr){
+        std::unique_ptr<Node> current(list);
+        list = current->next;
+
+        std::string line = normalize_newlines(current->msg);
         if (!m_windows.empty()){
-            QString str = to_window_str(line, color);
-            for (FileWindowLoggerWindow* window : m_windows){
+            window_lines.emplace_back(to_window_str(line, current->color));
+        }
+        m_file_buffer += to_file_str(current->msg);
+        has_error |= current->color == COLOR_RED;
+        count++;
+    }
+
+    if (!window_lines.empty()){
+        for (FileWindowLoggerWindow* window : m_windows){
+            for (const QString& str : window_lines){
                 window->log(str);
             }
         }
     }
-    {
-        m_file.write(to_file_str(msg).c_str());
+
+    if (!m_file_buffer.empty()){
+        m_file.write(m_file_buffer.c_str(), m_file_buffer.size());
+        m_unflushed_bytes += m_file_buffer.size();
+        m_file_buffer.clear();
+    }
+
+    //  Errors get flushed right away in case we're about to crash.
+    WallClock now = current_time();
+    if (m_unflushed_bytes != 0 && (
+        has_error ||
+        m_unflushed_bytes >= FLUSH_BYTES ||
+        now - m_last_flush >= FLUSH_INTERVAL
+    )){
         m_file.flush();
+        m_unflushed_bytes = 0;
+        m_last_flush = now;
+    }
+
+    m_queue_size.fetch_sub(count, std::memory_order_release);
+    return count;
+}
+std::string FileWindowLogger::overflow_report(){
+    //  Must be called under the lock.
+    uint64_t overflows = m_overflows.load(std::memory_order_relaxed);
+    if (overflows == m_reported_overflows){
+        return "";
+    }
+    m_reported_overflows = overflows;
+
+    std::ostringstream ss;
+    ss << "FileWindowLogger: Log queue was full. Stalled log calls per thread:";
+    for (const auto& item : m_overflows_per_thread){
+        ss << " [" << item.first << "] = " << item.second;
     }
+    return ss.str();
 }
 void FileWindowLogger::thread_loop(){
 //    auto scope_check = m_sanitizer.check_scope();
     std::unique_lock<std::mutex> lg(m_lock);
     while (true){
-        m_cv.wait(lg, [&]{
-            return m_stopping || !m_queue.empty();
+        m_cv.wait_for(lg, FLUSH_INTERVAL, [&]{
+            return m_stopping ||
+                m_flush_requested ||
+                m_head.load(std::memory_order_acquire) != nullptr;
         });
-        if (m_stopping){
-            break;
-        }
-        auto& item = m_queue.front();
-        std::string msg = std::move(item.first);
-        Color color = item.second;
-        m_queue.pop_front();
+        bool stopping = m_stopping;
+        bool flush_requested = m_flush_requested;
+        m_flush_requested = false;
+        std::string overflow = overflow_report();
 
         lg.unlock();
-        internal_log(msg, color);
+        if (!overflow.empty()){
+            //  Don't go through the queue here. It may be full.
+            {
+                std::lock_guard<std::mutex> lg1(m_last_log_lock);
+                m_last_log_tracker += overflow;
+            }
+            m_file_buffer += to_file_str(overflow);
+        }
+        size_t processed = process_pending();
+        if ((flush_requested || stopping) && m_unflushed_bytes != 0){
+            m_file.flush();
+            m_unflushed_bytes = 0;
+            m_last_flush = current_time();
+        }
         lg.lock();
 
-        if (m_queue.size() <= m_max_queue_size / 2){
-            m_cv.notify_all();
+        m_processed += processed;
+        if (m_unflushed_bytes == 0){
+            m_written = m_processed;
+        }
+
+        //  Wake up anyone waiting on space or a flush.
+        m_cv.notify_all();
+
+        if (stopping){
+            break;
         }
     }
 }
@@ -9,11 +9,15 @@
 
 #include <deque>
 #include <set>
+#include <map>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <thread>
 #include <QFile>
 #include <QTextEdit>
 #include <QMainWindow>
+#include "Common/Cpp/Time.h"
 #include "Common/Cpp/AbstractLogger.h"
 #include "Common/Cpp/Options/ConfigOption.h"
 //#include "Common/Cpp/LifetimeSanitizer.h"
@@ -38,7 +42,22 @@ private:
 };
 
 
+//
+//  Producers push onto a lock-free stack. The logger thread periodically takes
+//  the entire stack, restores the order and writes everything out in one
+//  batch. The file is flushed on a timer, when enough data has accumulated, or
+//  immediately when an error (red) line is seen.
+//
+//  Producers only touch the main lock when the queue goes from empty to
+//  non-empty (to wake up the logger thread) or when the queue is full. The
+//  latter is counted per thread and reported in the log. Each line is also
+//  added to the last-log tracker under its own lock so that get_last() is
+//  always current.
+//
 class FileWindowLogger : public Logger{
+    static constexpr size_t FLUSH_BYTES = 64 * 1024;
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL = std::chrono::milliseconds(500);
+
 public:
     ~FileWindowLogger();
     FileWindowLogger(const std::string& path);
@@ -48,25 +67,59 @@ public:
 
     virtual void log(const std::string& msg, Color color = Color()) override;
     virtual void log(std::string&& msg, Color color = Color()) override;
+    //  Includes everything logged so far, even lines that are still in the
+    //  queue. Does not wait on the logger thread.
     virtual std::vector<std::string> get_last() const override;
 
+    //  Block until everything logged so far has been written and flushed to
+    //  disk or until the timeout is reached.
+    void flush(std::chrono::milliseconds timeout = std::chrono::milliseconds(2000)) const;
+
 private:
+    struct Node{
+        Node* next;
+        std::string msg;
+        Color color;
+    };
+
     static std::string normalize_newlines(const std::string& msg);
     static std::string to_file_str(const std::string& msg);
     static QString to_window_str(const std::string& msg, Color color);
 
-    void internal_log(const std::string& msg, Color color);
+    void push(Node* node);
+    void wait_for_space();
+    size_t process_pending();
+    std::string overflow_report();
     void thread_loop();
 
 private:
     QFile m_file;
     size_t m_max_queue_size;
+
+    //  Lock-free part
+    std::atomic<Node*> m_head;
+    std::atomic<size_t> m_queue_size;
+    std::atomic<uint64_t> m_pushed;
+    std::atomic<uint64_t> m_overflows;
+
+    //  Only touched by the logger thread.
+    std::string m_file_buffer;
+    size_t m_unflushed_bytes;
+    WallClock m_last_flush;
+    uint64_t m_reported_overflows;
+
     mutable std::mutex m_lock;
-    std::condition_variable m_cv;
-    LastLogTracker m_last_log_tracker;
+    mutable std::condition_variable m_cv;
     bool m_stopping;
-    std::deque<std::pair<std::string, Color>> m_queue;
+    mutable bool m_flush_requested;
+    uint64_t m_written;     //  # of lines written and flushed to disk.
+    uint64_t m_processed;   //  # of lines taken off the queue.
+    std::map<std::thread::id, uint64_t> m_overflows_per_thread;
     std::set<FileWindowLoggerWindow*> m_windows;
+
+    mutable std::mutex m_last_log_lock;
+    LastLogTracker m_last_log_tracker;
+
     Thread m_thread;
 
 //    LifetimeSanitizer m_sanitizer;
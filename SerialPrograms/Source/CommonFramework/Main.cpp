@@ -28,6 +28,7 @@
 #include "Startup/NewVersionCheck.h"
 #include "CommonFramework/VideoPipeline/Backends/CameraImplementations.h"
 #include "CommonTools/OCR/OCR_RawOCR.h"
+#include "NintendoSwitch/Framework/NintendoSwitch_HeadlessProgramRunner.h"
 #include "Windows/MainWindow.h"
 
 #include <iostream>
@@ -50,9 +51,22 @@ void set_working_directory(){
 }
 
 
+//  "--headless <program-identifier>" runs that program without the main window.
+std::string get_headless_program(const QStringList& arguments){
+    for (qsizetype c = 1; c + 1 < arguments.size(); c++){
+        if (arguments[c] == "--headless"){
+            return arguments[c + 1].toStdString();
+        }
+    }
+    return "";
+}
+
+
 int run_program(int argc, char *argv[]){
     QApplication application(argc, argv);
 
+    std::string headless_program = get_headless_program(application.arguments());
+
     OutputRedirector redirect_stdout(std::cout, "stdout", Color());
     OutputRedirector redirect_stderr(std::cerr, "stderr", COLOR_RED);
 
@@ -111,11 +125,13 @@ int run_program(int argc, char *argv[]){
     }
 
     //  Check whether the hardware is powerful enough to run this program.
-    if (!check_hardware()){
+    if (headless_program.empty() && !check_hardware()){
         return 1;
     }
 
-    check_new_version(logger);
+    if (headless_program.empty()){
+        check_new_version(logger);
+    }
 
     set_working_directory();
 
@@ -139,6 +155,13 @@ int run_program(int argc, char *argv[]){
 #endif
 
 
+    if (!headless_program.empty()){
+        int ret = NintendoSwitch::run_headless_program(logger, headless_program);
+        GlobalMediaServices::instance().stop();
+        return ret;
+    }
+
+
     MainWindow w;
     w.show();
     w.raise(); // bring the window to front on macOS
@@ -0,0 +1,324 @@
+/*  Notification Pipeline
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "Integrations/DiscordSettingsOption.h"
+#include "Integrations/DiscordWebhook.h"
+#include "Integrations/DppIntegration/DppClient.h"
+#include "NotificationPipeline.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+JsonArray NotificationMessage::embeds() const{
+    JsonArray ret;
+    for (const Item& item : items){
+        ret.push_back(item.embed.clone());
+    }
+    if (dropped > 0){
+        ret.push_back(dropped_note(dropped));
+    }
+    return ret;
+}
+size_t NotificationMessage::embed_text_size(const JsonObject& embed){
+    size_t size = 0;
+    auto add = [&](const JsonObject& object, const char* key){
+        const std::string* text = object.get_string(key);
+        if (text != nullptr){
+            size += text->size();
+        }
+    };
+    add(embed, "title");
+    add(embed, "description");
+    const JsonArray* fields = embed.get_array("fields");
+    if (fields != nullptr){
+        for (const JsonValue& item : *fields){
+            const JsonObject* field = item.to_object();
+            if (field != nullptr){
+                add(*field, "name");
+                add(*field, "value");
+            }
+        }
+    }
+    const JsonObject* footer = embed.get_object("footer");
+    if (footer != nullptr){
+        add(*footer, "text");
+    }
+    const JsonObject* author = embed.get_object("author");
+    if (author != nullptr){
+        add(*author, "name");
+    }
+    return size;
+}
+JsonObject NotificationMessage::dropped_note(size_t dropped){
+    JsonObject embed;
+    embed["title"] = "Notifications Dropped";
+    embed["color"] = (int)((uint32_t)COLOR_RED & 0xffffff);
+    embed["description"] = tostr_u_commas(dropped) + " notification(s) were dropped because too many were queued.";
+    return embed;
+}
+std::vector<std::shared_ptr<PendingFileSend>> NotificationMessage::files() const{
+    std::vector<std::shared_ptr<PendingFileSend>> ret;
+    for (const Item& item : items){
+        if (item.file){
+            ret.emplace_back(item.file);
+        }
+    }
+    return ret;
+}
+
+
+
+NotificationPipeline::~NotificationPipeline(){
+    if (!flush(SHUTDOWN_FLUSH_TIMEOUT)){
+        m_logger.log(
+            "Timed out sending notifications on shutdown. Dropping " + tostr_u_commas(queued()) + " of them.",
+            COLOR_RED
+        );
+    }
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+        m_cv.notify_all();
+    }
+    m_runner.reset();
+}
+NotificationPipeline::NotificationPipeline(Sink sink, LimitsProvider limits)
+    : m_logger(global_logger_raw(), "NotificationPipeline")
+    , m_sink(std::move(sink))
+    , m_limits_provider(std::move(limits))
+    , m_dispatcher(nullptr, 1)
+{
+    m_runner = m_dispatcher.dispatch([this]{ thread_loop(); });
+}
+
+NotificationPipeline& NotificationPipeline::instance(){
+    //  The pipeline flushes into the webhook sender when it is destroyed, so
+    //  the sender must be constructed first to outlive it.
+    Integration::DiscordWebhook::DiscordWebhookSender::instance();
+
+    static NotificationPipeline pipeline(
+        [](NotificationMessage& message){
+            Logger& logger = global_logger_tagged();
+            Integration::DiscordWebhook::send_embed(
+                logger, message.should_ping, message.tags,
+                message.embeds(),
+                message.files()
+            );
+
+#ifdef PA_DPP
+            //  The bot sends one embed at a time.
+            for (const NotificationMessage::Item& item : message.items){
+                Integration::DppClient::Client::instance().send_embed_dpp(
+                    message.should_ping, item.color, message.tags, item.embed,
+                    item.file
+                );
+            }
+#endif
+        },
+        []{
+            const Integration::DiscordWebhookSettingsOption& settings = GlobalSettings::instance().DISCORD->webhooks;
+            NotificationPipelineLimits limits;
+            limits.coalesce_window = std::chrono::milliseconds(settings.coalesce_window);
+            limits.max_queued = settings.max_queued;
+            limits.max_attachment_width = settings.max_attachment_width;
+            return limits;
+        }
+    );
+    return pipeline;
+}
+
+
+bool NotificationPipeline::send(
+    Logger& logger,
+    Color color, bool should_ping, std::vector<std::string> tags,
+    JsonObject embed,
+    const ImageAttachment& image,
+    std::shared_ptr<PendingFileSend> file
+){
+    NotificationPipelineLimits limits = m_limits_provider();
+
+    Event event;
+    event.color = color;
+    event.embed = std::move(embed);
+    event.file = std::move(file);
+    if (image.mode != ImageAttachmentMode::NO_SCREENSHOT){
+        if (image.image){
+            //  The view may not outlive this call. Copy it now and leave the
+            //  rest to the worker.
+            event.image = image.image.copy();
+            event.mode = image.mode;
+            event.keep_file = image.keep_file;
+        }else{
+            logger.log("Screenshot is null.", COLOR_ORANGE);
+        }
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_limits = limits;
+    if (m_stopping){
+        return false;
+    }
+    if (m_queued >= limits.max_queued){
+        m_dropped++;
+        logger.log(
+            "Notification queue is full. Dropping notification. (dropped = " + tostr_u_commas(m_dropped) + ")",
+            COLOR_RED
+        );
+        return false;
+    }
+    m_channels[ChannelKey(should_ping, std::move(tags))].events.emplace_back(std::move(event));
+    m_queued++;
+    logger.log("Queued notification. (queue = " + tostr_u_commas(m_queued) + ")", COLOR_PURPLE);
+    m_cv.notify_all();
+    return true;
+}
+void NotificationPipeline::flush(){
+    std::unique_lock<std::mutex> lg(m_lock);
+    m_flushing++;
+    m_cv.notify_all();
+    m_cv.wait(lg, [this]{ return m_stopping || (m_queued == 0 && !m_busy); });
+    m_flushing--;
+}
+bool NotificationPipeline::flush(std::chrono::milliseconds timeout){
+    std::unique_lock<std::mutex> lg(m_lock);
+    m_flushing++;
+    m_cv.notify_all();
+    bool done = m_cv.wait_for(lg, timeout, [this]{ return m_stopping || (m_queued == 0 && !m_busy); });
+    m_flushing--;
+    return done;
+}
+size_t NotificationPipeline::queued() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_queued;
+}
+
+
+void NotificationPipeline::encode_attachment(Event& event, size_t max_width){
+    if (!event.image){
+        return;
+    }
+
+    ImageViewRGB32 image = event.image;
+    ImageRGB32 scaled;
+    if (!event.keep_file && max_width != 0 && image.width() > max_width){
+        size_t height = std::max<size_t>(image.height() * max_width / image.width(), 1);
+        scaled = image.scale_to(max_width, height, Kernels::ImageScaleFilter::AREA);
+        image = scaled;
+    }
+
+    event.file = std::make_shared<PendingFileSend>(
+        m_logger, ImageAttachment(image, event.mode, event.keep_file)
+    );
+    event.image = ImageRGB32();
+
+    if (event.file->filepath().empty()){
+        event.file.reset();
+        return;
+    }
+    JsonObject field;
+    field["url"] = "attachment://" + event.file->filename();
+    event.embed["image"] = std::move(field);
+}
+
+void NotificationPipeline::thread_loop(){
+    std::unique_lock<std::mutex> lg(m_lock);
+    while (!m_stopping){
+        //  Find a channel that is ready to send. Forget channels that are
+        //  empty and past their window.
+        WallClock now = current_time();
+        WallClock next = WallClock::max();
+        auto due = m_channels.end();
+        for (auto iter = m_channels.begin(); iter != m_channels.end();){
+            Channel& channel = iter->second;
+            WallClock ready = channel.last_sent + m_limits.coalesce_window;
+            if (channel.events.empty()){
+                if (ready <= now){
+                    iter = m_channels.erase(iter);
+                }else{
+                    ++iter;
+                }
+                continue;
+            }
+            if (m_flushing > 0 || ready <= now){
+                due = iter;
+                break;
+            }
+            next = std::min(next, ready);
+            ++iter;
+        }
+
+        if (due == m_channels.end()){
+            if (next == WallClock::max()){
+                m_cv.wait(lg);
+            }else{
+                m_cv.wait_until(lg, next);
+            }
+            continue;
+        }
+
+        NotificationMessage message;
+        message.should_ping = due->first.first;
+        message.tags = due->first.second;
+
+        message.dropped = m_dropped;
+        m_dropped = 0;
+
+        //  Stop at the embed limit or the text limit, whichever comes first.
+        //  The first one always goes even if it's too big by itself.
+        size_t text_size = message.dropped > 0
+            ? NotificationMessage::embed_text_size(NotificationMessage::dropped_note(message.dropped))
+            : 0;
+        std::vector<Event> events;
+        Channel& channel = due->second;
+        while (!channel.events.empty() && events.size() < MAX_ITEMS_PER_MESSAGE){
+            size_t size = NotificationMessage::embed_text_size(channel.events.front().embed);
+            if (!events.empty() && text_size + size > MAX_EMBED_TEXT_PER_MESSAGE){
+                break;
+            }
+            text_size += size;
+            events.emplace_back(std::move(channel.events.front()));
+            channel.events.pop_front();
+        }
+        channel.last_sent = now;
+        m_queued -= events.size();
+
+        size_t max_width = m_limits.max_attachment_width;
+        m_busy = true;
+        lg.unlock();
+
+        try{
+            for (Event& event : events){
+                encode_attachment(event, max_width);
+                message.items.emplace_back(NotificationMessage::Item{
+                    event.color, std::move(event.embed), std::move(event.file)
+                });
+            }
+            m_sink(message);
+        }catch (Exception& e){
+            m_logger.log("Unable to send notification: " + e.message(), COLOR_RED);
+        }catch (std::exception& e){
+            m_logger.log("Unable to send notification: " + std::string(e.what()), COLOR_RED);
+        }
+
+        lg.lock();
+        m_busy = false;
+        m_cv.notify_all();
+    }
+}
+
+
+
+}
@@ -0,0 +1,177 @@
+/*  Notification Pipeline
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Notifications are queued here and sent from a worker thread so that the
+ *  program thread never waits on encoding screenshots or on the network.
+ *
+ *  Notifications with the same ping and tags go to the same channels. If one
+ *  of these was sent less than the coalesce window ago, the next ones are held
+ *  until the window is over and then sent together as one message.
+ *
+ *  The queue is bounded. Once it is full, new notifications are dropped and
+ *  the next message says how many were lost.
+ *
+ *  On shutdown, whatever is still queued is flushed (with a time limit) since
+ *  the last notifications are usually the important ones: errors and
+ *  end-of-program reports.
+ *
+ */
+
+#ifndef PokemonAutomation_NotificationPipeline_H
+#define PokemonAutomation_NotificationPipeline_H
+
+#include <stdint.h>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include "Common/Cpp/Color.h"
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "MessageAttachment.h"
+
+namespace PokemonAutomation{
+
+
+struct NotificationPipelineLimits{
+    //  Hold notifications that come within this long of the previous message
+    //  to the same channels, and send them together.
+    std::chrono::milliseconds coalesce_window = std::chrono::milliseconds(3000);
+
+    //  Drop new notifications once this many are waiting.
+    size_t max_queued = 50;
+
+    //  Downscale screenshots wider than this before encoding them. Zero to
+    //  disable. Screenshots that are kept are never downscaled.
+    size_t max_attachment_width = 1280;
+};
+
+
+//  One message as it is handed to the sink.
+struct NotificationMessage{
+    struct Item{
+        Color color;
+        JsonObject embed;
+        std::shared_ptr<PendingFileSend> file;
+    };
+
+    bool should_ping = false;
+    std::vector<std::string> tags;
+    std::vector<Item> items;
+
+    //  Notifications that were dropped since the previous message.
+    size_t dropped = 0;
+
+    //  All the embeds of this message, including a note about the dropped
+    //  notifications if there are any.
+    JsonArray embeds() const;
+
+    //  Number of characters in "embed" that count toward Discord's limit on
+    //  the total text of a message. (title, description, field names and
+    //  values, footer, author) Bytes are counted, which is never less.
+    static size_t embed_text_size(const JsonObject& embed);
+    static JsonObject dropped_note(size_t dropped);
+    std::vector<std::shared_ptr<PendingFileSend>> files() const;
+};
+
+
+class NotificationPipeline{
+public:
+    //  Discord allows up to 10 embeds in one message. One is kept free for the
+    //  dropped notifications note.
+    static constexpr size_t MAX_ITEMS_PER_MESSAGE = 9;
+
+    //  Discord rejects a message if the text of all its embeds adds up to more
+    //  than this. (see NotificationMessage::embed_text_size())
+    static constexpr size_t MAX_EMBED_TEXT_PER_MESSAGE = 6000;
+
+    //  How long the destructor waits for queued notifications to go out.
+    static constexpr std::chrono::milliseconds SHUTDOWN_FLUSH_TIMEOUT = std::chrono::seconds(5);
+
+    using Sink = std::function<void(NotificationMessage& message)>;
+    using LimitsProvider = std::function<NotificationPipelineLimits()>;
+
+public:
+    //  Flushes what is still queued, but gives up after
+    //  SHUTDOWN_FLUSH_TIMEOUT and drops the rest.
+    ~NotificationPipeline();
+    NotificationPipeline(Sink sink, LimitsProvider limits);
+
+    //  Sends to the Discord webhooks and the Discord bot.
+    static NotificationPipeline& instance();
+
+    //  Queue a notification. This does not block.
+    //  "image" is copied, downscaled and encoded on the worker thread.
+    //  "file" is an attachment that is already on disk.
+    //  Returns false if the notification was dropped.
+    bool send(
+        Logger& logger,
+        Color color, bool should_ping, std::vector<std::string> tags,
+        JsonObject embed,
+        const ImageAttachment& image,
+        std::shared_ptr<PendingFileSend> file = nullptr
+    );
+
+    //  Send everything that is queued now without waiting for the coalesce
+    //  windows. Returns once it has all been handed to the sink.
+    void flush();
+
+    //  Same as above, but give up after "timeout".
+    //  Returns false if it timed out.
+    bool flush(std::chrono::milliseconds timeout);
+
+    size_t queued() const;
+
+
+private:
+    struct Event{
+        Color color;
+        JsonObject embed;
+        ImageRGB32 image;
+        ImageAttachmentMode mode = ImageAttachmentMode::NO_SCREENSHOT;
+        bool keep_file = false;
+        std::shared_ptr<PendingFileSend> file;
+    };
+    using ChannelKey = std::pair<bool, std::vector<std::string>>;
+    struct Channel{
+        std::deque<Event> events;
+        WallClock last_sent = WallClock::min();
+    };
+
+    void thread_loop();
+    void encode_attachment(Event& event, size_t max_width);
+
+
+private:
+    TaggedLogger m_logger;
+    Sink m_sink;
+    LimitsProvider m_limits_provider;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_cv;
+    bool m_stopping = false;
+    size_t m_flushing = 0;
+    bool m_busy = false;
+
+    NotificationPipelineLimits m_limits;
+    std::map<ChannelKey, Channel> m_channels;
+    size_t m_queued = 0;
+    size_t m_dropped = 0;
+
+    AsyncDispatcher m_dispatcher;
+    std::unique_ptr<AsyncTask> m_runner;
+};
+
+
+
+}
+#endif
@@ -14,8 +14,7 @@
 #include "CommonFramework/Tools/ProgramEnvironment.h"
 #include "CommonFramework/ProgramStats/StatsTracking.h"
 #include "Integrations/DiscordSettingsOption.h"
-#include "Integrations/DiscordWebhook.h"
-#include "Integrations/DppIntegration/DppClient.h"
+#include "NotificationPipeline.h"
 #include "ProgramNotifications.h"
 
 //#include <iostream>
@@ -88,15 +87,7 @@ void send_raw_notification(
     const std::vector<std::pair<std::string, std::string>>& messages,
     const ImageAttachment& image
 ){
-    bool hasImageFile = false;
-    std::shared_ptr<PendingFileSend> file;
-    if (image.image.width() > 0 && image.image.height() > 0){ // if image not empty
-        file = std::make_shared<PendingFileSend>(logger, image);
-        hasImageFile = !file->filepath().empty();
-    };
-
     JsonObject embed;
-    JsonArray embeds;
     {
         embed["title"] = title;
 
@@ -109,27 +100,14 @@ void send_raw_notification(
         append_body_fields(fields, messages);
         fields.push_back(make_credits_field(info));
         embed["fields"] = std::move(fields);
-
-        if (hasImageFile){
-            JsonObject field;
-            field["url"] = "attachment://" + file->filename();
-            embed["image"] = std::move(field);
-        }
-        embeds.push_back(embed.clone());
     }
 
-    Integration::DiscordWebhook::send_embed(
-        logger, should_ping, tags,
-        std::move(embeds),
-        hasImageFile ? file : nullptr
+    //  The screenshot is encoded and attached by the pipeline.
+    NotificationPipeline::instance().send(
+        logger, color, should_ping, tags,
+        std::move(embed),
+        image
     );
-
-#ifdef PA_DPP
-    Integration::DppClient::Client::instance().send_embed_dpp(
-        should_ping, color, tags, std::move(embed),
-        hasImageFile ? file : nullptr
-    );
-#endif
 }
 void send_raw_notification(
     Logger& logger,
@@ -143,7 +121,6 @@ void send_raw_notification(
     bool hasFile = !file->filepath().empty();
 
     JsonObject embed;
-    JsonArray embeds;
     {
         embed["title"] = title;
 
@@ -156,22 +133,14 @@ void send_raw_notification(
         append_body_fields(fields, messages);
         fields.push_back(make_credits_field(info));
         embed["fields"] = std::move(fields);
-
-        embeds.push_back(embed.clone());
     }
 
-    Integration::DiscordWebhook::send_embed(
-        logger, should_ping, tags,
-        std::move(embeds),
+    NotificationPipeline::instance().send(
+        logger, color, should_ping, tags,
+        std::move(embed),
+        ImageAttachment(),
         hasFile ? file : nullptr
     );
-
-#ifdef PA_DPP
-    Integration::DppClient::Client::instance().send_embed_dpp(
-        should_ping, color, tags, std::move(embed),
-        hasFile ? file : nullptr
-    );
-#endif
 }
 
 
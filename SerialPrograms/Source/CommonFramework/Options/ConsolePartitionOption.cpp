@@ -0,0 +1,75 @@
+/*  Console Partition Option
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <stdlib.h>
+#include "ConsolePartitionOption.h"
+
+namespace PokemonAutomation{
+
+
+ConsolePartitionOption::ConsolePartitionOption()
+    : GroupOption(
+        "Console Partitioning",
+        LockMode::LOCK_WHILE_RUNNING,
+        EnableMode::ALWAYS_ENABLED,
+        true
+    )
+    , m_description(
+        "How the thread pools above are shared between the consoles of a "
+        "multi-switch program. When the pools are busy, each console gets CPU "
+        "time in proportion to its weight so that one console can't starve "
+        "the others.<br>"
+        "Changes take effect when the next program starts."
+    )
+    , PARTITION_CORES(
+        "<b>Partition Cores:</b><br>"
+        "Split the processor cores evenly between the consoles. Pool threads "
+        "only run a console's tasks on that console's cores. (Linux only)",
+        LockMode::LOCK_WHILE_RUNNING,
+        false
+    )
+    , WEIGHTS(
+        false,
+        "<b>Console Weights:</b><br>"
+        "Comma-separated share of the thread pools for each console, starting "
+        "with Switch 0. Consoles without a weight get 1.",
+        LockMode::LOCK_WHILE_RUNNING,
+        "",
+        "2, 1, 1, 1"
+    )
+{
+    PA_ADD_STATIC(m_description);
+    PA_ADD_OPTION(PARTITION_CORES);
+    PA_ADD_OPTION(WEIGHTS);
+}
+
+double ConsolePartitionOption::weight(size_t console_index) const{
+    std::string weights = WEIGHTS;
+    size_t index = 0;
+    size_t start = 0;
+    while (start <= weights.size()){
+        size_t end = weights.find(',', start);
+        if (end == std::string::npos){
+            end = weights.size();
+        }
+        if (index == console_index){
+            std::string token = weights.substr(start, end - start);
+            char* parse_end;
+            double weight = strtod(token.c_str(), &parse_end);
+            if (parse_end == token.c_str() || weight <= 0){
+                return 1.0;
+            }
+            return weight;
+        }
+        index++;
+        start = end + 1;
+    }
+    return 1.0;
+}
+
+
+
+}
@@ -0,0 +1,36 @@
+/*  Console Partition Option
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Options_ConsolePartitionOption_H
+#define PokemonAutomation_Options_ConsolePartitionOption_H
+
+#include "Common/Cpp/Options/StaticTextOption.h"
+#include "Common/Cpp/Options/BooleanCheckBoxOption.h"
+#include "Common/Cpp/Options/StringOption.h"
+#include "Common/Cpp/Options/GroupOption.h"
+
+namespace PokemonAutomation{
+
+
+//  How the thread pools are shared between the consoles of a multi-switch
+//  program.
+class ConsolePartitionOption : public GroupOption{
+public:
+    ConsolePartitionOption();
+
+    //  The share of the thread pools for this console. Defaults to 1.
+    double weight(size_t console_index) const;
+
+public:
+    StaticTextOption m_description;
+    BooleanCheckBoxOption PARTITION_CORES;
+    StringOption WEIGHTS;
+};
+
+
+
+}
+#endif
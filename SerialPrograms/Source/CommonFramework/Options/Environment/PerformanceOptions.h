@@ -10,6 +10,7 @@
 #include "Common/Cpp/Options/GroupOption.h"
 #include "Common/Cpp/Options/TimeDurationOption.h"
 #include "CommonFramework/Options/ThreadPoolOption.h"
+#include "CommonFramework/Options/ConsolePartitionOption.h"
 #include "ProcessPriorityOption.h"
 #include "ProcessorLevelOption.h"
 
@@ -76,6 +77,7 @@ public:
 
         PA_ADD_OPTION(REALTIME_THREAD_POOL);
         PA_ADD_OPTION(NORMAL_THREAD_POOL);
+        PA_ADD_OPTION(CONSOLE_PARTITIONING);
 
         PA_ADD_OPTION(PRECISE_WAKE_MARGIN);
     }
@@ -89,6 +91,7 @@ public:
 
     ThreadPoolOption REALTIME_THREAD_POOL;
     ThreadPoolOption NORMAL_THREAD_POOL;
+    ConsolePartitionOption CONSOLE_PARTITIONING;
 
     MicrosecondsOption PRECISE_WAKE_MARGIN;
 };
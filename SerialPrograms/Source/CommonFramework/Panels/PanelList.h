@@ -29,7 +29,7 @@ public:
 
     PanelListWidget* make_QWidget(QWidget& parent, PanelHolder& holder) const;
 
-protected:
+    //  Also used to look up programs by identifier when there is no UI.
     virtual std::vector<PanelEntry> make_panels() const = 0;
 
 protected:
@@ -7,6 +7,8 @@
 #ifndef PokemonAutomation_CommonFramework_ProgramDescriptor_H
 #define PokemonAutomation_CommonFramework_ProgramDescriptor_H
 
+#include <vector>
+#include "CommonFramework/Tools/ResourceWarmup.h"
 #include "PanelDescriptor.h"
 
 namespace PokemonAutomation{
@@ -32,6 +34,10 @@ public:
     using PanelDescriptor::PanelDescriptor;
 
     virtual std::unique_ptr<StatsTracker> make_stats() const;
+
+    //  Lazily built matchers and databases that the program will use.
+    //  They are built in the background when the program is selected.
+    virtual std::vector<WarmupResource> warmup_resources() const;
 };
 
 
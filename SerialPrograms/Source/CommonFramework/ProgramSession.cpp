@@ -10,6 +10,7 @@
 #include "CommonFramework/Panels/ProgramDescriptor.h"
 #include "CommonFramework/ProgramSession.h"
 #include "CommonFramework/ProgramStats/StatsDatabase.h"
+#include "CommonFramework/Tools/ResourceWarmup.h"
 #include "Integrations/ProgramTracker.h"
 
 namespace PokemonAutomation{
@@ -33,9 +34,13 @@ ProgramSession::ProgramSession(const ProgramDescriptor& descriptor)
     , m_timestamp(current_time())
     , m_state(ProgramState::STOPPED)
 {
-    load_historical_stats();
+    //  This runs on the UI thread. Don't wait for the stats file if someone
+    //  else has it. The stats are loaded again when the program starts.
+    m_historical_stats = load_historical_stats(std::chrono::milliseconds(0));
+    start_resource_warmup();
 }
 ProgramSession::~ProgramSession(){
+    m_warmup_thread.join();
     ProgramTracker::instance().remove_program(m_instance_id);
 //    ProgramSession::request_program_stop();
 //    join_program_thread();
@@ -108,37 +113,53 @@ void ProgramSession::push_error(const std::string& message){
     m_listeners.run_method(&Listener::error, message);
 }
 
-void ProgramSession::load_historical_stats(){
+std::unique_ptr<StatsTracker> ProgramSession::load_historical_stats(std::chrono::milliseconds lock_timeout){
     //  Load historical stats.
     std::unique_ptr<StatsTracker> stats = m_descriptor.make_stats();
     if (stats){
         m_logger.log("Loading historical stats...");
 //        m_current_stats = m_descriptor.make_stats();
-        StatSet set;
-        set.open_from_file(GlobalSettings::instance().STATS_FILE);
-        const std::string& identifier = m_descriptor.identifier();
-        StatList& list = set[identifier];
-        if (list.size() != 0){
-            list.aggregate(*stats);
-        }
-        m_historical_stats = std::move(stats);
-    }
-}
-void ProgramSession::update_historical_stats_with_current(){
-    if (m_current_stats){
-        m_logger.log("Saving historical stats...");
-        bool ok = StatSet::update_file(
+        bool ok = StatSet::aggregate_from_file(
             GlobalSettings::instance().STATS_FILE,
             m_descriptor.identifier(),
-            *m_current_stats
+            *stats,
+            lock_timeout
         );
-        if (ok){
-            m_logger.log("Stats successfully saved!", COLOR_BLUE);
-        }else{
-            m_logger.log("Unable to save stats.", COLOR_RED);
-            push_error("Unable to save stats.");
+        if (!ok){
+            m_logger.log("Unable to load historical stats. The stats file is locked.", COLOR_RED);
+            stats.reset();
         }
     }
+    return stats;
+}
+void ProgramSession::start_resource_warmup(){
+    //  Sessions are built when the program is selected. So this usually
+    //  finishes before the user presses Start. If not, the program waits on
+    //  the resource it needs, which is no worse than building it itself.
+    std::vector<WarmupResource> resources = m_descriptor.warmup_resources();
+    if (resources.empty()){
+        return;
+    }
+    m_warmup_thread = Thread([this, resources = std::move(resources)]{
+        warm_up_resources(m_logger, resources);
+    });
+}
+bool ProgramSession::update_historical_stats_with_current(){
+    if (!m_current_stats){
+        return true;
+    }
+    m_logger.log("Saving historical stats...");
+    bool ok = StatSet::update_file(
+        GlobalSettings::instance().STATS_FILE,
+        m_descriptor.identifier(),
+        *m_current_stats
+    );
+    if (ok){
+        m_logger.log("Stats successfully saved!", COLOR_BLUE);
+    }else{
+        m_logger.log("Unable to save stats.", COLOR_RED);
+    }
+    return ok;
 }
 
 
@@ -225,17 +246,28 @@ std::string ProgramSession::stop_program(){
 
 
 void ProgramSession::run_program(){
+    //  The stats file may be locked by another instance for a while. Wait for
+    //  it here without holding "m_lock" so the UI can still read the stats.
+    std::unique_ptr<StatsTracker> historical_stats = load_historical_stats(StatSet::LOCK_TIMEOUT);
     {
         std::lock_guard<std::mutex> lg(m_lock);
         m_current_stats = m_descriptor.make_stats();
-        load_historical_stats();
+        if (historical_stats){
+            m_historical_stats = std::move(historical_stats);
+        }
         push_stats();
     }
     internal_run_program();
     {
         std::lock_guard<std::mutex> lg(m_lock);
         push_stats();
-        update_historical_stats_with_current();
+    }
+    bool saved = update_historical_stats_with_current();
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        if (!saved){
+            push_error("Unable to save stats.");
+        }
         set_state(ProgramState::STOPPED);
     }
 }
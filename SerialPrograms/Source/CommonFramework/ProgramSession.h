@@ -113,12 +113,17 @@ private:
     void set_state(ProgramState state);
     void push_stats();
     void push_error(const std::string& message);
-    void load_historical_stats();
-    void update_historical_stats_with_current();
+
+private:
+    //  These read and write the stats file and may wait on its lock. Don't
+    //  call them under the lock.
+    std::unique_ptr<StatsTracker> load_historical_stats(std::chrono::milliseconds lock_timeout);
+    bool update_historical_stats_with_current();
 
 
 private:
     void run_program();
+    void start_resource_warmup();
 
 
 private:
@@ -132,6 +137,7 @@ private:
     std::atomic<WallClock> m_timestamp;
     std::atomic<ProgramState> m_state;
     Thread m_thread;
+    Thread m_warmup_thread;
 
 //    std::mutex m_stats_lock;
     std::unique_ptr<StatsTracker> m_historical_stats;
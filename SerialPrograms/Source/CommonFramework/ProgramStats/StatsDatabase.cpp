@@ -4,8 +4,10 @@
  *
  */
 
+#include <string.h>
 #include <QFile>
 #include <QSaveFile>
+#include <QLockFile>
 #include "Common/Cpp/Time.h"
 #include "StatsDatabase.h"
 
@@ -105,6 +107,90 @@ void StatList::aggregate(StatsTracker& tracker) const{
 
 
 
+namespace{
+
+std::string stats_journal_path(const std::string& filepath){
+    return filepath + ".journal";
+}
+std::string stats_journal_compacting_path(const std::string& filepath){
+    return filepath + ".journal.compacting";
+}
+std::string stats_index_path(const std::string& filepath){
+    return filepath + ".index";
+}
+std::string stats_lock_path(const std::string& filepath){
+    return filepath + ".lock";
+}
+std::string read_entire_file(const std::string& filepath){
+    QFile file(QString::fromStdString(filepath));
+    if (!file.open(QIODevice::ReadOnly)){
+        return std::string();
+    }
+    QByteArray data = file.readAll();
+    return std::string(data.data(), data.size());
+}
+const std::string& canonical_stats_identifier(const std::string& identifier){
+    auto iter = STATS_DATABASE_ALIASES.find(identifier);
+    return iter == STATS_DATABASE_ALIASES.end()
+        ? identifier
+        : iter->second;
+}
+
+bool parse_index_number(size_t& value, const std::string& str){
+    if (str.empty()){
+        return false;
+    }
+    value = 0;
+    for (char ch : str){
+        if (ch < '0' || ch > '9'){
+            return false;
+        }
+        value = value * 10 + (ch - '0');
+    }
+    return true;
+}
+
+//  Parse all the lines of a section body and add them to "tracker".
+void aggregate_section(StatsTracker& tracker, const char* ptr, const char* end){
+    while (ptr < end){
+        const char* line_end = ptr;
+        while (line_end < end && *line_end != '\n' && *line_end != '\r'){
+            line_end++;
+        }
+        if (line_end != ptr){
+            StatLine line(std::string(ptr, line_end));
+            tracker.parse_and_append_line(line.stats());
+        }
+        ptr = line_end + 1;
+    }
+}
+
+//  Journal lines are of the form: "<identifier>\t<stat line>"
+//  Only parse the lines that match "identifier".
+void aggregate_journal(StatsTracker& tracker, const std::string& journal, const std::string& identifier){
+    const char* ptr = journal.c_str();
+    const char* end = ptr + journal.size();
+    while (ptr < end){
+        const char* line_end = ptr;
+        while (line_end < end && *line_end != '\n' && *line_end != '\r'){
+            line_end++;
+        }
+        const char* tab = (const char*)memchr(ptr, '\t', line_end - ptr);
+        if (tab != nullptr &&
+            canonical_stats_identifier(std::string(ptr, tab)) == identifier
+        ){
+            StatLine line(std::string(tab + 1, line_end));
+            tracker.parse_and_append_line(line.stats());
+        }
+        ptr = line_end + 1;
+    }
+}
+
+}
+
+
+
+
 #if 0
 StatList* StatSet::find(const std::string& label){
     auto iter = m_data.find(label);
@@ -118,6 +204,9 @@ StatList& StatSet::operator[](const std::string& identifier){
 }
 
 std::string StatSet::to_str() const{
+    return to_str(nullptr);
+}
+std::string StatSet::to_str(std::vector<IndexEntry>* index) const{
     std::string str;
     for (const auto& item : m_data){
         if (item.second.size() == 0){
@@ -127,27 +216,127 @@ std::string StatSet::to_str() const{
         str += item.first;
         str += "\r\n";
         str += "\r\n";
+        size_t offset = str.size();
         str += item.second.to_str();
+        if (index){
+            index->emplace_back(IndexEntry{item.first, offset, str.size() - offset});
+        }
         str += "\r\n";
     }
     return str;
 }
 
-void StatSet::save_to_file(const std::string& filepath){
-    QFile file(QString::fromStdString(filepath));
-    if (file.open(QIODevice::WriteOnly)){
-        std::string data = to_str();
+bool StatSet::write_file_and_index(const std::string& filepath, const StatSet& set){
+    std::vector<IndexEntry> index;
+    std::string data = set.to_str(&index);
+    {
+        QSaveFile file(QString::fromStdString(filepath));
+        if (!file.open(QIODevice::WriteOnly)){
+            return false;
+        }
         file.write(data.c_str(), data.size());
+        if (!file.commit()){
+            return false;
+        }
+    }
+
+    //  Everything in the journal is now in the main file.
+    QFile::remove(QString::fromStdString(stats_journal_compacting_path(filepath)));
+
+    //  The index is only an accelerator. If this fails, the next lookup will
+    //  see that it is stale and fall back to parsing the whole file.
+    std::string str = "size=" + std::to_string(data.size()) + "\r\n";
+    for (const IndexEntry& entry : index){
+        str += std::to_string(entry.offset);
+        str += "\t";
+        str += std::to_string(entry.bytes);
+        str += "\t";
+        str += entry.identifier;
+        str += "\r\n";
     }
+    QSaveFile file(QString::fromStdString(stats_index_path(filepath)));
+    if (file.open(QIODevice::WriteOnly)){
+        file.write(str.c_str(), str.size());
+        file.commit();
+    }
+
+    return true;
 }
-void StatSet::open_from_file(const std::string& filepath){
-    QFile file(QString::fromStdString(filepath));
-    if (!file.open(QIODevice::ReadOnly)){
-        return;
+
+bool StatSet::aggregate_from_file(
+    const std::string& filepath,
+    const std::string& identifier,
+    StatsTracker& tracker,
+    std::chrono::milliseconds lock_timeout
+){
+    QLockFile lock(QString::fromStdString(stats_lock_path(filepath)));
+    if (!lock.tryLock((int)lock_timeout.count())){
+        return false;
     }
 
-    std::string str = file.readAll().data();
-    load_from_string(str.c_str());
+    std::string data = read_entire_file(filepath);
+
+    //  Try to use the index.
+    bool indexed = false;
+    do{
+        std::string index = read_entire_file(stats_index_path(filepath));
+        const char* ptr = index.c_str();
+
+        std::string line;
+        if (!get_line(line, ptr) || line.rfind("size=", 0) != 0){
+            break;
+        }
+        if (std::to_string(data.size()) != line.substr(5)){
+//            cout << "Stats index is stale." << endl;
+            break;
+        }
+
+        std::vector<std::pair<size_t, size_t>> ranges;
+        bool valid = true;
+        while (get_line(line, ptr)){
+            size_t tab0 = line.find('\t');
+            size_t tab1 = tab0 == std::string::npos ? tab0 : line.find('\t', tab0 + 1);
+            if (tab1 == std::string::npos){
+                valid = false;
+                break;
+            }
+            if (line.compare(tab1 + 1, std::string::npos, identifier) != 0){
+                continue;
+            }
+            size_t offset, bytes;
+            if (!parse_index_number(offset, line.substr(0, tab0)) ||
+                !parse_index_number(bytes, line.substr(tab0 + 1, tab1 - tab0 - 1)) ||
+                offset + bytes > data.size()
+            ){
+                valid = false;
+                break;
+            }
+            ranges.emplace_back(offset, bytes);
+        }
+        if (!valid){
+            break;
+        }
+
+        for (const auto& range : ranges){
+            const char* start = data.c_str() + range.first;
+            aggregate_section(tracker, start, start + range.second);
+        }
+        indexed = true;
+    }while (false);
+
+    //  No usable index. Parse the whole file.
+    if (!indexed){
+        StatSet set;
+        set.load_from_string(data.c_str());
+        auto iter = set.m_data.find(identifier);
+        if (iter != set.m_data.end()){
+            iter->second.aggregate(tracker);
+        }
+    }
+
+    aggregate_journal(tracker, read_entire_file(stats_journal_compacting_path(filepath)), identifier);
+    aggregate_journal(tracker, read_entire_file(stats_journal_path(filepath)), identifier);
+    return true;
 }
 
 bool StatSet::update_file(
@@ -155,25 +344,64 @@ bool StatSet::update_file(
     const std::string& identifier,
     StatsTracker& tracker
 ){
-    QFile file(QString::fromStdString(filepath));
-    while (!file.open(QIODevice::ReadWrite)){
+    QLockFile lock(QString::fromStdString(stats_lock_path(filepath)));
+    if (!lock.tryLock((int)LOCK_TIMEOUT.count())){
         return false;
     }
-    std::string data = file.readAll().data();
 
-    StatSet set;
-    set.load_from_string(data.c_str());
-
-    set[identifier] += tracker;
+    qint64 journal_size;
+    {
+        QFile file(QString::fromStdString(stats_journal_path(filepath)));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Append)){
+            return false;
+        }
+        std::string line = identifier;
+        line += "\t";
+        line += StatLine(tracker).to_str();
+        line += "\r\n";
+        if (file.write(line.c_str(), line.size()) != (qint64)line.size()){
+            return false;
+        }
+        journal_size = file.size();
+    }
 
-    data = set.to_str();
-    file.seek(0);
-    file.write(data.c_str(), data.size());
-    file.resize(data.size());
+    //  Fold the journal in if it has gotten big or if there is no index yet.
+    if ((size_t)journal_size >= JOURNAL_COMPACT_THRESHOLD ||
+        !QFile::exists(QString::fromStdString(stats_index_path(filepath)))
+    ){
+        //  The entry is already safely in the journal. So failing to compact
+        //  is not an error.
+        compact_file_locked(filepath);
+    }
 
     return true;
 }
 
+bool StatSet::compact_file(const std::string& filepath){
+    QLockFile lock(QString::fromStdString(stats_lock_path(filepath)));
+    if (!lock.tryLock((int)LOCK_TIMEOUT.count())){
+        return false;
+    }
+    return compact_file_locked(filepath);
+}
+bool StatSet::compact_file_locked(const std::string& filepath){
+    //  Move the journal aside first. If a previous compaction was interrupted,
+    //  finish that one first and leave the current journal for next time.
+    QString journal = QString::fromStdString(stats_journal_path(filepath));
+    QString compacting = QString::fromStdString(stats_journal_compacting_path(filepath));
+    if (!QFile::exists(compacting) && QFile::exists(journal)){
+        if (!QFile::rename(journal, compacting)){
+            return false;
+        }
+    }
+
+    StatSet set;
+    set.load_from_string(read_entire_file(filepath).c_str());
+    set.load_journal(read_entire_file(stats_journal_compacting_path(filepath)).c_str());
+
+    return write_file_and_index(filepath, set);
+}
+
 
 bool StatSet::get_line(std::string& line, const char*& ptr){
     line.clear();
@@ -238,6 +466,19 @@ void StatSet::load_from_string(const char* ptr){
         }
     }
 }
+void StatSet::load_journal(const char* ptr){
+    while (true){
+        std::string line;
+        bool more = get_line(line, ptr);
+        size_t tab = line.find('\t');
+        if (tab != std::string::npos){
+            m_data[canonical_stats_identifier(line.substr(0, tab))] += line.substr(tab + 1);
+        }
+        if (!more){
+            return;
+        }
+    }
+}
 
 
 
@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_StatsDatabase_H
 #define PokemonAutomation_StatsDatabase_H
 
+#include <chrono>
 #include "StatsTracking.h"
 
 namespace PokemonAutomation{
@@ -46,25 +47,67 @@ private:
 
 
 
+//
+//  The stats file is a human-readable text file with one section per program.
+//  Rewriting it on every program stop gets expensive as it grows. So new
+//  entries are appended to a journal next to it ("<file>.journal") and only
+//  folded back into the main file once the journal gets large.
+//
+//  Whenever the main file is rewritten, an index ("<file>.index") of where
+//  each program's section lives is written along with it. This lets us load
+//  the stats of a single program without parsing everything else.
+//
 class StatSet{
+public:
+    //  How long to wait for the lock file when someone else is holding it.
+    //  Don't wait this long on the UI thread.
+    static constexpr std::chrono::milliseconds LOCK_TIMEOUT = std::chrono::seconds(5);
+
 public:
 //    StatList* find(const std::string& label);
     StatList& operator[](const std::string& identifier);
 
     std::string to_str() const;
 
-    void save_to_file(const std::string& filepath);
-    void open_from_file(const std::string& filepath);
+    //  Aggregate all the historical stats for "identifier" into "tracker".
+    //  Returns false and leaves "tracker" untouched if the file is locked by
+    //  someone else for longer than "lock_timeout". Zero only tries once.
+    static bool aggregate_from_file(
+        const std::string& filepath,
+        const std::string& identifier,
+        StatsTracker& tracker,
+        std::chrono::milliseconds lock_timeout = LOCK_TIMEOUT
+    );
 
+    //  Append a new entry. This only appends to the journal. The main file is
+    //  rewritten only when the journal exceeds "JOURNAL_COMPACT_THRESHOLD".
     static bool update_file(
         const std::string& filepath,
         const std::string& identifier,
         StatsTracker& tracker
     );
 
+    //  Fold the journal into the main file and rebuild the index.
+    static bool compact_file(const std::string& filepath);
+
+    static constexpr size_t JOURNAL_COMPACT_THRESHOLD = 64 * 1024;
+
 private:
-    bool get_line(std::string& line, const char*& ptr);
+    struct IndexEntry{
+        std::string identifier;
+        size_t offset;
+        size_t bytes;
+    };
+
+    std::string to_str(std::vector<IndexEntry>* index) const;
+
+    //  The caller must be holding the lock file.
+    static bool write_file_and_index(const std::string& filepath, const StatSet& set);
+    static bool compact_file_locked(const std::string& filepath);
+
+    static bool get_line(std::string& line, const char*& ptr);
     void load_from_string(const char* ptr);
+    void load_journal(const char* ptr);
 
 private:
     std::map<std::string, StatList> m_data;
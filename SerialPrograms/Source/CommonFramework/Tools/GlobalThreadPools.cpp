@@ -4,6 +4,8 @@
  *
  */
 
+#include <thread>
+#include <atomic>
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/Options/Environment/PerformanceOptions.h"
@@ -35,6 +37,46 @@ ComputationThreadPool& normal_inference(){
 
 
 
+ConsolePartition::ConsolePartition(Logger& logger, size_t consoles)
+    : m_consoles(consoles)
+{
+    //  Owners are never reused. Programs in other windows may still be using
+    //  the old ones.
+    static std::atomic<size_t> next_owner(1);
+    m_first_owner = next_owner.fetch_add(consoles);
+
+    const ConsolePartitionOption& option = GlobalSettings::instance().PERFORMANCE->CONSOLE_PARTITIONING;
+
+    size_t cpus_per_console = 0;
+    if (option.PARTITION_CORES && consoles > 1){
+        cpus_per_console = std::thread::hardware_concurrency() / consoles;
+        if (cpus_per_console == 0){
+            logger.log("Not enough cores to partition between " + std::to_string(consoles) + " consoles.", COLOR_ORANGE);
+        }
+    }
+
+    for (size_t c = 0; c < consoles; c++){
+        double weight = option.weight(c);
+        size_t first_cpu = c * cpus_per_console;
+        realtime_inference().configure_owner(owner(c), weight, first_cpu, cpus_per_console);
+        normal_inference().configure_owner(owner(c), weight, first_cpu, cpus_per_console);
+
+        std::string message = "Switch " + std::to_string(c) + ": Thread Pool Weight = " + std::to_string(weight);
+        if (cpus_per_console != 0){
+            message += ", Cores = " + std::to_string(first_cpu) + " - " + std::to_string(first_cpu + cpus_per_console - 1);
+        }
+        logger.log(message);
+    }
+}
+ConsolePartition::~ConsolePartition(){
+    for (size_t c = 0; c < m_consoles; c++){
+        realtime_inference().remove_owner(owner(c));
+        normal_inference().remove_owner(owner(c));
+    }
+}
+
+
+
 
 }
 }
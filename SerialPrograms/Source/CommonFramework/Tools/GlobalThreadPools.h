@@ -10,6 +10,9 @@
 #include "Common/Cpp/Concurrency/ComputationThreadPool.h"
 
 namespace PokemonAutomation{
+
+class Logger;
+
 namespace GlobalThreadPools{
 
 
@@ -18,6 +21,28 @@ ComputationThreadPool& realtime_inference();
 ComputationThreadPool& normal_inference();
 
 
+//  Give each console of a multi-switch program its own owner in both thread
+//  pools, set up from the console partitioning options. Threads working for
+//  a console should run inside "ThreadPoolOwnerScope(owner(index))".
+//
+//  The owners are removed from the pools when this is destroyed.
+class ConsolePartition{
+public:
+    ConsolePartition(Logger& logger, size_t consoles);
+    ~ConsolePartition();
+    ConsolePartition(const ConsolePartition&) = delete;
+    void operator=(const ConsolePartition&) = delete;
+
+    size_t owner(size_t console_index) const{
+        return m_first_owner + console_index;
+    }
+
+private:
+    size_t m_first_owner;
+    size_t m_consoles;
+};
+
+
 
 }
 }
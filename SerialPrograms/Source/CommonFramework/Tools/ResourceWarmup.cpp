@@ -0,0 +1,76 @@
+/*  Resource Warmup
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Time.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
+#include "ResourceWarmup.h"
+
+namespace PokemonAutomation{
+
+
+
+void warm_up_resources(Logger& logger, const std::vector<WarmupResource>& resources){
+    if (resources.empty()){
+        return;
+    }
+
+    struct Result{
+        WallDuration time = WallDuration::zero();
+        std::string error;
+    };
+    std::vector<Result> results(resources.size());
+
+    logger.log("Warming up " + std::to_string(resources.size()) + " resource(s)...");
+    WallClock start = current_time();
+
+    GlobalThreadPools::normal_inference().run_in_parallel(
+        [&](size_t index){
+            WallClock time0 = current_time();
+            try{
+                resources[index].load();
+            }catch (Exception& e){
+                results[index].error = e.to_str();
+            }catch (std::exception& e){
+                results[index].error = e.what();
+            }
+            results[index].time = current_time() - time0;
+        },
+        0, resources.size(), 1
+    );
+
+    WallDuration total = current_time() - start;
+
+    //  Slowest first.
+    std::vector<size_t> order(resources.size());
+    for (size_t c = 0; c < order.size(); c++){
+        order[c] = c;
+    }
+    std::sort(
+        order.begin(), order.end(),
+        [&](size_t a, size_t b){ return results[a].time > results[b].time; }
+    );
+
+    std::string str = "Resource warm-up finished in " +
+        std::to_string(std::chrono::duration_cast<Milliseconds>(total).count()) + " ms:";
+    bool ok = true;
+    for (size_t index : order){
+        const Result& result = results[index];
+        str += "\n    " + resources[index].name + ": " +
+            std::to_string(std::chrono::duration_cast<Milliseconds>(result.time).count()) + " ms";
+        if (!result.error.empty()){
+            str += " (failed: " + result.error + ")";
+            ok = false;
+        }
+    }
+    logger.log(str, ok ? COLOR_BLUE : COLOR_RED);
+}
+
+
+
+}
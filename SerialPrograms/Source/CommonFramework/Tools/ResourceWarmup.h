@@ -0,0 +1,54 @@
+/*  Resource Warmup
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Most matchers and databases used by inference are built lazily in
+ *  function-local statics. The first call from a running program then blocks
+ *  while sprites and dictionaries are decoded.
+ *
+ *  Program descriptors list the resources their program will use
+ *  (ProgramDescriptor::warmup_resources()) and ProgramSession builds them in
+ *  the background as soon as the program is selected.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ResourceWarmup_H
+#define PokemonAutomation_CommonFramework_ResourceWarmup_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <type_traits>
+
+namespace PokemonAutomation{
+
+class Logger;
+
+
+//  A lazily built resource. "load" builds it if it isn't built yet.
+//  It must be safe to call from any thread and any number of times, which
+//  is the case for function-local statics.
+struct WarmupResource{
+    std::string name;
+    std::function<void()> load;
+
+    //  "function" is the accessor of the resource. Its return value is
+    //  discarded.
+    template <typename Function>
+    WarmupResource(std::string p_name, Function&& function)
+        : name(std::move(p_name))
+        , load([function = std::forward<Function>(function)]{ (void)function(); })
+    {}
+};
+
+
+//  Build all the resources in parallel on the normal inference thread pool.
+//  Blocks until they are all built. Logs how long each one took.
+//  A resource that throws is logged and skipped. The program will hit the
+//  same error when it uses it.
+void warm_up_resources(Logger& logger, const std::vector<WarmupResource>& resources);
+
+
+
+}
+#endif
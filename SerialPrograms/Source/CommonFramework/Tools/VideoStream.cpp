@@ -40,9 +40,14 @@ bool VideoStream::save_stream_history(const std::string& filename){
 }
 
 
-void VideoStream::initialize_inference_threads(CancellableScope& scope, AsyncDispatcher& dispatcher){
+void VideoStream::initialize_inference_threads(
+    CancellableScope& scope, AsyncDispatcher& dispatcher,
+    size_t thread_pool_owner
+){
     m_video_pivot.reset(scope, m_video, dispatcher);
     m_audio_pivot.reset(scope, m_audio, dispatcher);
+    m_video_pivot->set_thread_pool_owner(thread_pool_owner);
+    m_audio_pivot->set_thread_pool_owner(thread_pool_owner);
     m_overlay.add_stat(*m_video_pivot);
     m_overlay.add_stat(*m_audio_pivot);
 }
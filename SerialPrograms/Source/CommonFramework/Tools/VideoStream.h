@@ -73,7 +73,12 @@ public:
 
 
 public:
-    void initialize_inference_threads(CancellableScope& scope, AsyncDispatcher& dispatcher);
+    //  "thread_pool_owner" is the owner of the inference threads in the
+    //  global thread pools. (see ThreadPoolOwnerScope)
+    void initialize_inference_threads(
+        CancellableScope& scope, AsyncDispatcher& dispatcher,
+        size_t thread_pool_owner = 0
+    );
 
 
 private:
@@ -88,6 +88,7 @@ CameraVideoSource::~CameraVideoSource(){
     run_on_main_thread_and_wait([&]{
 //        m_camera->stop();
         m_capture_session.reset();
+        m_video_sink.reset();
         m_camera.reset();
     });
 }
@@ -166,6 +167,35 @@ void CameraVideoSource::init(const CameraInfo& info, Resolution desired_resoluti
     m_capture_session.reset(new QMediaCaptureSession());
     m_capture_session->setCamera(&m_camera->camera());
 
+    //  Feed the pipeline from our own sink so that we get frames even if
+    //  nothing is displaying them. (minimized or headless)
+    m_video_sink.reset(new QVideoSink());
+    m_capture_session->setVideoSink(m_video_sink.get());
+
+    m_metaobject->connect(
+        m_video_sink.get(), &QVideoSink::videoFrameChanged,
+        &m_camera->camera(), [&](const QVideoFrame& frame){
+            //  This runs on the QCamera's thread. So it is off the critical path.
+
+            WallClock now = current_time();
+            bool new_frame = m_last_frame.push_frame(frame, now);
+            if (new_frame){
+                m_snapshot_manager.on_new_frame();
+            }
+
+            {
+                std::lock_guard<std::mutex> lg(m_display_lock);
+                if (m_display_sink != nullptr){
+                    m_display_sink->setVideoFrame(frame);
+                }
+            }
+
+            if (new_frame){
+                report_source_frame(std::make_shared<VideoFrame>(now, frame));
+            }
+        }
+    );
+
 #if 0
     connect(m_camera.get(), &QCamera::errorOccurred, this, [&](){
         if (m_camera->error() == QCamera::NoError){
@@ -180,26 +210,14 @@ void CameraVideoSource::init(const CameraInfo& info, Resolution desired_resoluti
 
 
 void CameraVideoSource::set_video_output(QGraphicsVideoItem& item){
-    if (m_capture_session == nullptr){
-        return;
-    }
-    if (m_capture_session->videoSink() == item.videoSink()){
-        return;
+    std::lock_guard<std::mutex> lg(m_display_lock);
+    m_display_sink = item.videoSink();
+}
+void CameraVideoSource::clear_video_output(QGraphicsVideoItem& item){
+    std::lock_guard<std::mutex> lg(m_display_lock);
+    if (m_display_sink == item.videoSink()){
+        m_display_sink = nullptr;
     }
-    m_capture_session->setVideoOutput(&item);
-
-    m_metaobject->connect(
-        item.videoSink(), &QVideoSink::videoFrameChanged,
-        &m_camera->camera(), [&](const QVideoFrame& frame){
-            //  This runs on the QCamera's thread. So it is off the critical path.
-
-            WallClock now = current_time();
-            if (!m_last_frame.push_frame(frame, now)){
-                return;
-            }
-            report_source_frame(std::make_shared<VideoFrame>(now, frame));
-        }
-    );
 }
 
 
@@ -218,6 +236,9 @@ QWidget* CameraVideoSource::make_display_QtWidget(QWidget* parent){
 
 
 
+CameraVideoDisplay::~CameraVideoDisplay(){
+    m_source.clear_video_output(m_video);
+}
 CameraVideoDisplay::CameraVideoDisplay(QWidget* parent, CameraVideoSource& source)
     : QWidget(parent)
     , m_source(source)
@@ -11,7 +11,7 @@
 #if QT_VERSION_MAJOR == 6
 
 //#include <set>
-//#include <mutex>
+#include <mutex>
 #include <QCameraDevice>
 #include <QMediaCaptureSession>
 #include <QVideoFrame>
@@ -114,12 +114,19 @@ public:
     virtual VideoSnapshot snapshot_recent_nonblocking(WallClock min_time) override{
         return m_snapshot_manager.snapshot_recent_nonblocking(min_time);
     }
+    virtual void set_frame_latency_stats(FrameLatencyStats* stats) override{
+        m_snapshot_manager.set_latency_stats(stats);
+    }
 
     virtual QWidget* make_display_QtWidget(QWidget* parent) override;
 
 private:
     void init(const CameraInfo& info, Resolution desired_resolution);
+
+    //  Frames always go into the pipeline through our own sink. A display is
+    //  optional and gets a copy of each frame.
     void set_video_output(QGraphicsVideoItem& item);
+    void clear_video_output(QGraphicsVideoItem& item);
 
 
 private:
@@ -136,6 +143,9 @@ private:
 
     std::vector<Resolution> m_resolutions;
 
+    std::mutex m_display_lock;
+    QVideoSink* m_display_sink = nullptr;
+
 
 private:
     QVideoFrameCache m_last_frame;
@@ -145,6 +155,7 @@ private:
 
 class CameraVideoDisplay : public QWidget{
 public:
+    ~CameraVideoDisplay();
     CameraVideoDisplay(QWidget* parent, CameraVideoSource& source);
 
 private:
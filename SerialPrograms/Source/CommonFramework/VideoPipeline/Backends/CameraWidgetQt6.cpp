@@ -178,6 +178,7 @@ void CameraVideoSource::init(const CameraInfo& info, Resolution desired_resoluti
             if (!m_last_frame.push_frame(frame, now)){
                 return;
             }
+            m_snapshot_manager.on_new_frame();
             report_source_frame(std::make_shared<VideoFrame>(now, frame));
         }
     );
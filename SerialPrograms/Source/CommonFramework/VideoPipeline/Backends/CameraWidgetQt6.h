@@ -71,6 +71,9 @@ public:
     virtual VideoSnapshot snapshot_recent_nonblocking(WallClock min_time) override{
         return m_snapshot_manager.snapshot_recent_nonblocking(min_time);
     }
+    virtual void set_frame_latency_stats(FrameLatencyStats* stats) override{
+        m_snapshot_manager.set_latency_stats(stats);
+    }
 
     virtual QWidget* make_display_QtWidget(QWidget* parent) override;
 
@@ -10,6 +10,7 @@
 #include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/VideoPipeline/VideoPipelineOptions.h"
+#include "CommonFramework/VideoPipeline/Stats/FrameLatencyStats.h"
 #include "SnapshotManager.h"
 
 //#include <iostream>
@@ -19,6 +20,13 @@
 namespace PokemonAutomation{
 
 
+//  Stop converting eagerly if nobody has asked for a frame in this long.
+const std::chrono::milliseconds EAGER_CONVERSION_IDLE_TIMEOUT(1000);
+
+//  Max # of conversions in flight from eager conversion. If all are busy, only
+//  the newest frame is converted when one finishes. The rest are dropped.
+const size_t EAGER_CONVERSION_MAX_IN_FLIGHT = 2;
+
 
 
 SnapshotManager::~SnapshotManager(){
@@ -31,6 +39,8 @@ SnapshotManager::SnapshotManager(Logger& logger, QVideoFrameCache& cache)
     , m_active_conversions(0)
     , m_converting_seqnum(0)
     , m_converted_seqnum(0)
+    , m_last_request(WallClock::min())
+    , m_latency_stats(nullptr)
     , m_stats_conversion("ConvertFrame", "ms", 1000, std::chrono::seconds(10))
 {}
 
@@ -74,6 +84,7 @@ void SnapshotManager::convert(uint64_t seqnum, QVideoFrame frame, WallClock time
         WallClock time1 = current_time();
         uint32_t microseconds = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
         m_stats_conversion.report_data(m_logger, microseconds);
+        report_converted(timestamp);
     }catch (...){
         try{
             m_logger.log("Exception thrown while converting QVideoFrame -> QImage.", COLOR_RED);
@@ -154,6 +165,40 @@ void SnapshotManager::dispatch_conversion(uint64_t seqnum, QVideoFrame frame, Wa
     }
 }
 
+void SnapshotManager::report_converted(WallClock capture_time) noexcept{
+    FrameLatencyStats* stats = m_latency_stats.load(std::memory_order_acquire);
+    if (stats != nullptr){
+        stats->converted.add(current_time() - capture_time);
+    }
+}
+
+void SnapshotManager::on_new_frame() noexcept{
+    if (!GlobalSettings::instance().VIDEO_PIPELINE->EAGER_FRAME_CONVERSION){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+
+    //  Nobody is running inference. Don't waste CPU.
+    if (m_last_request + EAGER_CONVERSION_IDLE_TIMEOUT < current_time()){
+        return;
+    }
+
+    //  Too many in flight. Whichever finishes first will pick up the latest
+    //  frame.
+    if (m_active_conversions >= EAGER_CONVERSION_MAX_IN_FLIGHT){
+        m_queued_convert = true;
+        return;
+    }
+
+    QVideoFrame frame;
+    WallClock timestamp;
+    uint64_t seqnum = m_cache.get_latest(frame, timestamp);
+    if (m_converted_seqnum < seqnum && m_converting_seqnum < seqnum){
+        dispatch_conversion(seqnum, std::move(frame), timestamp);
+    }
+}
+
 void SnapshotManager::push_new_screenshot(uint64_t seqnum, VideoSnapshot snapshot){
     m_converted_snapshot_archive[seqnum] = snapshot;
     m_converted_snapshot = std::move(snapshot);
@@ -201,6 +246,7 @@ void SnapshotManager::cleanup(){
 
 VideoSnapshot SnapshotManager::snapshot_latest_blocking(){
     std::unique_lock<std::mutex> lg(m_lock);
+    m_last_request = current_time();
 
 //    cout << "snapshot_latest_blocking()" << endl;
 
@@ -240,6 +286,7 @@ VideoSnapshot SnapshotManager::snapshot_latest_blocking(){
             microseconds = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
         }
         m_stats_conversion.report_data(m_logger, microseconds);
+        report_converted(timestamp);
     }catch (...){
         m_logger.log("Exception thrown while converting QVideoFrame -> QImage.", COLOR_RED);
         throw;
@@ -259,6 +306,7 @@ VideoSnapshot SnapshotManager::snapshot_recent_nonblocking(WallClock min_time){
 //    WallClock now = current_time();
 
     std::lock_guard<std::mutex> lg(m_lock);
+    m_last_request = current_time();
 
     //  Already up-to-date. Return it.
     uint64_t seqnum = m_cache.seqnum();
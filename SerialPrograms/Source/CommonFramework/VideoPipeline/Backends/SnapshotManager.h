@@ -18,6 +18,7 @@
 namespace PokemonAutomation{
 
 class AsyncTask;
+struct FrameLatencyStats;
 
 class SnapshotManager{
 public:
@@ -28,6 +29,16 @@ public:
     VideoSnapshot snapshot_latest_blocking();
     VideoSnapshot snapshot_recent_nonblocking(WallClock min_time);
 
+    //  Call this after a new frame has been pushed into the cache. If eager
+    //  conversion is enabled and someone has asked for a snapshot recently,
+    //  this will start converting it right away instead of waiting for the
+    //  next request.
+    void on_new_frame() noexcept;
+
+    void set_latency_stats(FrameLatencyStats* stats){
+        m_latency_stats.store(stats, std::memory_order_release);
+    }
+
 private:
     static QImage frame_to_image(const QVideoFrame& frame);
     void convert(uint64_t seqnum, QVideoFrame frame, WallClock timestamp) noexcept;
@@ -37,6 +48,8 @@ private:
     void push_new_screenshot(uint64_t seqnum, VideoSnapshot snapshot);
     void cleanup();
 
+    void report_converted(WallClock capture_time) noexcept;
+
 private:
     Logger& m_logger;
     QVideoFrameCache& m_cache;
@@ -60,6 +73,12 @@ private:
     //  will periodically clear out on the conversion threads.
     std::map<uint64_t, VideoSnapshot> m_converted_snapshot_archive;
 
+    //  Last time anyone asked for a snapshot. Eager conversion only runs if
+    //  this is recent.
+    WallClock m_last_request;
+
+    std::atomic<FrameLatencyStats*> m_latency_stats;
+
     PeriodicStatsReporterI32 m_stats_conversion;
 };
 
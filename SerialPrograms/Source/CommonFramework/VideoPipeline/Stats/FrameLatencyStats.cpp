@@ -0,0 +1,97 @@
+/*  Frame Latency Stats
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <bit>
+#include "Common/Cpp/PrettyPrint.h"
+#include "FrameLatencyStats.h"
+
+namespace PokemonAutomation{
+
+
+LatencyHistogram::LatencyHistogram(){
+    clear();
+}
+void LatencyHistogram::add(WallDuration latency){
+    int64_t microseconds = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    uint64_t units = microseconds <= 0 ? 0 : (uint64_t)microseconds / FIRST_BUCKET_MICROSECONDS;
+    size_t index = std::min<size_t>(std::bit_width(units), BUCKETS - 1);
+    m_buckets[index].fetch_add(1, std::memory_order_relaxed);
+}
+void LatencyHistogram::clear(){
+    for (std::atomic<uint64_t>& bucket : m_buckets){
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+uint64_t LatencyHistogram::count() const{
+    uint64_t total = 0;
+    for (const std::atomic<uint64_t>& bucket : m_buckets){
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+std::chrono::microseconds LatencyHistogram::percentile(double p) const{
+    uint64_t counts[BUCKETS];
+    uint64_t total = 0;
+    for (size_t c = 0; c < BUCKETS; c++){
+        counts[c] = m_buckets[c].load(std::memory_order_relaxed);
+        total += counts[c];
+    }
+    if (total == 0){
+        return std::chrono::microseconds(0);
+    }
+
+    uint64_t target = (uint64_t)(p * total);
+    uint64_t seen = 0;
+    size_t c = 0;
+    for (; c < BUCKETS - 1; c++){
+        seen += counts[c];
+        if (seen > target){
+            break;
+        }
+    }
+    return std::chrono::microseconds(FIRST_BUCKET_MICROSECONDS << c);
+}
+
+
+
+FrameLatencyStat::FrameLatencyStat(FrameLatencyStats& stats)
+    : m_stats(stats)
+    , m_window_start(current_time())
+    , m_last{"Frame Latency: ---"}
+{}
+OverlayStatSnapshot FrameLatencyStat::get_current(){
+    std::lock_guard<std::mutex> lg(m_lock);
+
+    WallClock now = current_time();
+    if (now - m_window_start < std::chrono::seconds(5)){
+        return m_last;
+    }
+    m_window_start = now;
+
+    if (m_stats.processed.count() == 0){
+        m_last = OverlayStatSnapshot{"Frame Latency: ---"};
+        m_stats.converted.clear();
+        return m_last;
+    }
+
+    auto to_ms = [](std::chrono::microseconds x){
+        return tostr_fixed(x.count() / 1000., 1);
+    };
+    m_last = OverlayStatSnapshot{
+        "Frame Latency (p50/p99): Convert " +
+        to_ms(m_stats.converted.percentile(0.50)) + "/" + to_ms(m_stats.converted.percentile(0.99)) +
+        " ms, Process " +
+        to_ms(m_stats.processed.percentile(0.50)) + "/" + to_ms(m_stats.processed.percentile(0.99)) +
+        " ms"
+    };
+    m_stats.converted.clear();
+    m_stats.processed.clear();
+    return m_last;
+}
+
+
+
+}
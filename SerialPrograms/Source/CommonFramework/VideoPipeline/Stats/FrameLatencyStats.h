@@ -0,0 +1,72 @@
+/*  Frame Latency Stats
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Histograms of how long it takes a video frame to go from capture to being
+ *  converted into an image and then to being processed by inference.
+ *
+ */
+
+#ifndef PokemonAutomation_FrameLatencyStats_H
+#define PokemonAutomation_FrameLatencyStats_H
+
+#include <atomic>
+#include <mutex>
+#include "Common/Cpp/Time.h"
+#include "CommonFramework/VideoPipeline/VideoOverlayTypes.h"
+
+namespace PokemonAutomation{
+
+
+//  Lock-free histogram with power-of-two buckets starting at 256us.
+class LatencyHistogram{
+public:
+    static constexpr size_t BUCKETS = 16;
+    static constexpr uint64_t FIRST_BUCKET_MICROSECONDS = 256;
+
+public:
+    LatencyHistogram();
+
+    void add(WallDuration latency);
+    void clear();
+
+    uint64_t count() const;
+
+    //  Upper bound of the bucket that contains this percentile. [0, 1]
+    std::chrono::microseconds percentile(double p) const;
+
+private:
+    std::atomic<uint64_t> m_buckets[BUCKETS];
+};
+
+
+struct FrameLatencyStats{
+    //  Capture -> converted to an image.
+    LatencyHistogram converted;
+
+    //  Capture -> the first inference callback has finished processing it.
+    //  (see VideoFeed::report_frame_processed())
+    LatencyHistogram processed;
+};
+
+
+//  Overlay stat that shows the frame latency percentiles over the last few
+//  seconds.
+class FrameLatencyStat : public OverlayStat{
+public:
+    FrameLatencyStat(FrameLatencyStats& stats);
+
+    virtual OverlayStatSnapshot get_current() override;
+
+private:
+    FrameLatencyStats& m_stats;
+
+    std::mutex m_lock;
+    WallClock m_window_start;
+    OverlayStatSnapshot m_last;
+};
+
+
+
+}
+#endif
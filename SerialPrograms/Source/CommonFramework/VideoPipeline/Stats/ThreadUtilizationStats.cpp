@@ -41,18 +41,28 @@ OverlayStatSnapshot ThreadUtilizationStat::get_current(){
 
 
 
-ThreadPoolUtilizationStat::ThreadPoolUtilizationStat(const ComputationThreadPool& thread_pool, std::string label)
+ThreadPoolUtilizationStat::ThreadPoolUtilizationStat(
+    const ComputationThreadPool& thread_pool,
+    std::string label,
+    size_t owner
+)
     : m_thread_pool(thread_pool)
     , m_label(std::move(label))
-    , m_last_clock(thread_pool.cpu_time())
+    , m_owner(owner)
+    , m_last_clock(cpu_time())
     , m_printer((double)thread_pool.max_threads())
 {}
+WallDuration ThreadPoolUtilizationStat::cpu_time() const{
+    return m_owner == ALL_OWNERS
+        ? m_thread_pool.cpu_time()
+        : m_thread_pool.owner_cpu_time(m_owner);
+}
 
 OverlayStatSnapshot ThreadPoolUtilizationStat::get_current(){
     std::lock_guard<std::mutex> lg(m_lock);
 
     WallClock now = current_time();
-    WallDuration clock = m_thread_pool.cpu_time();
+    WallDuration clock = cpu_time();
     if (clock <= WallDuration::zero()){
         return OverlayStatSnapshot();
     }
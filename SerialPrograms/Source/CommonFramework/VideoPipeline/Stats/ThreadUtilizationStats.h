@@ -40,13 +40,24 @@ private:
 
 class ThreadPoolUtilizationStat : public OverlayStat{
 public:
-    ThreadPoolUtilizationStat(const ComputationThreadPool& thread_pool, std::string label);
+    static constexpr size_t ALL_OWNERS = (size_t)-1;
+
+    //  If "owner" is set, only count the time spent on that owner's tasks.
+    ThreadPoolUtilizationStat(
+        const ComputationThreadPool& thread_pool,
+        std::string label,
+        size_t owner = ALL_OWNERS
+    );
 
     virtual OverlayStatSnapshot get_current() override;
 
+private:
+    WallDuration cpu_time() const;
+
 private:
     const ComputationThreadPool& m_thread_pool;
     std::string m_label;
+    size_t m_owner;
 
     std::mutex m_lock;
     WallDuration m_last_clock;
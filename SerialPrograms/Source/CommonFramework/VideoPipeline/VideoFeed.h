@@ -113,6 +113,11 @@ public:
     //  Returns the currently measured frames/second for the video display thread.
     //  Use this for diagnostic purposes.
     virtual double fps_display() const = 0;
+
+    //  Called by inference once it has finished processing the frame that was
+    //  captured at "capture_time". Feeds that track frame latencies use this
+    //  to measure capture -> processed. Others can ignore it.
+    virtual void report_frame_processed([[maybe_unused]] WallClock capture_time){}
 };
 
 
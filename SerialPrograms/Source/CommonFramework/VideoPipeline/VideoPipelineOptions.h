@@ -10,6 +10,7 @@
 #include "Common/Cpp/Options/GroupOption.h"
 #include "Common/Cpp/Options/BooleanCheckBoxOption.h"
 #include "Common/Cpp/Options/SimpleIntegerOption.h"
+#include "Common/Cpp/Options/FloatingPointOption.h"
 #include "Common/Cpp/Options/EnumDropdownOption.h"
 #include "Backends/CameraImplementations.h"
 
@@ -77,6 +78,35 @@ public:
             LockMode::UNLOCK_WHILE_RUNNING,
             VideoRotation::ROTATE_0
         )
+        , EAGER_FRAME_CONVERSION(
+            "<b>Eager Frame Conversion:</b><br>"
+            "Convert each new video frame as soon as it arrives while a program is using the video. "
+            "This lowers the reaction time of inference at the cost of more CPU usage.",
+            LockMode::UNLOCK_WHILE_RUNNING,
+            false
+        )
+        , ADAPTIVE_INFERENCE_PERIODS(
+            "<b>Adaptive Inference Periods:</b><br>"
+            "Run video inference when new frames arrive instead of on a fixed timer. "
+            "The same frame is never inspected twice and expensive detectors are slowed down "
+            "when the inference thread is overloaded.",
+            LockMode::UNLOCK_WHILE_RUNNING,
+            false
+        )
+        , SKIP_UNCHANGED_REGIONS(
+            "<b>Skip Unchanged Regions:</b><br>"
+            "Track which parts of the video change between frames. Detectors that support it "
+            "skip frames where nothing they look at has changed.",
+            LockMode::UNLOCK_WHILE_RUNNING,
+            false
+        )
+        , UNCHANGED_REGION_THRESHOLD(
+            "<b>Unchanged Region Threshold:</b><br>"
+            "A 16x16 block of the video is unchanged if its average difference per color channel "
+            "from the previous frame is at most this much. Raise this if your capture card is noisy.",
+            LockMode::UNLOCK_WHILE_RUNNING,
+            2.0, 0, 255
+        )
     {
         PA_ADD_OPTION(VIDEO_BACKEND);
 #if QT_VERSION_MAJOR == 5
@@ -85,6 +115,10 @@ public:
 
         PA_ADD_OPTION(AUTO_RESET_SECONDS);
         PA_ADD_OPTION(VIDEO_ROTATION);
+        PA_ADD_OPTION(EAGER_FRAME_CONVERSION);
+        PA_ADD_OPTION(ADAPTIVE_INFERENCE_PERIODS);
+        PA_ADD_OPTION(SKIP_UNCHANGED_REGIONS);
+        PA_ADD_OPTION(UNCHANGED_REGION_THRESHOLD);
     }
 
 public:
@@ -95,6 +129,10 @@ public:
 
     SimpleIntegerOption<uint8_t> AUTO_RESET_SECONDS;
     EnumDropdownOption<VideoRotation> VIDEO_ROTATION;
+    BooleanCheckBoxOption EAGER_FRAME_CONVERSION;
+    BooleanCheckBoxOption ADAPTIVE_INFERENCE_PERIODS;
+    BooleanCheckBoxOption SKIP_UNCHANGED_REGIONS;
+    FloatingPointOption UNCHANGED_REGION_THRESHOLD;
 };
 
 
@@ -168,6 +168,7 @@ void VideoSession::internal_reset(){
         resolution = source->current_resolution();
         source->add_source_frame_listener(*this);
         source->add_rendered_frame_listener(*this);
+        source->set_frame_latency_stats(&m_frame_latency);
     }
 
     {
@@ -214,6 +215,7 @@ void VideoSession::internal_set_source(
         resolution = source->current_resolution();
         source->add_source_frame_listener(*this);
         source->add_rendered_frame_listener(*this);
+        source->set_frame_latency_stats(&m_frame_latency);
     }
 
     {
@@ -251,6 +253,7 @@ void VideoSession::internal_set_resolution(Resolution resolution){
         resolution = source->current_resolution();
         source->add_source_frame_listener(*this);
         source->add_rendered_frame_listener(*this);
+        source->set_frame_latency_stats(&m_frame_latency);
     }
 
     {
@@ -331,6 +334,9 @@ double VideoSession::fps_display() const{
     ReadSpinLock lg(m_fps_lock);
     return m_fps_tracker_rendered.events_per_second();
 }
+void VideoSession::report_frame_processed(WallClock capture_time){
+    m_frame_latency.processed.add(current_time() - capture_time);
+}
 void VideoSession::on_frame(std::shared_ptr<const VideoFrame> frame){
     m_frame_listeners.run_method(&VideoFrameListener::on_frame, frame);
     {
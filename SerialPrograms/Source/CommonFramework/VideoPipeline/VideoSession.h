@@ -13,6 +13,7 @@
 #include "Common/Cpp/EventRateTracker.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "Common/Cpp/Concurrency/Watchdog.h"
+#include "Stats/FrameLatencyStats.h"
 #include "VideoSourceDescriptor.h"
 #include "VideoSource.h"
 
@@ -125,6 +126,14 @@ public:
     //  Use this for diagnostic purposes.
     //  This function is thread-safe. It has a lock to prevent concurrent fps calls.
     virtual double fps_display() const override;
+    //  Implements VideoFeed::report_frame_processed().
+    virtual void report_frame_processed(WallClock capture_time) override;
+
+    //  Capture -> conversion -> processing latencies of the frames from
+    //  whichever source is currently active.
+    FrameLatencyStats& frame_latency(){
+        return m_frame_latency;
+    }
 
 
 public:
@@ -212,6 +221,8 @@ private:
     EventRateTracker m_fps_tracker_source;
     EventRateTracker m_fps_tracker_rendered;
 
+    FrameLatencyStats m_frame_latency;
+
     std::shared_ptr<const VideoSourceDescriptor> m_descriptor;
     std::unique_ptr<VideoSource> m_video_source;
 
@@ -18,6 +18,8 @@ class QWidget;
 
 namespace PokemonAutomation{
 
+struct FrameLatencyStats;
+
 
 
 
@@ -61,6 +63,10 @@ public:
     virtual VideoSnapshot snapshot_latest_blocking() = 0;
     virtual VideoSnapshot snapshot_recent_nonblocking(WallClock min_time) = 0;
 
+    //  Where to report frame latencies. Sources that don't track them can
+    //  ignore this. The stats object must outlive the source.
+    virtual void set_frame_latency_stats([[maybe_unused]] FrameLatencyStats* stats){}
+
 
 protected:
     //  These are not thread-safe.
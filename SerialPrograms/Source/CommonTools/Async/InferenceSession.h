@@ -38,6 +38,10 @@ class VideoStream;
 //  returned true. So it is expected that the object will be destructed soon
 //  after "scope.cancel()" is called.
 //
+//  With "Adaptive Inference Periods" enabled, the video periods are the
+//  minimum time between two runs of a callback. The runs themselves follow
+//  the arrival of new frames. (see VisualInferencePivot)
+//
 class InferenceSession{
 public:
     InferenceSession(
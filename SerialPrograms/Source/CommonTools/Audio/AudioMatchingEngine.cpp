@@ -0,0 +1,192 @@
+/*  Audio Matching Engine
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <cfloat>
+#include <algorithm>
+#include "AudioMatchingEngine.h"
+
+namespace PokemonAutomation{
+
+
+
+void AudioMatchingEngine::add_matcher(const SpectrogramMatcher& matcher){
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_matchers.find(&matcher) != m_matchers.end()){
+        return;
+    }
+    FeatureHistory& history = m_histories[matcher.feature_key()];
+    if (history.preprocessor == nullptr){
+        history.preprocessor = &matcher;
+    }
+    history.matchers.emplace_back(&matcher);
+    history.windows_needed = std::max(history.windows_needed, matcher.numMatchedWindows());
+
+    //  Other matchers may already be sharing this history. Don't score the new
+    //  one against anything that came in before it was added.
+    uint64_t first_stamp = history.last_stamp == ~(uint64_t)0 ? 0 : history.last_stamp + 1;
+    m_matchers.emplace(&matcher, MatcherState{&history, {}, first_stamp});
+}
+void AudioMatchingEngine::remove_matcher(const SpectrogramMatcher& matcher){
+    std::lock_guard<std::mutex> lg(m_lock);
+    auto iter = m_matchers.find(&matcher);
+    if (iter == m_matchers.end()){
+        return;
+    }
+    m_matchers.erase(iter);
+
+    auto history_iter = m_histories.find(matcher.feature_key());
+    FeatureHistory& history = history_iter->second;
+    history.matchers.erase(std::find(history.matchers.begin(), history.matchers.end(), &matcher));
+    if (history.matchers.empty()){
+        m_histories.erase(history_iter);
+        return;
+    }
+
+    history.preprocessor = history.matchers[0];
+    history.windows_needed = 0;
+    for (const SpectrogramMatcher* item : history.matchers){
+        history.windows_needed = std::max(history.windows_needed, item->numMatchedWindows());
+    }
+    while (history.features.size() > history.windows_needed){
+        history.features.pop_back();
+    }
+}
+
+void AudioMatchingEngine::push_spectrum(FeatureHistory& history, const AudioSpectrum& spectrum){
+    //  Already seen.
+    if (history.last_stamp != ~(uint64_t)0 && spectrum.stamp <= history.last_stamp){
+        return;
+    }
+
+    //  Gap in the stream. The old history can't be matched across it.
+    if (history.last_stamp + 1 != spectrum.stamp){
+        history.features.clear();
+    }
+    history.last_stamp = spectrum.stamp;
+
+    std::shared_ptr<const AlignedVector<float>> features = history.preprocessor->preprocess(spectrum);
+    if (!features){
+        history.features.clear();
+        return;
+    }
+    history.features.emplace_front(std::move(features));
+    while (history.features.size() > history.windows_needed){
+        history.features.pop_back();
+    }
+
+    history.feature_ptrs.clear();
+    for (const auto& item : history.features){
+        history.feature_ptrs.emplace_back(item->data());
+    }
+
+    //  Score every matcher on this history.
+    for (const SpectrogramMatcher* matcher : history.matchers){
+        MatcherState& state = m_matchers.find(matcher)->second;
+        std::deque<MatchResult>& results = state.results;
+        if (results.size() >= MAX_PENDING_RESULTS){
+            results.pop_front();
+        }
+        size_t windows = history.feature_ptrs.size();
+        if (spectrum.stamp < state.first_stamp){
+            windows = 0;
+        }else{
+            windows = (size_t)std::min<uint64_t>(windows, spectrum.stamp - state.first_stamp + 1);
+        }
+        if (windows < matcher->numMatchedWindows()){
+            results.emplace_back(MatchResult{spectrum.stamp, FLT_MAX, 0.0f});
+            continue;
+        }
+        std::pair<float, float> match = matcher->match_features(history.feature_ptrs.data());
+        results.emplace_back(MatchResult{spectrum.stamp, match.first, match.second});
+    }
+}
+void AudioMatchingEngine::push_spectrums(AudioFeed& feed, const std::vector<AudioSpectrum>& new_spectrums){
+    if (new_spectrums.empty()){
+        return;
+    }
+
+    //  Find the oldest stamp that some history is still missing.
+    uint64_t next_stamp = ~(uint64_t)0;
+    for (const auto& item : m_histories){
+        if (item.second.last_stamp != ~(uint64_t)0){
+            next_stamp = std::min(next_stamp, item.second.last_stamp + 1);
+        }
+    }
+
+    //  The caller's spectrums start after that. Fill the gap from the feed.
+    const std::vector<AudioSpectrum>* spectrums = &new_spectrums;
+    if (next_stamp < new_spectrums.back().stamp){
+        feed.read_spectrums_since(next_stamp, m_backfill);
+        if (!m_backfill.empty() && m_backfill[0].stamp >= new_spectrums[0].stamp){
+            spectrums = &m_backfill;
+        }
+    }
+
+    for (auto& item : m_histories){
+        FeatureHistory& history = item.second;
+        for (auto iter = spectrums->rbegin(); iter != spectrums->rend(); ++iter){
+            push_spectrum(history, *iter);
+        }
+    }
+    m_backfill.clear();
+}
+
+void AudioMatchingEngine::match(
+    AudioFeed& feed,
+    const SpectrogramMatcher& matcher,
+    const std::vector<AudioSpectrum>& new_spectrums,
+    std::vector<MatchResult>& results
+){
+    results.clear();
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    push_spectrums(feed, new_spectrums);
+
+    auto iter = m_matchers.find(&matcher);
+    if (iter == m_matchers.end()){
+        return;
+    }
+    std::deque<MatchResult>& pending = iter->second.results;
+    for (auto spectrum = new_spectrums.rbegin(); spectrum != new_spectrums.rend(); ++spectrum){
+        //  Results that the caller skipped over are stale.
+        while (!pending.empty() && pending.front().stamp < spectrum->stamp){
+            pending.pop_front();
+        }
+        if (!pending.empty() && pending.front().stamp == spectrum->stamp){
+            results.emplace_back(pending.front());
+            pending.pop_front();
+        }else{
+            results.emplace_back(MatchResult{spectrum->stamp, FLT_MAX, 0.0f});
+        }
+    }
+}
+
+void AudioMatchingEngine::reset_matcher(const SpectrogramMatcher& matcher){
+    std::lock_guard<std::mutex> lg(m_lock);
+    auto iter = m_matchers.find(&matcher);
+    if (iter == m_matchers.end()){
+        return;
+    }
+    MatcherState& state = iter->second;
+    state.results.clear();
+    uint64_t last_stamp = state.history->last_stamp;
+    state.first_stamp = last_stamp == ~(uint64_t)0 ? 0 : last_stamp + 1;
+}
+void AudioMatchingEngine::clear(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    for (auto& item : m_histories){
+        item.second.features.clear();
+        item.second.last_stamp = ~(uint64_t)0;
+    }
+    for (auto& item : m_matchers){
+        item.second.results.clear();
+        item.second.first_stamp = 0;
+    }
+}
+
+
+
+}
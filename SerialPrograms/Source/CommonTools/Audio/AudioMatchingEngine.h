@@ -0,0 +1,118 @@
+/*  Audio Matching Engine
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Shared spectrogram matching for all the audio detectors running on the
+ *  same audio feed.
+ *
+ *  Each SpectrogramMatcher preprocesses every incoming spectrum before it can
+ *  match against its template. When several detectors run at once (shiny sound,
+ *  cry, battle music...) they would all redo the same preprocessing on the
+ *  same spectrums.
+ *
+ *  This engine keeps one preprocessed history per distinct preprocessing
+ *  configuration (SpectrogramMatcher::FeatureKey). Each new spectrum is
+ *  preprocessed once and then every registered matcher that uses that history
+ *  is scored against it in the same pass. The results are queued up for each
+ *  matcher until its detector asks for them.
+ *
+ *  This class is thread-safe.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_AudioMatchingEngine_H
+#define PokemonAutomation_CommonTools_AudioMatchingEngine_H
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include "SpectrogramMatcher.h"
+
+namespace PokemonAutomation{
+
+
+class AudioMatchingEngine{
+public:
+    struct MatchResult{
+        uint64_t stamp;
+        //  FLT_MAX if there was not enough history to match.
+        float score;
+        float scale;
+    };
+
+public:
+    AudioMatchingEngine() = default;
+    AudioMatchingEngine(const AudioMatchingEngine&) = delete;
+    void operator=(const AudioMatchingEngine&) = delete;
+
+    //  The matcher must stay alive until it is removed. It is only scored
+    //  against spectrums that come in after it is added, even if it shares a
+    //  history with matchers that were added earlier.
+    void add_matcher(const SpectrogramMatcher& matcher);
+    void remove_matcher(const SpectrogramMatcher& matcher);
+
+    //  Feed in new spectrums and return the results for "matcher" for each of
+    //  them. "new_spectrums" is ordered newest first, like everything else from
+    //  AudioFeed. "results" is ordered oldest first.
+    //
+    //  Spectrums that have already been fed in (by another detector) are not
+    //  processed again. If "new_spectrums" starts after a gap in the shared
+    //  history (e.g. a detector that just started), the gap is filled from
+    //  "feed" so that the other matchers don't lose their history.
+    void match(
+        AudioFeed& feed,
+        const SpectrogramMatcher& matcher,
+        const std::vector<AudioSpectrum>& new_spectrums,
+        std::vector<MatchResult>& results
+    );
+
+    //  Drop any pending results for this matcher and start its history over.
+    //  The shared history is kept for the other matchers, but this matcher will
+    //  not be scored against any spectrum that came in before this call.
+    void reset_matcher(const SpectrogramMatcher& matcher);
+
+    //  Drop all history and pending results.
+    void clear();
+
+
+private:
+    struct FeatureHistory;
+    void push_spectrums(AudioFeed& feed, const std::vector<AudioSpectrum>& new_spectrums);
+    void push_spectrum(FeatureHistory& history, const AudioSpectrum& spectrum);
+
+
+private:
+    //  Results older than this that nobody picked up are dropped.
+    static constexpr size_t MAX_PENDING_RESULTS = 64;
+
+    struct FeatureHistory{
+        //  Any of the matchers below. Used to do the preprocessing.
+        const SpectrogramMatcher* preprocessor = nullptr;
+        std::vector<const SpectrogramMatcher*> matchers;
+
+        //  Largest number of windows needed by any matcher.
+        size_t windows_needed = 0;
+        uint64_t last_stamp = ~(uint64_t)0;
+
+        //  Newest first.
+        std::deque<std::shared_ptr<const AlignedVector<float>>> features;
+        std::vector<const float*> feature_ptrs;
+    };
+    struct MatcherState{
+        FeatureHistory* history;
+        std::deque<MatchResult> results;
+        //  Oldest stamp this matcher may be scored against. Set when the
+        //  matcher is added and by reset_matcher().
+        uint64_t first_stamp = 0;
+    };
+
+    std::mutex m_lock;
+    std::map<SpectrogramMatcher::FeatureKey, FeatureHistory> m_histories;
+    std::map<const SpectrogramMatcher*, MatcherState> m_matchers;
+    std::vector<AudioSpectrum> m_backfill;
+};
+
+
+
+}
+#endif
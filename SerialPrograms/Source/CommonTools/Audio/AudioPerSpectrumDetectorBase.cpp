@@ -9,7 +9,6 @@
 #include "Common/Cpp/PrettyPrint.h"
 #include "Common/Cpp/Exceptions.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
-#include "SpectrogramMatcher.h"
 #include "AudioPerSpectrumDetectorBase.h"
 
 #include <iostream>
@@ -45,6 +44,12 @@ AudioPerSpectrumDetectorBase::~AudioPerSpectrumDetectorBase(){
     try{
         log_results();
     }catch (...){}
+    if (m_engine != nullptr && m_matcher != nullptr){
+        m_engine->remove_matcher(*m_matcher);
+    }
+    if (m_band_feed != nullptr && m_matcher != nullptr){
+        m_band_feed->remove_spectrum_band(m_matcher->spectrum_band());
+    }
 }
 void AudioPerSpectrumDetectorBase::throw_if_no_sound(std::chrono::milliseconds min_duration) const{
     if (m_start_timestamp + min_duration > current_time()){
@@ -101,16 +106,36 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
         m_last_reported = false;
     }
 
+    // Attach to the audio feed's shared matching engine the first time around.
+    if (m_engine == nullptr){
+        m_engine = audio_feed.matching_engine();
+        if (m_engine == nullptr){
+            m_private_engine = std::make_unique<AudioMatchingEngine>();
+            m_engine = m_private_engine.get();
+        }
+    }
+
     const size_t sample_rate = new_spectrums[0].sample_rate;
     // Lazy initialization of the spectrogram matcher.
     if (m_matcher == nullptr || m_matcher->sample_rate() != sample_rate){
         m_logger.log("Loading spectrogram...");
+        if (m_matcher != nullptr){
+            m_engine->remove_matcher(*m_matcher);
+            if (m_band_feed != nullptr){
+                m_band_feed->remove_spectrum_band(m_matcher->spectrum_band());
+            }
+        }
         m_matcher = build_spectrogram_matcher(sample_rate);
+        m_engine->add_matcher(*m_matcher);
+
+        // Have the feed publish only the frequencies we match on.
+        m_band_feed = &audio_feed;
+        m_band_feed->add_spectrum_band(m_matcher->spectrum_band());
     }
 
-    // Feed spectrum one by one to the matcher:
-    // new_spectrums are ordered from newest (largest timestamp) to oldest (smallest timestamp).
-    // To feed the spectrum from old to new, we need to go through the vector in the reverse order:
+    // The engine matches the template at each new spectrum. The results are
+    // ordered from old to new.
+    m_engine->match(audio_feed, *m_matcher, new_spectrums, m_results);
 
 
 //#define PA_DEBUG_FORCE_PLA_SOUND
@@ -123,9 +148,8 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
     
     bool found = false;
     const float threshold = get_score_threshold();
-    for (auto it = new_spectrums.rbegin(); it != new_spectrums.rend(); it++){
-        std::vector<AudioSpectrum> single_spectrum = {*it};
-        const float matcher_score = m_matcher->match(single_spectrum);
+    for (const AudioMatchingEngine::MatchResult& result : m_results){
+        const float matcher_score = result.score;
         // std::cout << "error: " << matcherScore << std::endl;
 
         if (m_lowest_error < 1.0){
@@ -145,7 +169,7 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
 
         found = matcher_score <= threshold;
 
-        uint64_t curStamp = m_matcher->latestTimestamp();
+        uint64_t curStamp = result.stamp;
 
 #ifdef PA_DEBUG_FORCE_PLA_SOUND
         if (debug_count % 300 > 300 - 5){
@@ -164,20 +188,11 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
             m_last_error = std::min(m_last_error, matcher_score);
 
             std::ostringstream os;
-            os << m_audio_name << " found, score " << matcher_score << "/" << threshold << ", scale: " << m_matcher->lastMatchedScale();
+            os << m_audio_name << " found, score " << matcher_score << "/" << threshold << ", scale: " << result.scale;
             m_logger.log(os.str(), COLOR_BLUE);
             audio_feed.add_overlay(curStamp+1-m_matcher->numMatchedWindows(), curStamp+1, m_detection_color);
 
             // Since the target audio is found, no need to check detection on the rest of the spectrums in `new_spectrums`.
-
-            // Tell m_matcher to skip the remaining spectrums so that if `process_spectrums()` gets
-            // called again on a newer batch of spectrums, m_matcher is happy.
-            m_matcher->skip(std::vector<AudioSpectrum>(
-                new_spectrums.begin(),
-                new_spectrums.begin() + std::distance(it + 1, new_spectrums.rend())
-            ));
-
-            // Skip the remaining spectrums.
             break;
         }
     }
@@ -211,7 +226,11 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
 }
 
 void AudioPerSpectrumDetectorBase::clear(){
-    m_matcher->clear();
+    if (m_private_engine){
+        m_private_engine->clear();
+    }else if (m_engine != nullptr && m_matcher != nullptr){
+        m_engine->reset_matcher(*m_matcher);
+    }
 }
 
 
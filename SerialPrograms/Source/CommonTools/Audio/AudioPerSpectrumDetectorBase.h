@@ -33,12 +33,12 @@
 #include "Common/Cpp/Color.h"
 #include "Common/Cpp/Time.h"
 #include "CommonTools/InferenceCallbacks/AudioInferenceCallback.h"
+#include "AudioMatchingEngine.h"
 
 namespace PokemonAutomation{
 
 
 class Logger;
-class SpectrogramMatcher;
 
 // A virtual base class for audio detectors to match an audio template starting at each incoming
 // spectrum in the audio stream.
@@ -124,6 +124,15 @@ protected:
     bool m_last_reported = false;
     
     std::unique_ptr<SpectrogramMatcher> m_matcher;
+    // The engine that does the matching. Normally the one shared by all the
+    // detectors on the audio feed. If the feed doesn't have one, it's
+    // "m_private_engine".
+    AudioMatchingEngine* m_engine = nullptr;
+    std::unique_ptr<AudioMatchingEngine> m_private_engine;
+    std::vector<AudioMatchingEngine::MatchResult> m_results;
+
+    // The feed that we asked to publish "m_matcher"'s spectrum band.
+    AudioFeed* m_band_feed = nullptr;
 
     std::vector<std::pair<float, std::string>> m_errors;
 };
@@ -1,7 +1,9 @@
 
 
+#include <string.h>
 #include <cfloat>
 #include <cmath>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 //#include "Common/Cpp/Exceptions.h"
@@ -78,6 +80,7 @@ SpectrogramMatcher::SpectrogramMatcher(
 
     m_originalFreqStart = int(low_frequency_filter * m_numOriginalFrequencies / halfSampleRate + 0.5);
     m_originalFreqEnd = 20000 * m_numOriginalFrequencies / halfSampleRate + 1;
+    m_originalFreqEnd = std::min(m_originalFreqEnd, m_numOriginalFrequencies);
 
     // Initialize the spike convolution kernel:
     m_convKernel = buildSpikeKernel(m_numOriginalFrequencies, halfSampleRate);
@@ -99,6 +102,7 @@ SpectrogramMatcher::SpectrogramMatcher(
         m_template = std::move(audio_template);
         m_freqStart = 0;
         m_freqEnd = numConvedFrequencies;
+        m_band = SpectrumBand{m_originalFreqStart, m_originalFreqEnd, 1};
         break;
     }
     case Mode::AVERAGE_5:
@@ -118,13 +122,31 @@ SpectrogramMatcher::SpectrogramMatcher(
         m_template = std::move(audio_template);
         m_freqStart = 0;
         m_freqEnd = numNewFreq;
+        m_band = SpectrumBand{m_originalFreqStart, m_originalFreqStart + numNewFreq * 5, 5};
         break;
     }
     case Mode::RAW:
-        m_freqStart = m_originalFreqStart;
-        m_freqEnd = m_originalFreqEnd;
+    {
+        // Crop the template to the matched frequencies so that it lines up
+        // with the band-limited spectrums.
+        const size_t numNewFreq = m_originalFreqEnd - m_originalFreqStart;
+
+        AudioTemplate audio_template(numNewFreq, numTemplateWindows);
+        for (size_t i = 0; i < numTemplateWindows; i++){
+            memcpy(
+                audio_template.getWindow(i),
+                m_template.getWindow(i) + m_originalFreqStart,
+                numNewFreq * sizeof(float)
+            );
+        }
+
+        m_template = std::move(audio_template);
+        m_freqStart = 0;
+        m_freqEnd = numNewFreq;
+        m_band = SpectrumBand{m_originalFreqStart, m_originalFreqEnd, 1};
         break;
     }
+    }
 
     if (templateSubdivision <= 1){
         m_templateRange.emplace_back(0, numTemplateWindows);
@@ -154,7 +176,7 @@ uint64_t SpectrogramMatcher::latestTimestamp() const{
     return m_spectrums.front().stamp;
 }
 
-void SpectrogramMatcher::conv(const float* src, size_t num, float* dst){
+void SpectrogramMatcher::conv(const float* src, size_t num, float* dst) const{
 //    cout << (size_t)dst % 64 << endl;
 
     const size_t numConvedFrequencies = num - m_convKernel.size() + 1;
@@ -194,51 +216,43 @@ std::vector<float> SpectrogramMatcher::buildTemplateNorm() const{
     return ret;
 }
 
-bool SpectrogramMatcher::update_to_new_spectrum(AudioSpectrum spectrum){
+std::shared_ptr<const AlignedVector<float>> SpectrogramMatcher::preprocess(const AudioSpectrum& spectrum) const{
     if (m_numOriginalFrequencies != spectrum.magnitudes->size()){
         std::cout << "Error: number of frequencies don't match in SpectrogramMatcher::match() " << 
             m_numOriginalFrequencies << " " << spectrum.magnitudes->size() << std::endl;
-        return false;
+        return nullptr;
     }
 
+    // If the feed published our band, it's already cropped (and averaged).
+    std::shared_ptr<const AlignedVector<float>> band = spectrum.find_band(m_band);
+
     switch(m_mode){
     case Mode::SPIKE_CONV:
     {
         // Do the conv on new spectrum too.
-        AlignedVector<float> convedSpectrum(m_template.bufferSize());
-        conv(spectrum.magnitudes->data() + m_originalFreqStart,
-            m_originalFreqEnd - m_originalFreqStart, convedSpectrum.data());
-        
-        spectrum.magnitudes = std::make_unique<AlignedVector<float>>(std::move(convedSpectrum));
-        break;
+        const float* input = band
+            ? band->data()
+            : spectrum.magnitudes->data() + m_originalFreqStart;
+        auto convedSpectrum = std::make_shared<AlignedVector<float>>(m_template.bufferSize());
+        conv(input, m_originalFreqEnd - m_originalFreqStart, convedSpectrum->data());
+        return convedSpectrum;
     }
     case Mode::AVERAGE_5:
-    {
-        AlignedVector<float> avgedSpectrum(m_template.bufferSize());
-        for(size_t j = 0; j < m_template.numFrequencies(); j++){
-            const float * rawFreqMag = spectrum.magnitudes->data() + m_originalFreqStart + j*5;
-            const float newMag = (rawFreqMag[0] + rawFreqMag[1] + rawFreqMag[2] + rawFreqMag[3] + rawFreqMag[4]) / 5.0f;
-            avgedSpectrum[j] = newMag;
-        }
-        spectrum.magnitudes = std::make_unique<AlignedVector<float>>(std::move(avgedSpectrum));
-        break;
-    }
     case Mode::RAW:
         break;
     }
-
-    // Compute the norm square (= sum squares) of the spectrum, used for matching:
-    // TODO: if there will be multiple SpectrogramMatcher running on the same audio stream, can
-    // move this per-spectrum computation to a shared struct for those matchers to save computation.
-    float spectrumNormSqr = 0.0f;
-    for (size_t i = m_freqStart; i < m_freqEnd; i++){
-        float mag = (*spectrum.magnitudes)[i];
-        spectrumNormSqr += mag * mag;
+    if (band){
+        return band;
     }
-    m_spectrumNormSqrs.push_front(spectrumNormSqr);
-
-    m_spectrums.emplace_front(std::move(spectrum));
+    return extract_spectrum_band(m_band, spectrum.magnitudes->data());
+}
 
+bool SpectrogramMatcher::update_to_new_spectrum(const AudioSpectrum& spectrum){
+    std::shared_ptr<const AlignedVector<float>> features = preprocess(spectrum);
+    if (!features){
+        return false;
+    }
+    m_spectrums.emplace_front(spectrum.stamp, spectrum.sample_rate, std::move(features));
     return true;
 }
 
@@ -252,61 +266,23 @@ bool SpectrogramMatcher::update_to_new_spectrums(const std::vector<AudioSpectrum
     // pop out too old spectrums
     while (m_spectrums.size() > m_numSpectrumsNeeded){
         m_spectrums.pop_back();
-        m_spectrumNormSqrs.pop_back();
     }
 
     return true;
 }
 
-std::pair<float, float> SpectrogramMatcher::match_sub_template(size_t sub_index) const{
-#if 0
-    auto iter = m_spectrums.begin();
-    auto iter2 = m_spectrumNormSqrs.begin();
-    float streamSumSqr = 0.0f;
-    float sumMulti = 0.0f;
-
-    const size_t template_start = m_templateRange[sub_index].first;
-    const size_t template_end = m_templateRange[sub_index].second;
-    for(size_t i = template_start; i < template_end; i++, iter++, iter2++){
-        // match in order from latest window to oldest
-        const float* templateData = m_template.getWindow(template_end-1-i);
-        const float* streamData = iter->magnitudes->data();
-        streamSumSqr += *iter2;
-        for(size_t j = m_freqStart; j < m_freqEnd; j++){
-            sumMulti += templateData[j] * streamData[j];
-        }
-    }
-//    cout << "sumMulti = " << sumMulti << ", streamSumSqr = " << streamSumSqr << endl;
-    const float scale = (streamSumSqr < 1e-6f ? 1.0f : sumMulti / streamSumSqr);
-
-    iter = m_spectrums.begin();
-    float sum = 0.0f;
-    for(size_t i = template_start; i < template_end; i++, iter++){
-        // match in order from latest window to oldest
-        const float* templateData = m_template.getWindow(template_end-1-i);
-        const float* streamData = iter->magnitudes->data();
-        for(size_t j = m_freqStart; j < m_freqEnd; j++){
-            float d = templateData[j] - scale * streamData[j];
-            sum += d * d;
-        }
-    }
-#else
+std::pair<float, float> SpectrogramMatcher::match_sub_template(size_t sub_index, const float* const* features) const{
     //  Build matrix.
-    auto iter = m_spectrums.begin();
     const size_t template_start = m_templateRange[sub_index].first;
     const size_t template_end = m_templateRange[sub_index].second;
     size_t windows = template_end - template_start;
 //    cout << windows << endl;
-//    cout << m_spectrums.size() << " / " << windows << endl;
     size_t freqs = m_freqEnd - m_freqStart;
     std::vector<const float*> matrixA(windows);
     std::vector<const float*> matrixT(windows);
-    for (size_t i = 0; i < windows; i++, iter++){
-//        cout << "Template: " << ((size_t)m_template.getWindow(template_end - 1 - i) % 64) << endl;
-//        cout << "Samples:  " << ((size_t)iter->magnitudes->data() % 64) << endl;
+    for (size_t i = 0; i < windows; i++){
         matrixT[i] = m_freqStart + m_template.getWindow(windows - 1 - i);
-        matrixA[i] = m_freqStart + iter->magnitudes->data();
-//        cout << matrixT[i] << " : " << matrixA[i] << endl;
+        matrixA[i] = m_freqStart + features[i];
     }
 
     //  Compute scale.
@@ -322,8 +298,6 @@ std::pair<float, float> SpectrogramMatcher::match_sub_template(size_t sub_index)
         scale,
         matrixA.data(), matrixT.data()
     );
-#endif
-
 
     float score = sqrt(sum) / m_templateNorm[0];
 //    cout << "score = " << score << endl;
@@ -332,6 +306,26 @@ std::pair<float, float> SpectrogramMatcher::match_sub_template(size_t sub_index)
     return std::make_pair(score, scale);
 }
 
+std::pair<float, float> SpectrogramMatcher::match_features(const float* const* features) const{
+    float score = FLT_MAX; // the lower the score, the better the match
+    float scale = 0.0f;
+    if (m_templateRange.size() == 1){
+        // Match the full template
+        return match_sub_template(0, features);
+    }
+    // Match each individual sub-template
+    for (size_t sub_template = 0; sub_template < m_templateRange.size(); sub_template++){
+        float sub_template_score = FLT_MAX;
+        float sub_template_scale = 1.0f;
+        std::tie(sub_template_score, sub_template_scale) = match_sub_template(sub_template, features);
+        if (sub_template_score < score){
+            score = sub_template_score;
+            scale = sub_template_scale;
+        }
+    }
+    return {score, scale};
+}
+
 float SpectrogramMatcher::match(const std::vector<AudioSpectrum>& new_spectrums){
     if (!update_to_new_spectrums(new_spectrums)){
         return FLT_MAX;
@@ -363,23 +357,13 @@ float SpectrogramMatcher::match(const std::vector<AudioSpectrum>& new_spectrums)
     m_lastStampTested = curStamp;
     
     // Do the match:
-    float score = FLT_MAX; // the lower the score, the better the match
-    if (m_templateRange.size() == 1){
-        // Match the full template
-        std::tie(score, m_lastScale) = match_sub_template(0);
-    }else{
-        // Match each individual sub-template
-        for (size_t sub_template = 0; sub_template < m_templateRange.size(); sub_template++){
-            float sub_template_score = FLT_MAX;
-            float sub_template_scale = 1.0f;
-            std::tie(sub_template_score, sub_template_scale) = match_sub_template(sub_template);
-            if (sub_template_score < score){
-                score = sub_template_score;
-                m_lastScale = sub_template_scale;
-            }
-        }
+    std::vector<const float*> features;
+    features.reserve(m_numSpectrumsNeeded);
+    for (const AudioSpectrum& spectrum : m_spectrums){
+        features.emplace_back(spectrum.magnitudes->data());
     }
-
+    float score;
+    std::tie(score, m_lastScale) = match_features(features.data());
     return score;
 }
 
@@ -394,7 +378,6 @@ bool SpectrogramMatcher::skip(const std::vector<AudioSpectrum>& new_spectrums){
 
 void SpectrogramMatcher::clear(){
     m_spectrums.clear();
-    m_spectrumNormSqrs.clear();
     m_lastStampTested = SIZE_MAX;
 }
 
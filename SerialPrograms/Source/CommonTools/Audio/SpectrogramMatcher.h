@@ -12,6 +12,8 @@
 #include <memory>
 #include <vector>
 #include <list>
+#include <tuple>
+#include "Common/Cpp/Containers/AlignedVector.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
 #include "CommonFramework/AudioPipeline/AudioTemplate.h"
 
@@ -49,6 +51,39 @@ public:
 
     size_t sample_rate() const{ return m_sample_rate; }
 
+    //  Everything that determines how an incoming spectrum is preprocessed
+    //  before it is matched. Matchers with the same key produce identical
+    //  preprocessed spectrums and can share them. (See AudioMatchingEngine.)
+    struct FeatureKey{
+        Mode mode;
+        size_t sample_rate;
+        size_t num_frequencies;
+        size_t freq_start;
+        size_t freq_end;
+
+        bool operator<(const FeatureKey& x) const{
+            return std::tie(mode, sample_rate, num_frequencies, freq_start, freq_end)
+                < std::tie(x.mode, x.sample_rate, x.num_frequencies, x.freq_start, x.freq_end);
+        }
+    };
+    FeatureKey feature_key() const{
+        return {m_mode, m_sample_rate, m_numOriginalFrequencies, m_originalFreqStart, m_originalFreqEnd};
+    }
+
+    //  The part of the full spectrum that this matcher reads. Register it with
+    //  AudioFeed::add_spectrum_band() so that the feed publishes it compactly.
+    const SpectrumBand& spectrum_band() const{ return m_band; }
+
+    //  Run the per-spectrum preprocessing (filtering + frequency cropping).
+    //  Uses the published copy of spectrum_band() if the spectrum has one.
+    //  Return nullptr if the spectrum doesn't fit this matcher.
+    std::shared_ptr<const AlignedVector<float>> preprocess(const AudioSpectrum& spectrum) const;
+
+    //  Match the template against preprocessed spectrums.
+    //  "features" must have at least numMatchedWindows() entries, newest first.
+    //  Return the match score and the scale.
+    std::pair<float, float> match_features(const float* const* features) const;
+
     // Match the newest spectrums and return a match score.
     // Newer (larger timestamp) spectrums at beginning of `new_spectrums` while older (smaller
     // timestamp) spectrums at the end.
@@ -78,17 +113,17 @@ public:
     float lastMatchedScale() const { return m_lastScale; }
 
 private:
-    void conv(const float* src, size_t num, float* dst);
+    void conv(const float* src, size_t num, float* dst) const;
     
     // The function to build `m_templateNorm`
     std::vector<float> buildTemplateNorm() const;
 
     // For a given sub-template, return its match score and scaling factor
-    std::pair<float, float> match_sub_template(size_t sub_index) const;
+    std::pair<float, float> match_sub_template(size_t sub_index, const float* const* features) const;
 
     // Update internal data for the next new spectrum. Called by `update_to_new_spectrums()`.
     // Return true if there is no error.
-    bool update_to_new_spectrum(AudioSpectrum newSpectrum);
+    bool update_to_new_spectrum(const AudioSpectrum& newSpectrum);
 
     // Update internal data for the new specttrums.
     // Return true if there is no error.
@@ -105,6 +140,7 @@ private:
     size_t m_numOriginalFrequencies = 0;
     size_t m_originalFreqStart = 0;
     size_t m_originalFreqEnd = 0;
+    SpectrumBand m_band;
 
     size_t m_freqStart = 0;
     size_t m_freqEnd = 0;
@@ -118,10 +154,8 @@ private:
 
     std::vector<float> m_convKernel;
 
-    // Spectrums from audio feed. They will be matched against the template.
+    // Preprocessed spectrums from audio feed. They will be matched against the template.
     std::list<AudioSpectrum> m_spectrums;
-    // Norm squares of each spectrum in `m_spectrums`.
-    std::list<float> m_spectrumNormSqrs;
     // How many spectrums needed to store.
     size_t m_numSpectrumsNeeded = 0;
 
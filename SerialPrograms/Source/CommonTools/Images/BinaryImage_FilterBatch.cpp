@@ -0,0 +1,108 @@
+/*  Binary Image Filter Batch
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include "Common/Cpp/Containers/FixedLimitVector.tpp"
+#include "Common/Cpp/Concurrency/ComputationThreadPool.h"
+#include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
+#include "BinaryImage_FilterBatch.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+size_t BinaryFilterBatch::add(
+    const ImageFloatBox& box,
+    std::vector<std::pair<uint32_t, uint32_t>> filters
+){
+    Box& entry = m_boxes.emplace_back();
+    entry.box = box;
+    entry.filters = std::move(filters);
+    return m_boxes.size() - 1;
+}
+
+void BinaryFilterBatch::run(const ImageViewRGB32& image){
+    size_t pixels = 0;
+    for (size_t c = 0; c < m_boxes.size(); c++){
+        Box& entry = m_boxes[c];
+        entry.region = extract_box_reference(image, entry.box);
+        pixels += entry.region.width() * entry.region.height() * entry.filters.size();
+        prepare_box(c);
+    }
+
+    if (pixels < PARALLEL_MIN_PIXELS){
+        for (size_t c = 0; c < m_boxes.size(); c++){
+            run_rows(c, 0, m_boxes[c].region.height());
+        }
+        return;
+    }
+
+    //  Split each box into strips of rows of about TASK_PIXELS each.
+    m_tasks.clear();
+    for (size_t c = 0; c < m_boxes.size(); c++){
+        const Box& entry = m_boxes[c];
+        size_t height = entry.region.height();
+        size_t row_pixels = entry.region.width() * entry.filters.size();
+        if (height == 0 || row_pixels == 0){
+            continue;
+        }
+        size_t rows = (TASK_PIXELS + row_pixels - 1) / row_pixels;
+        rows = (rows + STRIP_ROW_ALIGNMENT - 1) / STRIP_ROW_ALIGNMENT * STRIP_ROW_ALIGNMENT;
+        for (size_t row = 0; row < height; row += rows){
+            m_tasks.emplace_back(Task{c, row, std::min(row + rows, height)});
+        }
+    }
+
+    GlobalThreadPools::realtime_inference().run_in_parallel(
+        [this](size_t index){
+            const Task& task = m_tasks[index];
+            run_rows(task.box, task.row_begin, task.row_end);
+        },
+        0, m_tasks.size()
+    );
+}
+
+void BinaryFilterBatch::prepare_box(size_t index){
+    Box& entry = m_boxes[index];
+    const ImageViewRGB32& region = entry.region;
+    size_t width = region.width();
+    size_t height = region.height();
+
+    //  Reuse the masks from the last run if the box is still the same size.
+    entry.masks.resize(entry.filters.size());
+    for (PackedBinaryMatrix& mask : entry.masks){
+        if (mask.width() != width || mask.height() != height){
+            mask = PackedBinaryMatrix(width, height);
+        }
+    }
+}
+void BinaryFilterBatch::run_rows(size_t index, size_t row_begin, size_t row_end){
+    Box& entry = m_boxes[index];
+    const ImageViewRGB32& region = entry.region;
+    if (entry.filters.empty() || region.width() == 0 || row_begin >= row_end){
+        return;
+    }
+
+    //  All filters of the box in one pass over its pixels.
+    FixedLimitVector<Kernels::CompressRgb32ToBinaryRangeFilter> filters(entry.filters.size());
+    for (size_t c = 0; c < entry.filters.size(); c++){
+        filters.emplace_back(entry.masks[c], entry.filters[c].first, entry.filters[c].second);
+    }
+    Kernels::compress_rgb32_to_binary_range(
+        region.data(), region.bytes_per_row(),
+        filters.data(), filters.size(),
+        row_begin, row_end
+    );
+}
+
+
+
+}
@@ -0,0 +1,94 @@
+/*  Binary Image Filter Batch
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Filter several boxes of the same image into binary masks in one call.
+ *
+ *  Set up the boxes and their filter ranges once, then call "run()" on each
+ *  frame. The masks are kept between runs and are only reallocated when a
+ *  box changes size, so a detector that keeps one of these around does not
+ *  allocate per frame. If the boxes are large enough in total, they are
+ *  filtered in parallel on the realtime inference pool. Large boxes are split
+ *  into strips of rows so that a single large box is also filtered in
+ *  parallel.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_BinaryImage_FilterBatch_H
+#define PokemonAutomation_CommonTools_BinaryImage_FilterBatch_H
+
+#include <stdint.h>
+#include <vector>
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTypes/BinaryImage.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+
+namespace PokemonAutomation{
+
+
+class BinaryFilterBatch{
+public:
+    //  Below this many pixels (summed over every box and filter) the boxes
+    //  are filtered on the calling thread.
+    static constexpr size_t PARALLEL_MIN_PIXELS = 256 * 1024;
+
+    //  Target size of each parallel task in pixels (times filters). Strips
+    //  are a multiple of 64 rows so that no two tasks write to the same
+    //  matrix tile.
+    static constexpr size_t TASK_PIXELS = 64 * 1024;
+    static constexpr size_t STRIP_ROW_ALIGNMENT = 64;
+
+public:
+    //  Add a box and the [min, max] ranges to filter it with.
+    //  Returns the index of the box.
+    size_t add(
+        const ImageFloatBox& box,
+        std::vector<std::pair<uint32_t, uint32_t>> filters
+    );
+
+    size_t size() const{ return m_boxes.size(); }
+
+    //  Filter every box of "image". "image" must outlive any use of
+    //  "region()" afterwards.
+    void run(const ImageViewRGB32& image);
+
+    //  The part of the image that box "index" covered in the last run.
+    const ImageViewRGB32& region(size_t index) const{
+        return m_boxes[index].region;
+    }
+
+    //  The mask of filter "filter" of box "index" from the last run.
+    //  These are overwritten by the next run.
+    const PackedBinaryMatrix& mask(size_t index, size_t filter) const{
+        return m_boxes[index].masks[filter];
+    }
+    PackedBinaryMatrix& mask(size_t index, size_t filter){
+        return m_boxes[index].masks[filter];
+    }
+
+
+private:
+    void prepare_box(size_t index);
+    void run_rows(size_t index, size_t row_begin, size_t row_end);
+
+private:
+    struct Box{
+        ImageFloatBox box;
+        std::vector<std::pair<uint32_t, uint32_t>> filters;
+        ImageViewRGB32 region;
+        std::vector<PackedBinaryMatrix> masks;
+    };
+    std::vector<Box> m_boxes;
+
+    struct Task{
+        size_t box;
+        size_t row_begin;
+        size_t row_end;
+    };
+    std::vector<Task> m_tasks;
+};
+
+
+
+}
+#endif
@@ -8,7 +8,9 @@
 #define PokemonAutomation_CommonTools_VisualInferenceCallback_H
 
 #include <string>
+#include <vector>
 #include "Common/Cpp/Time.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "InferenceCallback.h"
 
 namespace PokemonAutomation{
@@ -37,6 +39,35 @@ public:
     //  You must override at least one of the overloaded `process_frame()`.
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp);
 
+    //  Regions that "skip_unchanged_frames()" watches. Empty if not opted in.
+    const std::vector<ImageFloatBox>& change_boxes() const{ return m_change_boxes; }
+
+    //  Called instead of `process_frame()` on frames where nothing under
+    //  `change_boxes()` has changed since the last frame this callback saw.
+    //  A true result would have ended the session, so the previous result is
+    //  always false and that's what the default returns.
+    virtual bool process_unchanged_frame([[maybe_unused]] const VideoSnapshot& frame){ return false; }
+
+protected:
+    //  Opt into skipping frames where nothing under "boxes" has changed.
+    //  This only takes effect with "Skip Unchanged Regions" enabled.
+    //
+    //  Only do this if `process_frame()` returns false again when it gets the
+    //  same pixels. Callbacks that depend on the passage of time should
+    //  override `process_unchanged_frame()`.
+    //
+    //  Changes are only measured against the previous frame, so a slow drift
+    //  can go unnoticed until the next full run (at most a second later).
+    //  Callbacks that compare against an older reference frame
+    //  (e.g. FrozenImageDetector) should not opt in.
+    //
+    //  DetectorToFinder supports this. See GradientArrowWatcher for an example.
+    void skip_unchanged_frames(std::vector<ImageFloatBox> boxes){
+        m_change_boxes = std::move(boxes);
+    }
+
+private:
+    std::vector<ImageFloatBox> m_change_boxes;
 };
 
 
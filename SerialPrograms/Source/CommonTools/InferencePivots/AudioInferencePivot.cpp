@@ -24,6 +24,9 @@ struct AudioInferencePivot::PeriodicCallback{
 
     uint64_t last_seqnum = ~(uint64_t)0;
 
+    //  Reused across runs so polling doesn't allocate.
+    std::vector<AudioSpectrum> spectrums;
+
     StatAccumulatorI32 stats;
 
     PeriodicCallback(
@@ -87,16 +90,16 @@ StatAccumulatorI32 AudioInferencePivot::remove_callback(AudioInferenceCallback&
 void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
     try{
-        std::vector<AudioSpectrum> spectrums;
+        std::vector<AudioSpectrum>& spectrums = callback.spectrums;
 
         if (callback.last_seqnum == ~(uint64_t)0){
 //            cout << "m_last_timestamp == SIZE_MAX" << endl;
-            spectrums = m_feed.spectrums_latest(1);
+            m_feed.read_spectrums_latest(1, spectrums);
         }else{
 //            cout << "(m_last_timestamp != SIZE_MAX" << endl;
             //  Note: in this file we never consider the case that stamp may overflow.
             //  It requires on the order of 1e10 years to overflow if we have about 25ms per stamp.
-            spectrums = m_feed.spectrums_since(callback.last_seqnum + 1);
+            m_feed.read_spectrums_since(callback.last_seqnum + 1, spectrums);
         }
         if (spectrums.size() > 0){
             //  spectrums[0] has the newest spectrum with the largest stamp:
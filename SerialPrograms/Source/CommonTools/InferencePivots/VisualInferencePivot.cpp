@@ -5,6 +5,8 @@
  */
 
 #include "Common/Cpp/Exceptions.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/VideoPipeline/VideoPipelineOptions.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "VisualInferencePivot.h"
 
@@ -15,6 +17,23 @@
 namespace PokemonAutomation{
 
 
+//  Adaptive mode: Slow down expensive callbacks while the pivot thread is
+//  busier than this. Speed them back up once it drops below half of it.
+const double ADAPTIVE_UTILIZATION_BUDGET = 0.80;
+
+//  Adaptive mode: A callback is expensive if a run takes at least this
+//  fraction of its period.
+const double ADAPTIVE_EXPENSIVE_FRACTION = 0.25;
+
+const double ADAPTIVE_BACKOFF_STEP = 1.5;
+const double ADAPTIVE_MAX_BACKOFF = 8.0;
+
+//  Skip mode: Run the full callback at least this often anyway. The change map
+//  only compares consecutive frames, so this bounds how long a slow drift can
+//  go unnoticed.
+const WallDuration UNCHANGED_MAX_SKIP = std::chrono::seconds(1);
+
+
 
 struct VisualInferencePivot::PeriodicCallback{
     Cancellable& scope;
@@ -24,17 +43,37 @@ struct VisualInferencePivot::PeriodicCallback{
     StatAccumulatorI32 stats;
     WallClock last_timestamp;
 
+    //  Adaptive mode.
+    bool adaptive;
+    uint64_t frames_seen;       //  "m_frames_arrived" when it last looked for a frame.
+    WallClock next_allowed;     //  Don't run again before this.
+    double average_cost;        //  Microseconds
+    double backoff;             //  Multiplier on "period".
+
+    //  The frame at "last_timestamp" went through "m_change_map".
+    bool last_frame_mapped;
+    //  Timestamp of the last frame given to "process_frame()".
+    WallClock last_full_run;
+
     PeriodicCallback(
         Cancellable& p_scope,
         std::atomic<InferenceCallback*>* p_set_when_triggered,
         VisualInferenceCallback& p_callback,
-        std::chrono::milliseconds p_period
+        std::chrono::milliseconds p_period,
+        bool p_adaptive
     )
         : scope(p_scope)
         , set_when_triggered(p_set_when_triggered)
         , callback(p_callback)
         , period(p_period)
         , last_timestamp(WallClock::min())
+        , adaptive(p_adaptive)
+        , frames_seen(0)
+        , next_allowed(WallClock::min())
+        , average_cost(0)
+        , backoff(1.0)
+        , last_frame_mapped(false)
+        , last_full_run(WallClock::min())
     {}
 };
 
@@ -43,10 +82,17 @@ struct VisualInferencePivot::PeriodicCallback{
 VisualInferencePivot::VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher)
     : PeriodicRunner(dispatcher)
     , m_feed(feed)
+    , m_frames_arrived(0)
+    , m_last_frames(0)
+    , m_last_processed(WallClock::min())
+    , m_adaptive_callbacks(0)
+    , m_change_map(GlobalSettings::instance().VIDEO_PIPELINE->UNCHANGED_REGION_THRESHOLD)
 {
     attach(scope);
+    m_feed.add_frame_listener(*this);
 }
 VisualInferencePivot::~VisualInferencePivot(){
+    m_feed.remove_frame_listener(*this);
     detach();
     stop_thread();
 }
@@ -56,6 +102,8 @@ void VisualInferencePivot::add_callback(
     VisualInferenceCallback& callback,
     std::chrono::milliseconds period
 ){
+    bool adaptive = GlobalSettings::instance().VIDEO_PIPELINE->ADAPTIVE_INFERENCE_PERIODS;
+
     WriteSpinLock lg(m_lock);
     auto iter = m_map.find(&callback);
     if (iter != m_map.end()){
@@ -64,7 +112,7 @@ void VisualInferencePivot::add_callback(
     iter = m_map.emplace(
         std::piecewise_construct,
         std::forward_as_tuple(&callback),
-        std::forward_as_tuple(scope, set_when_triggered, callback, period)
+        std::forward_as_tuple(scope, set_when_triggered, callback, period, adaptive)
     ).first;
     try{
         PeriodicRunner::add_event(&iter->second, period);
@@ -72,6 +120,9 @@ void VisualInferencePivot::add_callback(
         m_map.erase(iter);
         throw;
     }
+    if (adaptive){
+        m_adaptive_callbacks++;
+    }
 }
 StatAccumulatorI32 VisualInferencePivot::remove_callback(VisualInferenceCallback& callback){
     WriteSpinLock lg(m_lock);
@@ -81,51 +132,163 @@ StatAccumulatorI32 VisualInferencePivot::remove_callback(VisualInferenceCallback
     }
     StatAccumulatorI32 stats = iter->second.stats;
     PeriodicRunner::remove_event(&iter->second);
+    if (iter->second.adaptive){
+        m_adaptive_callbacks--;
+    }
     m_map.erase(iter);
     return stats;
 }
+void VisualInferencePivot::on_frame(std::shared_ptr<const VideoFrame> frame){
+    //  This runs on the video thread. Don't do anything that can block.
+    m_frames_arrived.fetch_add(1, std::memory_order_release);
+    if (m_adaptive_callbacks.load(std::memory_order_relaxed) != 0){
+        release_parked_events();
+    }
+}
 void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
     try{
-        //  Reuse the cached screenshot.
-        if (!is_back_to_back || callback.last_timestamp == m_last.timestamp){
-//            cout << "back-to-back" << endl;
-//            m_last = m_feed.snapshot();
-
-            WallClock min_time = callback.last_timestamp;
-            if (min_time == WallClock::min()){
-                min_time = current_time() - 2 * callback.period;
-            }
-
-            //  TODO: Destructing "m_last" is really slow so this is not the
-            //  best place to do it.
-//            WallClock start = current_time();
-//            cout << "m_feed.snapshot_recent_nonblocking() - start" << endl;
-            m_last = m_feed.snapshot_recent_nonblocking(min_time);  //  Implied destruction.
-//            WallClock end = current_time();
-//            cout << "m_feed.snapshot_recent_nonblocking() - end" << std::chrono::duration_cast<Milliseconds>(end - start).count() << endl;
+        //  Until the feed has reported a frame, we don't know if it ever will.
+        uint64_t frames = m_frames_arrived.load(std::memory_order_acquire);
+        if (callback.adaptive && frames != 0){
+            run_adaptive(callback, frames);
+        }else{
+            run_fixed(callback, is_back_to_back);
+        }
+    }catch (...){
+        callback.scope.cancel(std::current_exception());
+    }
+}
+void VisualInferencePivot::run_fixed(PeriodicCallback& callback, bool is_back_to_back){
+    //  Reuse the cached screenshot.
+    if (!is_back_to_back || callback.last_timestamp == m_last.timestamp){
+//        cout << "back-to-back" << endl;
+//        m_last = m_feed.snapshot();
+
+        WallClock min_time = callback.last_timestamp;
+        if (min_time == WallClock::min()){
+            min_time = current_time() - 2 * callback.period;
+        }
+
+        //  TODO: Destructing "m_last" is really slow so this is not the
+        //  best place to do it.
+//        WallClock start = current_time();
+//        cout << "m_feed.snapshot_recent_nonblocking() - start" << endl;
+        m_last = m_feed.snapshot_recent_nonblocking(min_time);  //  Implied destruction.
+//        WallClock end = current_time();
+//        cout << "m_feed.snapshot_recent_nonblocking() - end" << std::chrono::duration_cast<Milliseconds>(end - start).count() << endl;
+
+        //  Not necessarily the newest frame.
+        m_last_frames = 0;
+    }
+
+    if (!m_last){
+        return;
+    }
+
+    process(callback);
+}
+void VisualInferencePivot::run_adaptive(PeriodicCallback& callback, uint64_t frames){
+    WallClock now = current_time();
+    WallDuration interval = std::chrono::duration_cast<WallDuration>(callback.period * callback.backoff);
+
+    //  No new frame since the last look. Sleep until the next one arrives.
+    //  The deadline is only a safety net in case a notification is lost.
+    if (callback.frames_seen == frames){
+        park_event(&callback, callback.next_allowed, now + interval);
+        return;
+    }
+    callback.frames_seen = frames;
+
+    //  Another callback may have already grabbed this frame.
+    if (m_last_frames != frames){
+        m_last = m_feed.snapshot_latest_blocking();
+        m_last_frames = frames;
+    }
+
+    //  Never process the same frame twice.
+    if (!m_last || m_last.timestamp <= callback.last_timestamp){
+        park_event(&callback, callback.next_allowed, now + interval);
+        return;
+    }
+
+    process(callback);
+
+    //  Back off expensive callbacks while the pivot is overloaded.
+    double utilization = current_utilization();
+    double period_us = (double)std::chrono::duration_cast<std::chrono::microseconds>(callback.period).count();
+    if (utilization > ADAPTIVE_UTILIZATION_BUDGET){
+        if (callback.average_cost >= ADAPTIVE_EXPENSIVE_FRACTION * period_us){
+            callback.backoff = std::min(callback.backoff * ADAPTIVE_BACKOFF_STEP, ADAPTIVE_MAX_BACKOFF);
         }
+    }else if (utilization < 0.5 * ADAPTIVE_UTILIZATION_BUDGET){
+        callback.backoff = std::max(callback.backoff / ADAPTIVE_BACKOFF_STEP, 1.0);
+    }
+
+    //  Run on the next frame, but no earlier than one (backed off) period
+    //  after this run started.
+    interval = std::chrono::duration_cast<WallDuration>(callback.period * callback.backoff);
+    callback.next_allowed = now + interval;
+    park_event(&callback, callback.next_allowed, callback.next_allowed + interval);
+}
+void VisualInferencePivot::process(PeriodicCallback& callback){
+    WallClock time0 = current_time();
+    bool stop;
+    if (unchanged_since_last_run(callback)){
+        stop = callback.callback.process_unchanged_frame(m_last);
+    }else{
+        stop = callback.callback.process_frame(m_last);
+        callback.last_full_run = m_last.timestamp;
+    }
+    WallClock time1 = current_time();
+    uint32_t microseconds = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+    callback.stats += microseconds;
+    callback.average_cost += (microseconds - callback.average_cost) * 0.125;
+    callback.last_timestamp = m_last.timestamp;
 
-        if (!m_last){
-            return;
+    //  Only the first callback to finish a frame counts for its latency.
+    if (m_last.timestamp > m_last_processed){
+        m_last_processed = m_last.timestamp;
+        m_feed.report_frame_processed(m_last.timestamp);
+    }
+
+    if (stop){
+        if (callback.set_when_triggered){
+            InferenceCallback* expected = nullptr;
+            callback.set_when_triggered->compare_exchange_strong(expected, &callback.callback);
         }
+        callback.scope.cancel(nullptr);
+    }
+}
+bool VisualInferencePivot::unchanged_since_last_run(PeriodicCallback& callback){
+    const std::vector<ImageFloatBox>& boxes = callback.callback.change_boxes();
+    const VideoPipelineOptions& options = *GlobalSettings::instance().VIDEO_PIPELINE;
+    if (boxes.empty() || !options.SKIP_UNCHANGED_REGIONS){
+        callback.last_frame_mapped = false;
+        return false;
+    }
+
+    //  Only frames newer than the last one in the map can be compared to it.
+    if (m_last.timestamp > m_change_map.timestamp()){
+        m_change_map.set_threshold(options.UNCHANGED_REGION_THRESHOLD);
+        m_change_map.update(m_last.frame, m_last.timestamp);
+    }
+
+    bool previous_mapped = callback.last_frame_mapped;
+    callback.last_frame_mapped = m_last.timestamp == m_change_map.timestamp();
+    if (!previous_mapped || !callback.last_frame_mapped){
+        return false;
+    }
+    if (m_last.timestamp - callback.last_full_run >= UNCHANGED_MAX_SKIP){
+        return false;
+    }
 
-        WallClock time0 = current_time();
-        bool stop = callback.callback.process_frame(m_last);
-        WallClock time1 = current_time();
-        callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
-        callback.last_timestamp = m_last.timestamp;
-
-        if (stop){
-            if (callback.set_when_triggered){
-                InferenceCallback* expected = nullptr;
-                callback.set_when_triggered->compare_exchange_strong(expected, &callback.callback);
-            }
-            callback.scope.cancel(nullptr);
+    for (const ImageFloatBox& box : boxes){
+        if (m_change_map.last_change(box) > callback.last_timestamp){
+            return false;
         }
-    }catch (...){
-        callback.scope.cancel(std::current_exception());
     }
+    return true;
 }
 
 
@@ -9,6 +9,7 @@
 
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "Common/Cpp/Concurrency/PeriodicScheduler.h"
+#include "CommonFramework/ImageTools/TileChangeMap.h"
 #include "CommonFramework/Tools/StatAccumulator.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayTypes.h"
@@ -20,7 +21,22 @@ class VideoFeed;
 
 
 
-class VisualInferencePivot final : public PeriodicRunner, public OverlayStat{
+//
+//  With "Adaptive Inference Periods" enabled, callbacks are woken up by new
+//  frames instead of running on a fixed timer. The period of the callback
+//  becomes the minimum time between two runs, a callback never sees the same
+//  frame twice, and expensive callbacks are slowed down when the pivot thread
+//  is busier than its utilization budget.
+//
+//  Video sources that don't report new frames fall back to the fixed timer.
+//
+//  With "Skip Unchanged Regions" enabled, callbacks that watch specific boxes
+//  (see VisualInferenceCallback::skip_unchanged_frames()) only run if a tile
+//  under their boxes has changed since the last frame they saw. The change map
+//  is updated at most once per new frame and only while such a callback runs.
+//  They still run at least once a second to catch slow drifts.
+//
+class VisualInferencePivot final : public PeriodicRunner, public OverlayStat, private VideoFrameListener{
 public:
     VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher);
     virtual ~VisualInferencePivot();
@@ -40,17 +56,33 @@ public:
     StatAccumulatorI32 remove_callback(VisualInferenceCallback& callback);
 
 private:
+    struct PeriodicCallback;
+
     virtual void run(void* event, bool is_back_to_back) noexcept override;
     virtual OverlayStatSnapshot get_current() override;
+    virtual void on_frame(std::shared_ptr<const VideoFrame> frame) override;
 
-private:
-    struct PeriodicCallback;
+    void run_fixed(PeriodicCallback& callback, bool is_back_to_back);
+    void run_adaptive(PeriodicCallback& callback, uint64_t frames);
+    void process(PeriodicCallback& callback);
+    bool unchanged_since_last_run(PeriodicCallback& callback);
 
+private:
     VideoFeed& m_feed;
     SpinLock m_lock;
     std::map<VisualInferenceCallback*, PeriodicCallback> m_map;
     VideoSnapshot m_last;
 
+    //  Number of new frames reported by the feed.
+    std::atomic<uint64_t> m_frames_arrived;
+    //  "m_frames_arrived" at the time "m_last" was taken.
+    uint64_t m_last_frames;
+    //  Capture time of the newest frame reported to the feed as processed.
+    WallClock m_last_processed;
+    std::atomic<size_t> m_adaptive_callbacks;
+
+    TileChangeMap m_change_map;
+
     OverlayStatUtilizationPrinter m_printer;
 };
 
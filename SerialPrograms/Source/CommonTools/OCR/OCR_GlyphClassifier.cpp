@@ -0,0 +1,181 @@
+/*  OCR Glyph Classifier
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <cmath>
+#include <filesystem>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "CommonFramework/Globals.h"
+#include "OCR_GlyphClassifier.h"
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+//  Aspect ratio separates glyphs like "1" and "I" from the rest. Weigh it
+//  like a few grid cells.
+const double ASPECT_RATIO_WEIGHT = 8.0;
+
+//  New templates closer than this to one of the same glyph add nothing.
+const double DUPLICATE_DISTANCE = 0.25;
+
+
+
+GlyphClassifier::Template::Template(char p_glyph, const PackedBinaryMatrix& matrix)
+    : glyph(p_glyph)
+    , coverage{}
+{
+    size_t width = matrix.width();
+    size_t height = matrix.height();
+    log_aspect_ratio = std::log((double)std::max<size_t>(width, 1) / std::max<size_t>(height, 1));
+
+    std::array<uint32_t, GRID_WIDTH * GRID_HEIGHT> set{};
+    std::array<uint32_t, GRID_WIDTH * GRID_HEIGHT> total{};
+    for (size_t r = 0; r < height; r++){
+        size_t cell_r = r * GRID_HEIGHT / height;
+        for (size_t c = 0; c < width; c++){
+            size_t cell = cell_r * GRID_WIDTH + c * GRID_WIDTH / width;
+            set[cell] += matrix.get(c, r);
+            total[cell]++;
+        }
+    }
+
+    //  Glyphs smaller than the grid leave some cells empty. Fill them from
+    //  the pixel that would have landed there.
+    for (size_t r = 0; r < GRID_HEIGHT; r++){
+        for (size_t c = 0; c < GRID_WIDTH; c++){
+            size_t cell = r * GRID_WIDTH + c;
+            if (total[cell] != 0){
+                coverage[cell] = (float)set[cell] / total[cell];
+            }else if (width != 0 && height != 0){
+                coverage[cell] = matrix.get(c * width / GRID_WIDTH, r * height / GRID_HEIGHT) ? 1.0f : 0.0f;
+            }
+        }
+    }
+}
+double GlyphClassifier::Template::distance(const Template& x) const{
+    double sum = 0;
+    for (size_t c = 0; c < coverage.size(); c++){
+        double diff = coverage[c] - x.coverage[c];
+        sum += diff * diff;
+    }
+    double aspect = log_aspect_ratio - x.log_aspect_ratio;
+    return sum + ASPECT_RATIO_WEIGHT * aspect * aspect;
+}
+
+
+
+GlyphClassifier::GlyphClassifier(const std::string& json_path){
+    std::string path = RESOURCE_PATH() + json_path;
+    if (!std::filesystem::exists(path)){
+        return;
+    }
+
+    JsonValue json = load_json_file(path);
+    const JsonObject& root = json.to_object_throw(path);
+    if ((size_t)root.get_integer_throw("GridWidth", path) != GRID_WIDTH ||
+        (size_t)root.get_integer_throw("GridHeight", path) != GRID_HEIGHT
+    ){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Glyph templates have the wrong grid size.", path);
+    }
+
+    for (const JsonValue& item : root.get_array_throw("Templates", path)){
+        const JsonObject& obj = item.to_object_throw(path);
+        const std::string& glyph = obj.get_string_throw("Glyph", path);
+        if (glyph.size() != 1){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Glyph must be a single character: " + glyph, path);
+        }
+
+        Template entry(glyph[0], obj.get_double_throw("LogAspectRatio", path));
+        const JsonArray& coverage = obj.get_array_throw("Coverage", path);
+        if (coverage.size() != entry.coverage.size()){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Glyph template has the wrong number of cells: " + glyph, path);
+        }
+        for (size_t c = 0; c < coverage.size(); c++){
+            entry.coverage[c] = (float)(coverage[c].to_integer_throw(path) / 255.);
+        }
+        m_templates.emplace_back(std::move(entry));
+    }
+}
+void GlyphClassifier::save(const std::string& json_path) const{
+    JsonArray templates;
+    for (const Template& entry : m_templates){
+        JsonArray coverage;
+        for (float x : entry.coverage){
+            coverage.push_back((int64_t)std::lround(x * 255));
+        }
+        JsonObject obj;
+        obj["Glyph"] = std::string(1, entry.glyph);
+        obj["LogAspectRatio"] = entry.log_aspect_ratio;
+        obj["Coverage"] = std::move(coverage);
+        templates.push_back(std::move(obj));
+    }
+
+    JsonObject root;
+    root["GridWidth"] = (int64_t)GRID_WIDTH;
+    root["GridHeight"] = (int64_t)GRID_HEIGHT;
+    root["Templates"] = std::move(templates);
+    root.dump(json_path);
+}
+
+
+bool GlyphClassifier::add_template(char glyph, const PackedBinaryMatrix& matrix){
+    Template entry(glyph, matrix);
+    for (const Template& existing : m_templates){
+        if (existing.glyph == glyph && existing.distance(entry) < DUPLICATE_DISTANCE){
+            return false;
+        }
+    }
+    m_templates.emplace_back(std::move(entry));
+    return true;
+}
+
+char GlyphClassifier::classify(const PackedBinaryMatrix& matrix) const{
+    if (m_templates.empty() || matrix.width() == 0 || matrix.height() == 0){
+        return 0;
+    }
+
+    Template glyph(0, matrix);
+
+    const Template* best = nullptr;
+    double best_distance = INFINITY;
+    for (const Template& entry : m_templates){
+        double distance = entry.distance(glyph);
+        if (best_distance > distance){
+            best_distance = distance;
+            best = &entry;
+        }
+    }
+    if (best_distance > MAX_DISTANCE){
+        return 0;
+    }
+
+    double runner_up = INFINITY;
+    for (const Template& entry : m_templates){
+        if (entry.glyph != best->glyph){
+            runner_up = std::min(runner_up, entry.distance(glyph));
+        }
+    }
+    if (runner_up < MIN_MARGIN * best_distance){
+        return 0;
+    }
+
+    return best->glyph;
+}
+
+
+
+const GlyphClassifier& number_glyphs(){
+    static const GlyphClassifier classifier("CommonTools/NumberGlyphs.json");
+    return classifier;
+}
+
+
+
+}
+}
@@ -0,0 +1,87 @@
+/*  OCR Glyph Classifier
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Nearest-neighbor classifier for single characters of a fixed font.
+ *
+ *  Readers that waterfill each character out of the image can use this to
+ *  identify the characters without running a full OCR pass on each one.
+ *  Each glyph is shrunk to a small grid of pixel coverages. A glyph is only
+ *  classified when it is close to a template and clearly closer to it than to
+ *  any template of a different character. Otherwise the caller should fall
+ *  back to OCR.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_OCR_GlyphClassifier_H
+#define PokemonAutomation_CommonTools_OCR_GlyphClassifier_H
+
+#include <string>
+#include <vector>
+#include <array>
+#include "CommonFramework/ImageTypes/BinaryImage.h"
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+class GlyphClassifier{
+public:
+    static constexpr size_t GRID_WIDTH = 8;
+    static constexpr size_t GRID_HEIGHT = 12;
+
+    //  Maximum distance to the nearest template to accept a glyph.
+    static constexpr double MAX_DISTANCE = 4.0;
+
+    //  The nearest template of any other character must be at least this
+    //  many times further away.
+    static constexpr double MIN_MARGIN = 2.0;
+
+public:
+    GlyphClassifier() = default;
+
+    //  Load the templates from "json_path" (relative to the resources).
+    //  If the file doesn't exist, the classifier is empty.
+    GlyphClassifier(const std::string& json_path);
+
+    bool empty() const{ return m_templates.empty(); }
+    size_t size() const{ return m_templates.size(); }
+
+    //  Returns false if the template was a near duplicate and was not added.
+    bool add_template(char glyph, const PackedBinaryMatrix& matrix);
+
+    //  Returns the character of "matrix" or 0 if it isn't confident.
+    char classify(const PackedBinaryMatrix& matrix) const;
+
+    void save(const std::string& json_path) const;
+
+
+private:
+    struct Template{
+        char glyph;
+        double log_aspect_ratio;
+        std::array<float, GRID_WIDTH * GRID_HEIGHT> coverage;
+
+        Template(char p_glyph, const PackedBinaryMatrix& matrix);
+        Template(char p_glyph, double p_log_aspect_ratio)
+            : glyph(p_glyph)
+            , log_aspect_ratio(p_log_aspect_ratio)
+            , coverage{}
+        {}
+
+        double distance(const Template& x) const;
+    };
+
+    std::vector<Template> m_templates;
+};
+
+
+
+//  Templates for the digits of the number readers. (see OCR_NumberReader.h)
+const GlyphClassifier& number_glyphs();
+
+
+
+}
+}
+#endif
@@ -18,6 +18,7 @@
 #include "CommonTools/Images/ImageFilter.h"
 #include "CommonTools/Images/BinaryImage_FilterRgb32.h"
 #include "OCR_RawOCR.h"
+#include "OCR_GlyphClassifier.h"
 #include "OCR_NumberReader.h"
 
 #include <iostream>
@@ -170,11 +171,21 @@ std::string read_number_waterfill_no_normalization(
         }
     }
 
+    const GlyphClassifier& glyphs = number_glyphs();
+
     std::string ocr_text;
     for (const auto& item : map){
         const WaterfillObject& object = item.second;
-        ImageRGB32 cropped = extract_box_reference(filtered, object).copy();            
         PackedBinaryMatrix tmp(object.packed_matrix());
+
+        //  Most digits match a template. Only run OCR on the ones that don't.
+        char glyph = glyphs.classify(tmp);
+        if (glyph != 0){
+            ocr_text += glyph;
+            continue;
+        }
+
+        ImageRGB32 cropped = extract_box_reference(filtered, object).copy();            
         filter_by_mask(tmp, cropped, Color(0xffffffff), true);
 
         //  Tesseract doesn't like numbers that are too big. So scale it down.
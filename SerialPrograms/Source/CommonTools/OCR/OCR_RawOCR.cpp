@@ -155,9 +155,13 @@ private:
     std::vector<TesseractAPI*> m_idle;
 };
 
+//  Enough for all the text regions of a few screens in every filter.
+const size_t OCR_RESULT_CACHE_SIZE = 1024;
+
 struct OcrGlobals{
     SpinLock ocr_pool_lock;
     std::map<Language, TesseractPool> ocr_pool;
+    OcrResultCache result_cache{OCR_RESULT_CACHE_SIZE};
 
     static OcrGlobals& instance(){
         static OcrGlobals globals;
@@ -176,6 +180,13 @@ std::string ocr_read(Language language, const ImageViewRGB32& image){
     }
 
     OcrGlobals& globals = OcrGlobals::instance();
+
+    OcrResultCache::Key key(language, image);
+    std::string text;
+    if (globals.result_cache.get(key, text)){
+        return text;
+    }
+
     std::map<Language, TesseractPool>& ocr_pool = globals.ocr_pool;
 
     std::map<Language, TesseractPool>::iterator iter;
@@ -186,7 +197,13 @@ std::string ocr_read(Language language, const ImageViewRGB32& image){
             iter = ocr_pool.emplace(language, language).first;
         }
     }
-    return iter->second.run(image);
+    text = iter->second.run(image);
+
+    globals.result_cache.insert(key, text);
+    return text;
+}
+OcrResultCacheStats result_cache_stats(){
+    return OcrGlobals::instance().result_cache.stats();
 }
 void ensure_instances(Language language, size_t instances){
     if (language == Language::None){
@@ -211,6 +228,7 @@ void clear_cache(){
     std::map<Language, TesseractPool>& ocr_pool = globals.ocr_pool;
     WriteSpinLock lg(globals.ocr_pool_lock, "ocr_clear_cache()");
     ocr_pool.clear();
+    globals.result_cache.clear();
 }
 
 
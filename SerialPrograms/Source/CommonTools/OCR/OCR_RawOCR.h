@@ -9,6 +9,7 @@
 
 #include <string>
 #include "CommonFramework/Language.h"
+#include "OCR_ResultCache.h"
 
 namespace PokemonAutomation{
     class ImageViewRGB32;
@@ -19,8 +20,13 @@ bool language_available(Language language);
 
 
 //  OCR the image in the specified language.
+//  The results of recently read images are cached. Reading the exact same
+//  image again returns the cached text without running OCR.
 std::string ocr_read(Language language, const ImageViewRGB32& image);
 
+//  Hit/miss counts of the "ocr_read()" result cache.
+OcrResultCacheStats result_cache_stats();
+
 //  Ensure that there are this many parallel instances for this language.
 //  Call this if you expect to need to do many OCR instances in parallel and you
 //  want to preload the OCR instances.
@@ -0,0 +1,129 @@
+/*  OCR Result Cache
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "OCR_ResultCache.h"
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+namespace{
+
+//  Two independent hashes over 8-byte words in one pass. The first is FNV-1a
+//  style mixing. The second is a multiply-rotate hash with different constants.
+//  These only need to be fast and spread well. They aren't adversarial.
+void hash_image(const ImageViewRGB32& image, uint64_t& hash, uint64_t& hash2){
+    const uint64_t PRIME = 0x100000001b3;
+    const uint64_t PRIME2 = 0x9e3779b97f4a7c15;
+    hash = 0xcbf29ce484222325;
+    hash2 = 0x84222325cbf29ce4;
+
+    size_t bytes = image.width() * sizeof(uint32_t);
+    const char* row = (const char*)image.data();
+    for (size_t r = 0; r < image.height(); r++){
+        size_t c = 0;
+        for (; c + 8 <= bytes; c += 8){
+            uint64_t word;
+            memcpy(&word, row + c, 8);
+            hash = (hash ^ word) * PRIME;
+            hash ^= hash >> 29;
+            hash2 = ((hash2 + word) * PRIME2);
+            hash2 = (hash2 << 31) | (hash2 >> 33);
+        }
+        if (c < bytes){
+            uint32_t word;
+            memcpy(&word, row + c, 4);
+            hash = (hash ^ word) * PRIME;
+            hash ^= hash >> 29;
+            hash2 = ((hash2 + word) * PRIME2);
+            hash2 = (hash2 << 31) | (hash2 >> 33);
+        }
+        row += image.bytes_per_row();
+    }
+    hash2 ^= hash2 >> 32;
+}
+
+}
+
+
+OcrResultCache::Key::Key(Language p_language, const ImageViewRGB32& image)
+    : language(p_language)
+    , width(image.width())
+    , height(image.height())
+{
+    hash_image(image, hash, hash2);
+}
+
+
+
+OcrResultCache::OcrResultCache(size_t capacity)
+    : m_capacity(capacity)
+    , m_hits(0)
+    , m_misses(0)
+{}
+
+bool OcrResultCache::get(const Key& key, std::string& text){
+    {
+        WriteSpinLock lg(m_lock, "OcrResultCache::get()");
+        auto iter = m_map.find(key);
+        if (iter != m_map.end()){
+            m_entries.splice(m_entries.begin(), m_entries, iter->second);
+            text = iter->second->second;
+            m_hits++;
+            return true;
+        }
+    }
+    m_misses++;
+    return false;
+}
+void OcrResultCache::insert(const Key& key, std::string text){
+    if (m_capacity == 0){
+        return;
+    }
+
+    WriteSpinLock lg(m_lock, "OcrResultCache::insert()");
+
+    //  Another thread may have read the same image in the meantime.
+    auto iter = m_map.find(key);
+    if (iter != m_map.end()){
+        m_entries.splice(m_entries.begin(), m_entries, iter->second);
+        return;
+    }
+
+    m_entries.emplace_front(key, std::move(text));
+    try{
+        m_map.emplace(key, m_entries.begin());
+    }catch (...){
+        m_entries.pop_front();
+        throw;
+    }
+
+    if (m_entries.size() > m_capacity){
+        m_map.erase(m_entries.back().first);
+        m_entries.pop_back();
+    }
+}
+
+OcrResultCacheStats OcrResultCache::stats() const{
+    OcrResultCacheStats ret;
+    ret.hits = m_hits.load(std::memory_order_relaxed);
+    ret.misses = m_misses.load(std::memory_order_relaxed);
+    ReadSpinLock lg(m_lock, "OcrResultCache::stats()");
+    ret.entries = m_entries.size();
+    return ret;
+}
+void OcrResultCache::clear(){
+    WriteSpinLock lg(m_lock, "OcrResultCache::clear()");
+    m_map.clear();
+    m_entries.clear();
+}
+
+
+
+}
+}
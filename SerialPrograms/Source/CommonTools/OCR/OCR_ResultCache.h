@@ -0,0 +1,89 @@
+/*  OCR Result Cache
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Remembers the text of recently OCR'ed images.
+ *
+ *  Programs tend to read the same unchanged text over and over. (menus,
+ *  dialogs, stat screens) After filtering, those images are identical down to
+ *  the pixel, so the text can be reused instead of running Tesseract again.
+ *
+ *  The key is the image dimensions plus two independent 64-bit hashes of the
+ *  pixels. Only identical images are meant to hit. A false hit needs both
+ *  hashes to collide on images of the same size, which is negligible but not
+ *  impossible.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_OCR_ResultCache_H
+#define PokemonAutomation_CommonTools_OCR_ResultCache_H
+
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <atomic>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "CommonFramework/Language.h"
+
+namespace PokemonAutomation{
+    class ImageViewRGB32;
+namespace OCR{
+
+
+struct OcrResultCacheStats{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    size_t entries = 0;
+};
+
+
+class OcrResultCache{
+public:
+    struct Key{
+        Language language;
+        size_t width;
+        size_t height;
+        uint64_t hash;
+        uint64_t hash2;
+
+        Key(Language language, const ImageViewRGB32& image);
+
+        bool operator==(const Key& x) const{
+            return language == x.language &&
+                width == x.width && height == x.height &&
+                hash == x.hash && hash2 == x.hash2;
+        }
+    };
+
+public:
+    OcrResultCache(size_t capacity);
+
+    //  Returns true and sets "text" if "key" is in the cache.
+    bool get(const Key& key, std::string& text);
+    void insert(const Key& key, std::string text);
+
+    OcrResultCacheStats stats() const;
+    void clear();
+
+
+private:
+    struct KeyHash{
+        size_t operator()(const Key& key) const{ return (size_t)key.hash; }
+    };
+    using Entry = std::pair<Key, std::string>;
+
+    const size_t m_capacity;
+    std::atomic<uint64_t> m_hits;
+    std::atomic<uint64_t> m_misses;
+
+    mutable SpinLock m_lock;
+    //  Most recently used first.
+    std::list<Entry> m_entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_map;
+};
+
+
+
+}
+}
+#endif
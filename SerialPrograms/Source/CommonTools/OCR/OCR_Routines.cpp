@@ -46,17 +46,18 @@ StringMatchResult multifiltered_OCR(
         [&](size_t index){
             const std::pair<ImageRGB32, size_t>& filtered = filtered_images[index];
 
-            std::string text = ocr_read(language, filtered.first);
-        //    cout << text << endl;
-        //    filtered.first.save("test" + std::to_string(index) + ".png");
-
             //  Compute ratio of image that matches text color. Skip if it's out of range.
+            //  Do this before the OCR since the text would be thrown away anyway.
             double ratio = filtered.second * pixels_inv;
 //            cout << "ratio = " << ratio << endl;
             if (ratio < min_text_ratio || ratio > max_text_ratio){
                 return;
             }
 
+            std::string text = ocr_read(language, filtered.first);
+        //    cout << text << endl;
+        //    filtered.first.save("test" + std::to_string(index) + ".png");
+
             StringMatchResult current = dictionary.match_substring(language, text, log10p_spread);
 
             WriteSpinLock lg(lock);
@@ -12,8 +12,11 @@
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Options/Environment/PerformanceOptions.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonTools/Images/BinaryImage_FilterRgb32.h"
+#include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "OCR_SmallDictionaryMatcher.h"
 #include "OCR_LargeDictionaryMatcher.h"
+#include "OCR_GlyphClassifier.h"
 #include "OCR_TrainingTools.h"
 
 namespace PokemonAutomation{
@@ -276,6 +279,94 @@ void TrainingSession::generate_large_dictionary(
 
 
 
+
+//  The glyph of a sample is its largest object that isn't the background.
+bool extract_glyph(
+    PackedBinaryMatrix& glyph,
+    const ImageViewRGB32& image, const TextColorRange& range
+){
+    using namespace Kernels::Waterfill;
+
+    PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(image, range.mins, range.maxs);
+    std::unique_ptr<WaterfillSession> session = make_WaterfillSession(matrix);
+    auto iter = session->make_iterator(20);
+
+    WaterfillObject best;
+    WaterfillObject object;
+    while (iter->find_next(object, true)){
+        if (object.width() >= image.width() && object.height() >= image.height()){
+            continue;
+        }
+        if (best.area < object.area){
+            best = std::move(object);
+        }
+    }
+    if (best.area == 0){
+        return false;
+    }
+    glyph = best.packed_matrix();
+    return true;
+}
+
+void TrainingSession::generate_glyph_templates(
+    const std::string& output_json_file,
+    const std::vector<OCR::TextColorRange>& text_color_ranges
+) const{
+    m_logger.log("Generating Glyph Templates...");
+
+    //  Glyphs don't depend on the language.
+    std::vector<std::pair<char, PackedBinaryMatrix>> glyphs;
+    for (const auto& language : m_samples){
+        for (const TrainingSample& sample : language.second){
+            m_scope.throw_if_cancelled();
+            if (sample.token.size() != 1){
+                m_logger.log("Skipping: " + sample.filepath + " (token is not a single character)");
+                continue;
+            }
+            ImageRGB32 image(m_directory + sample.filepath);
+            if (!image){
+                m_logger.log("Skipping: " + sample.filepath);
+                continue;
+            }
+            for (const TextColorRange& range : text_color_ranges){
+                PackedBinaryMatrix glyph;
+                if (extract_glyph(glyph, image, range)){
+                    glyphs.emplace_back(sample.token[0], std::move(glyph));
+                }
+            }
+        }
+    }
+
+    GlyphClassifier classifier;
+    for (const auto& item : glyphs){
+        classifier.add_template(item.first, item.second);
+    }
+
+    //  Check the templates against the samples they came from.
+    size_t matched = 0;
+    size_t missed = 0;
+    size_t wrong = 0;
+    for (const auto& item : glyphs){
+        char glyph = classifier.classify(item.second);
+        if (glyph == item.first){
+            matched++;
+        }else if (glyph == 0){
+            missed++;
+        }else{
+            wrong++;
+            m_logger.log(std::string("Misread: ") + item.first + " -> " + glyph, COLOR_RED);
+        }
+    }
+
+    m_logger.log("Glyphs: " + tostr_u_commas(glyphs.size()));
+    m_logger.log("Templates: " + tostr_u_commas(classifier.size()));
+    m_logger.log("Matched: " + tostr_u_commas(matched));
+    m_logger.log("Missed (OCR fallback): " + tostr_u_commas(missed));
+    m_logger.log("Wrong: " + tostr_u_commas(wrong));
+
+    classifier.save(output_json_file);
+}
+
 }
 }
 
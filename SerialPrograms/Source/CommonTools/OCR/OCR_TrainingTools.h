@@ -54,6 +54,13 @@ public:
         double min_text_ratio = 0.01, double max_text_ratio = 0.50
     ) const;
 
+    //  Build templates for GlyphClassifier. Each sample is an image of a
+    //  single character whose token is that character.
+    void generate_glyph_templates(
+        const std::string& output_json_file,
+        const std::vector<OCR::TextColorRange>& text_color_ranges
+    ) const;
+
 private:
     Logger& m_logger;
     CancellableScope& m_scope;
@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_CommonTools_VisualDetector_H
 #define PokemonAutomation_CommonTools_VisualDetector_H
 
+#include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonTools/InferenceCallbacks/VisualInferenceCallback.h"
 
 namespace PokemonAutomation{
@@ -99,10 +100,36 @@ public:
     //    is implemented.
     using VisualInferenceCallback::process_frame;
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override{
+        m_last_result = this->detect(frame);
+        return process_result(m_last_result, timestamp);
+    }
+
+    //  Nothing under the boxes given to `skip_unchanged_frames()` has changed,
+    //  so the detector would return the same result. Only the time moves on.
+    virtual bool process_unchanged_frame(const VideoSnapshot& frame) override{
+        return process_result(m_last_result, frame.timestamp);
+    }
+
+    //  If m_finder_type is CONSISTENT and process_frame() returns true,
+    //  whether it is consecutively detected , or consecutively not detected.
+    bool consistent_result() const { return m_consistent_result; }
+
+    //  Reset internal state so the finder is ready for next round of detection.
+    //  If there is some kind of "lock-in" mechanism to lock the detection result during
+    //  `process_frame()`, this function should unlock it.
+    virtual void reset_state() override {
+        Detector::reset_state();
+        m_start_of_detection = WallClock::min();
+        m_last_detected = 0;
+        m_consistent_result = false;
+    }
+
+private:
+    bool process_result(bool result, WallClock timestamp){
         switch (m_finder_type){
         case FinderType::PRESENT:
         case FinderType::GONE:
-            if (this->detect(frame) == (m_finder_type == FinderType::GONE)){
+            if (result == (m_finder_type == FinderType::GONE)){
                 m_start_of_detection = WallClock::min();
                 return false;
             }
@@ -117,7 +144,6 @@ public:
                 return false;
             }
         case FinderType::CONSISTENT:{
-            const bool result = this->detect(frame);
             const bool result_changed = (result && m_last_detected < 0) || (!result && m_last_detected > 0);
 
             m_last_detected = (result ? 1 : -1);
@@ -144,26 +170,13 @@ public:
         return false;
     }
 
-    //  If m_finder_type is CONSISTENT and process_frame() returns true,
-    //  whether it is consecutively detected , or consecutively not detected.
-    bool consistent_result() const { return m_consistent_result; }
-
-    //  Reset internal state so the finder is ready for next round of detection.
-    //  If there is some kind of "lock-in" mechanism to lock the detection result during
-    //  `process_frame()`, this function should unlock it.
-    virtual void reset_state() override {
-        Detector::reset_state();
-        m_start_of_detection = WallClock::min();
-        m_last_detected = 0;
-        m_consistent_result = false;
-    }
-
 private:
     std::chrono::milliseconds m_duration;  // duration of frames to decide detection outcome
     FinderType m_finder_type;
     WallClock m_start_of_detection = WallClock::min();
     int8_t m_last_detected = 0; // 0: no prior detection, 1: last detected positive, -1: last detected negative
     bool m_consistent_result = false;
+    bool m_last_result = false;     //  Last result from detect().
 };
 
 
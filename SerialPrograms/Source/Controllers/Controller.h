@@ -74,6 +74,13 @@ public:
     //  Zero means "tick precise".
     virtual Milliseconds timing_variation() const = 0;
 
+    //  Measured delay from issuing a command here to the device receiving it.
+    //  This is half the smoothed round-trip time of the connection.
+    //  Zero if the controller doesn't measure it.
+    virtual WallDuration command_latency() const{
+        return WallDuration::zero();
+    }
+
     //  If the controller can atomically press/release multiple buttons
     //  return true. This means that if the program presses A and B
     //  simultaneously, the console will never see an intermediate state where
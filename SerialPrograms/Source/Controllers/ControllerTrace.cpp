@@ -0,0 +1,186 @@
+/*  Controller Trace
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include "Common/Cpp/Exceptions.h"
+#include "ControllerTrace.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+const char TRACE_MAGIC[8] = {'P', 'A', 'C', 'T', 'R', 'A', 'C', 'E'};
+const uint32_t TRACE_VERSION = 1;
+
+struct TraceFileHeader{
+    char magic[8];
+    uint32_t version;
+    uint32_t sources;
+    uint64_t events;
+    uint64_t dropped;
+};
+
+uint64_t steady_nanoseconds(){
+    static const std::chrono::steady_clock::time_point START = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - START
+    ).count();
+}
+
+}
+
+
+
+void ControllerTraceSnapshot::save(const std::string& path) const{
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open file for writing.", path);
+    }
+
+    TraceFileHeader header{};
+    memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.sources = (uint32_t)sources.size();
+    header.events = events.size();
+    header.dropped = dropped;
+    file.write((const char*)&header, sizeof(header));
+
+    for (const std::string& name : sources){
+        uint32_t bytes = (uint32_t)name.size();
+        file.write((const char*)&bytes, sizeof(bytes));
+        file.write(name.data(), bytes);
+    }
+    file.write((const char*)events.data(), events.size() * sizeof(ControllerTraceEvent));
+
+    file.flush();
+    if (!file){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write controller trace.", path);
+    }
+}
+ControllerTraceSnapshot ControllerTraceSnapshot::load(const std::string& path){
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open file.", path);
+    }
+
+    TraceFileHeader header;
+    file.read((char*)&header, sizeof(header));
+    if (!file ||
+        memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0 ||
+        header.version != TRACE_VERSION
+    ){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Not a controller trace.", path);
+    }
+    if (header.sources > 65536 || header.events > ControllerTrace::CAPACITY){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Controller trace is corrupt.", path);
+    }
+
+    ControllerTraceSnapshot ret;
+    ret.dropped = header.dropped;
+    ret.sources.resize(header.sources);
+    for (std::string& name : ret.sources){
+        uint32_t bytes = 0;
+        file.read((char*)&bytes, sizeof(bytes));
+        if (!file || bytes > 4096){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Controller trace is corrupt.", path);
+        }
+        name.resize(bytes);
+        file.read(name.data(), bytes);
+    }
+    ret.events.resize(header.events);
+    file.read((char*)ret.events.data(), ret.events.size() * sizeof(ControllerTraceEvent));
+    if (!file){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Controller trace is truncated.", path);
+    }
+    return ret;
+}
+
+
+
+ControllerTrace::ControllerTrace()
+    : m_events(CAPACITY)
+    , m_recorded(0)
+{}
+
+uint16_t ControllerTrace::add_source(std::string name){
+    SpinLockGuard lg(m_lock, "ControllerTrace::add_source()");
+
+    //  Ids are never reused. If we somehow run out, share the last one.
+    if (m_sources.size() > UINT16_MAX){
+        return UINT16_MAX;
+    }
+    m_sources.emplace_back(std::move(name));
+    return (uint16_t)(m_sources.size() - 1);
+}
+void ControllerTrace::record(
+    uint16_t source, ControllerTraceEventType type,
+    uint64_t seqnum, int64_t value
+){
+    SpinLockGuard lg(m_lock, "ControllerTrace::record()");
+
+    //  Take the timestamp under the lock so the buffer stays in time order.
+    uint64_t recorded = m_recorded.load(std::memory_order_relaxed);
+    ControllerTraceEvent& event = m_events[recorded % CAPACITY];
+    event.timestamp_ns = steady_nanoseconds();
+    event.seqnum = seqnum;
+    event.value = value;
+    event.source = source;
+    event.type = type;
+    memset(event.reserved, 0, sizeof(event.reserved));
+    m_recorded.store(recorded + 1, std::memory_order_relaxed);
+}
+
+ControllerTraceSnapshot ControllerTrace::snapshot() const{
+    //  Only the indices are read under the lock. The events are copied outside
+    //  of it so that "record()" on the serial threads never waits on a copy of
+    //  the whole buffer.
+    ControllerTraceSnapshot ret;
+    uint64_t end;
+    {
+        SpinLockGuard lg(m_lock, "ControllerTrace::snapshot()");
+        ret.sources = m_sources;
+        end = m_recorded.load(std::memory_order_relaxed);
+    }
+    uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+
+    ret.events.resize((size_t)(end - begin));
+    size_t start = (size_t)(begin % CAPACITY);
+    size_t first = std::min(ret.events.size(), CAPACITY - start);
+    memcpy(ret.events.data(), m_events.data() + start, first * sizeof(ControllerTraceEvent));
+    memcpy(ret.events.data() + first, m_events.data(), (ret.events.size() - first) * sizeof(ControllerTraceEvent));
+
+    //  Events that were overwritten while they were being copied may be torn.
+    //  Drop them. Anything recorded after this doesn't matter since the copy
+    //  is already done.
+    uint64_t recorded;
+    {
+        SpinLockGuard lg(m_lock, "ControllerTrace::snapshot()");
+        recorded = m_recorded.load(std::memory_order_relaxed);
+    }
+    uint64_t valid_begin = recorded > CAPACITY ? recorded - CAPACITY : 0;
+    if (valid_begin > begin){
+        size_t overwritten = (size_t)std::min(valid_begin - begin, end - begin);
+        ret.events.erase(ret.events.begin(), ret.events.begin() + overwritten);
+        begin += overwritten;
+    }
+
+    ret.dropped = begin;
+    return ret;
+}
+
+
+ControllerTrace& global_controller_trace(){
+    static ControllerTrace trace;
+    return trace;
+}
+
+
+
+}
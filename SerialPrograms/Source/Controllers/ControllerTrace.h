@@ -0,0 +1,122 @@
+/*  Controller Trace
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  A binary trace of controller timing events: every schedule entry that is
+ *  issued, every packet sent to the device, and every ack and command-finished
+ *  message that comes back.
+ *
+ *  Events go into a fixed-size ring buffer that is always on. Once it is full,
+ *  the oldest events are overwritten. It can be saved to a file at any time
+ *  (and is saved with every error report) and then read back by
+ *  "ControllerTraceAnalysis" offline.
+ *
+ *  Timestamps are from the steady clock. "current_time()" can jump, so it can't
+ *  be used for latencies.
+ *
+ */
+
+#ifndef PokemonAutomation_Controllers_ControllerTrace_H
+#define PokemonAutomation_Controllers_ControllerTrace_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <atomic>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "ControllerTypes.h"
+
+namespace PokemonAutomation{
+
+
+enum class ControllerTraceEventType : uint8_t{
+    CONTROLLER_TYPE,    //  value = ControllerType of the source from here on.
+    SCHEDULE_ENTRY,     //  value = duration of the entry in microseconds.
+    SEND_REQUEST,       //  value = message type.
+    SEND_COMMAND,       //  value = message type.
+    RETRANSMIT,
+    ACK_REQUEST,
+    ACK_COMMAND,
+    COMMAND_FINISHED,
+    CLEAR_COMMANDS,     //  All commands up to "seqnum" were dropped.
+};
+
+struct ControllerTraceEvent{
+    uint64_t timestamp_ns;
+    uint64_t seqnum;
+    int64_t value;
+    uint16_t source;
+    ControllerTraceEventType type;
+    uint8_t reserved[5];
+};
+static_assert(sizeof(ControllerTraceEvent) == 32);
+
+
+//  The contents of the trace at one point in time.
+struct ControllerTraceSnapshot{
+    //  Indexed by "ControllerTraceEvent::source".
+    std::vector<std::string> sources;
+
+    //  In the order they were recorded.
+    std::vector<ControllerTraceEvent> events;
+
+    //  # of events that were overwritten before the snapshot was taken.
+    uint64_t dropped = 0;
+
+    //  Throws FileException on failure.
+    void save(const std::string& path) const;
+    static ControllerTraceSnapshot load(const std::string& path);
+};
+
+
+class ControllerTrace{
+public:
+    static const size_t CAPACITY = (size_t)1 << 16;
+
+    ControllerTrace();
+
+    uint16_t add_source(std::string name);
+
+    void record(
+        uint16_t source, ControllerTraceEventType type,
+        uint64_t seqnum = 0, int64_t value = 0
+    );
+
+    bool empty() const{
+        return m_recorded.load(std::memory_order_relaxed) == 0;
+    }
+    ControllerTraceSnapshot snapshot() const;
+
+private:
+    mutable SpinLock m_lock;
+    std::vector<std::string> m_sources;
+    std::vector<ControllerTraceEvent> m_events;
+    std::atomic<uint64_t> m_recorded;
+};
+
+ControllerTrace& global_controller_trace();
+
+
+
+//  One traced controller connection.
+class ControllerTraceSource{
+public:
+    ControllerTraceSource(std::string name)
+        : m_id(global_controller_trace().add_source(std::move(name)))
+    {}
+
+    void set_controller_type(ControllerType type){
+        record(ControllerTraceEventType::CONTROLLER_TYPE, 0, (int64_t)type);
+    }
+    void record(ControllerTraceEventType type, uint64_t seqnum = 0, int64_t value = 0){
+        global_controller_trace().record(m_id, type, seqnum, value);
+    }
+
+private:
+    const uint16_t m_id;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,268 @@
+/*  Controller Trace Analysis
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include <fstream>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "ControllerTypeStrings.h"
+#include "ControllerTraceAnalysis.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+std::string ns_to_ms(uint64_t ns){
+    return tostr_fixed(ns / 1000000., 3) + " ms";
+}
+std::string ns_to_s(uint64_t ns){
+    return tostr_fixed(ns / 1000000000., 3) + " s";
+}
+
+}
+
+
+
+uint64_t ControllerTraceLatency::percentile(double p) const{
+    if (samples.empty()){
+        return 0;
+    }
+    size_t index = (size_t)(p * (samples.size() - 1) + 0.5);
+    return samples[std::min(index, samples.size() - 1)];
+}
+std::string ControllerTraceLatency::to_str() const{
+    if (samples.empty()){
+        return "no samples";
+    }
+    std::string ret;
+    ret += "n = " + tostr_u_commas(samples.size());
+    ret += ", p50 = " + ns_to_ms(percentile(0.50) * 1000);
+    ret += ", p90 = " + ns_to_ms(percentile(0.90) * 1000);
+    ret += ", p99 = " + ns_to_ms(percentile(0.99) * 1000);
+    ret += ", max = " + ns_to_ms(samples.back() * 1000);
+    return ret;
+}
+
+
+
+ControllerTraceAnalysis::ControllerTraceAnalysis(
+    const ControllerTraceSnapshot& trace,
+    uint64_t idle_threshold_ns
+)
+    : m_dropped(trace.dropped)
+    , m_events(trace.events.size())
+{
+    struct InFlight{
+        uint64_t sent_ns;
+        ControllerType controller_type;
+        bool acked = false;
+    };
+    struct State{
+        std::map<uint64_t, InFlight> requests;
+        std::map<uint64_t, InFlight> commands;
+
+        //  When the command queue last changed.
+        uint64_t last_change_ns = 0;
+
+        //  When the command queue last became empty. Zero if no command has
+        //  been sent yet.
+        uint64_t empty_since_ns = 0;
+    };
+    std::map<uint16_t, State> states;
+
+    for (const ControllerTraceEvent& event : trace.events){
+        auto inserted = m_sources.try_emplace(event.source);
+        Source& source = inserted.first->second;
+        State& state = states[event.source];
+        if (inserted.second){
+            source.first_ns = event.timestamp_ns;
+            if (event.source < trace.sources.size()){
+                source.name = trace.sources[event.source];
+            }
+        }
+        source.last_ns = event.timestamp_ns;
+
+        size_t depth_before = state.commands.size();
+        if (depth_before != 0){
+            source.busy_ns += event.timestamp_ns - state.last_change_ns;
+            state.last_change_ns = event.timestamp_ns;
+        }
+
+        switch (event.type){
+        case ControllerTraceEventType::CONTROLLER_TYPE:
+            source.controller_type = (ControllerType)event.value;
+            break;
+        case ControllerTraceEventType::SCHEDULE_ENTRY:
+            source.schedule_entries++;
+            source.scheduled_ns += (uint64_t)event.value * 1000;
+            break;
+        case ControllerTraceEventType::SEND_REQUEST:
+            source.requests_sent++;
+            state.requests[event.seqnum] = InFlight{event.timestamp_ns, source.controller_type};
+            break;
+        case ControllerTraceEventType::SEND_COMMAND:
+            source.commands_sent++;
+            state.commands[event.seqnum] = InFlight{event.timestamp_ns, source.controller_type};
+            break;
+        case ControllerTraceEventType::RETRANSMIT:
+            source.retransmits++;
+            break;
+        case ControllerTraceEventType::ACK_REQUEST:{
+            auto iter = state.requests.find(event.seqnum);
+            if (iter == state.requests.end()){
+                break;
+            }
+            m_latencies[iter->second.controller_type].request_ack.samples.emplace_back(
+                (event.timestamp_ns - iter->second.sent_ns) / 1000
+            );
+            state.requests.erase(iter);
+            break;
+        }
+        case ControllerTraceEventType::ACK_COMMAND:{
+            auto iter = state.commands.find(event.seqnum);
+            if (iter == state.commands.end() || iter->second.acked){
+                break;
+            }
+            iter->second.acked = true;
+            m_latencies[iter->second.controller_type].command_ack.samples.emplace_back(
+                (event.timestamp_ns - iter->second.sent_ns) / 1000
+            );
+            break;
+        }
+        case ControllerTraceEventType::COMMAND_FINISHED:{
+            auto iter = state.commands.find(event.seqnum);
+            if (iter == state.commands.end()){
+                break;
+            }
+            m_latencies[iter->second.controller_type].command_finish.samples.emplace_back(
+                (event.timestamp_ns - iter->second.sent_ns) / 1000
+            );
+            state.commands.erase(iter);
+            break;
+        }
+        case ControllerTraceEventType::CLEAR_COMMANDS:
+            while (!state.commands.empty() && state.commands.begin()->first <= event.seqnum){
+                state.commands.erase(state.commands.begin());
+                source.commands_cleared++;
+            }
+            break;
+        }
+
+        size_t depth_after = state.commands.size();
+        if (depth_after == depth_before){
+            continue;
+        }
+
+        source.queue_depth.emplace_back(QueueDepthChange{event.timestamp_ns, (uint32_t)depth_after});
+        source.max_queue_depth = std::max(source.max_queue_depth, (uint32_t)depth_after);
+        state.last_change_ns = event.timestamp_ns;
+
+        if (depth_after == 0){
+            state.empty_since_ns = event.timestamp_ns;
+            continue;
+        }
+        if (depth_before == 0 && state.empty_since_ns != 0){
+            uint64_t gap = event.timestamp_ns - state.empty_since_ns;
+            source.idle_ns += gap;
+            if (gap >= idle_threshold_ns){
+                source.idle_gaps.emplace_back(IdleGap{state.empty_since_ns, gap});
+            }
+        }
+    }
+
+    for (auto& item : m_latencies){
+        std::sort(item.second.request_ack.samples.begin(), item.second.request_ack.samples.end());
+        std::sort(item.second.command_ack.samples.begin(), item.second.command_ack.samples.end());
+        std::sort(item.second.command_finish.samples.begin(), item.second.command_finish.samples.end());
+    }
+}
+
+
+
+std::string ControllerTraceAnalysis::to_str(size_t max_gaps_per_source) const{
+    std::string ret;
+    ret += "Controller Trace: " + tostr_u_commas(m_events) + " events";
+    if (m_dropped != 0){
+        ret += " (" + tostr_u_commas(m_dropped) + " older events were overwritten)";
+    }
+    ret += "\n";
+
+    for (const auto& item : m_sources){
+        const Source& source = item.second;
+        uint64_t duration_ns = source.last_ns - source.first_ns;
+
+        ret += "\nSource " + std::to_string(item.first) + ": " + source.name;
+        ret += " (" + CONTROLLER_TYPE_STRINGS.get_string(source.controller_type) + ")\n";
+        ret += "    Duration: " + ns_to_s(duration_ns) + "\n";
+        ret += "    Schedule Entries: " + tostr_u_commas(source.schedule_entries);
+        ret += ", Scheduled Time: " + ns_to_s(source.scheduled_ns) + "\n";
+        ret += "    Sent: " + tostr_u_commas(source.requests_sent) + " requests, ";
+        ret += tostr_u_commas(source.commands_sent) + " commands, ";
+        ret += tostr_u_commas(source.retransmits) + " retransmits, ";
+        ret += tostr_u_commas(source.commands_cleared) + " commands cleared\n";
+
+        double average_depth = 0;
+        uint64_t depth_area = 0;
+        for (size_t c = 1; c < source.queue_depth.size(); c++){
+            depth_area += source.queue_depth[c - 1].depth * (source.queue_depth[c].timestamp_ns - source.queue_depth[c - 1].timestamp_ns);
+        }
+        if (!source.queue_depth.empty()){
+            uint64_t span = source.queue_depth.back().timestamp_ns - source.queue_depth.front().timestamp_ns;
+            average_depth = span == 0 ? 0 : (double)depth_area / span;
+        }
+        ret += "    Queue Depth: max = " + std::to_string(source.max_queue_depth);
+        ret += ", average = " + tostr_fixed(average_depth, 2);
+        ret += ", busy = " + ns_to_s(source.busy_ns) + "\n";
+
+        ret += "    Device Idle: " + ns_to_s(source.idle_ns);
+        ret += ", " + tostr_u_commas(source.idle_gaps.size()) + " gaps over the threshold\n";
+
+        std::vector<IdleGap> gaps = source.idle_gaps;
+        std::sort(
+            gaps.begin(), gaps.end(),
+            [](const IdleGap& x, const IdleGap& y){ return x.length_ns > y.length_ns; }
+        );
+        if (gaps.size() > max_gaps_per_source){
+            gaps.resize(max_gaps_per_source);
+        }
+        for (const IdleGap& gap : gaps){
+            ret += "        at " + ns_to_s(gap.start_ns - source.first_ns) + ": " + ns_to_ms(gap.length_ns) + "\n";
+        }
+    }
+
+    ret += "\nIssue-to-Ack Latency:\n";
+    for (const auto& item : m_latencies){
+        ret += "    " + CONTROLLER_TYPE_STRINGS.get_string(item.first) + ":\n";
+        ret += "        Request Ack:    " + item.second.request_ack.to_str() + "\n";
+        ret += "        Command Ack:    " + item.second.command_ack.to_str() + "\n";
+        ret += "        Command Finish: " + item.second.command_finish.to_str() + "\n";
+    }
+
+    return ret;
+}
+
+void ControllerTraceAnalysis::save_queue_depth_csv(const std::string& path) const{
+    std::ofstream file(path);
+    if (!file.is_open()){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open file for writing.", path);
+    }
+    file << "source,time_ms,depth\n";
+    for (const auto& item : m_sources){
+        for (const QueueDepthChange& change : item.second.queue_depth){
+            file << item.first << ","
+                 << tostr_fixed((change.timestamp_ns - item.second.first_ns) / 1000000., 3) << ","
+                 << change.depth << "\n";
+        }
+    }
+    if (!file){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write file.", path);
+    }
+}
+
+
+
+}
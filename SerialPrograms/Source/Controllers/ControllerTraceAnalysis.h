@@ -0,0 +1,95 @@
+/*  Controller Trace Analysis
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Offline analysis of a saved controller trace.
+ *
+ *  A command is in the device queue from when it is first sent until its
+ *  command-finished message arrives (or it is cleared). The device is idle
+ *  whenever that queue is empty. Gaps before the first command and after the
+ *  last one are not counted.
+ *
+ */
+
+#ifndef PokemonAutomation_Controllers_ControllerTraceAnalysis_H
+#define PokemonAutomation_Controllers_ControllerTraceAnalysis_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include "ControllerTypes.h"
+#include "ControllerTrace.h"
+
+namespace PokemonAutomation{
+
+
+struct ControllerTraceLatency{
+    //  All in microseconds.
+    std::vector<uint64_t> samples;
+
+    uint64_t percentile(double p) const;
+    std::string to_str() const;
+};
+
+
+class ControllerTraceAnalysis{
+public:
+    struct QueueDepthChange{
+        uint64_t timestamp_ns;
+        uint32_t depth;
+    };
+    struct IdleGap{
+        uint64_t start_ns;
+        uint64_t length_ns;
+    };
+    struct Source{
+        std::string name;
+        ControllerType controller_type = ControllerType::None;
+
+        uint64_t first_ns = 0;
+        uint64_t last_ns = 0;
+
+        uint64_t schedule_entries = 0;
+        uint64_t scheduled_ns = 0;
+        uint64_t requests_sent = 0;
+        uint64_t commands_sent = 0;
+        uint64_t retransmits = 0;
+        uint64_t commands_cleared = 0;
+
+        std::vector<QueueDepthChange> queue_depth;
+        uint32_t max_queue_depth = 0;
+        uint64_t busy_ns = 0;
+
+        std::vector<IdleGap> idle_gaps;
+        uint64_t idle_ns = 0;
+    };
+    struct ControllerTypeLatencies{
+        ControllerTraceLatency request_ack;
+        ControllerTraceLatency command_ack;
+        ControllerTraceLatency command_finish;
+    };
+
+public:
+    //  Idle gaps shorter than "idle_threshold_ns" are not reported.
+    ControllerTraceAnalysis(const ControllerTraceSnapshot& trace, uint64_t idle_threshold_ns);
+
+    const std::map<uint16_t, Source>& sources() const{ return m_sources; }
+    const std::map<ControllerType, ControllerTypeLatencies>& latencies() const{ return m_latencies; }
+
+    std::string to_str(size_t max_gaps_per_source = 10) const;
+
+    //  One row per queue depth change: "source,time_ms,depth".
+    void save_queue_depth_csv(const std::string& path) const;
+
+private:
+    uint64_t m_dropped;
+    uint64_t m_events;
+    std::map<uint16_t, Source> m_sources;
+    std::map<ControllerType, ControllerTypeLatencies> m_latencies;
+};
+
+
+
+}
+#endif
@@ -35,8 +35,8 @@ public:
     //  Superscalar Commands (the "ssf" framework)
 
     void issue_barrier(Cancellable* cancellable){
-        SuperscalarScheduler::Schedule schedule;
         std::lock_guard<std::mutex> lg0(m_issue_lock);
+        SuperscalarScheduler::Schedule& schedule = start_schedule();
         {
             std::lock_guard<std::mutex> lg1(m_state_lock);
             m_scheduler.issue_wait_for_all(schedule);
@@ -47,8 +47,8 @@ public:
         }
     }
     void issue_nop(Cancellable* cancellable, Milliseconds duration){
-        SuperscalarScheduler::Schedule schedule;
         std::lock_guard<std::mutex> lg0(m_issue_lock);
+        SuperscalarScheduler::Schedule& schedule = start_schedule();
         {
             std::lock_guard<std::mutex> lg1(m_state_lock);
             if (cancellable){
@@ -67,6 +67,14 @@ public:
 
 
 protected:
+    //  The schedule of the current issue. This reuses the same buffer for
+    //  every issue so that issuing doesn't allocate.
+    //  Must be called while holding "m_issue_lock".
+    SuperscalarScheduler::Schedule& start_schedule(){
+        m_schedule.clear();
+        return m_schedule;
+    }
+
     virtual void execute_state(
         Cancellable* cancellable,
         const SuperscalarScheduler::ScheduleEntry& entry
@@ -94,6 +102,9 @@ protected:
     //  be held for long periods of time if the command queue is full.
     std::mutex m_issue_lock;
 
+    //  Protected by "m_issue_lock".
+    SuperscalarScheduler::Schedule m_schedule;
+
     //  This lock protects the state/fields of this class and subclasses.
     //  This lock is never held for a long time.
     std::mutex m_state_lock;
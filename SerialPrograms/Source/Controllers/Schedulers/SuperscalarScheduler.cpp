@@ -4,8 +4,11 @@
  *
  */
 
-//#include "Common/Cpp/Exceptions.h"
+#include <string.h>
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Time.h"
+#include "Controllers/ControllerTrace.h"
 #include "SuperscalarScheduler.h"
 
 //#include <iostream>
@@ -22,6 +25,8 @@ SuperscalarScheduler::SuperscalarScheduler(
     : m_logger(logger)
     , m_flush_threshold(flush_threshold)
 {
+    m_state_changes.reserve(64);
+    m_live_ids.reserve(MAX_RESOURCES);
     clear();
 }
 
@@ -36,33 +41,59 @@ void SuperscalarScheduler::clear() noexcept{
     m_device_sent_time = now;
     m_max_free_time = now;
     m_state_changes.clear();
-    m_live_commands.clear();
+    memset(m_live, 0, sizeof(m_live));
+    m_live_ids.clear();
     m_pending_clear = false;
 }
 
-SuperscalarScheduler::State SuperscalarScheduler::current_live_commands(){
+void SuperscalarScheduler::add_live_command(size_t resource_id){
+    if (m_live[resource_id]){
+        return;
+    }
+    m_live[resource_id] = true;
+    m_live_ids.insert(
+        std::lower_bound(m_live_ids.begin(), m_live_ids.end(), (uint32_t)resource_id),
+        (uint32_t)resource_id
+    );
+}
+void SuperscalarScheduler::add_state_change(WallClock timestamp){
+    auto iter = std::lower_bound(m_state_changes.begin(), m_state_changes.end(), timestamp);
+    if (iter == m_state_changes.end() || *iter != timestamp){
+        m_state_changes.insert(iter, timestamp);
+    }
+}
+
+void SuperscalarScheduler::current_live_commands(State& state) const{
     WallClock device_sent_time = m_device_sent_time;
-    State ret;
+    state.m_size = 0;
 //    cout << "device_sent_time = " << std::chrono::duration_cast<Milliseconds>(device_sent_time - m_local_start).count() << endl;
-    for (auto& item : m_live_commands){
-//        cout << "busy = " << std::chrono::duration_cast<Milliseconds>(item.second.busy_time - m_local_start).count()
-//             << ", done = " << std::chrono::duration_cast<Milliseconds>(item.second.done_time - m_local_start).count() << endl;
-        if (item.second.busy_time <= device_sent_time && device_sent_time < item.second.done_time){
-            ret.emplace_back(item.second.command);
+    for (uint32_t id : m_live_ids){
+        const Command& command = m_commands[id];
+//        cout << "busy = " << std::chrono::duration_cast<Milliseconds>(command.busy_time - m_local_start).count()
+//             << ", done = " << std::chrono::duration_cast<Milliseconds>(command.done_time - m_local_start).count() << endl;
+        if (command.busy_time <= device_sent_time && device_sent_time < command.done_time){
+            if (state.m_size >= MAX_ACTIVE_RESOURCES){
+                throw InternalProgramError(
+                    &m_logger, PA_CURRENT_FUNCTION,
+                    "Too many resources are active at once: " + std::to_string(state.m_size + 1)
+                );
+            }
+            state.m_commands[state.m_size++] = command.command;
         }
     }
-    return ret;
 }
 void SuperscalarScheduler::clear_finished_commands(){
     WallClock device_sent_time = m_device_sent_time;
-    for (auto iter = m_live_commands.begin(); iter != m_live_commands.end();){
-//        cout << "device_sent_time = " << device_sent_time << ", free_time = " << iter->second.free_time << endl;
-        if (device_sent_time >= iter->second.free_time){
-            iter = m_live_commands.erase(iter);
+    size_t kept = 0;
+    for (uint32_t id : m_live_ids){
+//        cout << "device_sent_time = " << device_sent_time << ", free_time = " << m_commands[id].free_time << endl;
+        if (device_sent_time >= m_commands[id].free_time){
+            m_live[id] = false;
         }else{
-            ++iter;
+            m_live_ids[kept++] = id;
         }
     }
+    m_live_ids.resize(kept);
 }
 bool SuperscalarScheduler::iterate_schedule(Schedule& schedule){
 //    cout << "----------------------------> " << m_state_changes.size() << endl;
@@ -74,17 +105,15 @@ bool SuperscalarScheduler::iterate_schedule(Schedule& schedule){
         return false;
     }
 
-    auto iter = m_state_changes.begin();
+    WallClock first_state_change = m_state_changes[0];
 
     WallClock next_state_change;
-    if (m_device_sent_time < *iter){
-        next_state_change = *iter;
+    if (m_device_sent_time < first_state_change){
+        next_state_change = first_state_change;
     }else{
-        auto next = iter;
-        ++next;
-        next_state_change = next == m_state_changes.end()
+        next_state_change = m_state_changes.size() < 2
             ? m_device_issue_time
-            : *next;
+            : m_state_changes[1];
     }
 
     //  Things get complicated if we overshoot the issue time.
@@ -104,17 +133,22 @@ bool SuperscalarScheduler::iterate_schedule(Schedule& schedule){
     }
 
     //  Compute the resource state at this timestamp.
-    std::vector<std::shared_ptr<const SchedulerResource>> state = current_live_commands();
+    ScheduleEntry& entry = schedule.emplace_back();
+    entry.duration = duration;
+    current_live_commands(entry.state);
     clear_finished_commands();
 
     m_device_sent_time = next_state_change;
-    if (next_state_change > *iter){
-        m_state_changes.erase(iter);
+    if (next_state_change > first_state_change){
+        m_state_changes.erase(m_state_changes.begin());
     }
 
-    ScheduleEntry& entry = schedule.emplace_back();
-    entry.duration = duration;
-    entry.state = std::move(state);
+    if (m_trace){
+        m_trace->record(
+            ControllerTraceEventType::SCHEDULE_ENTRY, 0,
+            std::chrono::duration_cast<std::chrono::microseconds>(duration).count()
+        );
+    }
 
 //    SpinLockGuard lg(m_lock);
 
@@ -193,7 +227,7 @@ void SuperscalarScheduler::issue_nop(Schedule& schedule, WallDuration delay){
 //         << ", max_free_time = " << std::chrono::duration_cast<Milliseconds>((m_max_free_time - m_local_start)).count()
 //         << endl;
     WallClock next_issue_time = m_device_issue_time + delay;
-    m_state_changes.insert(next_issue_time);
+    add_state_change(next_issue_time);
     m_device_issue_time = next_issue_time;
     m_max_free_time = std::max(m_max_free_time, m_device_issue_time);
     m_local_last_activity = current_time();
@@ -211,9 +245,8 @@ void SuperscalarScheduler::issue_wait_for_resource(Schedule& schedule, size_t re
 //         << endl;
 
     //  Resource is not ready yet. Stall until it is.
-    auto iter = m_live_commands.find(resource_id);
-    if (iter != m_live_commands.end() && m_device_sent_time < iter->second.free_time){
-        m_device_issue_time = iter->second.free_time;
+    if (is_live(resource_id) && m_device_sent_time < m_commands[resource_id].free_time){
+        m_device_issue_time = m_commands[resource_id].free_time;
         m_local_last_activity = current_time();
     }
 
@@ -221,21 +254,29 @@ void SuperscalarScheduler::issue_wait_for_resource(Schedule& schedule, size_t re
 }
 void SuperscalarScheduler::issue_to_resource(
     Schedule& schedule,
-    std::shared_ptr<const SchedulerResource> resource,
+    const SchedulerResource& resource,
     WallDuration delay, WallDuration hold, WallDuration cooldown
 ){
+    const size_t id = resource.id;
+    if (id >= MAX_RESOURCES){
+        throw InternalProgramError(
+            &m_logger, PA_CURRENT_FUNCTION,
+            "Resource id is out of range: " + std::to_string(id)
+        );
+    }
+
     if (m_pending_clear){
         clear();
     }
 
     //  Resource is busy. Stall until it is free.
-    auto ret = m_live_commands.try_emplace(resource->id);
-    if (!ret.second){
-//        cout << m_device_sent_time << " : " << ret.first->second.free_time << endl;
-        m_device_issue_time = std::max(m_device_issue_time, ret.first->second.free_time);
+    if (m_live[id]){
+//        cout << m_device_sent_time << " : " << m_commands[id].free_time << endl;
+        m_device_issue_time = std::max(m_device_issue_time, m_commands[id].free_time);
         process_schedule(schedule);
     }
-    Command& command = ret.first->second;
+    add_live_command(id);
+    Command& command = m_commands[id];
 
     delay    = std::max(delay, WallDuration::zero());
     hold     = std::max(hold, WallDuration::zero());
@@ -254,10 +295,10 @@ void SuperscalarScheduler::issue_to_resource(
     WallClock release_time = m_device_issue_time + hold;
     WallClock free_time = release_time + cooldown;
 
-    m_state_changes.insert(m_device_issue_time);
-    m_state_changes.insert(release_time);
+    add_state_change(m_device_issue_time);
+    add_state_change(release_time);
 
-    command.command = std::move(resource);
+    command.command = resource;
     command.busy_time = m_device_issue_time;
     command.done_time = release_time;
     command.free_time = free_time;
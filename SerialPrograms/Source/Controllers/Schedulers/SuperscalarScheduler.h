@@ -7,9 +7,8 @@
 #ifndef PokemonAutomation_Controllers_SuperscalarScheduler_H
 #define PokemonAutomation_Controllers_SuperscalarScheduler_H
 
-#include <memory>
-#include <set>
-#include <map>
+#include <stdint.h>
+#include <vector>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Time.h"
 #include "Common/Cpp/AbstractLogger.h"
@@ -18,19 +17,26 @@
 namespace PokemonAutomation{
 
 class SuperscalarScheduler;
+class ControllerTraceSource;
 
 
 
 
+//  A command that holds one resource. "id" is the resource. What "value"
+//  means is up to the controller.
+//
+//  Controllers subclass this only to construct it. The subclasses must not
+//  add any members since the scheduler stores these by value.
 class SchedulerResource{
 public:
-    const size_t id;
+    uint32_t id;
+    uint64_t value;
 
-    SchedulerResource(size_t id)
-        : id(id)
+    SchedulerResource() = default;
+    SchedulerResource(size_t id, uint64_t value = 0)
+        : id((uint32_t)id)
+        , value(value)
     {}
-
-    virtual ~SchedulerResource() = default;
 };
 
 
@@ -39,11 +45,36 @@ public:
 
 class SuperscalarScheduler{
 public:
-    using State = std::vector<std::shared_ptr<const SchedulerResource>>;
+    //  Resource ids must be less than this.
+    static constexpr size_t MAX_RESOURCES = 256;
+
+    //  Most resources that can be active in one schedule entry.
+    static constexpr size_t MAX_ACTIVE_RESOURCES = 64;
+
+    //  The commands that are active during a schedule entry, sorted by id.
+    class State{
+    public:
+        size_t size() const{ return m_size; }
+        bool empty() const{ return m_size == 0; }
+        const SchedulerResource& operator[](size_t index) const{ return m_commands[index]; }
+        const SchedulerResource* begin() const{ return m_commands; }
+        const SchedulerResource* end() const{ return m_commands + m_size; }
+
+    private:
+        friend class SuperscalarScheduler;
+        size_t m_size = 0;
+        SchedulerResource m_commands[MAX_ACTIVE_RESOURCES];
+    };
     struct ScheduleEntry{
+        //  User-provided so that emplace_back() doesn't zero the state.
+        ScheduleEntry(){}
+
         WallDuration duration;
         State state;
     };
+
+    //  Nothing here allocates once the vector has grown to its working size.
+    //  So reuse it between issues if possible.
     using Schedule = std::vector<ScheduleEntry>;
 
 public:
@@ -53,6 +84,11 @@ public:
         m_pending_clear = true;
     }
 
+    //  Record every schedule entry that is issued into "trace".
+    void set_trace(ControllerTraceSource* trace){
+        m_trace = trace;
+    }
+
 
 public:
     //  These are the standard "issue" commands.
@@ -64,9 +100,8 @@ public:
     //
 
     WallClock busy_until(size_t resource_id) const{
-        auto iter = m_live_commands.find(resource_id);
-        return iter != m_live_commands.end()
-            ? iter->second.free_time
+        return is_live(resource_id)
+            ? m_commands[resource_id].free_time
             : WallClock::min();
     }
 
@@ -85,14 +120,21 @@ public:
     //  Issue a resource with the specified timing parameters.
     void issue_to_resource(
         Schedule& schedule,
-        std::shared_ptr<const SchedulerResource> resource,
+        const SchedulerResource& resource,
         WallDuration delay, WallDuration hold, WallDuration cooldown
     );
 
 
 private:
     void clear() noexcept;
-    State current_live_commands();
+
+    bool is_live(size_t resource_id) const{
+        return resource_id < MAX_RESOURCES && m_live[resource_id];
+    }
+    void add_live_command(size_t resource_id);
+    void add_state_change(WallClock timestamp);
+
+    void current_live_commands(State& state) const;
     void clear_finished_commands();
     bool iterate_schedule(Schedule& schedule);
     void process_schedule(Schedule& schedule);
@@ -107,6 +149,8 @@ private:
 
     bool m_pending_clear;
 
+    ControllerTraceSource* m_trace = nullptr;
+
     //  The construction time of this object. This is only used for debugging
     //  purposes since it lets you print wall times relative to this.
     WallClock m_local_start;
@@ -124,17 +168,24 @@ private:
     //  Maximum of: m_live_commands[]->second.free_time
     WallClock m_max_free_time;
 
-    //  A set of all the scheduled state changes that will happen. Between
-    //  timestamps in this set, the state is constant.
-    std::set<WallClock> m_state_changes;
+    //  All the scheduled state changes that will happen, sorted and without
+    //  duplicates. Between these timestamps, the state is constant.
+    //  This stays small (about 2 per live command) so a sorted array beats a
+    //  tree.
+    std::vector<WallClock> m_state_changes;
 
     struct Command{
-        std::shared_ptr<const SchedulerResource> command;
+        SchedulerResource command;
         WallClock busy_time;    //  Timestamp of when resource will be become busy.
         WallClock done_time;    //  Timestamp of when resource will be done being busy.
         WallClock free_time;    //  Timestamp of when resource can be used again.
     };
-    std::map<size_t, Command> m_live_commands;
+
+    //  The live command of each resource is stored inline, indexed by id.
+    //  "m_live_ids" lists the live ones in order of id.
+    bool m_live[MAX_RESOURCES];
+    Command m_commands[MAX_RESOURCES];
+    std::vector<uint32_t> m_live_ids;
 };
 
 
@@ -8,6 +8,7 @@
 #define PokemonAutomation_AbstractBotBase_H
 
 #include <string>
+#include "Common/Cpp/Time.h"
 #include "Common/Cpp/CancellableScope.h"
 
 namespace PokemonAutomation{
@@ -16,6 +17,7 @@ class Logger;
 struct BotBaseMessage;
 class BotBaseRequest;
 class BotBaseControllerContext;
+class ControllerTraceSource;
 
 
 
@@ -38,6 +40,18 @@ public:
     virtual State state() const = 0;
     virtual size_t queue_limit() const = 0;
 
+    //  Smoothed time from sending a message to receiving its ack.
+    //  Zero if it hasn't been measured yet.
+    virtual WallDuration round_trip_time() const{
+        return WallDuration::zero();
+    }
+
+    //  Where this connection records its timing events.
+    //  Null if it isn't traced.
+    virtual ControllerTraceSource* trace(){
+        return nullptr;
+    }
+
     //  Waits for all pending requests to finish.
     virtual void wait_for_all_requests(Cancellable* cancelled = nullptr) = 0;
 
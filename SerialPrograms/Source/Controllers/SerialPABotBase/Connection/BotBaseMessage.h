@@ -11,32 +11,92 @@
 #include <cstring>
 #include <string>
 #include "Common/Cpp/Exceptions.h"
-#include "Common/Cpp/LifetimeSanitizer.h"
+#include "Common/SerialPABotBase/SerialPABotBase_Protocol.h"
 
 namespace PokemonAutomation{
 
 
+//  Fixed-capacity inline storage for a message body.
+//
+//  Packets are capped at PABB_PROTOCOL_MAX_PACKET_SIZE bytes, so there is
+//  no reason to heap allocate for every message that goes over the wire.
+//  The interface mirrors the subset of std::string that the protocol code
+//  uses so that callers do not need to care.
+class BotBaseMessageBody{
+public:
+    static constexpr size_t CAPACITY = PABB_PROTOCOL_MAX_PACKET_SIZE - PABB_PROTOCOL_OVERHEAD;
+
+public:
+    BotBaseMessageBody()
+        : m_size(0)
+    {}
+    BotBaseMessageBody(const void* data, size_t bytes){
+        assign(data, bytes);
+    }
+    BotBaseMessageBody(const std::string& data){
+        assign(data.data(), data.size());
+    }
+
+    void assign(const void* data, size_t bytes){
+        if (bytes > CAPACITY){
+            throw InternalProgramError(
+                nullptr, PA_CURRENT_FUNCTION,
+                "Message body is too long: " + std::to_string(bytes)
+            );
+        }
+        memcpy(m_data, data, bytes);
+        m_size = (uint8_t)bytes;
+    }
+
+    bool empty() const{ return m_size == 0; }
+    size_t size() const{ return m_size; }
+
+    const char* data() const{ return m_data; }
+          char* data()      { return m_data; }
+    const char* c_str() const{ return m_data; }
+
+    const char& operator[](size_t index) const{ return m_data[index]; }
+          char& operator[](size_t index)      { return m_data[index]; }
+
+    std::string substr(size_t pos) const{
+        if (pos > m_size){
+            pos = m_size;
+        }
+        return std::string(m_data + pos, m_size - pos);
+    }
+    std::string to_string() const{
+        return std::string(m_data, m_size);
+    }
+
+private:
+    uint8_t m_size;
+    alignas(uint32_t) char m_data[CAPACITY];
+};
+
+
+
 struct BotBaseMessage{
     uint8_t type;
-    std::string body;
-
-    LifetimeSanitizer sanitizer;
+    BotBaseMessageBody body;
 
     BotBaseMessage() = default;
-    BotBaseMessage(uint8_t p_type, std::string p_body)
+    BotBaseMessage(uint8_t p_type, const std::string& p_body)
+        : type(p_type)
+        , body(p_body)
+    {}
+    BotBaseMessage(uint8_t p_type, const void* data, size_t bytes)
         : type(p_type)
-        , body(std::move(p_body))
+        , body(data, bytes)
     {}
 
     template <typename Params>
     BotBaseMessage(uint8_t p_type, const Params& params)
         : type(p_type)
-        , body((char*)&params, sizeof(params))
+        , body(&params, sizeof(params))
     {}
 
     template <uint8_t MessageType, typename MessageBody>
     void convert(Logger& logger, MessageBody& params) const{
-        sanitizer.check_usage();
         if (type != MessageType){
             throw SerialProtocolException(
                 logger, PA_CURRENT_FUNCTION,
@@ -49,8 +109,7 @@ struct BotBaseMessage{
                 "Received Incorrect Response Size: Expected = " + std::to_string(sizeof(MessageBody)) + ", Actual = " + std::to_string(body.size())
             );
         }
-        memcpy(&params, body.c_str(), body.size());
-        sanitizer.check_usage();
+        memcpy(&params, body.data(), body.size());
     }
 
 };
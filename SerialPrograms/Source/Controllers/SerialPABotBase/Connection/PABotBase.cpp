@@ -49,6 +49,7 @@ PABotBase::PABotBase(
     , m_send_seq(1)
     , m_retransmit_delay(retransmit_delay)
     , m_last_ack(current_time())
+    , m_trace("PABotBase")
     , m_state(State::RUNNING)
     , m_error(false)
 {
@@ -221,6 +222,7 @@ void PABotBase::clear_all_active_commands(uint64_t seqnum){
             "Clearing all active commands... (Commands: " + std::to_string(m_pending_commands.size()) + ")",
             COLOR_DARKGREEN
         );
+        m_trace.record(ControllerTraceEventType::CLEAR_COMMANDS, seqnum);
 
 
         if (m_pending_commands.empty()){
@@ -267,6 +269,7 @@ void PABotBase::clear_all_active_commands(uint64_t seqnum){
                     handle.silent_remove = true;
                     handle.request = std::move(message);
                     handle.first_sent = current_time();
+                    handle.retransmitted = true;
                 }
             }
 
@@ -349,6 +352,10 @@ void PABotBase::process_ack_request(BotBaseMessage message){
 
         state = iter->second.state;
         if (state == AckState::NOT_ACKED){
+            m_trace.record(ControllerTraceEventType::ACK_REQUEST, full_seqnum);
+            if (!iter->second.retransmitted){
+                m_round_trip.add_sample(current_time() - iter->second.first_sent);
+            }
             if (iter->second.silent_remove){
                 m_pending_requests.erase(iter);
             }else{
@@ -406,6 +413,10 @@ void PABotBase::process_ack_command(BotBaseMessage message){
     switch (iter->second.state){
     case AckState::NOT_ACKED:
 //        std::cout << "acked: " << full_seqnum << std::endl;
+        m_trace.record(ControllerTraceEventType::ACK_COMMAND, full_seqnum);
+        if (!iter->second.retransmitted){
+            m_round_trip.add_sample(current_time() - iter->second.first_sent);
+        }
         iter->second.state = AckState::ACKED;
         iter->second.ack = std::move(message);
         return;
@@ -440,12 +451,12 @@ void PABotBase::process_command_finished(BotBaseMessage message){
 
 #ifdef INTENTIONALLY_DROP_MESSAGES
         if (rand() % 10 != 0){
-            send_message(BotBaseMessage(PABB_MSG_ACK_REQUEST, std::string((char*)&ack, sizeof(ack))), false);
+            send_message(BotBaseMessage(PABB_MSG_ACK_REQUEST, ack), false);
         }else{
             m_logger.log("Intentionally dropping finish ack: " + std::to_string(seqnum), COLOR_RED);
         }
 #else
-        send_message(BotBaseMessage(PABB_MSG_ACK_REQUEST, std::string((char*)&ack, sizeof(ack))), false);
+        send_message(BotBaseMessage(PABB_MSG_ACK_REQUEST, ack), false);
 #endif
 
         if (m_pending_commands.empty()){
@@ -470,6 +481,7 @@ void PABotBase::process_command_finished(BotBaseMessage message){
         switch (iter->second.state){
         case AckState::NOT_ACKED:
         case AckState::ACKED:
+            m_trace.record(ControllerTraceEventType::COMMAND_FINISHED, full_seqnum);
             iter->second.state = AckState::FINISHED;
             iter->second.ack = std::move(message);
             if (iter->second.silent_remove){
@@ -616,6 +628,19 @@ void PABotBase::retransmit_thread(){
         if (!messages.empty() && now - oldest >= m_retransmit_delay){
             for (const auto& item : messages){
                 send_message(*item.second, true);
+                m_trace.record(ControllerTraceEventType::RETRANSMIT, item.first);
+            }
+
+            //  Acks of these can no longer be timed. (Karn's algorithm)
+            for (auto& item : m_pending_requests){
+                if (item.second.state == AckState::NOT_ACKED){
+                    item.second.retransmitted = true;
+                }
+            }
+            for (auto& item : m_pending_commands){
+                if (item.second.state == AckState::NOT_ACKED){
+                    item.second.retransmitted = true;
+                }
             }
         }
 
@@ -723,6 +748,7 @@ uint64_t PABotBase::try_issue_request(
 #else
     send_message(handle.request, false);
 #endif
+    m_trace.record(ControllerTraceEventType::SEND_REQUEST, seqnum, handle.request.type);
 
     return seqnum;
 }
@@ -803,6 +829,7 @@ uint64_t PABotBase::try_issue_command(
 #else
     send_message(handle.request, false);
 #endif
+    m_trace.record(ControllerTraceEventType::SEND_COMMAND, seqnum, handle.request.type);
 
     return seqnum;
 }
@@ -29,9 +29,11 @@
 #include <atomic>
 #include <condition_variable>
 #include "Common/Cpp/AbstractLogger.h"
+#include "Common/Cpp/RoundTripTracker.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "Common/Cpp/Concurrency/Thread.h"
 #include "Common/SerialPABotBase/SerialPABotBase_Protocol.h"
+#include "Controllers/ControllerTrace.h"
 #include "Controllers/SerialPABotBase/Connection/MessageLogger.h"
 #include "Controllers/SerialPABotBase/Connection/PABotBaseConnection.h"
 #include "BotBase.h"
@@ -75,6 +77,17 @@ public:
     }
     void set_queue_limit(size_t queue_limit);
 
+    virtual WallDuration round_trip_time() const override{
+        return m_round_trip.smoothed();
+    }
+    const RoundTripTracker& round_trip() const{
+        return m_round_trip;
+    }
+
+    virtual ControllerTraceSource* trace() override{
+        return &m_trace;
+    }
+
 public:
     //  Basic Requests
 
@@ -103,6 +116,7 @@ private:
         BotBaseMessage request;
         BotBaseMessage ack;
         WallClock first_sent;
+        bool retransmitted = false;
         LifetimeSanitizer sanitizer;
     };
     struct PendingCommand{
@@ -111,6 +125,7 @@ private:
         BotBaseMessage request;
         BotBaseMessage ack;
         WallClock first_sent;
+        bool retransmitted = false;
         LifetimeSanitizer sanitizer;
     };
 
@@ -187,6 +202,11 @@ private:
     std::chrono::milliseconds m_retransmit_delay;
     std::atomic<std::chrono::time_point<std::chrono::system_clock>> m_last_ack;
 
+    //  Only updated by the receive thread while holding "m_state_lock".
+    RoundTripTracker m_round_trip;
+
+    ControllerTraceSource m_trace;
+
     std::map<uint64_t, PendingRequest> m_pending_requests;
     std::map<uint64_t, PendingCommand> m_pending_commands;
 
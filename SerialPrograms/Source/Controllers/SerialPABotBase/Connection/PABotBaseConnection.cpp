@@ -4,6 +4,8 @@
  * 
  */
 
+#include <string.h>
+#include <algorithm>
 #include "Common/CRC32.h"
 #include "Common/SerialPABotBase/SerialPABotBase_Protocol.h"
 //#include "Controllers/SerialPABotBase/Connection/MessageConverter.h"
@@ -70,14 +72,14 @@ void PABotBaseConnection::send_message(const BotBaseMessage& message, bool is_re
         throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Message is too long.");
     }
 
-    std::string buffer;
-    buffer += ~(uint8_t)total_bytes;
-    buffer += message.type;
-    buffer += message.body;
-    buffer += std::string(sizeof(uint32_t), 0);
-    pabb_crc32_write_to_message(&buffer[0], buffer.size());
+    //  Assemble the entire packet on the stack and send it in one shot.
+    alignas(uint32_t) char buffer[PABB_PROTOCOL_MAX_PACKET_SIZE];
+    buffer[0] = ~(uint8_t)total_bytes;
+    buffer[1] = message.type;
+    memcpy(buffer + 2, message.body.data(), message.body.size());
+    pabb_crc32_write_to_message(buffer, total_bytes);
 
-    m_connection->send(&buffer[0], buffer.size());
+    m_connection->send(buffer, total_bytes);
 }
 
 
@@ -109,18 +111,37 @@ void PABotBaseConnection::push_error_byte(ErrorBatchType type, char byte){
     m_current_error_type = type;
 }
 void PABotBaseConnection::on_recv(const void* data, size_t bytes){
-    //  Push into receive buffer.
-    for (size_t c = 0; c < bytes; c++){
-        m_recv_buffer.emplace_back(((const char*)data)[c]);
+    const char* ptr = (const char*)data;
+    while (bytes > 0){
+        //  Out of room at the back. Shift the unparsed bytes to the front.
+        if (m_recv_back == RECV_BUFFER_SIZE){
+            size_t remaining = m_recv_back - m_recv_front;
+            memmove(m_recv_buffer, m_recv_buffer + m_recv_front, remaining);
+            m_recv_front = 0;
+            m_recv_back = remaining;
+        }
+
+        //  Push into receive buffer.
+        size_t block = std::min(bytes, RECV_BUFFER_SIZE - m_recv_back);
+        memcpy(m_recv_buffer + m_recv_back, ptr, block);
+        m_recv_back += block;
+        ptr += block;
+        bytes -= block;
+
+        process_recv_buffer();
     }
+}
+void PABotBaseConnection::process_recv_buffer(){
+    while (m_recv_front < m_recv_back){
+        const char* message = m_recv_buffer + m_recv_front;
+        size_t available = m_recv_back - m_recv_front;
 
-    while (!m_recv_buffer.empty()){
-        uint8_t length = ~m_recv_buffer[0];
+        uint8_t length = ~message[0];
 
-        if (m_recv_buffer[0] == 0){
+        if (message[0] == 0){
 //            m_logger.log("Skipping zero byte.");
             push_error_byte(ErrorBatchType::ZERO_BYTES, 0);
-            m_recv_buffer.pop_front();
+            m_recv_front++;
             continue;
         }
 
@@ -132,7 +153,7 @@ void PABotBaseConnection::on_recv(const void* data, size_t bytes){
                 m_logger.log("Message is too short: bytes = " + std::to_string(length));
                 push_error_byte(ErrorBatchType::OTHER, ~length);
             }
-            m_recv_buffer.pop_front();
+            m_recv_front++;
             continue;
         }
 
@@ -144,27 +165,26 @@ void PABotBaseConnection::on_recv(const void* data, size_t bytes){
 //                : std::string(", char = ") + ascii;
 //            m_logger.log("Message is too long: bytes = " + std::to_string(length) + text);
             push_error_byte(ErrorBatchType::ASCII_BYTES, ~length);
-            m_recv_buffer.pop_front();
+            m_recv_front++;
             continue;
         }
 
         //  Message is incomplete.
-        if (length > m_recv_buffer.size()){
-            return;
+        if (length > available){
+            break;
         }
 
         m_current_error_type = ErrorBatchType::NO_ERROR_;
         m_current_error_batch.clear();
 
-        std::string message(m_recv_buffer.begin(), m_recv_buffer.begin() + length);
-
         //  Verify checksum
         {
             //  Calculate checksum.
-            uint32_t checksumA = pabb_crc32(0xffffffff, &message[0], length - sizeof(uint32_t));
+            uint32_t checksumA = pabb_crc32(0xffffffff, message, length - sizeof(uint32_t));
 
             //  Read the checksum from the message.
-            uint32_t checksumE = ((uint32_t*)(&message[0] + length))[-1];
+            uint32_t checksumE;
+            memcpy(&checksumE, message + length - sizeof(uint32_t), sizeof(uint32_t));
 
             //  Compare
 //            std::cout << checksumA << " / " << checksumE << std::endl;
@@ -172,16 +192,22 @@ void PABotBaseConnection::on_recv(const void* data, size_t bytes){
                 m_logger.log("Invalid Checksum: bytes = " + std::to_string(length));
 //                std::cout << checksumA << " / " << checksumE << std::endl;
 //                log(message_to_string(message[1], &message[2], length - PABB_PROTOCOL_OVERHEAD));
-                m_recv_buffer.pop_front();
+                m_recv_front++;
                 continue;
             }
         }
-        m_recv_buffer.erase(m_recv_buffer.begin(), m_recv_buffer.begin() + length);
+        m_recv_front += length;
 
-        BotBaseMessage msg(message[1], std::string(&message[2], length - PABB_PROTOCOL_OVERHEAD));
+        BotBaseMessage msg(message[1], message + 2, length - PABB_PROTOCOL_OVERHEAD);
         m_sniffer->on_recv(msg);
         on_recv_message(std::move(msg));
     }
+
+    //  Everything has been consumed. Rewind to the start of the buffer.
+    if (m_recv_front == m_recv_back){
+        m_recv_front = 0;
+        m_recv_back = 0;
+    }
 }
 
 
@@ -15,7 +15,6 @@
 #define PokemonAutomation_PABotBaseConnection_H
 
 #include <memory>
-#include <deque>
 #include "Common/Cpp/SerialConnection/StreamInterface.h"
 #include "Common/SerialPABotBase/SerialPABotBase_Protocol.h"
 #include "BotBase.h"
@@ -54,9 +53,20 @@ private:
     };
     void push_error_byte(ErrorBatchType type, char byte);
 
+    //  Parse as many complete messages as possible out of the receive buffer.
+    void process_recv_buffer();
+
 private:
+    //  Receive buffer. Bytes are appended at the back and parsed from the
+    //  front. Messages are always contiguous so the checksum is verified in
+    //  place. Any incomplete message at the end is shifted back to the start
+    //  when the buffer runs out of room. This never allocates.
+    static constexpr size_t RECV_BUFFER_SIZE = 16 * PABB_PROTOCOL_MAX_PACKET_SIZE;
+
     std::unique_ptr<StreamConnection> m_connection;
-    std::deque<char> m_recv_buffer;
+    size_t m_recv_front = 0;
+    size_t m_recv_back = 0;
+    char m_recv_buffer[RECV_BUFFER_SIZE];
 
     ErrorBatchType m_current_error_type;
     std::string m_current_error_batch;
@@ -119,6 +119,7 @@ ControllerType SerialPABotBase_Connection::refresh_controller_type(){
         CONTROLLER_TYPE_STRINGS.get_string(current_controller)
     );
     m_current_controller.store(current_controller, std::memory_order_release);
+    m_botbase->trace()->set_controller_type(current_controller);
     return current_controller;
 }
 
@@ -179,6 +180,12 @@ ControllerType SerialPABotBase_Connection::process_device(bool set_to_null_contr
         }
     }
 
+    //  Optional Features
+    m_supports_batched_reports = m_protocol >= PABB_PROTOCOL_VERSION_BATCHED_REPORTS;
+    m_logger.Logger::log(
+        std::string("Batched Controller Reports: ") + (m_supports_batched_reports ? "Supported" : "Not Supported")
+    );
+
     //  Firmware Version
     {
         m_logger.Logger::log("Checking Firmware Version...");
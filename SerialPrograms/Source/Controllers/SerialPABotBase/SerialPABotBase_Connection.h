@@ -37,6 +37,12 @@ public:
     }
     BotBaseController* botbase();
 
+    //  Device accepts multiple controller reports packed into one command.
+    //  Only valid after the connection is ready.
+    bool supports_batched_reports() const{
+        return m_supports_batched_reports;
+    }
+
     ControllerType refresh_controller_type();
 
 
@@ -53,6 +59,7 @@ private:
     std::string m_device_name;
 
     uint32_t m_protocol = 0;
+    bool m_supports_batched_reports = false;
     uint32_t m_version = 0;
     uint8_t m_program_id = 0;
     std::string m_program_name;
@@ -5,11 +5,14 @@
  */
 
 #include <string.h>
+#include <stddef.h>
+#include <algorithm>
 #include <sstream>
 #include "Common/Cpp/PrettyPrint.h"
 #include "Common/SerialPABotBase/SerialPABotBase_Messages_NS1_OemControllers.h"
 #include "Controllers/SerialPABotBase/Connection/MessageConverter.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
+#include "SerialPABotBase_Routines_NS1_OemControllers.h"
 
 //#include <iostream>
 //using std::cout;
@@ -69,6 +72,40 @@ void register_message_converters_NS1_OemControllers(){
             return ss.str();
         }
     );
+    register_message_converter(
+        PABB_MSG_COMMAND_NS1_OEM_CONTROLLER_BUTTONS_BATCH,
+        [](const std::string& body){
+            //  Disable this by default since it's very spammy.
+            if (!GlobalSettings::instance().LOG_EVERYTHING){
+                return std::string();
+            }
+            using MessageType = pabb_Message_Command_NS1_OemController_ButtonsBatch;
+            std::ostringstream ss;
+            ss << "PABB_MSG_COMMAND_NS1_OEM_CONTROLLER_BUTTONS_BATCH() - ";
+            if (body.size() < offsetof(MessageType, entries)){ ss << "(invalid size)" << std::endl; return ss.str(); }
+            MessageType params{};
+            memcpy(&params, body.c_str(), std::min(body.size(), sizeof(MessageType)));
+            size_t expected = offsetof(MessageType, entries) + params.count * sizeof(pabb_NS1_OemController_ButtonsBatchEntry);
+            if (params.count > PABB_NS1_OEM_CONTROLLER_BUTTONS_BATCH_MAX || body.size() != expected){
+                ss << "(invalid size)" << std::endl;
+                return ss.str();
+            }
+            ss << "seqnum = " << (uint64_t)params.seqnum;
+            ss << ", milliseconds = (";
+            for (uint8_t c = 0; c < params.count; c++){
+                if (c != 0){
+                    ss << ", ";
+                }
+                ss << params.entries[c].milliseconds;
+            }
+            ss << ")";
+
+            //  Do not log the contents of the command due to privacy concerns.
+            //  (people entering passwords)
+
+            return ss.str();
+        }
+    );
     register_message_converter(
         PABB_MSG_COMMAND_NS1_OEM_CONTROLLER_FULL_STATE,
         [](const std::string& body){
@@ -129,5 +166,52 @@ void register_message_converters_NS1_OemControllers(){
 
 
 
+void ButtonsBatchSender::push(
+    Milliseconds duration,
+    const pabb_NintendoSwitch_OemController_State0x30_Buttons& buttons
+){
+    //  Zero-length states are dropped by the unbatched path. Do the same here.
+    if (duration <= Milliseconds::zero()){
+        return;
+    }
+
+    if (duration > Milliseconds(65535)){
+        flush();
+        while (duration > Milliseconds::zero()){
+            Milliseconds current = std::min(duration, Milliseconds(65535));
+            m_connection.issue_request(
+                MessageControllerStateButtons((uint16_t)current.count(), buttons),
+                m_cancellable
+            );
+            duration -= current;
+        }
+        return;
+    }
+
+    m_batch.push_back((uint16_t)duration.count(), buttons);
+    if (m_batch.full()){
+        flush();
+    }
+}
+void ButtonsBatchSender::flush(){
+    if (m_batch.params.count == 0){
+        return;
+    }
+    if (m_batch.params.count == 1){
+        m_connection.issue_request(
+            MessageControllerStateButtons(
+                m_batch.params.entries[0].milliseconds,
+                m_batch.params.entries[0].buttons
+            ),
+            m_cancellable
+        );
+    }else{
+        m_connection.issue_request(m_batch, m_cancellable);
+    }
+    m_batch.params.count = 0;
+}
+
+
+
 }
 }
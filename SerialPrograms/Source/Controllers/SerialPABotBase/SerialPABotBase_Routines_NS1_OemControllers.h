@@ -7,11 +7,13 @@
 #ifndef PokemonAutomation_SerialPABotBase_ESP32_Routines_H
 #define PokemonAutomation_SerialPABotBase_ESP32_Routines_H
 
+#include <stddef.h>
 #include "Common/SerialPABotBase/SerialPABotBase_Protocol_IDs.h"
 #include "Common/SerialPABotBase/SerialPABotBase_Messages_NS1_OemControllers.h"
 #include "Controllers/ControllerTypes.h"
 #include "Controllers/SerialPABotBase/SerialPABotBase.h"
 #include "Controllers/SerialPABotBase/Connection/BotBaseMessage.h"
+#include "Controllers/SerialPABotBase/Connection/BotBase.h"
 
 namespace PokemonAutomation{
 namespace SerialPABotBase{
@@ -74,6 +76,40 @@ public:
         return BotBaseMessage(PABB_MSG_COMMAND_NS1_OEM_CONTROLLER_BUTTONS, params);
     }
 };
+class MessageControllerStateButtonsBatch : public BotBaseRequest{
+    static_assert(
+        sizeof(pabb_Message_Command_NS1_OemController_ButtonsBatch) <= BotBaseMessageBody::CAPACITY,
+        "Batched report does not fit in a single packet."
+    );
+
+public:
+    pabb_Message_Command_NS1_OemController_ButtonsBatch params;
+    MessageControllerStateButtonsBatch()
+        : BotBaseRequest(true)
+    {
+        params.seqnum = 0;
+        params.count = 0;
+    }
+    bool full() const{
+        return params.count >= PABB_NS1_OEM_CONTROLLER_BUTTONS_BATCH_MAX;
+    }
+    void push_back(
+        uint16_t milliseconds,
+        const pabb_NintendoSwitch_OemController_State0x30_Buttons& state
+    ){
+        pabb_NS1_OemController_ButtonsBatchEntry& entry = params.entries[params.count++];
+        entry.milliseconds = milliseconds;
+        entry.buttons = state;
+    }
+    virtual BotBaseMessage message() const override{
+        return BotBaseMessage(
+            PABB_MSG_COMMAND_NS1_OEM_CONTROLLER_BUTTONS_BATCH,
+            &params,
+            offsetof(pabb_Message_Command_NS1_OemController_ButtonsBatch, entries) +
+                params.count * sizeof(pabb_NS1_OemController_ButtonsBatchEntry)
+        );
+    }
+};
 class MessageControllerStateFull : public BotBaseRequest{
 public:
     pabb_Message_Command_NS1_OemController_FullState params;
@@ -96,6 +132,33 @@ public:
 
 
 
+//  Packs consecutive button states into batched commands and sends them on
+//  "connection". A batch of one is sent as a normal button command. Holds too
+//  long for a batch entry are sent on their own in 65535ms pieces.
+//
+//  Call "flush()" before sending anything else on the connection and when
+//  done so the order of the states is preserved.
+class ButtonsBatchSender{
+public:
+    ButtonsBatchSender(BotBaseController& connection, Cancellable* cancellable)
+        : m_connection(connection)
+        , m_cancellable(cancellable)
+    {}
+
+    void push(
+        Milliseconds duration,
+        const pabb_NintendoSwitch_OemController_State0x30_Buttons& buttons
+    );
+    void flush();
+
+private:
+    BotBaseController& m_connection;
+    Cancellable* m_cancellable;
+    MessageControllerStateButtonsBatch m_batch;
+};
+
+
+
 }
 }
 #endif
@@ -16,14 +16,14 @@ void KeyboardControllerWithScheduler::issue_key(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     KeyboardKey key
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = start_schedule();
     {
         if (cancellable){
             cancellable->throw_if_cancelled();
         }
         m_scheduler.issue_to_resource(
-            schedule, std::make_unique<KeyboardCommand>(key, m_seqnum++),
+            schedule, KeyboardCommand(key, m_seqnum++),
             delay, hold, cooldown
         );
     }
@@ -43,8 +43,8 @@ void KeyboardControllerWithScheduler::issue_keys(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     const std::vector<KeyboardKey>& keys
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = start_schedule();
     {
         if (cancellable){
             cancellable->throw_if_cancelled();
@@ -54,7 +54,7 @@ void KeyboardControllerWithScheduler::issue_keys(
         }
         for (KeyboardKey key : keys){
             m_scheduler.issue_to_resource(
-                schedule, std::make_unique<KeyboardCommand>(key, m_seqnum++),
+                schedule, KeyboardCommand(key, m_seqnum++),
                 WallDuration::zero(), hold, cooldown
             );
         }
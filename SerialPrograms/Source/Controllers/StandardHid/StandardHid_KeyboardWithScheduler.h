@@ -24,21 +24,18 @@ struct KeyboardControllerState{
     std::set<KeyboardKey> keys;
 };
 
+//  "value" is the order the key was pressed in.
 class KeyboardCommand : public SchedulerResource{
 public:
     KeyboardCommand(KeyboardKey key, uint64_t seqnum)
-        : SchedulerResource((size_t)key)
-        , m_seqnum(seqnum)
+        : SchedulerResource((size_t)key, seqnum)
     {}
     KeyboardKey key() const{
         return (KeyboardKey)id;
     }
     uint64_t seqnum() const{
-        return m_seqnum;
+        return value;
     }
-
-private:
-    uint64_t m_seqnum;
 };
 
 
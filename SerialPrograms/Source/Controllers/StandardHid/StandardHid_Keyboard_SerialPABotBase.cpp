@@ -89,8 +89,8 @@ void SerialPABotBase_Keyboard::replace_on_next_command(){
 
 
 void SerialPABotBase_Keyboard::wait_for_all(Cancellable* cancellable){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = start_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         m_logger.log("wait_for_all()", COLOR_DARKGREEN);
@@ -111,9 +111,8 @@ void SerialPABotBase_Keyboard::execute_state(
 ){
     std::map<KeyboardKey, uint64_t> state;
     for (const auto& item : entry.state){
-        const KeyboardCommand& key = static_cast<const KeyboardCommand&>(*item);
-//        cout << (int)key << endl;
-        state.emplace(key.key(), key.seqnum());
+//        cout << (int)item.id << endl;
+        state.emplace((KeyboardKey)item.id, item.value);
     }
 
 //    cout << "last = " << m_last_state.size() << ", now = " << state.size() << endl;
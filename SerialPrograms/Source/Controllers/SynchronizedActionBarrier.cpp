@@ -0,0 +1,160 @@
+/*  Synchronized Action Barrier
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include "Common/Cpp/AbstractLogger.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "Controller.h"
+#include "SynchronizedActionBarrier.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+//  Wake up the waiters if the scope is cancelled while they are waiting.
+class BarrierCancelListener : public Cancellable::CancelListener{
+public:
+    BarrierCancelListener(Cancellable& cancellable, std::mutex& lock, std::condition_variable& cv)
+        : m_cancellable(cancellable)
+        , m_lock(lock)
+        , m_cv(cv)
+    {
+        m_cancellable.add_cancel_listener(*this);
+    }
+    ~BarrierCancelListener(){
+        m_cancellable.remove_cancel_listener(*this);
+    }
+    virtual void on_cancellable_cancel() override{
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+        }
+        m_cv.notify_all();
+    }
+
+private:
+    Cancellable& m_cancellable;
+    std::mutex& m_lock;
+    std::condition_variable& m_cv;
+};
+
+std::string to_ms_string(WallDuration duration){
+    double ms = (double)std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / 1000;
+    return tostr_fixed(ms, 1) + " ms";
+}
+
+}
+
+
+
+SynchronizedActionBarrier::SynchronizedActionBarrier(
+    Logger& logger,
+    size_t participants,
+    Milliseconds slack
+)
+    : m_logger(logger)
+    , m_participants(participants)
+    , m_slack(slack)
+{}
+
+SynchronizedActionReport SynchronizedActionBarrier::last_report() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_last_report;
+}
+
+WallClock SynchronizedActionBarrier::run(
+    CancellableScope& scope,
+    AbstractController& controller,
+    const std::function<void()>& action
+){
+    //  Drain the queue first. Otherwise the nop below would start whenever
+    //  the current commands finish rather than when the device receives it.
+    controller.wait_for_all(&scope);
+    WallDuration latency = controller.command_latency();
+
+    //  Arrive and wait for the others.
+    WallClock release_time;
+    WallClock target;
+    {
+        BarrierCancelListener listener(scope, m_lock, m_cv);
+        std::unique_lock<std::mutex> lg(m_lock);
+        uint64_t generation = m_generation;
+        m_latencies.emplace_back(latency);
+        if (m_latencies.size() >= m_participants){
+            m_release_time = current_time();
+            m_round_latency = *std::max_element(m_latencies.begin(), m_latencies.end());
+            m_target = m_release_time + m_round_latency + m_slack;
+            m_issued = 0;
+            m_late = 0;
+            m_max_wake_delay = WallDuration::zero();
+            m_earliest_start = WallClock::max();
+            m_latest_start = WallClock::min();
+            m_latencies.clear();
+            m_generation++;
+            m_cv.notify_all();
+        }else{
+            m_cv.wait(lg, [&]{
+                return m_generation != generation || scope.cancelled();
+            });
+            if (m_generation == generation){
+                m_latencies.erase(std::find(m_latencies.begin(), m_latencies.end(), latency));
+                lg.unlock();
+                scope.throw_if_cancelled();
+            }
+        }
+        release_time = m_release_time;
+        target = m_target;
+    }
+
+    //  Pad the queue so that the action starts at the target time.
+    WallClock now = current_time();
+    Milliseconds pad = std::chrono::round<Milliseconds>(target - latency - now);
+    bool late = pad <= Milliseconds::zero();
+    if (late){
+        pad = Milliseconds::zero();
+    }else{
+        controller.issue_nop(&scope, pad);
+    }
+    WallClock start = now + latency + pad;
+    action();
+
+    //  Record this participant. The last one reports the round.
+    SynchronizedActionReport report;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_max_wake_delay = std::max(m_max_wake_delay, now - release_time);
+        m_earliest_start = std::min(m_earliest_start, start);
+        m_latest_start = std::max(m_latest_start, start);
+        if (late){
+            m_late++;
+        }
+        m_issued++;
+        if (m_issued < m_participants){
+            return start;
+        }
+        report.participants = m_participants;
+        report.max_latency = m_round_latency;
+        report.max_wake_delay = m_max_wake_delay;
+        report.skew = m_latest_start - m_earliest_start;
+        report.late = m_late;
+        m_last_report = report;
+    }
+
+    m_logger.log(
+        "SynchronizedActionBarrier: participants = " + std::to_string(report.participants) +
+        ", max latency = " + to_ms_string(report.max_latency) +
+        ", max wake delay = " + to_ms_string(report.max_wake_delay) +
+        ", skew = " + to_ms_string(report.skew) +
+        (report.late == 0 ? "" : ", late = " + std::to_string(report.late)),
+        report.late == 0 ? COLOR_BLUE : COLOR_ORANGE
+    );
+
+    return start;
+}
+
+
+
+}
@@ -0,0 +1,128 @@
+/*  Synchronized Action Barrier
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Make several controllers start an action at the same time.
+ *
+ *  Each participating program thread calls "run()" with its own controller.
+ *  Once everyone has arrived, a common target time is picked far enough
+ *  ahead that every controller can reach it. Each thread then pads its
+ *  controller's queue with a nop that ends at the target time (minus that
+ *  controller's measured command latency) and issues the action right after.
+ *
+ *  This takes thread wake-up jitter out of the picture. The wait is done by
+ *  the controller's own scheduler rather than by the threads.
+ *
+ *  Example:
+ *
+ *      SynchronizedActionBarrier barrier(env.logger(), env.consoles.size());
+ *      env.run_in_parallel(scope, [&](CancellableScope& scope, ConsoleHandle& console){
+ *          ...
+ *          barrier.run(scope, console.controller(), [&]{
+ *              pbf_press_button(context, BUTTON_A, 80ms, 0ms);
+ *          });
+ *      });
+ *
+ *  The barrier can be reused. All participants must call "run()" the same
+ *  number of times.
+ *
+ */
+
+#ifndef PokemonAutomation_Controllers_SynchronizedActionBarrier_H
+#define PokemonAutomation_Controllers_SynchronizedActionBarrier_H
+
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/CancellableScope.h"
+
+namespace PokemonAutomation{
+
+class Logger;
+class AbstractController;
+
+
+
+struct SynchronizedActionReport{
+    size_t participants = 0;
+
+    //  Largest command latency of all the controllers.
+    WallDuration max_latency = WallDuration::zero();
+
+    //  How late the slowest thread was to wake up after the last one arrived.
+    WallDuration max_wake_delay = WallDuration::zero();
+
+    //  Spread of the predicted start times of the action on the devices.
+    //  This includes the rounding of the nop and the threads that woke up too
+    //  late to hit the target time. It does not include the controllers'
+    //  own timing variation.
+    WallDuration skew = WallDuration::zero();
+
+    //  Number of controllers that could not reach the target time.
+    size_t late = 0;
+};
+
+
+
+class SynchronizedActionBarrier{
+public:
+    //  "slack" is added on top of the largest command latency when picking
+    //  the target time. It needs to cover the time for the threads to wake up
+    //  and issue the nop.
+    SynchronizedActionBarrier(
+        Logger& logger,
+        size_t participants,
+        Milliseconds slack = Milliseconds(20)
+    );
+
+    //  Wait for the controller to go idle and for all other participants to
+    //  arrive. Then issue "action" so that it starts on the device at the
+    //  common target time.
+    //
+    //  "action" should only issue commands to "controller". It runs on the
+    //  calling thread.
+    //
+    //  Returns the predicted start time of the action on this device.
+    WallClock run(
+        CancellableScope& scope,
+        AbstractController& controller,
+        const std::function<void()>& action
+    );
+
+    //  The report of the last completed round.
+    SynchronizedActionReport last_report() const;
+
+
+private:
+    Logger& m_logger;
+    const size_t m_participants;
+    const Milliseconds m_slack;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_cv;
+
+    //  Current round.
+    uint64_t m_generation = 0;
+    //  Command latencies of the participants waiting in this round. A waiter
+    //  that is cancelled takes its own back out.
+    std::vector<WallDuration> m_latencies;
+
+    //  Released round, still being issued.
+    WallClock m_release_time;
+    WallDuration m_round_latency = WallDuration::zero();
+    WallClock m_target;
+    size_t m_issued = 0;
+    size_t m_late = 0;
+    WallDuration m_max_wake_delay = WallDuration::zero();
+    WallClock m_earliest_start;
+    WallClock m_latest_start;
+
+    SynchronizedActionReport m_last_report;
+};
+
+
+
+}
+#endif
@@ -102,9 +102,27 @@ DiscordWebhookSettingsOption::DiscordWebhookSettingsOption()
         "<b>Rate Limit:</b><br>Maximum number of sends per second.",
         LockMode::LOCK_WHILE_RUNNING, 2, 1
     )
+    , coalesce_window(
+        "<b>Coalesce Window (ms):</b><br>Notifications with the same tags that are sent within "
+        "this long of each other are combined into one message.",
+        LockMode::LOCK_WHILE_RUNNING, 3000, 0, 60000
+    )
+    , max_queued(
+        "<b>Max Queued Notifications:</b><br>If more notifications than this are waiting to be sent, "
+        "new ones are dropped and counted in the next message.",
+        LockMode::LOCK_WHILE_RUNNING, 50, 1
+    )
+    , max_attachment_width(
+        "<b>Max Screenshot Width:</b><br>Screenshots that are sent (and not kept) are downscaled "
+        "to this width. Set to zero to send them at full resolution.",
+        LockMode::LOCK_WHILE_RUNNING, 1280
+    )
 {
     PA_ADD_OPTION(urls);
     PA_ADD_OPTION(sends_per_second);
+    PA_ADD_OPTION(coalesce_window);
+    PA_ADD_OPTION(max_queued);
+    PA_ADD_OPTION(max_attachment_width);
 }
 
 
@@ -48,6 +48,9 @@ public:
 
     DiscordWebhookSettingsTable urls;
     SimpleIntegerOption<uint8_t> sends_per_second;
+    SimpleIntegerOption<uint16_t> coalesce_window;
+    SimpleIntegerOption<uint16_t> max_queued;
+    SimpleIntegerOption<uint16_t> max_attachment_width;
 };
 
 
@@ -17,6 +17,8 @@ namespace AbsFFT{
 void fft_abs_Default(int k, float* abs, float* real);
 void fft_abs_x86_SSE41(int k, float* abs, float* real);
 void fft_abs_x86_AVX2(int k, float* abs, float* real);
+void fft_abs_x86_AVX512(int k, float* abs, float* real);
+void fft_abs_arm64_NEON(int k, float* abs, float* real);
 
 
 void fft_abs(int k, float* abs, float* real){
@@ -30,6 +32,12 @@ void fft_abs(int k, float* abs, float* real){
         throw "real must be aligned to 64 bytes.";
     }
 
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        fft_abs_x86_AVX512(k, abs, real);
+        return;
+    }
+#endif
 #ifdef PA_AutoDispatch_x64_13_Haswell
     if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
         fft_abs_x86_AVX2(k, abs, real);
@@ -41,6 +49,12 @@ void fft_abs(int k, float* abs, float* real){
         fft_abs_x86_SSE41(k, abs, real);
         return;
     }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        fft_abs_arm64_NEON(k, abs, real);
+        return;
+    }
 #endif
     fft_abs_Default(k, abs, real);
 }
@@ -0,0 +1,93 @@
+/*  ABS FFT Arch (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_AbsFFT_Arch_arm64_NEON_H
+#define PokemonAutomation_Kernels_AbsFFT_Arch_arm64_NEON_H
+
+#include <arm_neon.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace AbsFFT{
+struct Context_arm64_NEON{
+
+
+using vtype = float32x4_t;
+
+static const int VECTOR_K = 2;
+static const size_t VECTOR_LENGTH = (size_t)1 << VECTOR_K;
+
+static const int BASE_COMPLEX_TRANSFORM_K = 4;
+static const size_t MIN_TABLE_WIDTH = 1;
+
+
+static PA_FORCE_INLINE vtype vset1(float x){
+    return vdupq_n_f32(x);
+}
+static PA_FORCE_INLINE vtype vneg(vtype x){
+    return vnegq_f32(x);
+}
+static PA_FORCE_INLINE vtype vadd(vtype x, vtype y){
+    return vaddq_f32(x, y);
+}
+static PA_FORCE_INLINE vtype vsub(vtype x, vtype y){
+    return vsubq_f32(x, y);
+}
+static PA_FORCE_INLINE vtype vmul(vtype x, vtype y){
+    return vmulq_f32(x, y);
+}
+static PA_FORCE_INLINE void cmul_pp(
+    vtype& Xr, vtype& Xi,
+    vtype Wr, vtype Wi
+){
+    vtype t0 = vmulq_f32(Xr, Wr);
+    vtype t1 = vmulq_f32(Xi, Wr);
+    t0 = vfmsq_f32(t0, Xi, Wi);
+    Xi = vfmaq_f32(t1, Xr, Wi);
+    Xr = t0;
+}
+
+
+static PA_FORCE_INLINE vtype abs(vtype r, vtype i){
+    vtype r0 = vfmaq_f32(vmulq_f32(i, i), r, r);
+    return vsqrtq_f32(r0);
+}
+static PA_FORCE_INLINE void swap_odd(vtype& L, vtype& H){
+    //  [x0, x1, x2, x3] -> [x2, x3, x0, x1]. The odd lanes are where they
+    //  need to be for the other side.
+    const uint32x4_t ODD = {0, 0xffffffff, 0, 0xffffffff};
+    vtype r0 = vextq_f32(L, L, 2);
+    vtype r1 = vextq_f32(H, H, 2);
+    L = vbslq_f32(ODD, r1, L);
+    H = vbslq_f32(ODD, r0, H);
+}
+
+
+static PA_FORCE_INLINE void interleave_v0(
+    vtype& out0, vtype& out1,
+    vtype lo, vtype hi
+){
+    out0 = vzip1q_f32(lo, hi);
+    out1 = vzip2q_f32(lo, hi);
+}
+static PA_FORCE_INLINE void interleave_v1(
+    vtype& out0, vtype& out1,
+    vtype lo, vtype hi
+){
+    float64x2_t l = vreinterpretq_f64_f32(lo);
+    float64x2_t h = vreinterpretq_f64_f32(hi);
+    out0 = vreinterpretq_f32_f64(vzip1q_f64(l, h));
+    out1 = vreinterpretq_f32_f64(vzip2q_f64(l, h));
+}
+
+
+
+};
+}
+}
+}
+#endif
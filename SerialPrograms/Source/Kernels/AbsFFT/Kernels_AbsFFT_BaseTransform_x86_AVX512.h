@@ -0,0 +1,136 @@
+/*  ABS FFT Base Transform (x86 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_AbsFFT_BaseTransform_x86_AVX512_H
+#define PokemonAutomation_Kernels_AbsFFT_BaseTransform_x86_AVX512_H
+
+#include "Kernels_AbsFFT_Arch_x86_AVX512.h"
+#include "Kernels_AbsFFT_Butterflies.h"
+#include "Kernels_AbsFFT_ComplexVector.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace AbsFFT{
+
+//  Transpose the 128-bit blocks of 4 vectors.
+PA_FORCE_INLINE void vtranspose_x4(__m512& r0, __m512& r1, __m512& r2, __m512& r3){
+    __m512 a0 = _mm512_shuffle_f32x4(r0, r1, 68);
+    __m512 a1 = _mm512_shuffle_f32x4(r0, r1, 238);
+    __m512 a2 = _mm512_shuffle_f32x4(r2, r3, 68);
+    __m512 a3 = _mm512_shuffle_f32x4(r2, r3, 238);
+    r0 = _mm512_shuffle_f32x4(a0, a2, 136);
+    r1 = _mm512_shuffle_f32x4(a0, a2, 221);
+    r2 = _mm512_shuffle_f32x4(a1, a3, 136);
+    r3 = _mm512_shuffle_f32x4(a1, a3, 221);
+}
+//  Transpose the 4x4 blocks within each 128-bit lane of 4 vectors.
+PA_FORCE_INLINE void vtranspose_x1(__m512& r0, __m512& r1, __m512& r2, __m512& r3){
+    __m512 a0 = _mm512_unpacklo_ps(r0, r1);
+    __m512 a1 = _mm512_unpackhi_ps(r0, r1);
+    __m512 a2 = _mm512_unpacklo_ps(r2, r3);
+    __m512 a3 = _mm512_unpackhi_ps(r2, r3);
+    r0 = _mm512_shuffle_ps(a0, a2, 68);
+    r1 = _mm512_shuffle_ps(a0, a2, 238);
+    r2 = _mm512_shuffle_ps(a1, a3, 68);
+    r3 = _mm512_shuffle_ps(a1, a3, 238);
+}
+
+
+template <>
+void base_transform<Context_x86_AVX512>(const TwiddleTable<Context_x86_AVX512>& table, Context_x86_AVX512::vtype* T){
+    __m512 r0, r1, r2, r3;
+    __m512 i0, i1, i2, i3;
+
+    r0 = T[0];
+    i0 = T[1];
+    r1 = T[2];
+    i1 = T[3];
+    r2 = T[4];
+    i2 = T[5];
+    r3 = T[6];
+    i3 = T[7];
+
+    //  64 -> 16 across the vectors.
+    {
+        const vcomplex<Context_x86_AVX512>* w1 = table[5].w1.data();
+        const vcomplex<Context_x86_AVX512>* w2 = table[6].w1.data();
+        const vcomplex<Context_x86_AVX512>* w3 = table[6].w3.data();
+        Butterflies<Context_x86_AVX512>::butterfly4(
+            r0, i0,
+            r1, i1, w1[0].r, w1[0].i,
+            r2, i2, w2[0].r, w2[0].i,
+            r3, i3, w3[0].r, w3[0].i
+        );
+    }
+
+    //  16 -> 4 across the 128-bit blocks.
+    vtranspose_x4(r0, r1, r2, r3);
+    vtranspose_x4(i0, i1, i2, i3);
+    {
+        const float TW16_1 = 0.92387953251128675613f;
+        const float TW16_3 = 0.38268343236508977173f;
+        const __m512 w1r = _mm512_setr_ps(
+            1, TW8_1, 0, -TW8_1,    1, TW8_1, 0, -TW8_1,
+            1, TW8_1, 0, -TW8_1,    1, TW8_1, 0, -TW8_1
+        );
+        const __m512 w1i = _mm512_setr_ps(
+            0, TW8_1, 1, TW8_1,     0, TW8_1, 1, TW8_1,
+            0, TW8_1, 1, TW8_1,     0, TW8_1, 1, TW8_1
+        );
+        const __m512 w2r = _mm512_setr_ps(
+            1, TW16_1, TW8_1, TW16_3,   1, TW16_1, TW8_1, TW16_3,
+            1, TW16_1, TW8_1, TW16_3,   1, TW16_1, TW8_1, TW16_3
+        );
+        const __m512 w2i = _mm512_setr_ps(
+            0, TW16_3, TW8_1, TW16_1,   0, TW16_3, TW8_1, TW16_1,
+            0, TW16_3, TW8_1, TW16_1,   0, TW16_3, TW8_1, TW16_1
+        );
+        const __m512 w3r = _mm512_setr_ps(
+            1, TW16_3, -TW8_1, -TW16_1,     1, TW16_3, -TW8_1, -TW16_1,
+            1, TW16_3, -TW8_1, -TW16_1,     1, TW16_3, -TW8_1, -TW16_1
+        );
+        const __m512 w3i = _mm512_setr_ps(
+            0, TW16_1, TW8_1, -TW16_3,      0, TW16_1, TW8_1, -TW16_3,
+            0, TW16_1, TW8_1, -TW16_3,      0, TW16_1, TW8_1, -TW16_3
+        );
+        Butterflies<Context_x86_AVX512>::butterfly4(
+            r0, i0,
+            r1, i1, w1r, w1i,
+            r2, i2, w2r, w2i,
+            r3, i3, w3r, w3i
+        );
+    }
+
+    //  4 -> 1 within the 128-bit blocks.
+    vtranspose_x1(r0, r1, r2, r3);
+    vtranspose_x1(i0, i1, i2, i3);
+    Butterflies<Context_x86_AVX512>::butterfly4(
+        r0, i0,
+        r1, i1,
+        r2, i2,
+        r3, i3
+    );
+
+    vtranspose_x1(r0, r1, r2, r3);
+    vtranspose_x4(r0, r1, r2, r3);
+    T[0] = r0;
+    T[2] = r1;
+    T[4] = r2;
+    T[6] = r3;
+    vtranspose_x1(i0, i1, i2, i3);
+    vtranspose_x4(i0, i1, i2, i3);
+    T[1] = i0;
+    T[3] = i1;
+    T[5] = i2;
+    T[7] = i3;
+}
+
+
+
+}
+}
+}
+#endif
@@ -71,7 +71,8 @@ void compress_rgb32_to_binary_range_64x4_Default(
 );
 void compress_rgb32_to_binary_range_64x4_Default(
     const uint32_t* image, size_t bytes_per_row,
-    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count
+    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count,
+    size_t row_begin, size_t row_end
 );
 
 void compress_rgb32_to_binary_range_64x8_x64_SSE42(
@@ -81,7 +82,8 @@ void compress_rgb32_to_binary_range_64x8_x64_SSE42(
 );
 void compress_rgb32_to_binary_range_64x8_x64_SSE42(
     const uint32_t* image, size_t bytes_per_row,
-    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count
+    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count,
+    size_t row_begin, size_t row_end
 );
 
 void compress_rgb32_to_binary_range_64x16_x64_AVX2(
@@ -91,7 +93,8 @@ void compress_rgb32_to_binary_range_64x16_x64_AVX2(
 );
 void compress_rgb32_to_binary_range_64x16_x64_AVX2(
     const uint32_t* image, size_t bytes_per_row,
-    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count
+    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count,
+    size_t row_begin, size_t row_end
 );
 
 void compress_rgb32_to_binary_range_64x32_x64_AVX512(
@@ -101,7 +104,8 @@ void compress_rgb32_to_binary_range_64x32_x64_AVX512(
 );
 void compress_rgb32_to_binary_range_64x32_x64_AVX512(
     const uint32_t* image, size_t bytes_per_row,
-    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count
+    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count,
+    size_t row_begin, size_t row_end
 );
 
 void compress_rgb32_to_binary_range_64x64_x64_AVX512(
@@ -111,7 +115,8 @@ void compress_rgb32_to_binary_range_64x64_x64_AVX512(
 );
 void compress_rgb32_to_binary_range_64x64_x64_AVX512(
     const uint32_t* image, size_t bytes_per_row,
-    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count
+    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count,
+    size_t row_begin, size_t row_end
 );
 
 void compress_rgb32_to_binary_range_64x8_arm64_NEON(
@@ -120,7 +125,8 @@ void compress_rgb32_to_binary_range_64x8_arm64_NEON(
 );
 void compress_rgb32_to_binary_range_64x8_arm64_NEON(
     const uint32_t* image, size_t bytes_per_row,
-    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count
+    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count,
+    size_t row_begin, size_t row_end
 );
 
 void compress_rgb32_to_binary_range(
@@ -166,6 +172,20 @@ void compress_rgb32_to_binary_range(
     if (filter_count == 0){
         return;
     }
+    compress_rgb32_to_binary_range(
+        image, bytes_per_row,
+        filters, filter_count,
+        0, filters[0].matrix.height()
+    );
+}
+void compress_rgb32_to_binary_range(
+    const uint32_t* image, size_t bytes_per_row,
+    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count,
+    size_t row_begin, size_t row_end
+){
+    if (filter_count == 0 || row_begin >= row_end){
+        return;
+    }
     BinaryMatrixType type = filters[0].matrix.type();
     for (size_t c = 1; c < filter_count; c++){
         if (type != filters[c].matrix.type()){
@@ -175,29 +195,29 @@ void compress_rgb32_to_binary_range(
     switch (type){
 #ifdef PA_AutoDispatch_x64_17_Skylake
     case BinaryMatrixType::i64x64_x64_AVX512:
-        compress_rgb32_to_binary_range_64x64_x64_AVX512(image, bytes_per_row, filters, filter_count);
+        compress_rgb32_to_binary_range_64x64_x64_AVX512(image, bytes_per_row, filters, filter_count, row_begin, row_end);
         return;
     case BinaryMatrixType::i64x32_x64_AVX512:
-        compress_rgb32_to_binary_range_64x32_x64_AVX512(image, bytes_per_row, filters, filter_count);
+        compress_rgb32_to_binary_range_64x32_x64_AVX512(image, bytes_per_row, filters, filter_count, row_begin, row_end);
         return;
 #endif
 #ifdef PA_AutoDispatch_x64_13_Haswell
     case BinaryMatrixType::i64x16_x64_AVX2:
-        compress_rgb32_to_binary_range_64x16_x64_AVX2(image, bytes_per_row, filters, filter_count);
+        compress_rgb32_to_binary_range_64x16_x64_AVX2(image, bytes_per_row, filters, filter_count, row_begin, row_end);
         return;
 #endif
 #ifdef PA_AutoDispatch_x64_08_Nehalem
     case BinaryMatrixType::i64x8_x64_SSE42:
-        compress_rgb32_to_binary_range_64x8_x64_SSE42(image, bytes_per_row, filters, filter_count);
+        compress_rgb32_to_binary_range_64x8_x64_SSE42(image, bytes_per_row, filters, filter_count, row_begin, row_end);
         return;
 #endif
 #ifdef PA_AutoDispatch_arm64_20_M1
     case BinaryMatrixType::arm64x8_x64_NEON:
-        compress_rgb32_to_binary_range_64x8_arm64_NEON(image, bytes_per_row, filters, filter_count);
+        compress_rgb32_to_binary_range_64x8_arm64_NEON(image, bytes_per_row, filters, filter_count, row_begin, row_end);
         return;
 #endif
     case BinaryMatrixType::i64x4_Default:
-        compress_rgb32_to_binary_range_64x4_Default(image, bytes_per_row, filters, filter_count);
+        compress_rgb32_to_binary_range_64x4_Default(image, bytes_per_row, filters, filter_count, row_begin, row_end);
         return;
     default:
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unsupported matrix format.");
@@ -76,6 +76,14 @@ void compress_rgb32_to_binary_range(
     const uint32_t* image, size_t bytes_per_row,
     CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count
 );
+//  Same as above, but only fill rows [`row_begin`, `row_end`) of the matrices.
+//  `image` still points to row 0. Calls on disjoint row ranges of the same
+//  matrices may run in parallel.
+void compress_rgb32_to_binary_range(
+    const uint32_t* image, size_t bytes_per_row,
+    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count,
+    size_t row_begin, size_t row_end
+);
 
 
 
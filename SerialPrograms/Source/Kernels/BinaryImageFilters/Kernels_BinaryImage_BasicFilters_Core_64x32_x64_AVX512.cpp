@@ -39,10 +39,11 @@ void compress_rgb32_to_binary_range_64x32_x64_AVX512(
 }
 void compress_rgb32_to_binary_range_64x32_x64_AVX512(
     const uint32_t* image, size_t bytes_per_row,
-    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count
+    CompressRgb32ToBinaryRangeFilter* filters, size_t filter_count,
+    size_t row_begin, size_t row_end
 ){
     compress_rgb32_to_binary<PackedBinaryMatrix_64x32_x64_AVX512, Compressor_RgbRange_x64_AVX512>(
-        image, bytes_per_row, filters, filter_count
+        image, bytes_per_row, filters, filter_count, row_begin, row_end
     );
 }
 
@@ -9,6 +9,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <algorithm>
 #include "Common/Cpp/Containers/FixedLimitVector.tpp"
 #include "Kernels_BinaryImage_BasicFilters.h"
 
@@ -86,7 +87,8 @@ struct CompressRgb32ToBinaryRangeEntry{
 template <typename BinaryMatrixType, typename Compressor>
 void compress_rgb32_to_binary(
     const uint32_t* image, size_t bytes_per_row,
-    CompressRgb32ToBinaryRangeFilter* filter, size_t filter_count
+    CompressRgb32ToBinaryRangeFilter* filter, size_t filter_count,
+    size_t row_begin, size_t row_end
 ){
     using Entry = CompressRgb32ToBinaryRangeEntry<BinaryMatrixType, Compressor>;
     FixedLimitVector<Entry> entries(filter_count);
@@ -95,8 +97,9 @@ void compress_rgb32_to_binary(
     }
 
     size_t bit_width = entries[0].matrix.get().width();
-    size_t word_height = entries[0].matrix.get().word64_height();
-    for (size_t r = 0; r < word_height; r++){
+    row_end = std::min(row_end, entries[0].matrix.get().word64_height());
+    image = (const uint32_t*)((const char*)image + row_begin * bytes_per_row);
+    for (size_t r = row_begin; r < row_end; r++){
         const uint32_t* img = image;
         size_t c = 0;
         size_t left = bit_width;
@@ -0,0 +1,106 @@
+/*  Image Scale
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImageScale_Tables.h"
+#include "Kernels_ImageScale.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace ImageScale{
+
+
+using ScaleFunction = void (*)(
+    const ScaleAxis& x_axis, const ScaleAxis& y_axis,
+    const uint32_t* src, size_t src_bytes_per_row,
+    uint32_t* dst, size_t dst_bytes_per_row
+);
+
+void scale_image_nearest_Default        (const ScaleAxis&, const ScaleAxis&, const uint32_t*, size_t, uint32_t*, size_t);
+void scale_image_weighted_Default       (const ScaleAxis&, const ScaleAxis&, const uint32_t*, size_t, uint32_t*, size_t);
+void scale_image_nearest_x64_SSE41      (const ScaleAxis&, const ScaleAxis&, const uint32_t*, size_t, uint32_t*, size_t);
+void scale_image_weighted_x64_SSE41     (const ScaleAxis&, const ScaleAxis&, const uint32_t*, size_t, uint32_t*, size_t);
+void scale_image_nearest_x64_AVX2       (const ScaleAxis&, const ScaleAxis&, const uint32_t*, size_t, uint32_t*, size_t);
+void scale_image_weighted_x64_AVX2      (const ScaleAxis&, const ScaleAxis&, const uint32_t*, size_t, uint32_t*, size_t);
+void scale_image_nearest_x64_AVX512     (const ScaleAxis&, const ScaleAxis&, const uint32_t*, size_t, uint32_t*, size_t);
+void scale_image_weighted_x64_AVX512    (const ScaleAxis&, const ScaleAxis&, const uint32_t*, size_t, uint32_t*, size_t);
+
+
+ScaleFunction get_nearest_function(){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        return scale_image_nearest_x64_AVX512;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        return scale_image_nearest_x64_AVX2;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        return scale_image_nearest_x64_SSE41;
+    }
+#endif
+    return scale_image_nearest_Default;
+}
+ScaleFunction get_weighted_function(){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        return scale_image_weighted_x64_AVX512;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        return scale_image_weighted_x64_AVX2;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        return scale_image_weighted_x64_SSE41;
+    }
+#endif
+    return scale_image_weighted_Default;
+}
+
+
+}
+
+
+
+void scale_image(
+    ImageScaleFilter filter,
+    const uint32_t* src, size_t src_bytes_per_row, size_t src_width, size_t src_height,
+    uint32_t* dst, size_t dst_bytes_per_row, size_t dst_width, size_t dst_height
+){
+    if (src_width == 0 || src_height == 0 || dst_width == 0 || dst_height == 0){
+        return;
+    }
+
+    //  Same size. Just copy.
+    if (src_width == dst_width && src_height == dst_height){
+        for (size_t r = 0; r < dst_height; r++){
+            memcpy(dst, src, dst_width * sizeof(uint32_t));
+            src = (const uint32_t*)((const char*)src + src_bytes_per_row);
+            dst = (uint32_t*)((char*)dst + dst_bytes_per_row);
+        }
+        return;
+    }
+
+    std::shared_ptr<const ImageScale::ScaleAxis> x_axis = ImageScale::get_scale_axis(filter, src_width, dst_width);
+    std::shared_ptr<const ImageScale::ScaleAxis> y_axis = ImageScale::get_scale_axis(filter, src_height, dst_height);
+
+    ImageScale::ScaleFunction function = filter == ImageScaleFilter::NEAREST
+        ? ImageScale::get_nearest_function()
+        : ImageScale::get_weighted_function();
+    function(*x_axis, *y_axis, src, src_bytes_per_row, dst, dst_bytes_per_row);
+}
+
+
+
+}
+}
@@ -0,0 +1,53 @@
+/*  Image Scale
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Resample an RGB32 image to a different size.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageScale_H
+#define PokemonAutomation_Kernels_ImageScale_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+enum class ImageScaleFilter{
+    //  Pick the closest source pixel. This follows the sampling of
+    //  QImage::scaled() with Qt::FastTransformation. A few rows or columns
+    //  may come from the neighboring source pixel.
+    NEAREST,
+
+    //  Interpolate between the 2x2 closest source pixels.
+    BILINEAR,
+
+    //  Average all the source pixels covered by each output pixel.
+    //  Use this for shrinking. When enlarging, this is the same as BILINEAR.
+    AREA,
+};
+
+
+//  Scale "src" (src_width x src_height) into "dst" (dst_width x dst_height).
+//  All 4 channels (including alpha) are resampled the same way.
+//
+//  "dst" is provided by the caller. Nothing is allocated except for the
+//  coefficient tables of each axis. Each thread keeps its own cache of the
+//  64 most recently used tables, so a table is built the first time a thread
+//  sees a (filter, src, dst) length or after it has been evicted.
+//
+//  "src" and "dst" must not overlap.
+void scale_image(
+    ImageScaleFilter filter,
+    const uint32_t* src, size_t src_bytes_per_row, size_t src_width, size_t src_height,
+    uint32_t* dst, size_t dst_bytes_per_row, size_t dst_width, size_t dst_height
+);
+
+
+
+}
+}
+#endif
@@ -0,0 +1,89 @@
+/*  Image Scale (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <stdint.h>
+#include <cmath>
+#include <algorithm>
+#include "Kernels_ImageScale_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace ImageScale{
+
+
+struct Context_Default{
+    static PA_FORCE_INLINE void nearest_row(
+        size_t length, const uint32_t* first,
+        const uint32_t* src, uint32_t* dst
+    ){
+        for (size_t c = 0; c < length; c++){
+            dst[c] = src[first[c]];
+        }
+    }
+
+    static PA_FORCE_INLINE uint32_t weighted_pixel(
+        const uint32_t* src, size_t bytes_per_row,
+        size_t x_taps, const float* x_weights,
+        size_t y_taps, const float* y_weights
+    ){
+        float sum[4] = {};
+        for (size_t j = 0; j < y_taps; j++){
+            float row[4] = {};
+            for (size_t i = 0; i < x_taps; i++){
+                uint32_t pixel = src[i];
+                float weight = x_weights[4*i];
+                row[0] += weight * (float)(pixel & 0xff);
+                row[1] += weight * (float)((pixel >> 8) & 0xff);
+                row[2] += weight * (float)((pixel >> 16) & 0xff);
+                row[3] += weight * (float)(pixel >> 24);
+            }
+            float weight = y_weights[4*j];
+            sum[0] += weight * row[0];
+            sum[1] += weight * row[1];
+            sum[2] += weight * row[2];
+            sum[3] += weight * row[3];
+            src = (const uint32_t*)((const char*)src + bytes_per_row);
+        }
+
+        uint32_t pixel = 0;
+        for (size_t c = 0; c < 4; c++){
+            float value = std::min(std::max(std::nearbyint(sum[c]), 0.0f), 255.0f);
+            pixel |= (uint32_t)value << (8 * c);
+        }
+        return pixel;
+    }
+};
+
+
+
+void scale_image_nearest_Default(
+    const ScaleAxis& x_axis, const ScaleAxis& y_axis,
+    const uint32_t* src, size_t src_bytes_per_row,
+    uint32_t* dst, size_t dst_bytes_per_row
+){
+    scale_image_nearest<Context_Default>(
+        x_axis, y_axis,
+        src, src_bytes_per_row,
+        dst, dst_bytes_per_row
+    );
+}
+void scale_image_weighted_Default(
+    const ScaleAxis& x_axis, const ScaleAxis& y_axis,
+    const uint32_t* src, size_t src_bytes_per_row,
+    uint32_t* dst, size_t dst_bytes_per_row
+){
+    scale_image_weighted<Context_Default>(
+        x_axis, y_axis,
+        src, src_bytes_per_row,
+        dst, dst_bytes_per_row
+    );
+}
+
+
+
+}
+}
+}
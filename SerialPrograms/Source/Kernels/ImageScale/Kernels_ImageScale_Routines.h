@@ -0,0 +1,78 @@
+/*  Image Scale Routines
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      The row/column loops shared by all the architectures.
+ *
+ *  "Context" provides:
+ *
+ *      //  dst[c] = src[first[c]] for c in [0, length)
+ *      static void nearest_row(
+ *          size_t length, const uint32_t* first,
+ *          const uint32_t* src, uint32_t* dst
+ *      );
+ *
+ *      //  One output pixel from a window of "x_taps" x "y_taps" source pixels
+ *      //  starting at "src".
+ *      static uint32_t weighted_pixel(
+ *          const uint32_t* src, size_t bytes_per_row,
+ *          size_t x_taps, const float* x_weights,
+ *          size_t y_taps, const float* y_weights
+ *      );
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageScale_Routines_H
+#define PokemonAutomation_Kernels_ImageScale_Routines_H
+
+#include "Common/Compiler.h"
+#include "Kernels_ImageScale_Tables.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace ImageScale{
+
+
+
+template <typename Context>
+void scale_image_nearest(
+    const ScaleAxis& x_axis, const ScaleAxis& y_axis,
+    const uint32_t* src, size_t src_bytes_per_row,
+    uint32_t* dst, size_t dst_bytes_per_row
+){
+    for (size_t r = 0; r < y_axis.dst_length; r++){
+        const uint32_t* src_row = (const uint32_t*)((const char*)src + y_axis.first[r] * src_bytes_per_row);
+        Context::nearest_row(x_axis.dst_length, x_axis.first.data(), src_row, dst);
+        dst = (uint32_t*)((char*)dst + dst_bytes_per_row);
+    }
+}
+
+
+template <typename Context>
+void scale_image_weighted(
+    const ScaleAxis& x_axis, const ScaleAxis& y_axis,
+    const uint32_t* src, size_t src_bytes_per_row,
+    uint32_t* dst, size_t dst_bytes_per_row
+){
+    const size_t x_taps = x_axis.taps;
+    const size_t y_taps = y_axis.taps;
+    for (size_t r = 0; r < y_axis.dst_length; r++){
+        const uint32_t* src_row = (const uint32_t*)((const char*)src + y_axis.first[r] * src_bytes_per_row);
+        const float* y_weights = y_axis.weights_for(r);
+        for (size_t c = 0; c < x_axis.dst_length; c++){
+            dst[c] = Context::weighted_pixel(
+                src_row + x_axis.first[c], src_bytes_per_row,
+                x_taps, x_axis.weights_for(c),
+                y_taps, y_weights
+            );
+        }
+        dst = (uint32_t*)((char*)dst + dst_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+}
+#endif
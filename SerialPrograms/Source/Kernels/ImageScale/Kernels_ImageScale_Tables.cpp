@@ -0,0 +1,205 @@
+/*  Image Scale Tables
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <cmath>
+#include <map>
+#include <list>
+#include <tuple>
+#include <algorithm>
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Kernels_ImageScale_Tables.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace ImageScale{
+
+
+
+namespace{
+
+
+//  This follows the stepping of QImage::scaled() with FastTransformation. The
+//  inverse scale is a 16.16 fixed-point step computed in floating-point, and
+//  sampling starts one unit short of half a step in. Tested against Qt 6.11
+//  this picks the same source pixels for almost every size. Qt occasionally
+//  recomputes the position partway through (e.g. very wide outputs), so a
+//  few rows or columns can come from the neighboring source pixel.
+void build_nearest(ScaleAxis& axis){
+    const uint64_t step = (uint64_t)(65536.0 / ((double)axis.dst_length / (double)axis.src_length));
+    axis.taps = 1;
+    axis.first.resize(axis.dst_length);
+    uint64_t position = step / 2 == 0 ? 0 : step / 2 - 1;
+    for (size_t c = 0; c < axis.dst_length; c++){
+        axis.first[c] = (uint32_t)std::min<uint64_t>(position >> 16, axis.src_length - 1);
+        position += step;
+    }
+}
+
+
+//  Contributions of source pixels to one output pixel.
+struct Contribution{
+    size_t start;
+    std::vector<float> weights;
+};
+
+Contribution bilinear_contribution(size_t src_length, size_t dst_length, size_t index){
+    //  Pixel centers are aligned.
+    double position = ((double)index + 0.5) * (double)src_length / (double)dst_length - 0.5;
+    position = std::max(position, 0.0);
+    size_t start = (size_t)position;
+    if (start + 1 >= src_length){
+        return Contribution{src_length - 1, {1.0f}};
+    }
+    float fraction = (float)(position - (double)start);
+    return Contribution{start, {1.0f - fraction, fraction}};
+}
+
+Contribution area_contribution(size_t src_length, size_t dst_length, size_t index){
+    //  The output pixel covers [begin, end) in source coordinates.
+    const double ratio = (double)src_length / (double)dst_length;
+    const double begin = (double)index * ratio;
+    const double end = std::min((double)(index + 1) * ratio, (double)src_length);
+
+    Contribution ret;
+    ret.start = (size_t)begin;
+    size_t stop = std::min((size_t)std::ceil(end), src_length);
+    for (size_t c = ret.start; c < stop; c++){
+        double overlap = std::min(end, (double)(c + 1)) - std::max(begin, (double)c);
+        ret.weights.emplace_back((float)(overlap / ratio));
+    }
+
+    //  Drop the slivers at the edges that are only there due to rounding.
+    while (ret.weights.size() > 1 && ret.weights.back() < 1e-6f){
+        ret.weights.pop_back();
+    }
+    return ret;
+}
+
+void build_weighted(ScaleAxis& axis, ImageScaleFilter filter){
+    const bool area = filter == ImageScaleFilter::AREA && axis.src_length > axis.dst_length;
+
+    std::vector<Contribution> contributions;
+    contributions.reserve(axis.dst_length);
+    size_t taps = 1;
+    for (size_t c = 0; c < axis.dst_length; c++){
+        contributions.emplace_back(
+            area
+                ? area_contribution(axis.src_length, axis.dst_length, c)
+                : bilinear_contribution(axis.src_length, axis.dst_length, c)
+        );
+        taps = std::max(taps, contributions.back().weights.size());
+    }
+    taps = std::min(taps, axis.src_length);
+
+    axis.taps = taps;
+    axis.first.resize(axis.dst_length);
+    axis.weights = AlignedVector<float>(axis.dst_length * taps * 4);
+    std::fill(axis.weights.begin(), axis.weights.end(), 0.0f);
+
+    for (size_t c = 0; c < axis.dst_length; c++){
+        const Contribution& contribution = contributions[c];
+
+        //  Keep the whole window inside the source.
+        size_t first = std::min(contribution.start, axis.src_length - taps);
+        axis.first[c] = (uint32_t)first;
+
+        //  Normalize so that flat areas stay exactly flat.
+        float sum = 0;
+        for (float weight : contribution.weights){
+            sum += weight;
+        }
+
+        float* weights = axis.weights.data() + c * taps * 4;
+        for (size_t i = 0; i < contribution.weights.size(); i++){
+            float weight = contribution.weights[i] / sum;
+            float* ptr = weights + (contribution.start + i - first) * 4;
+            ptr[0] = weight;
+            ptr[1] = weight;
+            ptr[2] = weight;
+            ptr[3] = weight;
+        }
+    }
+}
+
+
+std::shared_ptr<const ScaleAxis> build_scale_axis(
+    ImageScaleFilter filter,
+    size_t src_length, size_t dst_length
+){
+    auto axis = std::make_shared<ScaleAxis>();
+    axis->src_length = src_length;
+    axis->dst_length = dst_length;
+    if (filter == ImageScaleFilter::NEAREST){
+        build_nearest(*axis);
+    }else{
+        build_weighted(*axis, filter);
+    }
+    return axis;
+}
+
+
+//  Least-recently-used cache of tables. There is one per thread, so lookups
+//  don't need a lock.
+class ScaleAxisCache{
+public:
+    //  Template matching scales crops of many different sizes. Don't let the
+    //  cache grow forever. Tables that are still in use stay alive through
+    //  their shared_ptr.
+    static constexpr size_t MAX_CACHED_TABLES = 64;
+
+    std::shared_ptr<const ScaleAxis> get(
+        ImageScaleFilter filter,
+        size_t src_length, size_t dst_length
+    ){
+        Key key(filter, src_length, dst_length);
+        auto iter = m_map.find(key);
+        if (iter != m_map.end()){
+            m_entries.splice(m_entries.begin(), m_entries, iter->second);
+            return iter->second->second;
+        }
+
+        std::shared_ptr<const ScaleAxis> axis = build_scale_axis(filter, src_length, dst_length);
+        m_entries.emplace_front(key, axis);
+        try{
+            m_map.emplace(key, m_entries.begin());
+        }catch (...){
+            m_entries.pop_front();
+            throw;
+        }
+        if (m_entries.size() > MAX_CACHED_TABLES){
+            m_map.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+        return axis;
+    }
+
+private:
+    using Key = std::tuple<ImageScaleFilter, size_t, size_t>;
+    using Entry = std::pair<Key, std::shared_ptr<const ScaleAxis>>;
+
+    //  Most recently used first.
+    std::list<Entry> m_entries;
+    std::map<Key, std::list<Entry>::iterator> m_map;
+};
+
+
+}
+
+
+
+std::shared_ptr<const ScaleAxis> get_scale_axis(
+    ImageScaleFilter filter,
+    size_t src_length, size_t dst_length
+){
+    thread_local ScaleAxisCache cache;
+    return cache.get(filter, src_length, dst_length);
+}
+
+
+
+}
+}
+}
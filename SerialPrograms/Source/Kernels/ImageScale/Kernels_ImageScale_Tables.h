@@ -0,0 +1,68 @@
+/*  Image Scale Tables
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Precomputed sampling coefficients for one axis of an image scale.
+ *
+ *  Scaling is separable. So each output pixel (x, y) is:
+ *
+ *      sum over i, j of:
+ *          y_axis.weight(y, j) * x_axis.weight(x, i) *
+ *          src(x_axis.first[x] + i, y_axis.first[y] + j)
+ *
+ *  Both axes of a (src, dst) size pair are computed once and then cached per
+ *  thread.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageScale_Tables_H
+#define PokemonAutomation_Kernels_ImageScale_Tables_H
+
+#include <memory>
+#include <vector>
+#include "Common/Cpp/Containers/AlignedVector.h"
+#include "Kernels_ImageScale.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace ImageScale{
+
+
+struct ScaleAxis{
+    size_t src_length = 0;
+    size_t dst_length = 0;
+
+    //  Number of source pixels that contribute to each output pixel.
+    //  Output pixels that need fewer have zero weights for the rest.
+    //  It is always 1 for NEAREST.
+    size_t taps = 0;
+
+    //  The first contributing source pixel for each output pixel.
+    //  "first[c] + taps <= src_length" for all "c".
+    std::vector<uint32_t> first;
+
+    //  "taps" weights for each output pixel. Each weight is repeated 4 times
+    //  (once for each channel) so that the kernels can load them directly.
+    //  The weights of each output pixel add up to 1.
+    //  Empty for NEAREST.
+    AlignedVector<float> weights;
+
+    const float* weights_for(size_t index) const{
+        return weights.data() + index * taps * 4;
+    }
+};
+
+
+//  Get the table for scaling "src_length" pixels into "dst_length" pixels.
+//  Each thread keeps its own LRU cache of tables. This is thread-safe.
+std::shared_ptr<const ScaleAxis> get_scale_axis(
+    ImageScaleFilter filter,
+    size_t src_length, size_t dst_length
+);
+
+
+
+}
+}
+}
+#endif
@@ -0,0 +1,99 @@
+/*  Image Scale (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <stdint.h>
+#include <immintrin.h>
+#include "Kernels_ImageScale_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace ImageScale{
+
+
+struct Context_x64_AVX2{
+    static PA_FORCE_INLINE void nearest_row(
+        size_t length, const uint32_t* first,
+        const uint32_t* src, uint32_t* dst
+    ){
+        size_t c = 0;
+        for (; c + 8 <= length; c += 8){
+            __m256i index = _mm256_loadu_si256((const __m256i*)(first + c));
+            __m256i pixels = _mm256_i32gather_epi32((const int*)src, index, 4);
+            _mm256_storeu_si256((__m256i*)(dst + c), pixels);
+        }
+        for (; c < length; c++){
+            dst[c] = src[first[c]];
+        }
+    }
+
+    static PA_FORCE_INLINE uint32_t weighted_pixel(
+        const uint32_t* src, size_t bytes_per_row,
+        size_t x_taps, const float* x_weights,
+        size_t y_taps, const float* y_weights
+    ){
+        __m128 sum = _mm_setzero_ps();
+        for (size_t j = 0; j < y_taps; j++){
+            //  2 taps at a time.
+            __m256 row2 = _mm256_setzero_ps();
+            size_t i = 0;
+            for (; i + 2 <= x_taps; i += 2){
+                __m256 pixels = _mm256_cvtepi32_ps(
+                    _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i)))
+                );
+                row2 = _mm256_fmadd_ps(_mm256_loadu_ps(x_weights + 4*i), pixels, row2);
+            }
+            __m128 row = _mm_add_ps(
+                _mm256_castps256_ps128(row2),
+                _mm256_extractf128_ps(row2, 1)
+            );
+            if (i < x_taps){
+                __m128 pixel = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(src[i])));
+                row = _mm_fmadd_ps(_mm_load_ps(x_weights + 4*i), pixel, row);
+            }
+            sum = _mm_fmadd_ps(_mm_load_ps(y_weights + 4*j), row, sum);
+            src = (const uint32_t*)((const char*)src + bytes_per_row);
+        }
+
+        __m128i pixel = _mm_cvtps_epi32(sum);
+        pixel = _mm_packus_epi32(pixel, pixel);
+        pixel = _mm_packus_epi16(pixel, pixel);
+        return _mm_cvtsi128_si32(pixel);
+    }
+};
+
+
+
+void scale_image_nearest_x64_AVX2(
+    const ScaleAxis& x_axis, const ScaleAxis& y_axis,
+    const uint32_t* src, size_t src_bytes_per_row,
+    uint32_t* dst, size_t dst_bytes_per_row
+){
+    scale_image_nearest<Context_x64_AVX2>(
+        x_axis, y_axis,
+        src, src_bytes_per_row,
+        dst, dst_bytes_per_row
+    );
+}
+void scale_image_weighted_x64_AVX2(
+    const ScaleAxis& x_axis, const ScaleAxis& y_axis,
+    const uint32_t* src, size_t src_bytes_per_row,
+    uint32_t* dst, size_t dst_bytes_per_row
+){
+    scale_image_weighted<Context_x64_AVX2>(
+        x_axis, y_axis,
+        src, src_bytes_per_row,
+        dst, dst_bytes_per_row
+    );
+}
+
+
+
+}
+}
+}
+#endif
@@ -0,0 +1,84 @@
+/*  Image Scale (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <stdint.h>
+#include <smmintrin.h>
+#include "Kernels_ImageScale_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace ImageScale{
+
+
+struct Context_x64_SSE41{
+    static PA_FORCE_INLINE void nearest_row(
+        size_t length, const uint32_t* first,
+        const uint32_t* src, uint32_t* dst
+    ){
+        for (size_t c = 0; c < length; c++){
+            dst[c] = src[first[c]];
+        }
+    }
+
+    static PA_FORCE_INLINE __m128 load_pixel(const uint32_t* pixel){
+        return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(*pixel)));
+    }
+
+    static PA_FORCE_INLINE uint32_t weighted_pixel(
+        const uint32_t* src, size_t bytes_per_row,
+        size_t x_taps, const float* x_weights,
+        size_t y_taps, const float* y_weights
+    ){
+        __m128 sum = _mm_setzero_ps();
+        for (size_t j = 0; j < y_taps; j++){
+            __m128 row = _mm_setzero_ps();
+            for (size_t i = 0; i < x_taps; i++){
+                row = _mm_add_ps(row, _mm_mul_ps(_mm_load_ps(x_weights + 4*i), load_pixel(src + i)));
+            }
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(y_weights + 4*j), row));
+            src = (const uint32_t*)((const char*)src + bytes_per_row);
+        }
+
+        __m128i pixel = _mm_cvtps_epi32(sum);
+        pixel = _mm_packus_epi32(pixel, pixel);
+        pixel = _mm_packus_epi16(pixel, pixel);
+        return _mm_cvtsi128_si32(pixel);
+    }
+};
+
+
+
+void scale_image_nearest_x64_SSE41(
+    const ScaleAxis& x_axis, const ScaleAxis& y_axis,
+    const uint32_t* src, size_t src_bytes_per_row,
+    uint32_t* dst, size_t dst_bytes_per_row
+){
+    scale_image_nearest<Context_x64_SSE41>(
+        x_axis, y_axis,
+        src, src_bytes_per_row,
+        dst, dst_bytes_per_row
+    );
+}
+void scale_image_weighted_x64_SSE41(
+    const ScaleAxis& x_axis, const ScaleAxis& y_axis,
+    const uint32_t* src, size_t src_bytes_per_row,
+    uint32_t* dst, size_t dst_bytes_per_row
+){
+    scale_image_weighted<Context_x64_SSE41>(
+        x_axis, y_axis,
+        src, src_bytes_per_row,
+        dst, dst_bytes_per_row
+    );
+}
+
+
+
+}
+}
+}
+#endif
@@ -0,0 +1,65 @@
+/*  Pixel Summed-Area Table
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImagePixelIntegral.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void pixel_integral_Default(
+    const PixelIntegral& table,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+);
+void pixel_integral_x64_SSE41(
+    const PixelIntegral& table,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+);
+void pixel_integral_x64_AVX2(
+    const PixelIntegral& table,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+);
+
+
+void pixel_integral(
+    const PixelIntegral& table,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+){
+    if (width == 0 || height == 0){
+        return;
+    }
+    //  The squares of each row are summed in 32 bits.
+    if (width > 65535){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
+    }
+    if (table.stride < pixel_integral_stride(width)){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Table is too narrow: " + std::to_string(table.stride));
+    }
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        pixel_integral_x64_AVX2(table, width, height, image, image_bytes_per_row);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        pixel_integral_x64_SSE41(table, width, height, image, image_bytes_per_row);
+        return;
+    }
+#endif
+    pixel_integral_Default(table, width, height, image, image_bytes_per_row);
+}
+
+
+
+}
+}
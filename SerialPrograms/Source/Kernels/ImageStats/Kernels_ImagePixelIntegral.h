@@ -0,0 +1,62 @@
+/*  Pixel Summed-Area Table
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Build per-channel summed-area tables (integral images) of the sums
+ *  and sums of squares that "pixel_sum_sqr()" computes, so that the sums of
+ *  any box can be looked up with 4 reads per channel.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImagePixelIntegral_H
+#define PokemonAutomation_Kernels_ImagePixelIntegral_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//
+//  Each plane has (height + 1) rows of "stride" entries. Entry (x, y) is the
+//  total over all pixels above and to the left of pixel (x, y). So row 0 and
+//  column 0 are all zero.
+//
+//  Like "pixel_sum_sqr()", pixels with alpha < 128 are excluded.
+//
+//  The counts and sums are 32-bit and wrap around. The difference between
+//  entries is still exact as long as the box it covers has less than 2^24
+//  pixels. The squares don't fit and are 64-bit.
+//
+struct PixelIntegral{
+    size_t stride = 0;
+    uint32_t* count = nullptr;
+    uint32_t* sumR = nullptr;
+    uint32_t* sumG = nullptr;
+    uint32_t* sumB = nullptr;
+    uint64_t* sqrR = nullptr;
+    uint64_t* sqrG = nullptr;
+    uint64_t* sqrB = nullptr;
+};
+
+
+//  Fill rows [1, height] and columns [1, width] of "table" from "image".
+//  The caller zeros row 0 and column 0.
+//
+//  The vector versions fill whole vectors. So columns past "width" up to
+//  the next multiple of 8 may be overwritten with garbage. "table.stride"
+//  must be at least "pixel_integral_stride(width)".
+inline size_t pixel_integral_stride(size_t width){
+    return ((width + 7) & ~(size_t)7) + 1;
+}
+void pixel_integral(
+    const PixelIntegral& table,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+);
+
+
+}
+}
+#endif
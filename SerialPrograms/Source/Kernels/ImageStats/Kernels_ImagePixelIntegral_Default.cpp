@@ -0,0 +1,64 @@
+/*  Pixel Summed-Area Table (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Common/Compiler.h"
+#include "Kernels_ImagePixelIntegral.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void pixel_integral_Default(
+    const PixelIntegral& table,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+){
+    size_t stride = table.stride;
+    for (size_t r = 0; r < height; r++){
+        size_t above = r * stride + 1;
+        size_t current = above + stride;
+
+        uint32_t count = 0;
+        uint32_t sumR = 0;
+        uint32_t sumG = 0;
+        uint32_t sumB = 0;
+        uint32_t sqrR = 0;
+        uint32_t sqrG = 0;
+        uint32_t sqrB = 0;
+        for (size_t c = 0; c < width; c++){
+            uint32_t p = image[c];
+            int32_t m = (int32_t)p >> 31;
+            p &= (uint32_t)m;
+
+            uint32_t r0 = p & 0x000000ff;
+            uint32_t r1 = (p >>  8) & 0x000000ff;
+            uint32_t r2 = (p >> 16) & 0x000000ff;
+
+            count -= m;
+            sumB += r0;
+            sumG += r1;
+            sumR += r2;
+            sqrB += r0 * r0;
+            sqrG += r1 * r1;
+            sqrR += r2 * r2;
+
+            table.count[current + c] = table.count[above + c] + count;
+            table.sumR[current + c] = table.sumR[above + c] + sumR;
+            table.sumG[current + c] = table.sumG[above + c] + sumG;
+            table.sumB[current + c] = table.sumB[above + c] + sumB;
+            table.sqrR[current + c] = table.sqrR[above + c] + sqrR;
+            table.sqrG[current + c] = table.sqrG[above + c] + sqrG;
+            table.sqrB[current + c] = table.sqrB[above + c] + sqrB;
+        }
+
+        image = (const uint32_t*)((const char*)image + image_bytes_per_row);
+    }
+}
+
+
+
+}
+}
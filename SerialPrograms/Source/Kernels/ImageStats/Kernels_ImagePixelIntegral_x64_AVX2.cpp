@@ -0,0 +1,123 @@
+/*  Pixel Summed-Area Table (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <string.h>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImagePixelIntegral.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Running total of one plane along a row.
+class PixelIntegralPlane_x64_AVX2{
+public:
+    PixelIntegralPlane_x64_AVX2()
+        : m_carry(_mm256_setzero_si256())
+    {}
+
+    //  Add the prefix sums of "x" (continuing from the last call) to "above"
+    //  and store them to "current".
+    PA_FORCE_INLINE void store(uint32_t* current, const uint32_t* above, __m256i x){
+        x = prefix_sum(x);
+        _mm256_storeu_si256(
+            (__m256i*)current,
+            _mm256_add_epi32(x, _mm256_loadu_si256((const __m256i*)above))
+        );
+    }
+    PA_FORCE_INLINE void store(uint64_t* current, const uint64_t* above, __m256i x){
+        x = prefix_sum(x);
+        __m256i lo = _mm256_cvtepu32_epi64(_mm256_castsi256_si128(x));
+        __m256i hi = _mm256_cvtepu32_epi64(_mm256_extracti128_si256(x, 1));
+        _mm256_storeu_si256(
+            (__m256i*)current + 0,
+            _mm256_add_epi64(lo, _mm256_loadu_si256((const __m256i*)above + 0))
+        );
+        _mm256_storeu_si256(
+            (__m256i*)current + 1,
+            _mm256_add_epi64(hi, _mm256_loadu_si256((const __m256i*)above + 1))
+        );
+    }
+
+private:
+    PA_FORCE_INLINE __m256i prefix_sum(__m256i x){
+        //  Prefix sum within each 128-bit lane.
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+
+        //  Carry the total of the lower lane into the upper lane.
+        __m256i low = _mm256_permute2x128_si256(x, x, 0x08);
+        x = _mm256_add_epi32(x, _mm256_shuffle_epi32(low, 0xff));
+
+        x = _mm256_add_epi32(x, m_carry);
+        m_carry = _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7));
+        return x;
+    }
+
+private:
+    __m256i m_carry;
+};
+
+
+PA_FORCE_INLINE void pixel_integral_x64_AVX2(
+    const PixelIntegral& table, size_t above, size_t current,
+    PixelIntegralPlane_x64_AVX2 planes[7],
+    __m256i p
+){
+    __m256i m = _mm256_srai_epi32(p, 31);
+    p = _mm256_and_si256(p, m);
+
+    __m256i r0 = _mm256_and_si256(p, _mm256_set1_epi32(0x000000ff));
+    __m256i r1 = _mm256_and_si256(_mm256_srli_epi32(p, 8), _mm256_set1_epi32(0x000000ff));
+    __m256i r2 = _mm256_and_si256(_mm256_srli_epi32(p, 16), _mm256_set1_epi32(0x000000ff));
+
+    planes[0].store(table.count + current, table.count + above, _mm256_sub_epi32(_mm256_setzero_si256(), m));
+    planes[1].store(table.sumB + current, table.sumB + above, r0);
+    planes[2].store(table.sumG + current, table.sumG + above, r1);
+    planes[3].store(table.sumR + current, table.sumR + above, r2);
+    planes[4].store(table.sqrB + current, table.sqrB + above, _mm256_mullo_epi16(r0, r0));
+    planes[5].store(table.sqrG + current, table.sqrG + above, _mm256_mullo_epi16(r1, r1));
+    planes[6].store(table.sqrR + current, table.sqrR + above, _mm256_mullo_epi16(r2, r2));
+}
+
+
+void pixel_integral_x64_AVX2(
+    const PixelIntegral& table,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+){
+    size_t stride = table.stride;
+    for (size_t r = 0; r < height; r++){
+        size_t above = r * stride + 1;
+        size_t current = above + stride;
+
+        PixelIntegralPlane_x64_AVX2 planes[7];
+
+        size_t c = 0;
+        for (; c + 8 <= width; c += 8){
+            __m256i p = _mm256_loadu_si256((const __m256i*)(image + c));
+            pixel_integral_x64_AVX2(table, above + c, current + c, planes, p);
+        }
+        if (c < width){
+            //  Zero pixels are transparent and add nothing.
+            uint32_t buffer[8] = {};
+            memcpy(buffer, image + c, (width - c) * sizeof(uint32_t));
+            __m256i p = _mm256_loadu_si256((const __m256i*)buffer);
+            pixel_integral_x64_AVX2(table, above + c, current + c, planes, p);
+        }
+
+        image = (const uint32_t*)((const char*)image + image_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
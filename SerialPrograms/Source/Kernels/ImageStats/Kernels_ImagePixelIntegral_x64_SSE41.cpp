@@ -0,0 +1,117 @@
+/*  Pixel Summed-Area Table (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <string.h>
+#include <smmintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImagePixelIntegral.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Running total of one plane along a row.
+class PixelIntegralPlane_x64_SSE41{
+public:
+    PixelIntegralPlane_x64_SSE41()
+        : m_carry(_mm_setzero_si128())
+    {}
+
+    //  Add the prefix sums of "x" (continuing from the last call) to "above"
+    //  and store them to "current".
+    PA_FORCE_INLINE void store(uint32_t* current, const uint32_t* above, __m128i x){
+        x = prefix_sum(x);
+        _mm_storeu_si128(
+            (__m128i*)current,
+            _mm_add_epi32(x, _mm_loadu_si128((const __m128i*)above))
+        );
+    }
+    PA_FORCE_INLINE void store(uint64_t* current, const uint64_t* above, __m128i x){
+        x = prefix_sum(x);
+        __m128i lo = _mm_cvtepu32_epi64(x);
+        __m128i hi = _mm_cvtepu32_epi64(_mm_srli_si128(x, 8));
+        _mm_storeu_si128(
+            (__m128i*)current + 0,
+            _mm_add_epi64(lo, _mm_loadu_si128((const __m128i*)above + 0))
+        );
+        _mm_storeu_si128(
+            (__m128i*)current + 1,
+            _mm_add_epi64(hi, _mm_loadu_si128((const __m128i*)above + 1))
+        );
+    }
+
+private:
+    PA_FORCE_INLINE __m128i prefix_sum(__m128i x){
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, m_carry);
+        m_carry = _mm_shuffle_epi32(x, 0xff);
+        return x;
+    }
+
+private:
+    __m128i m_carry;
+};
+
+
+PA_FORCE_INLINE void pixel_integral_x64_SSE41(
+    const PixelIntegral& table, size_t above, size_t current,
+    PixelIntegralPlane_x64_SSE41 planes[7],
+    __m128i p
+){
+    __m128i m = _mm_srai_epi32(p, 31);
+    p = _mm_and_si128(p, m);
+
+    __m128i r0 = _mm_and_si128(p, _mm_set1_epi32(0x000000ff));
+    __m128i r1 = _mm_shuffle_epi8(p, _mm_setr_epi8(1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1));
+    __m128i r2 = _mm_shuffle_epi8(p, _mm_setr_epi8(2, -1, -1, -1, 6, -1, -1, -1, 10, -1, -1, -1, 14, -1, -1, -1));
+
+    planes[0].store(table.count + current, table.count + above, _mm_sub_epi32(_mm_setzero_si128(), m));
+    planes[1].store(table.sumB + current, table.sumB + above, r0);
+    planes[2].store(table.sumG + current, table.sumG + above, r1);
+    planes[3].store(table.sumR + current, table.sumR + above, r2);
+    planes[4].store(table.sqrB + current, table.sqrB + above, _mm_mullo_epi16(r0, r0));
+    planes[5].store(table.sqrG + current, table.sqrG + above, _mm_mullo_epi16(r1, r1));
+    planes[6].store(table.sqrR + current, table.sqrR + above, _mm_mullo_epi16(r2, r2));
+}
+
+
+void pixel_integral_x64_SSE41(
+    const PixelIntegral& table,
+    size_t width, size_t height,
+    const uint32_t* image, size_t image_bytes_per_row
+){
+    size_t stride = table.stride;
+    for (size_t r = 0; r < height; r++){
+        size_t above = r * stride + 1;
+        size_t current = above + stride;
+
+        PixelIntegralPlane_x64_SSE41 planes[7];
+
+        size_t c = 0;
+        for (; c + 4 <= width; c += 4){
+            __m128i p = _mm_loadu_si128((const __m128i*)(image + c));
+            pixel_integral_x64_SSE41(table, above + c, current + c, planes, p);
+        }
+        if (c < width){
+            //  Zero pixels are transparent and add nothing.
+            uint32_t buffer[4] = {};
+            memcpy(buffer, image + c, (width - c) * sizeof(uint32_t));
+            __m128i p = _mm_loadu_si128((const __m128i*)buffer);
+            pixel_integral_x64_SSE41(table, above + c, current + c, planes, p);
+        }
+
+        image = (const uint32_t*)((const char*)image + image_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
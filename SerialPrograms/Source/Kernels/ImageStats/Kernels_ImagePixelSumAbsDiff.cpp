@@ -0,0 +1,95 @@
+/*  Sum of Absolute Differences
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImagePixelSumAbsDiff.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void sum_abs_diff_tiles_Default(
+    uint64_t* sums, size_t tile_width,
+    size_t width, size_t height,
+    const uint32_t* a, size_t a_bytes_per_line,
+    const uint32_t* b, size_t b_bytes_per_line
+);
+void sum_abs_diff_tiles_x64_SSE41(
+    uint64_t* sums, size_t tile_width,
+    size_t width, size_t height,
+    const uint32_t* a, size_t a_bytes_per_line,
+    const uint32_t* b, size_t b_bytes_per_line
+);
+void sum_abs_diff_tiles_x64_AVX2(
+    uint64_t* sums, size_t tile_width,
+    size_t width, size_t height,
+    const uint32_t* a, size_t a_bytes_per_line,
+    const uint32_t* b, size_t b_bytes_per_line
+);
+void sum_abs_diff_tiles_x64_AVX512(
+    uint64_t* sums, size_t tile_width,
+    size_t width, size_t height,
+    const uint32_t* a, size_t a_bytes_per_line,
+    const uint32_t* b, size_t b_bytes_per_line
+);
+
+
+
+void sum_abs_diff_tiles(
+    uint64_t* sums, size_t tile_width,
+    size_t width, size_t height,
+    const uint32_t* a, size_t a_bytes_per_line,
+    const uint32_t* b, size_t b_bytes_per_line
+){
+    if (tile_width == 0 || tile_width % 16 != 0){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid tile width: " + std::to_string(tile_width));
+    }
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        sum_abs_diff_tiles_x64_AVX512(
+            sums, tile_width,
+            width, height,
+            a, a_bytes_per_line,
+            b, b_bytes_per_line
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        sum_abs_diff_tiles_x64_AVX2(
+            sums, tile_width,
+            width, height,
+            a, a_bytes_per_line,
+            b, b_bytes_per_line
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        sum_abs_diff_tiles_x64_SSE41(
+            sums, tile_width,
+            width, height,
+            a, a_bytes_per_line,
+            b, b_bytes_per_line
+        );
+        return;
+    }
+#endif
+    sum_abs_diff_tiles_Default(
+        sums, tile_width,
+        width, height,
+        a, a_bytes_per_line,
+        b, b_bytes_per_line
+    );
+}
+
+
+
+}
+}
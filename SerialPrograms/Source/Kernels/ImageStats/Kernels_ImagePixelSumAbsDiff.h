@@ -0,0 +1,38 @@
+/*  Sum of Absolute Differences
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImagePixelSumAbsDiff_H
+#define PokemonAutomation_Kernels_ImagePixelSumAbsDiff_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//
+//  Split the columns of "a" and "b" into tiles that are "tile_width" pixels
+//  wide and add the sum of absolute differences of all 4 channels of each
+//  tile into "sums".
+//
+//  sums[i] += SAD of columns [i * tile_width, min((i + 1) * tile_width, width))
+//             over all "height" rows.
+//
+//  "sums" must have (width + tile_width - 1) / tile_width entries.
+//  "tile_width" must be a non-zero multiple of 16.
+//
+void sum_abs_diff_tiles(
+    uint64_t* sums, size_t tile_width,
+    size_t width, size_t height,
+    const uint32_t* a, size_t a_bytes_per_line,
+    const uint32_t* b, size_t b_bytes_per_line
+);
+
+
+}
+}
+#endif
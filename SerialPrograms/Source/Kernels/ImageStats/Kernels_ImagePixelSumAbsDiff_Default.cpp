@@ -0,0 +1,55 @@
+/*  Sum of Absolute Differences (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <stdint.h>
+#include <algorithm>
+#include "Common/Compiler.h"
+#include "Kernels_ImagePixelSumAbsDiff.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE uint32_t sum_abs_diff_Default(uint32_t x, uint32_t y){
+    uint32_t sum = 0;
+    for (size_t c = 0; c < 4; c++){
+        uint32_t p = x & 0xff;
+        uint32_t q = y & 0xff;
+        sum += p > q ? p - q : q - p;
+        x >>= 8;
+        y >>= 8;
+    }
+    return sum;
+}
+PA_FORCE_INLINE uint64_t sum_abs_diff_Default(size_t length, const uint32_t* a, const uint32_t* b){
+    uint64_t sum = 0;
+    for (size_t c = 0; c < length; c++){
+        sum += sum_abs_diff_Default(a[c], b[c]);
+    }
+    return sum;
+}
+
+
+void sum_abs_diff_tiles_Default(
+    uint64_t* sums, size_t tile_width,
+    size_t width, size_t height,
+    const uint32_t* a, size_t a_bytes_per_line,
+    const uint32_t* b, size_t b_bytes_per_line
+){
+    for (size_t r = 0; r < height; r++){
+        uint64_t* sum = sums;
+        for (size_t c = 0; c < width; c += tile_width){
+            *sum++ += sum_abs_diff_Default(std::min(tile_width, width - c), a + c, b + c);
+        }
+        a = (const uint32_t*)((const char*)a + a_bytes_per_line);
+        b = (const uint32_t*)((const char*)b + b_bytes_per_line);
+    }
+}
+
+
+
+}
+}
@@ -0,0 +1,68 @@
+/*  Sum of Absolute Differences (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <algorithm>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImagePixelSumAbsDiff.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE uint64_t sum_abs_diff_x64_AVX2(size_t length, const uint32_t* a, const uint32_t* b){
+    __m256i sum = _mm256_setzero_si256();
+
+    size_t c = 0;
+    for (; c + 8 <= length; c += 8){
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + c));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + c));
+        sum = _mm256_add_epi64(sum, _mm256_sad_epu8(x, y));
+    }
+
+    __m128i sum128 = _mm_add_epi64(
+        _mm256_castsi256_si128(sum),
+        _mm256_extracti128_si256(sum, 1)
+    );
+    if (c + 4 <= length){
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + c));
+        __m128i y = _mm_loadu_si128((const __m128i*)(b + c));
+        sum128 = _mm_add_epi64(sum128, _mm_sad_epu8(x, y));
+        c += 4;
+    }
+    for (; c < length; c++){
+        __m128i x = _mm_cvtsi32_si128(a[c]);
+        __m128i y = _mm_cvtsi32_si128(b[c]);
+        sum128 = _mm_add_epi64(sum128, _mm_sad_epu8(x, y));
+    }
+
+    return _mm_cvtsi128_si64(sum128) + _mm_extract_epi64(sum128, 1);
+}
+
+
+void sum_abs_diff_tiles_x64_AVX2(
+    uint64_t* sums, size_t tile_width,
+    size_t width, size_t height,
+    const uint32_t* a, size_t a_bytes_per_line,
+    const uint32_t* b, size_t b_bytes_per_line
+){
+    for (size_t r = 0; r < height; r++){
+        uint64_t* sum = sums;
+        for (size_t c = 0; c < width; c += tile_width){
+            *sum++ += sum_abs_diff_x64_AVX2(std::min(tile_width, width - c), a + c, b + c);
+        }
+        a = (const uint32_t*)((const char*)a + a_bytes_per_line);
+        b = (const uint32_t*)((const char*)b + b_bytes_per_line);
+    }
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,58 @@
+/*  Sum of Absolute Differences (x64 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include <algorithm>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImagePixelSumAbsDiff.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE uint64_t sum_abs_diff_x64_AVX512(size_t length, const uint32_t* a, const uint32_t* b){
+    __m512i sum = _mm512_setzero_si512();
+
+    size_t c = 0;
+    for (; c + 16 <= length; c += 16){
+        __m512i x = _mm512_loadu_si512((const __m512i*)(a + c));
+        __m512i y = _mm512_loadu_si512((const __m512i*)(b + c));
+        sum = _mm512_add_epi64(sum, _mm512_sad_epu8(x, y));
+    }
+    if (c < length){
+        __mmask16 mask = ((uint32_t)1 << (length - c)) - 1;
+        __m512i x = _mm512_maskz_loadu_epi32(mask, a + c);
+        __m512i y = _mm512_maskz_loadu_epi32(mask, b + c);
+        sum = _mm512_add_epi64(sum, _mm512_sad_epu8(x, y));
+    }
+
+    return _mm512_reduce_add_epi64(sum);
+}
+
+
+void sum_abs_diff_tiles_x64_AVX512(
+    uint64_t* sums, size_t tile_width,
+    size_t width, size_t height,
+    const uint32_t* a, size_t a_bytes_per_line,
+    const uint32_t* b, size_t b_bytes_per_line
+){
+    for (size_t r = 0; r < height; r++){
+        uint64_t* sum = sums;
+        for (size_t c = 0; c < width; c += tile_width){
+            *sum++ += sum_abs_diff_x64_AVX512(std::min(tile_width, width - c), a + c, b + c);
+        }
+        a = (const uint32_t*)((const char*)a + a_bytes_per_line);
+        b = (const uint32_t*)((const char*)b + b_bytes_per_line);
+    }
+}
+
+
+
+}
+}
+#endif
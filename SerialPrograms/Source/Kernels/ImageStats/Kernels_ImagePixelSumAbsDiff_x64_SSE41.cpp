@@ -0,0 +1,59 @@
+/*  Sum of Absolute Differences (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <algorithm>
+#include <smmintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImagePixelSumAbsDiff.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE uint64_t sum_abs_diff_x64_SSE41(size_t length, const uint32_t* a, const uint32_t* b){
+    __m128i sum = _mm_setzero_si128();
+
+    size_t c = 0;
+    for (; c + 4 <= length; c += 4){
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + c));
+        __m128i y = _mm_loadu_si128((const __m128i*)(b + c));
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(x, y));
+    }
+    uint64_t total = _mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1);
+
+    for (; c < length; c++){
+        __m128i x = _mm_cvtsi32_si128(a[c]);
+        __m128i y = _mm_cvtsi32_si128(b[c]);
+        total += _mm_cvtsi128_si64(_mm_sad_epu8(x, y));
+    }
+
+    return total;
+}
+
+
+void sum_abs_diff_tiles_x64_SSE41(
+    uint64_t* sums, size_t tile_width,
+    size_t width, size_t height,
+    const uint32_t* a, size_t a_bytes_per_line,
+    const uint32_t* b, size_t b_bytes_per_line
+){
+    for (size_t r = 0; r < height; r++){
+        uint64_t* sum = sums;
+        for (size_t c = 0; c < width; c += tile_width){
+            *sum++ += sum_abs_diff_x64_SSE41(std::min(tile_width, width - c), a + c, b + c);
+        }
+        a = (const uint32_t*)((const char*)a + a_bytes_per_line);
+        b = (const uint32_t*)((const char*)b + b_bytes_per_line);
+    }
+}
+
+
+
+}
+}
+#endif
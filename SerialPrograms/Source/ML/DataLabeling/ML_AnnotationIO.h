@@ -14,14 +14,6 @@
 namespace PokemonAutomation{
 namespace ML{
 
-// Load pre-computed image embedding from disk
-// Return true if there is the embedding file.
-// The embedding is stored in a file in the same folder as the image, having the same name but with a suffix ".embedding".
-bool load_image_embedding(const std::string& image_filepath, std::vector<float>& image_embedding);
-
-// Save the image embedding as a file with path <image_filepath>.embedding.
-void save_image_embedding_to_disk(const std::string& image_filepath, const std::vector<float>& embedding);
-
 // Find image paths stored in a folder. The search can be recursive into child folders or not.
 std::vector<std::string> find_images_in_folder(const std::string& folder_path, bool recursive);
 
@@ -0,0 +1,314 @@
+/*  ML Embedding Store
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <QFile>
+#include "Common/Cpp/Exceptions.h"
+#include "ML_SegmentAnythingModelConstants.h"
+#include "ML_EmbeddingStore.h"
+
+namespace fs = std::filesystem;
+
+namespace PokemonAutomation{
+namespace ML{
+
+
+const char EMBEDDING_PACK_FILENAME[] = "SAM-Embeddings.pack";
+
+
+namespace{
+
+const char PACK_MAGIC[8] = {'P', 'A', 'S', 'A', 'M', 'E', 'M', '1'};
+const uint32_t RECORD_MAGIC = 0x44424d45;   //  "EMBD"
+const uint64_t PACK_ALIGNMENT = 64;
+
+struct PackHeader{
+    char magic[8];
+    uint32_t channels;
+    uint32_t height;
+    uint32_t width;
+    uint32_t reserved[11];
+};
+static_assert(sizeof(PackHeader) == PACK_ALIGNMENT);
+
+struct RecordHeader{
+    uint32_t magic;
+    uint32_t name_bytes;
+    uint64_t floats;
+};
+
+uint64_t align_up(uint64_t x){
+    return (x + PACK_ALIGNMENT - 1) & ~(PACK_ALIGNMENT - 1);
+}
+
+PackHeader make_pack_header(){
+    PackHeader header{};
+    memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.channels = SAM_EMBEDDER_OUTPUT_N_CHANNELS;
+    header.height = SAM_EMBEDDER_OUTPUT_IMAGE_SIZE;
+    header.width = SAM_EMBEDDER_OUTPUT_IMAGE_SIZE;
+    return header;
+}
+
+//  Read a legacy "<image>.embedding" file.
+ImageEmbedding load_legacy_embedding(const std::string& embedding_path){
+    std::ifstream fin(embedding_path, std::ios::binary);
+    if (!fin.is_open()){
+        return ImageEmbedding();
+    }
+
+    int embedding_n_channels = 0, embedding_height = 0, embedding_width = 0;
+    fin.read(reinterpret_cast<char*>(&embedding_n_channels), sizeof(int));
+    fin.read(reinterpret_cast<char*>(&embedding_height), sizeof(int));
+    fin.read(reinterpret_cast<char*>(&embedding_width), sizeof(int));
+
+    std::cout << "Image embedding shape [" << embedding_n_channels << ", " << embedding_height
+              << ", " << embedding_width << "]" << std::endl;
+    if (embedding_n_channels <= 0 || embedding_height <= 0 || embedding_width <= 0){
+        std::string err_msg = "Image embedding wrong dimension from " + embedding_path;
+        std::cerr << err_msg << std::endl;
+        throw std::runtime_error(err_msg);
+    }
+
+    const size_t size = (size_t)embedding_n_channels * embedding_height * embedding_width;
+    auto buffer = std::make_shared<std::vector<float>>(size);
+    fin.read(reinterpret_cast<char*>(buffer->data()), sizeof(float) * size);
+    const float* data = buffer->data();
+    return ImageEmbedding(std::move(buffer), data, size);
+}
+
+}
+
+
+
+struct EmbeddingPack::Mapping{
+    QFile file;
+    uchar* data = nullptr;
+
+    Mapping(const std::string& path)
+        : file(QString::fromStdString(path))
+    {}
+    ~Mapping(){
+        if (data != nullptr){
+            file.unmap(data);
+        }
+    }
+};
+
+
+EmbeddingPack::~EmbeddingPack() = default;
+EmbeddingPack::EmbeddingPack(const std::string& pack_path)
+    : m_mapping(new Mapping(pack_path))
+{
+    QFile& file = m_mapping->file;
+    if (!file.open(QIODevice::ReadOnly)){
+        return;
+    }
+    m_file_size = (uint64_t)file.size();
+    if (m_file_size < sizeof(PackHeader)){
+        return;
+    }
+    m_mapping->data = file.map(0, (qint64)m_file_size);
+    file.close();
+    if (m_mapping->data == nullptr){
+        std::cerr << "Unable to map embedding pack: " << pack_path << std::endl;
+        return;
+    }
+    const char* data = (const char*)m_mapping->data;
+
+    const PackHeader expected = make_pack_header();
+    PackHeader header;
+    memcpy(&header, data, sizeof(PackHeader));
+    if (memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+        header.channels != expected.channels ||
+        header.height != expected.height ||
+        header.width != expected.width
+    ){
+        std::cerr << "Embedding pack has the wrong format or shape: " << pack_path << std::endl;
+        return;
+    }
+    m_data = data;
+
+    //  Build the index. Only the record headers are touched, not the
+    //  embeddings themselves.
+    uint64_t offset = sizeof(PackHeader);
+    while (offset + sizeof(RecordHeader) <= m_file_size){
+        RecordHeader record;
+        memcpy(&record, data + offset, sizeof(RecordHeader));
+        if (record.magic != RECORD_MAGIC){
+            break;
+        }
+        uint64_t name_offset = offset + sizeof(RecordHeader);
+        uint64_t data_offset = align_up(name_offset + record.name_bytes);
+        uint64_t end = align_up(data_offset + record.floats * sizeof(float));
+        if (end > m_file_size){
+            break;
+        }
+        std::string name(data + name_offset, record.name_bytes);
+        m_index[std::move(name)] = {(const float*)(data + data_offset), (size_t)record.floats};
+        offset = end;
+    }
+    m_valid_bytes = offset;
+}
+
+ImageEmbedding EmbeddingPack::get(const std::string& image_filename) const{
+    auto iter = m_index.find(image_filename);
+    if (iter == m_index.end()){
+        return ImageEmbedding();
+    }
+    return ImageEmbedding(shared_from_this(), iter->second.first, iter->second.second);
+}
+
+
+namespace{
+std::mutex pack_cache_lock;
+std::map<std::string, std::shared_ptr<const EmbeddingPack>> pack_cache;
+}
+
+std::shared_ptr<const EmbeddingPack> EmbeddingPack::open(const std::string& pack_path){
+    std::error_code ec;
+    uint64_t file_size = fs::file_size(pack_path, ec);
+    if (ec){
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lg(pack_cache_lock);
+    auto iter = pack_cache.find(pack_path);
+    if (iter != pack_cache.end() && iter->second->m_file_size == file_size){
+        return iter->second;
+    }
+
+    auto pack = std::make_shared<const EmbeddingPack>(pack_path);
+    if (!pack->valid()){
+        pack_cache.erase(pack_path);
+        return nullptr;
+    }
+    pack_cache[pack_path] = pack;
+    return pack;
+}
+void EmbeddingPack::release(const std::string& pack_path){
+    std::lock_guard<std::mutex> lg(pack_cache_lock);
+    pack_cache.erase(pack_path);
+}
+
+
+
+EmbeddingPackWriter::EmbeddingPackWriter(const std::string& folder_path)
+    : m_pack_path((fs::path(folder_path) / EMBEDDING_PACK_FILENAME).string())
+{
+    EmbeddingPack::release(m_pack_path);
+
+    //  A pack that doesn't even have its header can be started over.
+    std::error_code ec;
+    if (fs::file_size(m_pack_path, ec) < sizeof(PackHeader) && !ec){
+        fs::remove(m_pack_path);
+    }
+
+    bool write_header = true;
+    if (fs::exists(m_pack_path)){
+        uint64_t valid_bytes = 0;
+        {
+            EmbeddingPack pack(m_pack_path);
+            if (!pack.valid()){
+                throw FileException(
+                    nullptr, PA_CURRENT_FUNCTION,
+                    "Existing embedding pack is not readable. Delete it to recompute.",
+                    m_pack_path
+                );
+            }
+            valid_bytes = pack.valid_bytes();
+        }
+        //  Drop a record that was cut short by an earlier run.
+        if (valid_bytes != fs::file_size(m_pack_path)){
+            std::cout << "Truncating incomplete record at the end of " << m_pack_path << std::endl;
+            fs::resize_file(m_pack_path, valid_bytes);
+        }
+        write_header = false;
+    }
+
+    m_file.open(m_pack_path, std::ios::binary | std::ios::app);
+    if (!m_file.is_open()){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open embedding pack for writing.", m_pack_path);
+    }
+    if (write_header){
+        PackHeader header = make_pack_header();
+        m_file.write((const char*)&header, sizeof(header));
+        m_file.flush();
+    }
+}
+EmbeddingPackWriter::~EmbeddingPackWriter(){
+    m_file.close();
+    EmbeddingPack::release(m_pack_path);
+}
+
+void EmbeddingPackWriter::append(const std::string& image_filename, const float* embedding, size_t size){
+    static const char ZEROS[PACK_ALIGNMENT] = {};
+
+    RecordHeader record;
+    record.magic = RECORD_MAGIC;
+    record.name_bytes = (uint32_t)image_filename.size();
+    record.floats = size;
+
+    //  Records start and end on the alignment, so the padding only depends
+    //  on the record itself.
+    uint64_t name_end = sizeof(RecordHeader) + image_filename.size();
+    uint64_t data_bytes = size * sizeof(float);
+    uint64_t data_end = align_up(name_end) + data_bytes;
+
+    m_file.write((const char*)&record, sizeof(record));
+    m_file.write(image_filename.data(), image_filename.size());
+    m_file.write(ZEROS, align_up(name_end) - name_end);
+    m_file.write((const char*)embedding, data_bytes);
+    m_file.write(ZEROS, align_up(data_end) - data_end);
+    m_file.flush();
+    if (!m_file){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write to embedding pack.", m_pack_path);
+    }
+}
+
+
+
+std::string embedding_pack_path_for_image(const std::string& image_filepath){
+    return (fs::path(image_filepath).parent_path() / EMBEDDING_PACK_FILENAME).string();
+}
+
+bool has_image_embedding(const std::string& image_filepath){
+    std::shared_ptr<const EmbeddingPack> pack = EmbeddingPack::open(embedding_pack_path_for_image(image_filepath));
+    if (pack && pack->contains(fs::path(image_filepath).filename().string())){
+        return true;
+    }
+    return fs::exists(image_filepath + ".embedding");
+}
+
+bool load_image_embedding(const std::string& image_filepath, ImageEmbedding& image_embedding){
+    image_embedding.clear();
+
+    std::shared_ptr<const EmbeddingPack> pack = EmbeddingPack::open(embedding_pack_path_for_image(image_filepath));
+    if (pack){
+        image_embedding = pack->get(fs::path(image_filepath).filename().string());
+        if (!image_embedding.empty()){
+            std::cout << "Loaded image embedding from pack " << embedding_pack_path_for_image(image_filepath) << std::endl;
+            return true;
+        }
+    }
+
+    const std::string embedding_path = image_filepath + ".embedding";
+    image_embedding = load_legacy_embedding(embedding_path);
+    if (image_embedding.empty()){
+        std::cout << "No embedding for image " << image_filepath << std::endl;
+        return false;
+    }
+    std::cout << "Loaded image embedding from " << embedding_path << std::endl;
+    return true;
+}
+
+
+
+}
+}
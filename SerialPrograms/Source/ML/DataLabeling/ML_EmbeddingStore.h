@@ -0,0 +1,130 @@
+/*  ML Embedding Store
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Packed storage of SAM image embeddings.
+ *
+ *  All embeddings of the images in one folder are appended to a single pack
+ *  file in that folder (EMBEDDING_PACK_FILENAME). Each record is the image
+ *  filename followed by the embedding floats, 64-byte aligned. Readers map the
+ *  pack into memory and index the records by filename, so loading an
+ *  embedding does not copy it.
+ *
+ *  Older datasets store one "<image>.embedding" file per image. These are
+ *  still read, but no longer written.
+ *
+ */
+
+#ifndef PokemonAutomation_ML_EmbeddingStore_H
+#define PokemonAutomation_ML_EmbeddingStore_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+
+namespace PokemonAutomation{
+namespace ML{
+
+
+extern const char EMBEDDING_PACK_FILENAME[];
+
+
+//  A read-only view of one image embedding. It keeps whatever holds the data
+//  (the mapped pack or a legacy file buffer) alive.
+class ImageEmbedding{
+public:
+    ImageEmbedding() = default;
+    ImageEmbedding(std::shared_ptr<const void> owner, const float* data, size_t size)
+        : m_owner(std::move(owner))
+        , m_data(data)
+        , m_size(size)
+    {}
+
+    const float* data() const{ return m_data; }
+    size_t size() const{ return m_size; }
+    bool empty() const{ return m_size == 0; }
+
+    void clear(){
+        m_owner.reset();
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+private:
+    std::shared_ptr<const void> m_owner;
+    const float* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+
+//  A memory-mapped embedding pack.
+class EmbeddingPack : public std::enable_shared_from_this<EmbeddingPack>{
+public:
+    //  Map the pack at "pack_path". Returns nullptr if there is no pack.
+    //  Packs are cached and remapped only when the file has grown.
+    static std::shared_ptr<const EmbeddingPack> open(const std::string& pack_path);
+
+    //  Drop the cached mapping of "pack_path". Views that are still alive
+    //  keep their mapping.
+    static void release(const std::string& pack_path);
+
+    ~EmbeddingPack();
+    EmbeddingPack(const std::string& pack_path);
+
+    bool valid() const{ return m_data != nullptr; }
+    size_t size() const{ return m_index.size(); }
+    bool contains(const std::string& image_filename) const{
+        return m_index.find(image_filename) != m_index.end();
+    }
+
+    //  Returns an empty embedding if "image_filename" is not in the pack.
+    ImageEmbedding get(const std::string& image_filename) const;
+
+    //  Number of bytes from the start of the file to the end of the last
+    //  complete record. Anything after this is a record that was cut short.
+    uint64_t valid_bytes() const{ return m_valid_bytes; }
+
+private:
+    struct Mapping;
+    std::unique_ptr<Mapping> m_mapping;
+    const char* m_data = nullptr;
+    uint64_t m_file_size = 0;
+    uint64_t m_valid_bytes = 0;
+    std::map<std::string, std::pair<const float*, size_t>> m_index;
+};
+
+
+//  Appends embeddings to the pack of one folder.
+//  This is not thread-safe. Use one writer per folder from one thread.
+class EmbeddingPackWriter{
+public:
+    EmbeddingPackWriter(const std::string& folder_path);
+    ~EmbeddingPackWriter();
+
+    void append(const std::string& image_filename, const float* embedding, size_t size);
+
+private:
+    std::string m_pack_path;
+    std::ofstream m_file;
+};
+
+
+//  The pack that holds the embedding of "image_filepath".
+std::string embedding_pack_path_for_image(const std::string& image_filepath);
+
+//  Load the embedding of "image_filepath" from its folder's pack, or from a
+//  legacy "<image_filepath>.embedding" file.
+//  Returns false and leaves "image_embedding" empty if there is neither.
+bool load_image_embedding(const std::string& image_filepath, ImageEmbedding& image_embedding);
+
+//  Whether an embedding exists for "image_filepath", in either a pack or a
+//  legacy ".embedding" file.
+bool has_image_embedding(const std::string& image_filepath);
+
+
+
+}
+}
+#endif
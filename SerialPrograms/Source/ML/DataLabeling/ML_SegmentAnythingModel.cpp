@@ -7,13 +7,22 @@
 
 #include <QDir>
 #include <QDirIterator>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <QMessageBox>
 #include <onnxruntime_cxx_api.h>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
 #include "3rdParty/ONNX/OnnxToolsPA.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Concurrency/Thread.h"
 #include "CommonFramework/Globals.h"
 #include "ML/Models/ML_ONNXRuntimeHelpers.h"
 #include "ML_SegmentAnythingModelConstants.h"
@@ -24,9 +33,9 @@ namespace PokemonAutomation{
 namespace ML{
 
 
-SAMEmbedderSession::SAMEmbedderSession(const std::string& model_path, bool use_gpu)
+SAMEmbedderSession::SAMEmbedderSession(const std::string& model_path, bool use_gpu, size_t intra_op_threads)
     : m_env{create_ORT_env()}
-    , m_session_options{create_session_options(ML_MODEL_CACHE_PATH() + "SAMEmbedder/", use_gpu)}
+    , m_session_options{create_session_options(ML_MODEL_CACHE_PATH() + "SAMEmbedder/", use_gpu, intra_op_threads)}
     , session{create_session(m_env, m_session_options, model_path, ML_MODEL_CACHE_PATH() + "SAMEmbedder/")}
     , memory_info{Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU)}
     , input_names{session.GetInputNames()}
@@ -83,7 +92,7 @@ SAMSession::SAMSession(const std::string& model_path, bool use_gpu)
 }
 
 void SAMSession::run(
-    std::vector<float>& image_embedding,
+    const ImageEmbedding& image_embedding,
     int original_image_height, int original_image_width,
     const std::vector<int>& input_points,
     const std::vector<int>& input_point_labels,
@@ -144,7 +153,11 @@ void SAMSession::run(
     output_mask_buffer.resize(original_image_height * original_image_width, 0.0);
 
     std::array<Ort::Value, SAM_N_INPUT_TENSORS> input_tensors;
-    input_tensors[0] = create_tensor<float>(memory_info, image_embedding, input_image_embedding_shape);
+    // The embedding may be mapped read-only from an embedding pack. ONNX Runtime does not write to inputs.
+    input_tensors[0] = Ort::Value::CreateTensor<float>(
+        memory_info, const_cast<float*>(image_embedding.data()), image_embedding.size(),
+        input_image_embedding_shape.data(), input_image_embedding_shape.size()
+    );
     input_tensors[1] = create_tensor<float>(memory_info, input_point_coords_buffer, input_point_coords_shape);
     input_tensors[2] = create_tensor<float>(memory_info, input_point_labels_buffer, input_point_labels_shape);
     input_tensors[3] = create_tensor<float>(memory_info, input_mask_buffer, input_mask_shape);
@@ -178,6 +191,182 @@ void SAMSession::run(
 }
 
 
+namespace{
+
+
+// A blocking FIFO with a fixed capacity. Producers wait while it is full, which bounds how many
+// decoded images and embeddings are held in memory between the pipeline stages.
+template <typename T>
+class BoundedQueue{
+public:
+    BoundedQueue(size_t capacity)
+        : m_capacity(capacity)
+    {}
+
+    // Return false if the queue was closed instead.
+    bool push(T&& item){
+        std::unique_lock<std::mutex> lg(m_lock);
+        m_not_full.wait(lg, [&]{ return m_closed || m_queue.size() < m_capacity; });
+        if (m_closed){
+            return false;
+        }
+        m_queue.emplace_back(std::move(item));
+        m_not_empty.notify_one();
+        return true;
+    }
+
+    // Return false once the queue is closed and empty.
+    bool pop(T& item){
+        std::unique_lock<std::mutex> lg(m_lock);
+        m_not_empty.wait(lg, [&]{ return m_closed || !m_queue.empty(); });
+        if (m_queue.empty()){
+            return false;
+        }
+        item = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_not_full.notify_one();
+        return true;
+    }
+
+    void close(){
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_closed = true;
+        m_not_full.notify_all();
+        m_not_empty.notify_all();
+    }
+
+private:
+    const size_t m_capacity;
+    std::mutex m_lock;
+    std::condition_variable m_not_full;
+    std::condition_variable m_not_empty;
+    std::deque<T> m_queue;
+    bool m_closed = false;
+};
+
+
+struct DecodedImage{
+    size_t index = 0;
+    cv::Mat image;
+};
+struct ComputedEmbedding{
+    size_t index = 0;
+    std::vector<float> embedding;
+};
+
+
+// Shared state of one compute_embeddings_for_folder() call.
+struct EmbeddingPipeline{
+    std::vector<std::string> image_paths;
+
+    BoundedQueue<DecodedImage> decoded;
+    BoundedQueue<ComputedEmbedding> computed;
+
+    std::atomic<size_t> next_image{0};
+    std::atomic<size_t> running_decoders{0};
+    std::atomic<size_t> running_workers{0};
+
+    std::atomic<bool> failed{false};
+    std::mutex error_lock;
+    std::string error_title;
+    std::string error_message;
+
+    EmbeddingPipeline(std::vector<std::string> paths, size_t queue_capacity)
+        : image_paths(std::move(paths))
+        , decoded(queue_capacity)
+        , computed(queue_capacity)
+    {}
+
+    // Record the first error and stop every stage.
+    void fail(std::string title, std::string message){
+        std::cerr << "Error: " << message << std::endl;
+        {
+            std::lock_guard<std::mutex> lg(error_lock);
+            if (!failed.load(std::memory_order_relaxed)){
+                error_title = std::move(title);
+                error_message = std::move(message);
+            }
+            failed.store(true, std::memory_order_release);
+        }
+        decoded.close();
+        computed.close();
+    }
+
+    // Read, convert to RGB and resize to the embedder input.
+    void run_decoder(){
+        while (!failed.load(std::memory_order_acquire)){
+            size_t index = next_image.fetch_add(1);
+            if (index >= image_paths.size()){
+                return;
+            }
+            const std::string& image_path = image_paths[index];
+            cv::Mat image_bgr = cv::imread(image_path);
+            if (image_bgr.empty()){
+                fail("Unable To Open Image", "Cannot open image file " + image_path + ". Probably not an actual image?");
+                return;
+            }
+            cv::Mat image;
+            if (image_bgr.channels() == 4){
+                cv::cvtColor(image_bgr, image, cv::COLOR_BGRA2RGB);
+            } else if (image_bgr.channels() == 3){
+                cv::cvtColor(image_bgr, image, cv::COLOR_BGR2RGB);
+            } else{
+                fail("Wrong Image Channels",
+                    "Image " + image_path + " has " + std::to_string(image_bgr.channels()) + " channels. Only support 3 or 4 channels.");
+                return;
+            }
+
+            DecodedImage item;
+            item.index = index;
+            // resize to the shape for the ML model input
+            cv::resize(image, item.image, cv::Size(SAM_EMBEDDER_INPUT_IMAGE_WIDTH, SAM_EMBEDDER_INPUT_IMAGE_HEIGHT));
+            if (!decoded.push(std::move(item))){
+                return;
+            }
+        }
+    }
+
+    // Run one embedder session. The session is built on this thread so that several load in parallel.
+    void run_worker(const std::string& embedding_model_path, bool use_gpu, size_t intra_op_threads){
+        std::unique_ptr<SAMEmbedderSession> session;
+        DecodedImage item;
+        while (decoded.pop(item)){
+            ComputedEmbedding output;
+            output.index = item.index;
+            // fall back to CPU if fails with GPU.
+            while (true){
+                try{
+                    if (!session){
+                        session = std::make_unique<SAMEmbedderSession>(embedding_model_path, use_gpu, intra_op_threads);
+                    }
+                    // throw Ort::Exception("Testing.", ORT_FAIL);  // to simulate GPU/CPU failure
+                    session->run(item.image, output.embedding);
+                    break;
+                }catch(Ort::Exception& e){
+                    if (use_gpu){
+                        std::cerr << "Warning: Embedding session failed using the GPU. Will reattempt with the CPU.\n" << e.what() << std::endl;
+                        use_gpu = false;
+                        session.reset();
+                        continue;
+                    }
+                    fail("Error:", "Embedding session failed even when using the CPU.\n" + std::string(e.what()));
+                    return;
+                }catch(...){
+                    fail("Error:", "Unknown error. Embedding session failed.");
+                    return;
+                }
+            }
+            if (!computed.push(std::move(output))){
+                return;
+            }
+        }
+    }
+};
+
+
+}
+
+
 void compute_embeddings_for_folder(const std::string& embedding_model_path, const std::string& image_folder_path, bool use_gpu_for_embedder_session){
     const bool recursive_search = true;
     std::vector<std::string> all_image_paths = find_images_in_folder(image_folder_path, recursive_search);
@@ -202,84 +391,92 @@ void compute_embeddings_for_folder(const std::string& embedding_model_path, cons
         return;
     }
 
-    bool use_gpu = use_gpu_for_embedder_session;
-    std::unique_ptr<SAMEmbedderSession> embedding_session = make_unique<SAMEmbedderSession>(embedding_model_path, use_gpu);
-    std::vector<float> output_image_embedding;
-    for (size_t i = 0; i < all_image_paths.size(); i++){
-        const auto& image_path = all_image_paths[i];
-        std::cout << (i+1) << "/" << all_image_paths.size() << ": ";
-        const std::string embedding_path = image_path + ".embedding";
-        if (std::filesystem::exists(embedding_path)){
-            std::cout << "skip already computed embedding " << embedding_path << "." << std::endl;
+    std::vector<std::string> image_paths;
+    for (const std::string& image_path : all_image_paths){
+        if (has_image_embedding(image_path)){
+            std::cout << "skip already computed embedding for " << image_path << "." << std::endl;
             continue;
         }
-        std::cout << "computing embedding for " << image_path << "..." << std::endl;
-        cv::Mat image_bgr = cv::imread(image_path);
-        if (image_bgr.empty()){
-            std::cerr << "Error: image empty. Probably the file is not an image?" << std::endl;
-            QMessageBox box;
-            box.warning(nullptr, "Unable To Open Image",
-                QString::fromStdString("Cannot open image file " + image_path + ". Probably not an actual image?"));
-            return;
-        }
-        cv::Mat image;
-        if (image_bgr.channels() == 4){
-            cv::cvtColor(image_bgr, image, cv::COLOR_BGRA2RGB);
-        } else if (image_bgr.channels() == 3){
-            cv::cvtColor(image_bgr, image, cv::COLOR_BGR2RGB);
-        } else{
-            std::cerr << "Error: wrong image channels. Only work with RGB or RGBA images." << std::endl;
-            QMessageBox box;
-            box.warning(nullptr, "Wrong Image Channels",
-                QString::fromStdString("Image has " + std::to_string(image_bgr.channels()) + " channels. Only support 3 or 4 channels."));
-            return;
-        }
-
-        cv::Mat resized_mat;  // resize to the shape for the ML model input
-        cv::resize(image, resized_mat, cv::Size(SAM_EMBEDDER_INPUT_IMAGE_WIDTH, SAM_EMBEDDER_INPUT_IMAGE_HEIGHT));
-
-        output_image_embedding.clear();
-
-        // fall back to CPU if fails with GPU.
-        for(size_t j = 0; j < 2; j++){
-            try{
-                // If fails with GPU, fall back to CPU.
-                // throw Ort::Exception("Testing.", ORT_FAIL);  // to simulate GPU/CPU failure
-                embedding_session->run(resized_mat, output_image_embedding);
-                break;
-            }catch(Ort::Exception& e){
-                if (use_gpu){
-                    std::cerr << "Warning: Embedding session failed using the GPU. Will reattempt with the CPU.\n" << e.what() << std::endl;
-                    use_gpu = false;
-                    embedding_session = make_unique<SAMEmbedderSession>(embedding_model_path, use_gpu);
-                }else{
-                    std::cerr << "Error: Embedding session failed even when using the CPU.\n" << e.what() << std::endl;
-                    QMessageBox box;
-                    box.warning(nullptr, "Error:",
-                        QString::fromStdString("Error: Embedding session failed."));
-                    return;
-                }
-            }catch(...){
-                std::cerr << "Error: Unknown error. Embedding session failed." << std::endl;
-                QMessageBox box;
-                box.warning(nullptr, "Error:",
-                    QString::fromStdString("Error: Unknown error. Embedding session failed."));
-                return;
+        image_paths.emplace_back(image_path);
+    }
+    if (image_paths.empty()){
+        std::cout << "All images in folder " << image_folder_path << " already have embeddings." << std::endl;
+        return;
+    }
 
+    // A single GPU gains nothing from more sessions. On the CPU, one session
+    // doesn't scale to many cores. So run several and split the cores.
+    const bool use_gpu = use_gpu_for_embedder_session;
+    const size_t cores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    size_t sessions = use_gpu ? 1 : std::clamp<size_t>(cores / 8, 1, 4);
+    sessions = std::min(sessions, image_paths.size());
+    const size_t intra_op_threads = sessions > 1 ? cores / sessions : 0;
+    // Decoding and resizing a screenshot is far faster than the embedder.
+    const size_t decoders = std::min<size_t>(2, image_paths.size());
+
+    std::cout << "Computing " << image_paths.size() << " embeddings with " << sessions << " session(s), "
+              << (intra_op_threads == 0 ? std::string("default") : std::to_string(intra_op_threads))
+              << " intra-op thread(s) each and " << decoders << " decoder thread(s)." << std::endl;
+
+    EmbeddingPipeline pipeline(std::move(image_paths), 2 * sessions);
+    const size_t total = pipeline.image_paths.size();
+
+    pipeline.running_decoders.store(decoders);
+    pipeline.running_workers.store(sessions);
+    std::vector<Thread> threads;
+    for (size_t c = 0; c < decoders; c++){
+        threads.emplace_back([&]{
+            pipeline.run_decoder();
+            if (pipeline.running_decoders.fetch_sub(1) == 1){
+                pipeline.decoded.close();
             }
+        });
+    }
+    for (size_t c = 0; c < sessions; c++){
+        threads.emplace_back([&]{
+            pipeline.run_worker(embedding_model_path, use_gpu, intra_op_threads);
+            if (pipeline.running_workers.fetch_sub(1) == 1){
+                pipeline.computed.close();
+            }
+        });
+    }
 
-            if (j > 0){
-                std::cerr << "Internal Program Error: This section of code shouldn't be reachable." << std::endl;
-                QMessageBox box;
-                box.warning(nullptr, "Error:",
-                    QString::fromStdString("Internal Program Error: This section of code shouldn't be reachable."));
-                return;
+    // Write on this thread.
+    std::map<std::string, std::unique_ptr<EmbeddingPackWriter>> writers;
+    size_t done = 0;
+    ComputedEmbedding item;
+    while (!pipeline.failed.load(std::memory_order_acquire) && pipeline.computed.pop(item)){
+        const std::filesystem::path image_path(pipeline.image_paths[item.index]);
+        try{
+            const std::string folder = image_path.parent_path().string();
+            std::unique_ptr<EmbeddingPackWriter>& writer = writers[folder];
+            if (!writer){
+                writer = std::make_unique<EmbeddingPackWriter>(folder);
             }
+            writer->append(image_path.filename().string(), item.embedding.data(), item.embedding.size());
+        }catch (Exception& e){
+            pipeline.fail("Unable To Save Embedding", e.message());
+            break;
+        }catch (std::exception& e){
+            pipeline.fail("Unable To Save Embedding", e.what());
+            break;
         }
-        save_image_embedding_to_disk(image_path, output_image_embedding);
+        done++;
+        std::cout << done << "/" << total << ": saved embedding for " << image_path.string() << std::endl;
     }
-    std::cout << "Done computing embeddings for images in folder " << image_folder_path << "." << std::endl;
 
+    for (Thread& thread : threads){
+        thread.join();
+    }
+    writers.clear();
+
+    if (pipeline.failed.load(std::memory_order_acquire)){
+        QMessageBox box;
+        box.warning(nullptr, QString::fromStdString(pipeline.error_title),
+            QString::fromStdString(pipeline.error_message));
+        return;
+    }
+    std::cout << "Done computing embeddings for images in folder " << image_folder_path << "." << std::endl;
 }
 
 }
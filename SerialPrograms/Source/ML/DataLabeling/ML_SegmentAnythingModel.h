@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 #include <onnxruntime_cxx_api.h>
+#include "ML_EmbeddingStore.h"
 
 namespace cv{
     class Mat;
@@ -22,13 +23,18 @@ namespace ML{
 
 
 // Compute embeddings for all images in a folder. Only support .png, .jpg and .jpeg filename extensions so far.
+// Images that already have an embedding are skipped. The embeddings of each folder are appended to the
+// embedding pack of that folder. See ML_EmbeddingStore.h.
+// Decoding, inference and writing run on separate threads. On the CPU, several embedder sessions run in
+// parallel and the cores are split between them.
 // This can be very slow!
 void compute_embeddings_for_folder(const std::string& embedding_model_path, const std::string& image_folder_path, bool use_gpu_for_embedder_session);
 
 
 class SAMEmbedderSession{
 public:
-    SAMEmbedderSession(const std::string& model_path, bool use_gpu);
+    // intra_op_threads: see create_session_options(). 0 uses all cores.
+    SAMEmbedderSession(const std::string& model_path, bool use_gpu, size_t intra_op_threads = 0);
 
     // Given an image of shape SAM_EMBEDDER_INPUT_IMAGE_WIDTH x SAM_EMBEDDER_INPUT_IMAGE_HEIGHT, RGB channel order,
     // compute its image embedding as a vector<float> of size [SAM_EMBEDDER_OUTPUT_SIZE]
@@ -64,7 +70,7 @@ public:
     // output_boolean_mask: output mask in the shape of [original_image_height x original_image_width].
     //     Vector size: original_image_height * original_image_width.
     void run(
-        std::vector<float>& embedding,
+        const ImageEmbedding& embedding,
         int original_image_height, int original_image_width,
         const std::vector<int>& input_points,
         const std::vector<int>& input_point_labels,
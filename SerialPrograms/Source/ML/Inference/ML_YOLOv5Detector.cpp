@@ -15,6 +15,7 @@
 #include "CommonFramework/VideoPipeline/VideoOverlay.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
 #include "CommonFramework/Globals.h"
+#include "CommonFramework/Logging/Logger.h"
 #include "Common/Cpp/StringTools.h"
 #include "Common/Cpp/PrettyPrint.h"
 #include "ML_YOLOv5Detector.h"
@@ -27,7 +28,11 @@ namespace PokemonAutomation{
 namespace ML{
 
 
-YOLOv5Detector::~YOLOv5Detector() = default;
+YOLOv5Detector::~YOLOv5Detector(){
+    if (m_yolo_session && m_yolo_session->latency().inference.count() > 0){
+        m_yolo_session->log_latency(global_logger_tagged());
+    }
+}
 
 
 YOLOv5Detector::YOLOv5Detector(const std::string& model_path)
@@ -86,10 +91,9 @@ bool YOLOv5Detector::detect(const ImageViewRGB32& screen){
         return false;
     }
 
+    //  The session reads BGRA directly. No need to convert to RGB first.
     cv::Mat frame_mat_bgra = screen.to_opencv_Mat();
-    cv::Mat frame_mat_rgb;
-    cv::cvtColor(frame_mat_bgra, frame_mat_rgb, cv::COLOR_BGRA2RGB);
-    
+
     m_output_boxes.clear();
 
     // fall back to CPU if fails with GPU.
@@ -97,7 +101,7 @@ bool YOLOv5Detector::detect(const ImageViewRGB32& screen){
         try{
             // if (m_use_gpu){ throw Ort::Exception("Testing.", ORT_FAIL); }  // to simulate GPU/CPU failure
             // If fails with GPU, fall back to CPU.
-            m_yolo_session->run(frame_mat_rgb, m_output_boxes);
+            m_yolo_session->run(frame_mat_bgra, m_output_boxes);
             break;
         }catch(Ort::Exception& e){
             if (m_use_gpu){
@@ -42,8 +42,11 @@ std::string create_file_hash(const std::string& filepath){
 }
 
 
-Ort::SessionOptions create_session_options(const std::string& model_cache_path, bool use_gpu){
+Ort::SessionOptions create_session_options(const std::string& model_cache_path, bool use_gpu, size_t intra_op_threads){
     Ort::SessionOptions so;
+    if (intra_op_threads > 0){
+        so.SetIntraOpNumThreads((int)intra_op_threads);
+    }
     std::cout << "Set potential model cache path in session options: " << model_cache_path << std::endl;
 
 if (use_gpu){
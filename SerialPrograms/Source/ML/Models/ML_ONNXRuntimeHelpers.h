@@ -23,7 +23,10 @@ namespace ML{
 //
 // model_cache_path: the path to store model caches. This path is better
 //   to be unique for each model for easier file management.
-Ort::SessionOptions create_session_options(const std::string& model_cache_path, bool use_gpu);
+// intra_op_threads: the number of threads ONNX Runtime uses inside one inference call.
+//   0 lets ONNX Runtime pick, which is one per physical core. Set it when running
+//   several sessions in parallel so they don't oversubscribe the CPU.
+Ort::SessionOptions create_session_options(const std::string& model_cache_path, bool use_gpu, size_t intra_op_threads = 0);
 
 
 // Create an ONNX Session. It will also update the model cache on macOS if necessary.
@@ -7,6 +7,7 @@
 
 
 #include <string>
+#include <algorithm>
 //#include <iostream>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/dnn.hpp>
@@ -19,42 +20,20 @@ namespace PokemonAutomation{
 namespace ML{
 
 
-std::tuple<int, int, double, double> resize_image_with_border(
-    const cv::Mat& input_image,
-    cv::Mat& output_image,
-    int target_width, int target_height,
-    cv::Scalar border_color = cv::Scalar(0,0,0)
+//  Normalize one row of 8-bit pixels to [0, 1] and split it into the three
+//  CHW planes.
+template <size_t CHANNELS, size_t R, size_t B>
+void normalize_transpose_row(
+    float* out_r, float* out_g, float* out_b,
+    const uint8_t* src, size_t width
 ){
-    int original_width = input_image.cols;
-    int original_height = input_image.rows;
-
-    double scale_x = static_cast<double>(target_width) / original_width;
-    double scale_y = static_cast<double>(target_height) / original_height;
-    double scale = std::min(scale_x, scale_y);
-
-    int new_width = static_cast<int>(original_width * scale);
-    int new_height = static_cast<int>(original_height * scale);
-    new_width = std::min(new_width, target_width);
-    new_height = std::min(new_height, target_height);
-
-    if (new_width == 0 || new_height == 0){
-        throw std::runtime_error("Input Image too small: " + std::to_string(original_width) + " x " + std::to_string(original_height));
+    const float SCALE = 1.0f / 255.0f;
+    for (size_t c = 0; c < width; c++){
+        out_r[c] = src[R] * SCALE;
+        out_g[c] = src[1] * SCALE;
+        out_b[c] = src[B] * SCALE;
+        src += CHANNELS;
     }
-
-    cv::Mat resized_image;
-    cv::resize(input_image, resized_image, cv::Size(new_width, new_height), 0, 0, cv::INTER_LINEAR); // INTER_AREA for shrinking
-
-    int border_top = (target_height - new_height) / 2;
-    int border_bottom = target_height - new_height - border_top;
-    int border_left = (target_width - new_width) / 2;
-    int border_right = target_width - new_width - border_left;
-
-    cv::copyMakeBorder(resized_image, output_image, border_top, border_bottom, border_left, border_right, cv::BORDER_CONSTANT, border_color);
-
-    return std::make_tuple(
-        border_left, border_top,
-        1.0 / new_width, 1.0 / new_height
-    );
 }
 
 
@@ -86,99 +65,188 @@ YOLOv5Session::YOLOv5Session(const std::string& model_path, std::vector<std::str
     m_model_output.resize(YOLO5_NUM_CANDIDATES * m_output_shape[2]);
 }
 
-// input: rgb color order
-void YOLOv5Session::run(const cv::Mat& input_image, std::vector<YOLOv5Session::DetectionBox>& output_boxes){
+YOLOv5Session::Letterbox YOLOv5Session::preprocess(const cv::Mat& input_image, float* model_input){
     CV_Assert(input_image.depth() == CV_8U);
-    CV_Assert(input_image.channels() == 3);
-
-    cv::Mat image_resized;
+    const int channels = input_image.channels();
+    CV_Assert(channels == 3 || channels == 4);
 
-    int x_shift = 0, y_shift = 0;
-    double x_scale = 1.0, y_scale = 1.0;
-    std::tie(x_shift, y_shift, x_scale, y_scale) = resize_image_with_border(input_image, image_resized,
-        YOLO5_INPUT_IMAGE_SIZE, YOLO5_INPUT_IMAGE_SIZE, cv::Scalar(114, 114, 114));
+    const int target_size = YOLO5_INPUT_IMAGE_SIZE;
+    int original_width = input_image.cols;
+    int original_height = input_image.rows;
 
-    // Declare a destination Mat for float32
-    cv::Mat image_float;
+    double scale_x = static_cast<double>(target_size) / original_width;
+    double scale_y = static_cast<double>(target_size) / original_height;
+    double scale = std::min(scale_x, scale_y);
 
-    // Convert the uint8_image to image_float
-    // The third argument (alpha) is a scaling factor.
-    // For normalization to [0.0, 1.0], use 1.0 / 255.0.
-    // For retaining original values (0-255), use 1.0.
-    image_resized.convertTo(image_float, CV_32F, 1.0 / 255.0); 
+    int new_width = static_cast<int>(original_width * scale);
+    int new_height = static_cast<int>(original_height * scale);
+    new_width = std::min(new_width, target_size);
+    new_height = std::min(new_height, target_size);
 
-    for (int c = 0, i = 0; c < 3; c++) {
-        for (int row = 0; row < image_float.rows; row++) {
-            for (int col = 0; col < image_float.cols; col++) {
-                float pixel_value = image_float.at<cv::Vec3f>(row, col)[c];
-                m_model_input[i++] = pixel_value;
-            }
-        }
+    if (new_width == 0 || new_height == 0){
+        throw std::runtime_error("Input Image too small: " + std::to_string(original_width) + " x " + std::to_string(original_height));
     }
 
-    auto input_tensor = create_tensor<float>(m_memory_info, m_model_input, m_input_shape);
-    auto output_tensor = create_tensor<float>(m_memory_info, m_model_output, m_output_shape);
+    const cv::Mat* resized = &input_image;
+    if (new_width != original_width || new_height != original_height){
+        cv::resize(input_image, m_resized, cv::Size(new_width, new_height), 0, 0, cv::INTER_LINEAR); // INTER_AREA for shrinking
+        resized = &m_resized;
+    }
 
-    const char* input_name_c = m_input_names[0].data();
-    const char* output_name_c = m_output_names[0].data();
-    // auto start = std::chrono::steady_clock::now();
-    m_session.Run(m_run_options, &input_name_c, &input_tensor, 1, &output_name_c, &output_tensor, 1);
-    // auto end = std::chrono::steady_clock::now();
-    // auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-    // std::cout << "Yolov5 inference time: " << milliseconds << " ms" << std::endl;
+    const int border_top = (target_size - new_height) / 2;
+    const int border_left = (target_size - new_width) / 2;
+
+    //  Letterbox, normalize and transpose HWC -> CHW in a single pass straight
+    //  into the model input.
+    const float BORDER = 114.0f / 255.0f;
+    const size_t plane_size = (size_t)target_size * target_size;
+    float* plane_r = model_input;
+    float* plane_g = model_input + plane_size;
+    float* plane_b = model_input + 2 * plane_size;
+    for (int row = 0; row < target_size; row++){
+        size_t offset = (size_t)row * target_size;
+        float* out_r = plane_r + offset;
+        float* out_g = plane_g + offset;
+        float* out_b = plane_b + offset;
+
+        int src_row = row - border_top;
+        if (src_row < 0 || src_row >= new_height){
+            std::fill(out_r, out_r + target_size, BORDER);
+            std::fill(out_g, out_g + target_size, BORDER);
+            std::fill(out_b, out_b + target_size, BORDER);
+            continue;
+        }
 
-    const size_t cand_size = m_label_names.size() + 5;
+        std::fill(out_r, out_r + border_left, BORDER);
+        std::fill(out_g, out_g + border_left, BORDER);
+        std::fill(out_b, out_b + border_left, BORDER);
+        std::fill(out_r + border_left + new_width, out_r + target_size, BORDER);
+        std::fill(out_g + border_left + new_width, out_g + target_size, BORDER);
+        std::fill(out_b + border_left + new_width, out_b + target_size, BORDER);
+
+        const uint8_t* src = resized->ptr<uint8_t>(src_row);
+        if (channels == 3){
+            //  RGB
+            normalize_transpose_row<3, 0, 2>(
+                out_r + border_left, out_g + border_left, out_b + border_left,
+                src, new_width
+            );
+        }else{
+            //  BGRA
+            normalize_transpose_row<4, 2, 0>(
+                out_r + border_left, out_g + border_left, out_b + border_left,
+                src, new_width
+            );
+        }
+    }
 
-    std::vector<cv::Rect> pixel_boxes;
-    std::vector<int> indices;
-    std::vector<float> scores;
-    std::vector<size_t> labels;
+    return Letterbox{
+        border_left, border_top,
+        1.0 / new_width, 1.0 / new_height
+    };
+}
 
-    for(int i = 0; i < YOLO5_NUM_CANDIDATES; i++){
-        float cx = m_model_output[cand_size*i];
-        float cy = m_model_output[cand_size*i+1];
-        float w = m_model_output[cand_size*i+2];
-        float h = m_model_output[cand_size*i+3];
-        float sc = m_model_output[cand_size*i+4];
+void YOLOv5Session::postprocess(
+    const float* model_output, const Letterbox& letterbox,
+    std::vector<DetectionBox>& output_boxes
+){
+    const size_t num_labels = m_label_names.size();
+    const size_t cand_size = num_labels + 5;
+
+    m_pixel_boxes.clear();
+    m_scores.clear();
+    m_labels.clear();
+    m_indices.clear();
+
+    for (int i = 0; i < YOLO5_NUM_CANDIDATES; i++){
+        const float* cand = model_output + cand_size * i;
+
+        //  The label scores are at most 1.0. So if the objectness is already
+        //  below the threshold, so is the final score. This rejects almost all
+        //  of the candidates without looking at their labels.
+        //
+        //  This is a scalar early-out, not a vectorized filter. The objectness
+        //  values are "cand_size" floats apart in the output. Gathering them
+        //  into SIMD lanes costs about as much as this branch saves.
+        float sc = cand[4];
+        if (sc <= SCORE_THRESHOLD){
+            continue;
+        }
 
         float max_score = 0.0;
         size_t pred_label = 0;  // predicted label
-        for(size_t j_label = 0; j_label < m_label_names.size(); j_label++){
-            float score = m_model_output[cand_size*i+5+j_label];
+        for (size_t j_label = 0; j_label < num_labels; j_label++){
+            float score = cand[5 + j_label];
             if (score > max_score){
                 max_score = score;
                 pred_label = j_label;
             }
         }
-        scores.push_back(max_score * sc); // sc is like a global confidence scale?
-        pixel_boxes.emplace_back((int)(cx - w / 2 + 0.5), (int)(cy - h / 2 + 0.5), int(w + 0.5), int(h + 0.5));
-        indices.push_back(i);
-        labels.push_back(pred_label);
-    }
+        float score = max_score * sc;  // sc is like a global confidence scale?
+        if (score <= SCORE_THRESHOLD){
+            continue;
+        }
 
-    cv::dnn::NMSBoxes(pixel_boxes, scores, 0.2f, 0.45f, indices);
+        float cx = cand[0];
+        float cy = cand[1];
+        float w = cand[2];
+        float h = cand[3];
+        m_scores.push_back(score);
+        m_pixel_boxes.emplace_back((int)(cx - w / 2 + 0.5), (int)(cy - h / 2 + 0.5), int(w + 0.5), int(h + 0.5));
+        m_labels.push_back(pred_label);
+    }
 
-    // std::cout << "num found pixel_boxes " << indices.size() << std::endl;
-    // return;
+    cv::dnn::NMSBoxes(m_pixel_boxes, m_scores, SCORE_THRESHOLD, NMS_THRESHOLD, m_indices);
 
-    for (int index : indices)
-    {
+    for (int index : m_indices){
         // Note the model predicts on (640x640) images, we need to convert the detected pixel_boxes back to
         // the full frame dimension.
-        double x = (pixel_boxes[index].x - x_shift) * x_scale;
-        double y = (pixel_boxes[index].y - y_shift) * y_scale;
-        double w = pixel_boxes[index].width * x_scale;
-        double h = pixel_boxes[index].height * y_scale;
-        // std::cout << scores[index] << " " <<  x << " " << y << " " << w << " " << h << std::endl;
+        const cv::Rect& pixel_box = m_pixel_boxes[index];
+        double x = (pixel_box.x - letterbox.x_shift) * letterbox.x_scale;
+        double y = (pixel_box.y - letterbox.y_shift) * letterbox.y_scale;
+        double w = pixel_box.width * letterbox.x_scale;
+        double h = pixel_box.height * letterbox.y_scale;
 
         YOLOv5Session::DetectionBox b;
         b.box = ImageFloatBox(x, y, w, h);
-        b.score = scores[index];
-        b.label_idx = labels[index];
+        b.score = m_scores[index];
+        b.label_idx = m_labels[index];
         output_boxes.push_back(b);
     }
 }
 
+// input: rgb or bgra color order
+void YOLOv5Session::run(const cv::Mat& input_image, std::vector<YOLOv5Session::DetectionBox>& output_boxes){
+    WallClock time0 = current_time();
+
+    Letterbox letterbox = preprocess(input_image, m_model_input.data());
+
+    WallClock time1 = current_time();
+
+    auto input_tensor = create_tensor<float>(m_memory_info, m_model_input, m_input_shape);
+    auto output_tensor = create_tensor<float>(m_memory_info, m_model_output, m_output_shape);
+
+    const char* input_name_c = m_input_names[0].data();
+    const char* output_name_c = m_output_names[0].data();
+    m_session.Run(m_run_options, &input_name_c, &input_tensor, 1, &output_name_c, &output_tensor, 1);
+
+    WallClock time2 = current_time();
+
+    postprocess(m_model_output.data(), letterbox, output_boxes);
+
+    WallClock time3 = current_time();
+
+    m_latency.preprocess += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+    m_latency.inference += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time2 - time1).count();
+    m_latency.postprocess += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time3 - time2).count();
+}
+
+void YOLOv5Session::log_latency(Logger& logger) const{
+    m_latency.preprocess.log(logger, "YOLOv5 Preprocess", "ms", 1000);
+    m_latency.inference.log(logger, "YOLOv5 Inference", "ms", 1000);
+    m_latency.postprocess.log(logger, "YOLOv5 Postprocess", "ms", 1000);
+}
+
 
 
 }
@@ -10,9 +10,14 @@
 
 
 #include <onnxruntime_cxx_api.h>
+#include <opencv2/core/mat.hpp>
 #include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonFramework/Tools/StatAccumulator.h"
 
 namespace PokemonAutomation{
+
+class Logger;
+
 namespace ML{
 
 
@@ -28,17 +33,47 @@ public:
         size_t label_idx;
     };
 
+    //  Time spent in each stage of run(), in microseconds.
+    struct StageLatency{
+        StatAccumulatorI32 preprocess;
+        StatAccumulatorI32 inference;
+        StatAccumulatorI32 postprocess;
+    };
+
     YOLOv5Session(const std::string& model_path, std::vector<std::string> label_names, bool use_gpu);
 
+    // input_image: CV_8UC3 in RGB order or CV_8UC4 in BGRA order (the layout
+    //  of ImageViewRGB32::to_opencv_Mat()).
+    //
+    //  Runs the model on one image. Batching several images into one Run()
+    //  is not supported. Every caller processes frames one at a time as they
+    //  arrive, and waiting to fill a batch would delay each detection.
     void run(const cv::Mat& input_image, std::vector<DetectionBox>& detections);
 
+    const StageLatency& latency() const{ return m_latency; }
+    void log_latency(Logger& logger) const;
+
     const std::string& label_name(size_t idx) const { return m_label_names[idx]; }
 
     std::vector<std::string> get_label_names() const { return m_label_names; }
     
+private:
+    //  How to map a box on the model input back to the original image.
+    struct Letterbox{
+        int x_shift;
+        int y_shift;
+        double x_scale;
+        double y_scale;
+    };
+
+    Letterbox preprocess(const cv::Mat& input_image, float* model_input);
+    void postprocess(const float* model_output, const Letterbox& letterbox, std::vector<DetectionBox>& detections);
+
 private:
     const int YOLO5_INPUT_IMAGE_SIZE = 640;
     const int YOLO5_NUM_CANDIDATES = 25200;
+    static constexpr float SCORE_THRESHOLD = 0.2f;
+    static constexpr float NMS_THRESHOLD = 0.45f;
 
     std::vector<std::string> m_label_names;
 
@@ -54,6 +89,15 @@ private:
 
     std::vector<float> m_model_input;
     std::vector<float> m_model_output;
+
+    //  Scratch space reused across runs.
+    cv::Mat m_resized;
+    std::vector<cv::Rect> m_pixel_boxes;
+    std::vector<float> m_scores;
+    std::vector<size_t> m_labels;
+    std::vector<int> m_indices;
+
+    StageLatency m_latency;
 };
 
 
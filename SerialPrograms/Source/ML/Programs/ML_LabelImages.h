@@ -81,7 +81,8 @@ public:
     void clear_for_new_image();
 
     // Load image related data:
-    // - Image SAM embedding data file, which has the same file path but with a name suffix ".embedding"
+    // - Image SAM embedding, from the embedding pack of the image folder or from a legacy embedding file
+    //   which has the same file path but with a name suffix ".embedding". See ML_EmbeddingStore.h.
     // - Existing annotation file, which is stored in the same folder as the image and with the same filename as
     //   the image but with name extension replaced to be ".json".
     void load_image_related_data(const std::string& image_path, const size_t source_image_width, const size_t source_image_height);
@@ -187,7 +188,7 @@ private:
 
     size_t source_image_height = 0;
     size_t source_image_width = 0;
-    std::vector<float> m_image_embedding;
+    ImageEmbedding m_image_embedding;
     std::vector<bool> m_output_boolean_mask;
 
     std::unique_ptr<SAMSession> m_sam_session;
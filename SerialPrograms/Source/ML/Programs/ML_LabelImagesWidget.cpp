@@ -20,6 +20,7 @@
 #include "Common/Qt/Options/ConfigWidget.h"
 #include "Common/Qt/CollapsibleGroupBox.h"
 
+#include "ML/DataLabeling/ML_EmbeddingStore.h"
 #include "ML_LabelImages.h"
 #include "ML_LabelImagesWidget.h"
 #include "ML/UI/ML_ImageAnnotationDisplayWidget.h"
@@ -248,10 +249,16 @@ void LabelImages_Widget::post_startup(VideoSource* source){
         return;
     }
 
-    const std::string embedding_path = image_path + ".embedding";
-    const std::string embedding_path_display = "<IMAGE_FOLDER>/" + std::filesystem::path(embedding_path).filename().string();
-    if (!std::filesystem::exists(embedding_path)){
-        m_embedding_info_label->setText(QString::fromStdString(embedding_path_display + " Dose Not Exist. Cannot Annotate The Image!"));
+    // The embedding is either in the folder's embedding pack or in a legacy <IMAGE>.embedding file.
+    const std::string image_filename = std::filesystem::path(image_path).filename().string();
+    std::string embedding_path_display;
+    std::shared_ptr<const EmbeddingPack> pack = EmbeddingPack::open(embedding_pack_path_for_image(image_path));
+    if (pack && pack->contains(image_filename)){
+        embedding_path_display = "<IMAGE_FOLDER>/" + std::string(EMBEDDING_PACK_FILENAME) + ": " + image_filename;
+    }else if (std::filesystem::exists(image_path + ".embedding")){
+        embedding_path_display = "<IMAGE_FOLDER>/" + image_filename + ".embedding";
+    }else{
+        m_embedding_info_label->setText(QString::fromStdString("<IMAGE_FOLDER>/" + image_filename + " Has No Embedding. Cannot Annotate The Image!"));
         m_embedding_info_label->setStyleSheet("color: red");
         return;
     }
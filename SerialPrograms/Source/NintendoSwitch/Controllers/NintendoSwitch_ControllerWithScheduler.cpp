@@ -21,8 +21,8 @@ void ControllerWithScheduler::issue_buttons(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     Button button
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = start_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         if (cancellable){
@@ -39,7 +39,7 @@ void ControllerWithScheduler::issue_buttons(
             if (button & mask){
                 m_scheduler.issue_to_resource(
                     schedule,
-                    std::make_unique<SwitchCommand_Button>((SwitchResource)c),
+                    SwitchCommand_Button((SwitchResource)c),
                     WallDuration::zero(), hold, cooldown
                 );
             }
@@ -62,8 +62,8 @@ void ControllerWithScheduler::issue_dpad(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     DpadPosition position
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = start_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         if (cancellable){
@@ -71,7 +71,7 @@ void ControllerWithScheduler::issue_dpad(
         }
         m_scheduler.issue_to_resource(
             schedule,
-            std::make_unique<SwitchCommand_Dpad>(position),
+            SwitchCommand_Dpad(position),
             delay, hold, cooldown
         );
     }
@@ -91,8 +91,8 @@ void ControllerWithScheduler::issue_left_joystick(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     uint8_t x, uint8_t y
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = start_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         if (cancellable){
@@ -100,7 +100,7 @@ void ControllerWithScheduler::issue_left_joystick(
         }
         m_scheduler.issue_to_resource(
             schedule,
-            std::make_unique<SwitchCommand_LeftJoystick>(x, y),
+            SwitchCommand_LeftJoystick(x, y),
             delay, hold, cooldown
         );
     }
@@ -120,8 +120,8 @@ void ControllerWithScheduler::issue_right_joystick(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     uint8_t x, uint8_t y
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = start_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         if (cancellable){
@@ -129,7 +129,7 @@ void ControllerWithScheduler::issue_right_joystick(
         }
         m_scheduler.issue_to_resource(
             schedule,
-            std::make_unique<SwitchCommand_RightJoystick>(x, y),
+            SwitchCommand_RightJoystick(x, y),
             delay, hold, cooldown
         );
     }
@@ -153,8 +153,8 @@ void ControllerWithScheduler::issue_gyro(
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
     int16_t value
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = start_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         if (cancellable){
@@ -162,7 +162,7 @@ void ControllerWithScheduler::issue_gyro(
         }
         m_scheduler.issue_to_resource(
             schedule,
-            std::make_unique<SwitchCommand_Gyro>(id, value),
+            SwitchCommand_Gyro(id, value),
             delay, hold, cooldown
         );
     }
@@ -189,8 +189,8 @@ void ControllerWithScheduler::issue_full_controller_state(
     uint8_t left_x, uint8_t left_y,
     uint8_t right_x, uint8_t right_y
 ){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = start_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         if (cancellable){
@@ -216,24 +216,24 @@ void ControllerWithScheduler::issue_full_controller_state(
             if (button & mask){
                 m_scheduler.issue_to_resource(
                     schedule,
-                    std::make_unique<SwitchCommand_Button>((SwitchResource)c),
+                    SwitchCommand_Button((SwitchResource)c),
                     WallDuration::zero(), hold, WallDuration::zero()
                 );
             }
         }
         m_scheduler.issue_to_resource(
             schedule,
-            std::make_unique<SwitchCommand_Dpad>(position),
+            SwitchCommand_Dpad(position),
             WallDuration::zero(), hold, WallDuration::zero()
         );
         m_scheduler.issue_to_resource(
             schedule,
-            std::make_unique<SwitchCommand_LeftJoystick>(left_x, left_y),
+            SwitchCommand_LeftJoystick(left_x, left_y),
             WallDuration::zero(), hold, WallDuration::zero()
         );
         m_scheduler.issue_to_resource(
             schedule,
-            std::make_unique<SwitchCommand_RightJoystick>(right_x, right_y),
+            SwitchCommand_RightJoystick(right_x, right_y),
             hold, hold, WallDuration::zero()
         );
     }
@@ -70,70 +70,66 @@ enum class SwitchResource{
     GYRO_ROTATE_Z,
 };
 
-class SwitchCommand : public SchedulerResource{
-public:
-    using SchedulerResource::SchedulerResource;
-    virtual void apply(SwitchControllerState& state) const = 0;
-};
-class SwitchCommand_Button : public SwitchCommand{
+//  The scheduler stores commands by value, so these only pack their
+//  parameters into "value". "apply_switch_command()" unpacks them.
+class SwitchCommand_Button : public SchedulerResource{
 public:
     SwitchCommand_Button(SwitchResource id)
-        : SwitchCommand((size_t)id)
+        : SchedulerResource((size_t)id)
     {}
-    virtual void apply(SwitchControllerState& state) const{
-        state.buttons |= (Button)((ButtonFlagType)1 << id);
-    }
 };
-struct SwitchCommand_Dpad : public SwitchCommand{
-    DpadPosition position;
-
+class SwitchCommand_Dpad : public SchedulerResource{
+public:
     SwitchCommand_Dpad(DpadPosition position)
-        : SwitchCommand((size_t)SwitchResource::DPAD)
-        , position(position)
+        : SchedulerResource((size_t)SwitchResource::DPAD, (uint64_t)position)
     {}
-    virtual void apply(SwitchControllerState& state) const override{
-        state.dpad = position;
-    }
 };
-struct SwitchCommand_LeftJoystick : public SwitchCommand{
-    uint8_t x;
-    uint8_t y;
-
+class SwitchCommand_LeftJoystick : public SchedulerResource{
+public:
     SwitchCommand_LeftJoystick(uint8_t x, uint8_t y)
-        : SwitchCommand((size_t)SwitchResource::JOYSTICK_LEFT)
-        , x(x), y(y)
+        : SchedulerResource((size_t)SwitchResource::JOYSTICK_LEFT, x | (uint64_t)y << 8)
     {}
-    virtual void apply(SwitchControllerState& state) const override{
-        state.left_stick_x = x;
-        state.left_stick_y = y;
-    }
 };
-struct SwitchCommand_RightJoystick : public SwitchCommand{
-    uint8_t x;
-    uint8_t y;
-
+class SwitchCommand_RightJoystick : public SchedulerResource{
+public:
     SwitchCommand_RightJoystick(uint8_t x, uint8_t y)
-        : SwitchCommand((size_t)SwitchResource::JOYSTICK_RIGHT)
-        , x(x), y(y)
+        : SchedulerResource((size_t)SwitchResource::JOYSTICK_RIGHT, x | (uint64_t)y << 8)
     {}
-    virtual void apply(SwitchControllerState& state) const override{
-        state.right_stick_x = x;
-        state.right_stick_y = y;
-    }
 };
-struct SwitchCommand_Gyro : public SwitchCommand{
-    int16_t value;
-
+class SwitchCommand_Gyro : public SchedulerResource{
+public:
     SwitchCommand_Gyro(SwitchResource id, int16_t value)
-        : SwitchCommand((size_t)id)
-        , value(value)
+        : SchedulerResource((size_t)id, (uint16_t)value)
     {}
-    virtual void apply(SwitchControllerState& state) const override{
-        size_t index = (ButtonFlagType)id - (ButtonFlagType)SwitchResource::GYRO_ACCEL_X;
-        state.gyro[index] = value;
-    }
 };
 
+inline void apply_switch_command(SwitchControllerState& state, const SchedulerResource& command){
+    switch ((SwitchResource)command.id){
+    case SwitchResource::DPAD:
+        state.dpad = (DpadPosition)command.value;
+        return;
+    case SwitchResource::JOYSTICK_LEFT:
+        state.left_stick_x = (uint8_t)command.value;
+        state.left_stick_y = (uint8_t)(command.value >> 8);
+        return;
+    case SwitchResource::JOYSTICK_RIGHT:
+        state.right_stick_x = (uint8_t)command.value;
+        state.right_stick_y = (uint8_t)(command.value >> 8);
+        return;
+    case SwitchResource::GYRO_ACCEL_X:
+    case SwitchResource::GYRO_ACCEL_Y:
+    case SwitchResource::GYRO_ACCEL_Z:
+    case SwitchResource::GYRO_ROTATE_X:
+    case SwitchResource::GYRO_ROTATE_Y:
+    case SwitchResource::GYRO_ROTATE_Z:
+        state.gyro[command.id - (size_t)SwitchResource::GYRO_ACCEL_X] = (uint16_t)command.value;
+        return;
+    default:
+        state.buttons |= (Button)((ButtonFlagType)1 << command.id);
+        return;
+    }
+}
+
 
 
 
@@ -29,6 +29,10 @@ SerialPABotBase_Controller::SerialPABotBase_Controller(
     , m_handle(connection)
     , m_serial(connection.botbase())
 {
+    if (m_serial){
+        m_scheduler.set_trace(m_serial->trace());
+    }
+
     if (!connection.is_ready()){
         return;
     }
@@ -63,8 +67,8 @@ void SerialPABotBase_Controller::replace_on_next_command(){
 
 
 void SerialPABotBase_Controller::wait_for_all(Cancellable* cancellable){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = start_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
 
@@ -41,6 +41,10 @@ public:
         return m_error_string;
     }
 
+    WallDuration command_latency() const{
+        return m_serial ? m_serial->round_trip_time() / 2 : WallDuration::zero();
+    }
+
 
 public:
     void cancel_all_commands();
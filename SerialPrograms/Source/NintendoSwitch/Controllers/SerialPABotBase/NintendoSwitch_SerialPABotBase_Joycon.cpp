@@ -165,7 +165,7 @@ void SerialPABotBase_Joycon<JoyconType>::execute_state_left_joycon(
 ){
     SwitchControllerState controller_state;
     for (auto& item : entry.state){
-        static_cast<const SwitchCommand&>(*item).apply(controller_state);
+        apply_switch_command(controller_state, item);
     }
 
     pabb_NintendoSwitch_OemController_State0x30_Buttons buttons{
@@ -209,7 +209,7 @@ void SerialPABotBase_Joycon<JoyconType>::execute_state_right_joycon(
 ){
     SwitchControllerState controller_state;
     for (auto& item : entry.state){
-        static_cast<const SwitchCommand&>(*item).apply(controller_state);
+        apply_switch_command(controller_state, item);
     }
 
     pabb_NintendoSwitch_OemController_State0x30_Buttons buttons{
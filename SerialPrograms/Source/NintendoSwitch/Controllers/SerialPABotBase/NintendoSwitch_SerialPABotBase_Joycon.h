@@ -58,6 +58,9 @@ public:
     virtual Milliseconds timing_variation() const override{
         return m_timing_variation;
     }
+    virtual WallDuration command_latency() const override{
+        return SerialPABotBase_Controller::command_latency();
+    }
     virtual bool atomic_multibutton() const override{
         return true;
     }
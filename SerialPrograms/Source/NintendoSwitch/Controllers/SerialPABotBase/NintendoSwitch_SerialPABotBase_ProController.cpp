@@ -5,6 +5,7 @@
  */
 
 #include "Controllers/SerialPABotBase/Connection/MessageConverter.h"
+#include "Controllers/SerialPABotBase/SerialPABotBase_Routines_NS1_OemControllers.h"
 #include "NintendoSwitch_SerialPABotBase_ProController.h"
 
 //#include <iostream>
@@ -36,17 +37,18 @@ SerialPABotBase_ProController::~SerialPABotBase_ProController(){
 }
 
 
-void SerialPABotBase_ProController::execute_state(
-    Cancellable* cancellable,
+bool SerialPABotBase_ProController::build_report(
+    pabb_NintendoSwitch_OemController_State0x30_Buttons& buttons,
+    pabb_NintendoSwitch_OemController_State0x30_Gyro& gyro,
     const SuperscalarScheduler::ScheduleEntry& entry
 ){
     SwitchControllerState controller_state;
     for (auto& item : entry.state){
-        static_cast<const SwitchCommand&>(*item).apply(controller_state);
+        apply_switch_command(controller_state, item);
     }
 
     //  https://github.com/dekuNukem/Nintendo_Switch_Reverse_Engineering/blob/master/bluetooth_hid_notes.md
-    pabb_NintendoSwitch_OemController_State0x30_Buttons buttons{
+    buttons = pabb_NintendoSwitch_OemController_State0x30_Buttons{
         .button3 = 0,
         .button4 = 0,
         .button5 = 0,
@@ -78,7 +80,7 @@ void SerialPABotBase_ProController::execute_state(
         controller_state.right_stick_x, controller_state.right_stick_y
     );
 
-    pabb_NintendoSwitch_OemController_State0x30_Gyro gyro{
+    gyro = pabb_NintendoSwitch_OemController_State0x30_Gyro{
         0x0000,
         0x0000,
         0x0000,
@@ -86,7 +88,17 @@ void SerialPABotBase_ProController::execute_state(
         0x0000,
         0x0000,
     };
-    bool gyro_active = populate_report_gyro(gyro, controller_state);
+    return populate_report_gyro(gyro, controller_state);
+}
+
+
+void SerialPABotBase_ProController::execute_state(
+    Cancellable* cancellable,
+    const SuperscalarScheduler::ScheduleEntry& entry
+){
+    pabb_NintendoSwitch_OemController_State0x30_Buttons buttons;
+    pabb_NintendoSwitch_OemController_State0x30_Gyro gyro;
+    bool gyro_active = build_report(buttons, gyro, entry);
 
 //    gyro_active = true;
 //    gyro.rotation_y = 0x00ff;
@@ -109,6 +121,34 @@ void SerialPABotBase_ProController::execute_state(
     );
 #endif
 }
+void SerialPABotBase_ProController::execute_schedule(
+    Cancellable* cancellable,
+    const SuperscalarScheduler::Schedule& schedule
+){
+    if (schedule.size() < 2 || !m_handle.supports_batched_reports()){
+        ControllerWithScheduler::execute_schedule(cancellable, schedule);
+        return;
+    }
+
+    SerialPABotBase::ButtonsBatchSender sender(*m_serial, cancellable);
+
+    for (const SuperscalarScheduler::ScheduleEntry& entry : schedule){
+        pabb_NintendoSwitch_OemController_State0x30_Buttons buttons;
+        pabb_NintendoSwitch_OemController_State0x30_Gyro gyro;
+        bool gyro_active = build_report(buttons, gyro, entry);
+
+        //  Gyro states are not batchable. Send them the normal way while
+        //  preserving the order.
+        if (gyro_active){
+            sender.flush();
+            issue_report(cancellable, entry.duration, buttons, gyro);
+            continue;
+        }
+
+        sender.push(std::chrono::duration_cast<Milliseconds>(entry.duration), buttons);
+    }
+    sender.flush();
+}
 
 
 
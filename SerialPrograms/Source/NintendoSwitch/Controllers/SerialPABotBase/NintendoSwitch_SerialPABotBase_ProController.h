@@ -55,6 +55,9 @@ public:
     virtual Milliseconds timing_variation() const override{
         return m_timing_variation;
     }
+    virtual WallDuration command_latency() const override{
+        return SerialPABotBase_Controller::command_latency();
+    }
     virtual bool atomic_multibutton() const override{
         return true;
     }
@@ -209,10 +212,24 @@ public:
 
 
 private:
+    //  Returns true if the gyro is active.
+    bool build_report(
+        pabb_NintendoSwitch_OemController_State0x30_Buttons& buttons,
+        pabb_NintendoSwitch_OemController_State0x30_Gyro& gyro,
+        const SuperscalarScheduler::ScheduleEntry& entry
+    );
+
     virtual void execute_state(
         Cancellable* cancellable,
         const SuperscalarScheduler::ScheduleEntry& entry
     ) override;
+
+    //  If the device supports it, pack consecutive button-only states into
+    //  batched commands to reduce the number of round trips.
+    virtual void execute_schedule(
+        Cancellable* cancellable,
+        const SuperscalarScheduler::Schedule& schedule
+    ) override;
 };
 
 
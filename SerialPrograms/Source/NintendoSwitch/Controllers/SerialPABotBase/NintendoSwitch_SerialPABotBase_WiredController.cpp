@@ -86,7 +86,7 @@ void SerialPABotBase_WiredController::execute_state(
 
     SwitchControllerState controller_state;
     for (auto& item : entry.state){
-        static_cast<const SwitchCommand&>(*item).apply(controller_state);
+        apply_switch_command(controller_state, item);
     }
 
     int dpad_x = 0;
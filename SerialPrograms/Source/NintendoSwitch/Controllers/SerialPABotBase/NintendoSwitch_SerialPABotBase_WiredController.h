@@ -61,6 +61,9 @@ public:
     virtual Milliseconds timing_variation() const override{
         return ConsoleSettings::instance().TIMING_OPTIONS.WIRED;
     }
+    virtual WallDuration command_latency() const override{
+        return SerialPABotBase_Controller::command_latency();
+    }
     virtual bool atomic_multibutton() const override{
         return true;
     }
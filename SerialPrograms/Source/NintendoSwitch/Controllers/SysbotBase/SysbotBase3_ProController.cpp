@@ -82,8 +82,8 @@ void ProController_SysbotBase3::replace_on_next_command(){
     m_logger.log("replace_on_next_command(): Command Queue Size = " + std::to_string(queued), COLOR_DARKGREEN);
 }
 void ProController_SysbotBase3::wait_for_all(Cancellable* cancellable){
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = start_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
 
@@ -189,7 +189,7 @@ void ProController_SysbotBase3::execute_state(
 
     SwitchControllerState controller_state;
     for (auto& item : entry.state){
-        static_cast<const SwitchCommand&>(*item).apply(controller_state);
+        apply_switch_command(controller_state, item);
     }
 
 
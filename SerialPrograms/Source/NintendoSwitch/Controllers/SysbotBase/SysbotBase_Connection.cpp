@@ -249,6 +249,8 @@ void TcpSysbotBase_Connection::process_message(const std::string& message, WallC
             return;
         }
 
+        m_round_trip.add_sample(timestamp - iter->second);
+
         std::chrono::microseconds latency = std::chrono::duration_cast<std::chrono::microseconds>(timestamp - iter->second);
         std::string text = "Response Time: " + pretty_print(latency.count()) + " ms";
         if (latency < 10ms){
@@ -14,6 +14,7 @@
 #include <QHostAddress>
 #include <QTcpSocket>
 #include "Common/Cpp/Time.h"
+#include "Common/Cpp/RoundTripTracker.h"
 #include "Common/Cpp/Concurrency/Thread.h"
 #include "Common/Cpp/Sockets/ClientSocket.h"
 #include "Controllers/ControllerConnection.h"
@@ -48,6 +49,11 @@ public:
 
     void write_data(const std::string& data);
 
+    //  Smoothed ping time. Zero if no ping has come back yet.
+    WallDuration round_trip_time() const{
+        return m_round_trip.smoothed();
+    }
+
 private:
     void thread_loop();
 
@@ -70,6 +76,7 @@ private:
 
     uint64_t m_ping_seqnum = 0;
     std::map<uint64_t, WallClock> m_active_pings;
+    RoundTripTracker m_round_trip;
 
     std::deque<char> m_receive_buffer;
 
@@ -77,8 +77,8 @@ void ProController_SysbotBase::replace_on_next_command(){
 
 void ProController_SysbotBase::wait_for_all(Cancellable* cancellable){
 //    cout << "ProController_SysbotBase::wait_for_all - Enter()" << endl;
-    SuperscalarScheduler::Schedule schedule;
     std::lock_guard<std::mutex> lg0(m_issue_lock);
+    SuperscalarScheduler::Schedule& schedule = start_schedule();
     {
         std::lock_guard<std::mutex> lg1(m_state_lock);
         m_logger.log("wait_for_all(): Command Queue Size = " + std::to_string(m_command_queue.size()), COLOR_DARKGREEN);
@@ -108,7 +108,7 @@ void ProController_SysbotBase::execute_state(
 
     SwitchControllerState controller_state;
     for (auto& item : entry.state){
-        static_cast<const SwitchCommand&>(*item).apply(controller_state);
+        apply_switch_command(controller_state, item);
     }
 
     //  Wait until there is space.
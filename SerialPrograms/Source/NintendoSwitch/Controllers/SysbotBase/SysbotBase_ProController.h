@@ -59,6 +59,9 @@ public:
     virtual Milliseconds timing_variation() const override{
         return ConsoleSettings::instance().TIMING_OPTIONS.SYSBOTBASE;
     }
+    virtual WallDuration command_latency() const override{
+        return m_connection.round_trip_time() / 2;
+    }
     virtual bool atomic_multibutton() const override{
         return false;
     }
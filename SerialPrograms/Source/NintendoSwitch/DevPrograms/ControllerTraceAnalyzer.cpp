@@ -0,0 +1,75 @@
+/*  Controller Trace Analyzer
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <QDir>
+#include "Common/Cpp/PrettyPrint.h"
+#include "CommonFramework/Tools/ProgramEnvironment.h"
+#include "Controllers/ControllerTrace.h"
+#include "Controllers/ControllerTraceAnalysis.h"
+#include "ControllerTraceAnalyzer.h"
+
+namespace PokemonAutomation{
+
+
+ControllerTraceAnalyzer_Descriptor::ControllerTraceAnalyzer_Descriptor()
+    : ComputerProgramDescriptor(
+        "Computer:ControllerTraceAnalyzer",
+        "Computer", "Controller Trace Analyzer",
+        "",
+        "Report controller queue depth, device idle gaps and issue-to-ack latencies from a controller trace."
+    )
+{}
+
+
+
+ControllerTraceAnalyzer::ControllerTraceAnalyzer()
+    : TRACE_FILE(
+        false,
+        "<b>Trace File:</b><br>"
+        "A \"ControllerTrace.bin\" from an error report. "
+        "Leave empty to save and analyze the live trace of this session.",
+        LockMode::LOCK_WHILE_RUNNING,
+        "",
+        "ErrorReportsLocal/.../ControllerTrace.bin"
+    )
+    , IDLE_THRESHOLD(
+        "<b>Idle Threshold (ms):</b><br>Report device idle gaps at least this long.",
+        LockMode::LOCK_WHILE_RUNNING,
+        50
+    )
+{
+    PA_ADD_OPTION(TRACE_FILE);
+    PA_ADD_OPTION(IDLE_THRESHOLD);
+}
+
+
+
+void ControllerTraceAnalyzer::program(ProgramEnvironment& env, CancellableScope& scope){
+    std::string path = TRACE_FILE;
+    ControllerTraceSnapshot trace;
+    if (path.empty()){
+        QDir().mkpath("ControllerTraces");
+        path = "ControllerTraces/" + now_to_filestring() + ".bin";
+        trace = global_controller_trace().snapshot();
+        trace.save(path);
+        env.log("Saved live controller trace to: " + path);
+    }else{
+        trace = ControllerTraceSnapshot::load(path);
+    }
+
+    ControllerTraceAnalysis analysis(trace, (uint64_t)IDLE_THRESHOLD * 1000000);
+    env.log(analysis.to_str());
+
+    std::string csv = path.ends_with(".bin") ? path.substr(0, path.size() - 4) : path;
+    csv += "-QueueDepth.csv";
+    analysis.save_queue_depth_csv(csv);
+    env.log("Saved queue depth over time to: " + csv);
+}
+
+
+
+
+}
@@ -0,0 +1,39 @@
+/*  Controller Trace Analyzer
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Computer_ControllerTraceAnalyzer_H
+#define PokemonAutomation_Computer_ControllerTraceAnalyzer_H
+
+#include "Common/Cpp/Options/SimpleIntegerOption.h"
+#include "Common/Cpp/Options/StringOption.h"
+#include "ComputerPrograms/ComputerProgram.h"
+
+namespace PokemonAutomation{
+
+
+class ControllerTraceAnalyzer_Descriptor : public ComputerProgramDescriptor{
+public:
+    ControllerTraceAnalyzer_Descriptor();
+};
+
+
+
+class ControllerTraceAnalyzer : public ComputerProgramInstance{
+public:
+    ControllerTraceAnalyzer();
+
+    virtual void program(ProgramEnvironment& env, CancellableScope& scope) override;
+
+private:
+    StringOption TRACE_FILE;
+    SimpleIntegerOption<uint32_t> IDLE_THRESHOLD;
+};
+
+
+
+
+}
+#endif
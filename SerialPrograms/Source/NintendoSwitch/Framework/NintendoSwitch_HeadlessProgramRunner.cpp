@@ -0,0 +1,123 @@
+/*  Headless Program Runner
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <functional>
+#include <QCoreApplication>
+#include <QTimer>
+#include "Common/Cpp/Time.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/Panels/PanelInstance.h"
+#include "PanelLists.h"
+#include "NintendoSwitch_SingleSwitchProgramOption.h"
+#include "NintendoSwitch_SingleSwitchProgramSession.h"
+#include "NintendoSwitch_MultiSwitchProgramOption.h"
+#include "NintendoSwitch_MultiSwitchProgramSession.h"
+#include "NintendoSwitch_HeadlessProgramRunner.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+
+
+//  How long to wait for the controllers to connect before giving up.
+const std::chrono::seconds HEADLESS_CONNECT_TIMEOUT(60);
+
+
+std::unique_ptr<PanelDescriptor> find_program_descriptor(const std::string& identifier){
+    for (const std::unique_ptr<PanelListDescriptor>& list : make_all_panel_lists()){
+        if (!list->enabled()){
+            continue;
+        }
+        for (PanelEntry& entry : list->make_panels()){
+            if (entry.descriptor && entry.descriptor->identifier() == identifier){
+                return std::move(entry.descriptor);
+            }
+        }
+    }
+    return nullptr;
+}
+
+
+//  Start the program once "ready()" returns true, then run the event loop
+//  until the program stops.
+int run_session(Logger& logger, ProgramSession& session, std::function<bool()> ready){
+    WallClock deadline = current_time() + HEADLESS_CONNECT_TIMEOUT;
+    bool started = false;
+
+    QTimer timer;
+    QObject::connect(&timer, &QTimer::timeout, [&]{
+        if (started){
+            if (session.current_state() == ProgramState::STOPPED){
+                logger.log("Headless: Program has stopped.");
+                QCoreApplication::exit(0);
+            }
+            return;
+        }
+        if (!ready()){
+            if (current_time() > deadline){
+                logger.log("Headless: Timed out waiting for the controllers to connect.", COLOR_RED);
+                QCoreApplication::exit(1);
+            }
+            return;
+        }
+        std::string error = session.start_program();
+        if (!error.empty()){
+            logger.log("Headless: Unable to start program: " + error, COLOR_RED);
+            QCoreApplication::exit(1);
+            return;
+        }
+        started = true;
+    });
+    timer.start(1000);
+
+    int ret = QCoreApplication::exec();
+
+    session.stop_program();
+    return ret;
+}
+
+
+int run_headless_program(Logger& logger, const std::string& identifier){
+    logger.log("Headless: Looking up program: " + identifier);
+
+    std::unique_ptr<PanelDescriptor> descriptor = find_program_descriptor(identifier);
+    if (!descriptor){
+        logger.log("Headless: No such program: " + identifier, COLOR_RED);
+        return 1;
+    }
+
+    std::unique_ptr<PanelInstance> panel = descriptor->make_panel();
+    panel->from_json();
+
+    if (auto* option = dynamic_cast<SingleSwitchProgramOption*>(panel.get())){
+        SingleSwitchProgramSession session(*option, 0);
+        return run_session(logger, session, [&]{
+            return session.system().controller_session().ready();
+        });
+    }
+    if (auto* option = dynamic_cast<MultiSwitchProgramOption*>(panel.get())){
+        MultiSwitchProgramSession session(*option);
+        return run_session(logger, session, [&]{
+            MultiSwitchSystemSession& system = session.system();
+            for (size_t c = 0; c < system.count(); c++){
+                if (!system[c].controller_session().ready()){
+                    return false;
+                }
+            }
+            return true;
+        });
+    }
+
+    logger.log("Headless: " + identifier + " is not a Switch program.", COLOR_RED);
+    return 1;
+}
+
+
+}
+}
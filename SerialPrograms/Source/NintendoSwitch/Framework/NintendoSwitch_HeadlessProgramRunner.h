@@ -0,0 +1,32 @@
+/*  Headless Program Runner
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Run a single program without the main window. The program and its consoles
+ *  use whatever settings were last saved for it from the UI.
+ *
+ *  This is meant for unattended hosts where nobody is watching the video.
+ *  Video frames still go through the inference pipeline, but nothing renders
+ *  them.
+ *
+ */
+
+#ifndef PokemonAutomation_NintendoSwitch_HeadlessProgramRunner_H
+#define PokemonAutomation_NintendoSwitch_HeadlessProgramRunner_H
+
+#include <string>
+
+namespace PokemonAutomation{
+    class Logger;
+namespace NintendoSwitch{
+
+
+//  Find the program with this identifier, start it as soon as its controllers
+//  are ready, and return when it stops. Must be called on the main thread
+//  with a QApplication already constructed. Returns the process exit code.
+int run_headless_program(Logger& logger, const std::string& identifier);
+
+
+}
+}
+#endif
@@ -8,6 +8,7 @@
 #include "CommonFramework/VideoPipeline/Stats/MemoryUtilizationStats.h"
 #include "CommonFramework/VideoPipeline/Stats/CpuUtilizationStats.h"
 #include "CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.h"
+#include "CommonFramework/VideoPipeline/Stats/FrameLatencyStats.h"
 #include "Integrations/ProgramTracker.h"
 #include "NintendoSwitch_SwitchSystemOption.h"
 #include "NintendoSwitch_SwitchSystemSession.h"
@@ -30,6 +31,7 @@ bool SwitchSystemSession::try_shutdown(){
     m_audio.remove_state_listener(m_history);
 
     ProgramTracker::instance().remove_console(m_console_id);
+    m_overlay.remove_stat(*m_frame_latency);
     m_overlay.remove_stat(*m_main_thread_utilization);
     m_overlay.remove_stat(*m_cpu_utilization);
     m_overlay.remove_stat(m_memory_usage->m_process);
@@ -62,12 +64,14 @@ SwitchSystemSession::SwitchSystemSession(
     , m_memory_usage(new MemoryUtilizationStats())
     , m_cpu_utilization(new CpuUtilizationStat())
     , m_main_thread_utilization(new ThreadUtilizationStat(current_thread_handle(), "Main Qt Thread:"))
+    , m_frame_latency(new FrameLatencyStat(m_video.frame_latency()))
 {
     m_console_id = ProgramTracker::instance().add_console(program_id, *this);
     m_overlay.add_stat(m_memory_usage->m_system);
     m_overlay.add_stat(m_memory_usage->m_process);
     m_overlay.add_stat(*m_cpu_utilization);
     m_overlay.add_stat(*m_main_thread_utilization);
+    m_overlay.add_stat(*m_frame_latency);
 
     m_history.start(m_audio.input_format(), m_video.current_source() != nullptr);
 
@@ -33,6 +33,7 @@ namespace PokemonAutomation{
     class MemoryUtilizationStats;
     class CpuUtilizationStat;
     class ThreadUtilizationStat;
+    class FrameLatencyStat;
 namespace NintendoSwitch{
 
 class SwitchSystemOption;
@@ -95,6 +96,7 @@ private:
     std::unique_ptr<MemoryUtilizationStats> m_memory_usage;
     std::unique_ptr<CpuUtilizationStat> m_cpu_utilization;
     std::unique_ptr<ThreadUtilizationStat> m_main_thread_utilization;
+    std::unique_ptr<FrameLatencyStat> m_frame_latency;
 };
 
 
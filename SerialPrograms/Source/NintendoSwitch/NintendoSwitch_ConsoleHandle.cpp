@@ -64,6 +64,29 @@ ConsoleHandle::ConsoleHandle(
     overlay.add_stat(*m_thread_utilization);
 }
 
+void ConsoleHandle::set_thread_pool_owner(size_t owner){
+    overlay().remove_stat(*m_thread_utilization);
+    overlay().remove_stat(*m_normal_inference_utilization);
+    overlay().remove_stat(*m_realtime_inference_utilization);
+    m_realtime_inference_utilization.reset(
+        new ThreadPoolUtilizationStat(
+            GlobalThreadPools::realtime_inference(),
+            "Real-Time Pool",
+            owner
+        )
+    );
+    m_normal_inference_utilization.reset(
+        new ThreadPoolUtilizationStat(
+            GlobalThreadPools::normal_inference(),
+            "Normal Pool",
+            owner
+        )
+    );
+    overlay().add_stat(*m_realtime_inference_utilization);
+    overlay().add_stat(*m_normal_inference_utilization);
+    overlay().add_stat(*m_thread_utilization);
+}
+
 
 
 
@@ -41,6 +41,10 @@ public:
 
     size_t index() const{ return m_index; }
 
+    //  Show only this owner's share of the global thread pools in the
+    //  overlay stats. (see ThreadPoolOwnerScope)
+    void set_thread_pool_owner(size_t owner);
+
     template <typename ControllerType = AbstractController>
     ControllerType& controller(){
         return m_controller.cast_with_exception<ControllerType>();
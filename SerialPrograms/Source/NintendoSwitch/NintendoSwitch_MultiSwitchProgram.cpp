@@ -29,9 +29,12 @@ MultiSwitchProgramEnvironment::MultiSwitchProgramEnvironment(
 )
     : ProgramEnvironment(program_info, session, current_stats, historical_stats)
     , consoles(std::move(p_switches))
+    , m_thread_pool_partition(logger(), consoles.size())
 {
-    for (ConsoleHandle& console : consoles){
-        console.initialize_inference_threads(scope, realtime_inference_dispatcher());
+    for (size_t c = 0; c < consoles.size(); c++){
+        size_t owner = m_thread_pool_partition.owner(c);
+        consoles[c].set_thread_pool_owner(owner);
+        consoles[c].initialize_inference_threads(scope, realtime_inference_dispatcher(), owner);
     }
 }
 
@@ -55,6 +58,7 @@ void MultiSwitchProgramEnvironment::run_in_parallel(
         s, e,
         [&](size_t index){
             ConsoleHandle& console = consoles[index];
+            ThreadPoolOwnerScope owner(m_thread_pool_partition.owner(index));
             ThreadUtilizationStat stat(current_thread_handle(), "Program Thread " + std::to_string(index) + ":");
             console.overlay().add_stat(stat);
             try{
@@ -76,6 +80,7 @@ void MultiSwitchProgramEnvironment::run_in_parallel(
         s, e,
         [&](size_t index){
             ConsoleHandle& console = consoles[index];
+            ThreadPoolOwnerScope owner(m_thread_pool_partition.owner(index));
             ThreadUtilizationStat stat(current_thread_handle(), "Program Thread " + std::to_string(index) + ":");
             console.overlay().add_stat(stat);
             try{
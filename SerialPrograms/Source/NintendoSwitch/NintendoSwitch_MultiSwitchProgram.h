@@ -14,7 +14,9 @@
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/Notifications/EventNotificationOption.h"
 #include "CommonFramework/Tools/ProgramEnvironment.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "CommonFramework/Panels/ProgramDescriptor.h"
+#include "Controllers/SynchronizedActionBarrier.h"
 #include "NintendoSwitch/Controllers/Procon/NintendoSwitch_ProController.h"
 #include "NintendoSwitch/NintendoSwitch_ConsoleHandle.h"
 
@@ -41,6 +43,8 @@ public:
     FixedLimitVector<ConsoleHandle> consoles;
 
     //  Run the specified lambda for all switches in parallel.
+    //  To make the switches do something at the same time, use a
+    //  SynchronizedActionBarrier inside the lambda.
     void run_in_parallel(
         CancellableScope& scope,
         const std::function<void(CancellableScope& scope, ConsoleHandle& console)>& func
@@ -64,6 +68,10 @@ public:
     void add_overlay_log_to_all_consoles(const std::string& message, Color color = COLOR_WHITE);
     // clear video overlay log on all console video streams
     void clear_all_overlay_logs();
+
+private:
+    //  Each console gets its own share of the global thread pools.
+    GlobalThreadPools::ConsolePartition m_thread_pool_partition;
 };
 
 
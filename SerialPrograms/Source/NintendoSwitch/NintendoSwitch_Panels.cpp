@@ -22,6 +22,7 @@
 #include "Programs/NintendoSwitch_RecordKeyboardController.h"
 
 #include "DevPrograms/BoxDraw.h"
+#include "DevPrograms/ControllerTraceAnalyzer.h"
 #include "Programs/NintendoSwitch_SnapshotDumper.h"
 #include "Programs/NintendoSwitch_MenuStabilityTester.h"
 #include "DevPrograms/TestProgramComputer.h"
@@ -30,6 +31,7 @@
 #include "DevPrograms/TestDudunsparceFormDetector.h"
 #include "Pokemon/Inference/Pokemon_TrainIVCheckerOCR.h"
 #include "Pokemon/Inference/Pokemon_TrainPokemonOCR.h"
+#include "Pokemon/Inference/Pokemon_TrainGlyphOCR.h"
 
 #ifdef PA_OFFICIAL
 #include "../../Internal/SerialPrograms/NintendoSwitch_TestPrograms.h"
@@ -72,10 +74,12 @@ std::vector<PanelEntry> PanelListFactory::make_panels() const{
         ret.emplace_back(make_single_switch_program<SnapshotDumper_Descriptor, SnapshotDumper>());
         ret.emplace_back(make_single_switch_program<MenuStabilityTester_Descriptor, MenuStabilityTester>());
         ret.emplace_back(make_computer_program<TestProgramComputer_Descriptor, TestProgramComputer>());
+        ret.emplace_back(make_computer_program<ControllerTraceAnalyzer_Descriptor, ControllerTraceAnalyzer>());
         ret.emplace_back(make_multi_switch_program<TestProgram_Descriptor, TestProgram>());
         ret.emplace_back(make_single_switch_program<JoyconProgram_Descriptor, JoyconProgram>());
         ret.emplace_back(make_computer_program<Pokemon::TrainIVCheckerOCR_Descriptor, Pokemon::TrainIVCheckerOCR>());
         ret.emplace_back(make_computer_program<Pokemon::TrainPokemonOCR_Descriptor, Pokemon::TrainPokemonOCR>());
+        ret.emplace_back(make_computer_program<Pokemon::TrainGlyphOCR_Descriptor, Pokemon::TrainGlyphOCR>());
         ret.emplace_back(make_single_switch_program<TestDudunsparceFormDetector_Descriptor, TestDudunsparceFormDetector>());
 #ifdef PA_OFFICIAL
         add_panels(ret);
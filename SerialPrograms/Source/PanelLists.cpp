@@ -34,6 +34,33 @@ namespace PokemonAutomation{
 
 
 
+std::vector<std::unique_ptr<PanelListDescriptor>> make_all_panel_lists(){
+    std::vector<std::unique_ptr<PanelListDescriptor>> ret;
+
+    ret.emplace_back(std::make_unique<NintendoSwitch::PanelListFactory>());
+    ret.emplace_back(std::make_unique<NintendoSwitch::PokemonHome::PanelListFactory>());
+    ret.emplace_back(std::make_unique<NintendoSwitch::PokemonLGPE::PanelListFactory>());
+    ret.emplace_back(std::make_unique<NintendoSwitch::PokemonSwSh::PanelListFactory>());
+    ret.emplace_back(std::make_unique<NintendoSwitch::PokemonBDSP::PanelListFactory>());
+    ret.emplace_back(std::make_unique<NintendoSwitch::PokemonLA::PanelListFactory>());
+    ret.emplace_back(std::make_unique<NintendoSwitch::PokemonSV::PanelListFactory>());
+
+    ret.emplace_back(std::make_unique<NintendoSwitch::PokemonLZA::PanelListFactory>());
+    if (PreloadSettings::instance().DEVELOPER_MODE){
+        ret.emplace_back(std::make_unique<NintendoSwitch::PokemonRSE::PanelListFactory>());
+    }
+
+    ret.emplace_back(std::make_unique<NintendoSwitch::ZeldaTotK::PanelListFactory>());
+
+    if (PreloadSettings::instance().DEVELOPER_MODE){
+        ret.emplace_back(std::make_unique<ML::PanelListFactory>());
+    }
+
+    return ret;
+}
+
+
+
 ProgramSelect::ProgramSelect(QWidget& parent, PanelHolder& holder)
     : QGroupBox("Program Select", &parent)
     , m_holder(holder)
@@ -45,23 +72,8 @@ ProgramSelect::ProgramSelect(QWidget& parent, PanelHolder& holder)
     layout->addWidget(m_dropdown);
 
 
-    add(std::make_unique<NintendoSwitch::PanelListFactory>());
-    add(std::make_unique<NintendoSwitch::PokemonHome::PanelListFactory>());
-    add(std::make_unique<NintendoSwitch::PokemonLGPE::PanelListFactory>());
-    add(std::make_unique<NintendoSwitch::PokemonSwSh::PanelListFactory>());
-    add(std::make_unique<NintendoSwitch::PokemonBDSP::PanelListFactory>());
-    add(std::make_unique<NintendoSwitch::PokemonLA::PanelListFactory>());
-    add(std::make_unique<NintendoSwitch::PokemonSV::PanelListFactory>());
-
-    add(std::make_unique<NintendoSwitch::PokemonLZA::PanelListFactory>());
-    if (PreloadSettings::instance().DEVELOPER_MODE){
-        add(std::make_unique<NintendoSwitch::PokemonRSE::PanelListFactory>());
-    }
-
-    add(std::make_unique<NintendoSwitch::ZeldaTotK::PanelListFactory>());
-
-    if (PreloadSettings::instance().DEVELOPER_MODE){
-        add(std::make_unique<ML::PanelListFactory>());
+    for (std::unique_ptr<PanelListDescriptor>& list : make_all_panel_lists()){
+        add(std::move(list));
     }
 
 
@@ -15,6 +15,10 @@ class QComboBox;
 namespace PokemonAutomation{
 
 
+// All the program lists in the order they appear in the dropdown.
+std::vector<std::unique_ptr<PanelListDescriptor>> make_all_panel_lists();
+
+
 // The program selection UI on the left side of the program window.
 // It has a dropdown menu to select which Switch game's program list to show, and
 // a display list window to show the current active game's program list.
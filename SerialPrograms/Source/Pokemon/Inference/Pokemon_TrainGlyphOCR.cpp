@@ -0,0 +1,59 @@
+/*  Train Glyph OCR Data
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "CommonFramework/Tools/ProgramEnvironment.h"
+#include "CommonTools/OCR/OCR_TrainingTools.h"
+#include "Pokemon/Pokemon_Strings.h"
+#include "Pokemon_TrainGlyphOCR.h"
+
+namespace PokemonAutomation{
+namespace Pokemon{
+
+
+TrainGlyphOCR_Descriptor::TrainGlyphOCR_Descriptor()
+    : ComputerProgramDescriptor(
+        "PokemonSwSh:TrainGlyphOCR",
+        STRING_POKEMON, "Train Glyph OCR",
+        "",
+        "Train the glyph templates used to read digits and codes without OCR. "
+        "Each sample is a black-on-white image of one character named after that character."
+    )
+{}
+
+
+
+TrainGlyphOCR::TrainGlyphOCR()
+    : DIRECTORY(
+        false,
+        "<b>Training Data Directory:</b> (Relative to \"TrainingData/\")",
+        LockMode::LOCK_WHILE_RUNNING,
+        "GlyphOCR/",
+        "GlyphOCR/"
+    )
+    , OUTPUT(
+        false,
+        "<b>Output File:</b><br>"
+        "Copy this to \"CommonTools/NumberGlyphs.json\" or \"PokemonSV/TeraCode/TeraCodeGlyphs.json\" in the resources.",
+        LockMode::LOCK_WHILE_RUNNING,
+        "NumberGlyphs.json",
+        "NumberGlyphs.json"
+    )
+{
+    PA_ADD_OPTION(DIRECTORY);
+    PA_ADD_OPTION(OUTPUT);
+}
+
+
+
+void TrainGlyphOCR::program(ProgramEnvironment& env, CancellableScope& scope){
+    OCR::TrainingSession session(env.logger(), scope, DIRECTORY);
+    session.generate_glyph_templates(OUTPUT, OCR::BLACK_TEXT_FILTERS());
+}
+
+
+
+}
+}
@@ -0,0 +1,40 @@
+/*  Train Glyph OCR Data
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Pokemon_TrainGlyphOCR_H
+#define PokemonAutomation_Pokemon_TrainGlyphOCR_H
+
+#include "Common/Cpp/Options/StringOption.h"
+#include "ComputerPrograms/ComputerProgram.h"
+
+namespace PokemonAutomation{
+namespace Pokemon{
+
+
+class TrainGlyphOCR_Descriptor : public ComputerProgramDescriptor{
+public:
+    TrainGlyphOCR_Descriptor();
+};
+
+
+
+class TrainGlyphOCR : public ComputerProgramInstance{
+public:
+    TrainGlyphOCR();
+
+    virtual void program(ProgramEnvironment& env, CancellableScope& scope) override;
+
+private:
+    StringOption DIRECTORY;
+    StringOption OUTPUT;
+
+};
+
+
+
+}
+}
+#endif
@@ -401,6 +401,10 @@ const MMOSpriteMatchingMap& MMO_SPRITE_MATCHING_DATA(){
     return sprite_matching_data;
 }
 
+void preload_MMO_sprite_matching_data(){
+    MMO_SPRITE_MATCHING_DATA();
+}
+
 
 std::multimap<double, std::string> match_pokemon_map_sprite_feature(const ImageViewRGB32& image, MapRegion region){
     const FeatureVector& image_feature = compute_feature(image);
@@ -55,6 +55,9 @@ MapSpriteMatchResult match_sprite_on_map(
     bool debug_mode = false
 );
 
+//  Build the sprite data used by match_sprite_on_map() if it isn't built yet.
+void preload_MMO_sprite_matching_data();
+
 
 }
 }
@@ -21,6 +21,7 @@
 #include "Pokemon/Inference/Pokemon_NameReader.h"
 #include "PokemonLA/Inference/Map/PokemonLA_SelectedRegionDetector.h"
 #include "PokemonLA/Inference/Map/PokemonLA_OutbreakReader.h"
+#include "PokemonLA/Inference/Map/PokemonLA_PokemonMapSpriteReader.h"
 #include "PokemonLA/PokemonLA_Settings.h"
 #include "PokemonLA/Programs/PokemonLA_GameEntry.h"
 #include "PokemonLA/Programs/PokemonLA_GameSave.h"
@@ -139,6 +140,12 @@ public:
 std::unique_ptr<StatsTracker> OutbreakFinder_Descriptor::make_stats() const{
     return std::unique_ptr<StatsTracker>(new Stats());
 }
+std::vector<WarmupResource> OutbreakFinder_Descriptor::warmup_resources() const{
+    return {
+        {"PokemonLA: MMO Sprites", ALL_MMO_SPRITES},
+        {"PokemonLA: MMO Sprite Matching Data", preload_MMO_sprite_matching_data},
+    };
+}
 
 
 
@@ -24,6 +24,7 @@ public:
 
     class Stats;
     virtual std::unique_ptr<StatsTracker> make_stats() const override;
+    virtual std::vector<WarmupResource> warmup_resources() const override;
 };
 
 
@@ -37,6 +37,9 @@ public:
     //  Otherwise, returns false and "box" is undefined.
     bool detect(ImageFloatBox& box, const ImageViewRGB32& screen) const;
 
+    //  The region that is searched for the arrow.
+    const ImageFloatBox& box() const{ return m_box; }
+
 protected:
     Color m_color;
     GradientArrowType m_type;
@@ -53,7 +56,9 @@ public:
         std::chrono::milliseconds hold_duration = std::chrono::milliseconds(250)
     )
         : DetectorToFinder("GradientArrowWatcher", hold_duration, color, type, box)
-    {}
+    {
+        skip_unchanged_frames({box});
+    }
 };
 
 
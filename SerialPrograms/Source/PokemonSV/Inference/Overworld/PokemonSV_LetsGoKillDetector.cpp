@@ -8,7 +8,6 @@
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
-#include "CommonTools/Images/BinaryImage_FilterRgb32.h"
 #include "CommonTools/ImageMatch/ExactImageMatcher.h"
 #include "CommonTools/Audio/SpectrogramMatcher.h"
 #include "CommonTools/Audio/AudioTemplateCache.h"
@@ -83,13 +82,46 @@ bool is_kill_icon(
 
 
 
+static const std::vector<std::pair<uint32_t, uint32_t>>& LETS_GO_KILL_RED_FILTERS(){
+    static const std::vector<std::pair<uint32_t, uint32_t>> filters{
+        {0xff801e1e, 0xffff5f5f},
+        {0xff901e1e, 0xffff5f5f},
+        {0xffa01e1e, 0xffff5f5f},
+        {0xffb01e1e, 0xffff5f5f},
+        {0xffc01e1e, 0xffff5f5f},
+        {0xffd01e1e, 0xffff5f5f},
+        {0xff801e1e, 0xffff7f7f},
+        {0xff901e1e, 0xffff7f7f},
+        {0xffa01e1e, 0xffff7f7f},
+        {0xffb01e1e, 0xffff7f7f},
+        {0xffc01e1e, 0xffff7f7f},
+        {0xffd01e1e, 0xffff7f7f},
+    };
+    return filters;
+}
+static const std::vector<std::pair<uint32_t, uint32_t>>& LETS_GO_KILL_WHITE_FILTERS(){
+    static const std::vector<std::pair<uint32_t, uint32_t>> filters{
+        {0xffb0b0b0, 0xffffffff},
+        {0xffc0c0c0, 0xffffffff},
+        {0xffd0d0d0, 0xffffffff},
+        {0xffe0e0e0, 0xffffffff},
+    };
+    return filters;
+}
+
+
+
 LetsGoKillDetector::LetsGoKillDetector(
     Color color,
     const ImageFloatBox& box
 )
     : m_color(color)
     , m_box(box)
-{}
+{
+    std::vector<std::pair<uint32_t, uint32_t>> filters = LETS_GO_KILL_RED_FILTERS();
+    filters.insert(filters.end(), LETS_GO_KILL_WHITE_FILTERS().begin(), LETS_GO_KILL_WHITE_FILTERS().end());
+    m_filters.add(m_box, std::move(filters));
+}
 void LetsGoKillDetector::make_overlays(VideoOverlaySet& items) const{
     items.add(m_color, m_box);
 }
@@ -98,31 +130,18 @@ bool LetsGoKillDetector::detect(const ImageViewRGB32& screen){
 
     size_t size_threshold = (size_t)(10. * screen.total_pixels() / 2073600);
 
-    ImageViewRGB32 region = extract_box_reference(screen, m_box);
+    m_filters.run(screen);
+    const ImageViewRGB32& region = m_filters.region(0);
+    const size_t red_filters = LETS_GO_KILL_RED_FILTERS().size();
+    const size_t white_filters = LETS_GO_KILL_WHITE_FILTERS().size();
+
     std::vector<WaterfillObject> reds;
     std::vector<WaterfillObject> whites;
     std::unique_ptr<WaterfillSession> session = make_WaterfillSession();
     {
-        std::vector<PackedBinaryMatrix> matrices = compress_rgb32_to_binary_range(
-            region,
-            {
-                {0xff801e1e, 0xffff5f5f},
-                {0xff901e1e, 0xffff5f5f},
-                {0xffa01e1e, 0xffff5f5f},
-                {0xffb01e1e, 0xffff5f5f},
-                {0xffc01e1e, 0xffff5f5f},
-                {0xffd01e1e, 0xffff5f5f},
-                {0xff801e1e, 0xffff7f7f},
-                {0xff901e1e, 0xffff7f7f},
-                {0xffa01e1e, 0xffff7f7f},
-                {0xffb01e1e, 0xffff7f7f},
-                {0xffc01e1e, 0xffff7f7f},
-                {0xffd01e1e, 0xffff7f7f},
-            }
-        );
 //        size_t c = 0;
-        for (PackedBinaryMatrix& matrix : matrices){
-            session->set_source(matrix);
+        for (size_t f = 0; f < red_filters; f++){
+            session->set_source(m_filters.mask(0, f));
             auto iter = session->make_iterator(size_threshold);
             WaterfillObject object;
             while (iter->find_next(object, false)){
@@ -137,18 +156,9 @@ bool LetsGoKillDetector::detect(const ImageViewRGB32& screen){
         }
     }
     {
-        std::vector<PackedBinaryMatrix> matrices = compress_rgb32_to_binary_range(
-            region,
-            {
-                {0xffb0b0b0, 0xffffffff},
-                {0xffc0c0c0, 0xffffffff},
-                {0xffd0d0d0, 0xffffffff},
-                {0xffe0e0e0, 0xffffffff},
-            }
-        );
 //        size_t c = 0;
-        for (PackedBinaryMatrix& matrix : matrices){
-            session->set_source(matrix);
+        for (size_t f = 0; f < white_filters; f++){
+            session->set_source(m_filters.mask(0, red_filters + f));
             auto iter = session->make_iterator(size_threshold);
             WaterfillObject object;
             while (iter->find_next(object, false)){
@@ -11,6 +11,7 @@
 #include <atomic>
 #include "Common/Cpp/Color.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonTools/Images/BinaryImage_FilterBatch.h"
 #include "CommonTools/Audio/AudioPerSpectrumDetectorBase.h"
 #include "CommonTools/VisualDetector.h"
 
@@ -31,6 +32,9 @@ public:
 private:
     Color m_color;
     ImageFloatBox m_box;
+
+    //  The red filters followed by the white filters. All in one pass.
+    BinaryFilterBatch m_filters;
 };
 class LetsGoKillWatcher : public DetectorToFinder<LetsGoKillDetector>{
 public:
@@ -64,7 +64,9 @@ class MainMenuWatcher : public DetectorToFinder<MainMenuDetector>{
 public:
     MainMenuWatcher(Color color = COLOR_RED)
          : DetectorToFinder("MainMenuWatcher", std::chrono::milliseconds(250), color)
-    {}
+    {
+        skip_unchanged_frames({m_bottom, m_arrow_left.box(), m_arrow_right.box(), m_dlc_icon.box()});
+    }
 };
 
 
@@ -16,6 +16,7 @@
 #include "CommonTools/Images/BinaryImage_FilterRgb32.h"
 #include "CommonTools/ImageMatch/ExactImageMatcher.h"
 #include "CommonTools/OCR/OCR_RawOCR.h"
+#include "CommonTools/OCR/OCR_GlyphClassifier.h"
 #include "PokemonSV_TeraCodeReader.h"
 
 //#define PA_ENABLE_CODE_DEBUG
@@ -37,6 +38,7 @@ class CharacterTemplates{
         , ENG_S(RESOURCE_PATH() + "PokemonSV/TeraCode/TeraCode-S-eng.png")
         , CHI_5(RESOURCE_PATH() + "PokemonSV/TeraCode/TeraCode-5-chi.png")
         , CHI_S(RESOURCE_PATH() + "PokemonSV/TeraCode/TeraCode-S-chi.png")
+        , GLYPHS("PokemonSV/TeraCode/TeraCodeGlyphs.json")
     {}
 
 public:
@@ -49,6 +51,9 @@ public:
     ImageMatch::ExactImageMatcher ENG_S;
     ImageMatch::ExactImageMatcher CHI_5;
     ImageMatch::ExactImageMatcher CHI_S;
+
+    //  Empty if there are no trained templates.
+    OCR::GlyphClassifier GLYPHS;
 };
 
 void preload_code_templates(){
@@ -172,8 +177,21 @@ std::vector<WaterfillOCRResult> waterfill_OCR(
         ret.emplace_back(WaterfillOCRResult{std::move(item.second), ""});
     }
 
+    //  Only characters that don't match a template need OCR.
+    const OCR::GlyphClassifier& glyphs = CharacterTemplates::instance().GLYPHS;
+    std::vector<size_t> unclassified;
+    for (size_t c = 0; c < ret.size(); c++){
+        char glyph = glyphs.classify(ret[c].object.packed_matrix());
+        if (glyph != 0){
+            ret[c].ocr = glyph;
+        }else{
+            unclassified.emplace_back(c);
+        }
+    }
+
     GlobalThreadPools::realtime_inference().run_in_parallel(
-        [&](size_t index){
+        [&](size_t c){
+            size_t index = unclassified[c];
             WaterfillObject& object = ret[index].object;
             ImageRGB32 cropped = extract_box_reference(filtered, object).copy();
             PackedBinaryMatrix tmp(object.packed_matrix());
@@ -181,7 +199,7 @@ std::vector<WaterfillOCRResult> waterfill_OCR(
             ImageRGB32 padded = pad_image(cropped, cropped.width(), 0xffffffff);
             ret[index].ocr = OCR::ocr_read(Language::English, padded);
         },
-        0, ret.size()
+        0, unclassified.size()
     );
 
 #ifdef PA_ENABLE_CODE_DEBUG
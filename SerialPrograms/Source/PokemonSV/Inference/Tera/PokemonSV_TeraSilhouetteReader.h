@@ -20,6 +20,9 @@ namespace PokemonSV{
 
 
 
+const ImageMatch::SilhouetteDictionaryMatcher& TERA_RAID_SILHOUETTE_MATCHER();
+
+
 class TeraSilhouetteReader{
 public:
     TeraSilhouetteReader(Color color = COLOR_GREEN);
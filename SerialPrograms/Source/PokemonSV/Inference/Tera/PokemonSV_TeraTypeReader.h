@@ -20,6 +20,9 @@ namespace PokemonSV{
 
 
 
+const ImageMatch::SilhouetteDictionaryMatcher& TERA_RAID_TYPE_MATCHER();
+
+
 class TeraTypeReader{
 public:
     TeraTypeReader(Color color = COLOR_BLUE);
@@ -87,6 +87,11 @@ struct ItemPrinterRNG_Descriptor::Stats : public StatsTracker{
 std::unique_ptr<StatsTracker> ItemPrinterRNG_Descriptor::make_stats() const{
     return std::unique_ptr<StatsTracker>(new Stats());
 }
+std::vector<WarmupResource> ItemPrinterRNG_Descriptor::warmup_resources() const{
+    return {
+        {"PokemonSV: Item Printer Material Names", MaterialNameReader::instance},
+    };
+}
 
 ItemPrinterRNG::~ItemPrinterRNG(){
     MATERIAL_FARMER_OPTIONS.remove_listener(*this);
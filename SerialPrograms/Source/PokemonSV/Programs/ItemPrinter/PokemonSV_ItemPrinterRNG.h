@@ -27,6 +27,7 @@ public:
     ItemPrinterRNG_Descriptor();
     struct Stats;
     virtual std::unique_ptr<StatsTracker> make_stats() const override;
+    virtual std::vector<WarmupResource> warmup_resources() const override;
 };
 
 class ItemPrinterRNG : public SingleSwitchProgramInstance, public ConfigOption::Listener{
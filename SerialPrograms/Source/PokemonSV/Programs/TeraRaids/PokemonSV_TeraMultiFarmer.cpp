@@ -148,6 +148,12 @@ struct TeraMultiFarmer_Descriptor::Stats : public StatsTracker{
 std::unique_ptr<StatsTracker> TeraMultiFarmer_Descriptor::make_stats() const{
     return std::unique_ptr<StatsTracker>(new Stats());
 }
+std::vector<WarmupResource> TeraMultiFarmer_Descriptor::warmup_resources() const{
+    return {
+        {"PokemonSV: Tera Type Matcher", TERA_RAID_TYPE_MATCHER},
+        {"PokemonSV: Tera Silhouette Matcher", TERA_RAID_SILHOUETTE_MATCHER},
+    };
+}
 
 
 TeraMultiFarmer::~TeraMultiFarmer(){
@@ -5,7 +5,21 @@
  */
 
 
+#include <cfloat>
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <QEventLoop>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUrl>
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "CommonFramework/AudioPipeline/AudioFeed.h"
+#include "CommonFramework/AudioPipeline/AudioTemplate.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/Notifications/NotificationPipeline.h"
+#include "Integrations/DiscordWebhook.h"
+#include "CommonTools/Audio/AudioMatchingEngine.h"
 #include "CommonTools/VisualDetectors/BlackBorderDetector.h"
 #include "CommonFramework_Tests.h"
 #include "TestUtils.h"
@@ -29,4 +43,328 @@ int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool t
 }
 
 
+namespace{
+
+//  Stands in for the Discord webhook endpoint. Runs its own event loop on a
+//  separate thread, records the body of every request and replies 204.
+class LocalWebhookServer{
+public:
+    LocalWebhookServer()
+        : m_thread(&LocalWebhookServer::thread_body, this)
+    {
+        std::unique_lock<std::mutex> lg(m_lock);
+        m_cv.wait(lg, [this]{ return m_loop != nullptr; });
+    }
+    ~LocalWebhookServer(){
+        QEventLoop* loop = m_loop;
+        QMetaObject::invokeMethod(loop, [loop]{ loop->quit(); }, Qt::QueuedConnection);
+        m_thread.join();
+    }
+
+    std::string url() const{
+        return "http://127.0.0.1:" + std::to_string(m_port) + "/webhook";
+    }
+
+    //  Wait until "count" requests have arrived or "timeout" passes.
+    //  Returns the number of requests that have arrived.
+    size_t wait_for_requests(size_t count, std::chrono::seconds timeout = std::chrono::seconds(30)){
+        std::unique_lock<std::mutex> lg(m_lock);
+        m_cv.wait_for(lg, timeout, [&]{ return m_requests.size() >= count; });
+        return m_requests.size();
+    }
+    std::string request(size_t index) const{
+        std::lock_guard<std::mutex> lg(m_lock);
+        return m_requests[index];
+    }
+
+private:
+    void thread_body(){
+        QEventLoop loop;
+        QTcpServer server;
+        server.listen(QHostAddress::LocalHost, 0);
+        QObject::connect(&server, &QTcpServer::newConnection, &server, [this, &server]{
+            while (QTcpSocket* socket = server.nextPendingConnection()){
+                QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+                QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket]{
+                    on_read(*socket);
+                });
+            }
+        });
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            m_port = server.serverPort();
+            m_loop = &loop;
+        }
+        m_cv.notify_all();
+        loop.exec();
+    }
+    void on_read(QTcpSocket& socket){
+        QByteArray& buffer = m_buffers[&socket];
+        buffer.append(socket.readAll());
+
+        qsizetype header_end = buffer.indexOf("\r\n\r\n");
+        if (header_end < 0){
+            return;
+        }
+        QByteArray headers = buffer.left(header_end).toLower();
+        qsizetype length = 0;
+        qsizetype index = headers.indexOf("content-length:");
+        if (index >= 0){
+            qsizetype line_end = headers.indexOf("\r\n", index);
+            length = headers.mid(index + 15, line_end < 0 ? -1 : line_end - index - 15).trimmed().toLongLong();
+        }
+        if (buffer.size() < header_end + 4 + length){
+            return;
+        }
+
+        std::string body = buffer.mid(header_end + 4, length).toStdString();
+        m_buffers.erase(&socket);
+        socket.write("HTTP/1.1 204 No Content\r\nConnection: close\r\n\r\n");
+        socket.disconnectFromHost();
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            m_requests.emplace_back(std::move(body));
+        }
+        m_cv.notify_all();
+    }
+
+private:
+    mutable std::mutex m_lock;
+    std::condition_variable m_cv;
+    QEventLoop* m_loop = nullptr;
+    uint16_t m_port = 0;
+    std::vector<std::string> m_requests;
+
+    //  Only touched by the server thread.
+    std::map<QTcpSocket*, QByteArray> m_buffers;
+
+    std::thread m_thread;
+};
+
+size_t count_occurrences(const std::string& str, const std::string& token){
+    size_t count = 0;
+    for (size_t pos = str.find(token); pos != std::string::npos; pos = str.find(token, pos + token.size())){
+        count++;
+    }
+    return count;
+}
+
+}
+
+
+int test_CommonFramework_NotificationPipeline([[maybe_unused]] const std::string& test_path){
+    LocalWebhookServer server;
+    QUrl url(QString::fromStdString(server.url()));
+
+    //  Hold everything that can be held so nothing depends on timing. The
+    //  window is released by shortening it below.
+    NotificationPipelineLimits limits;
+    limits.coalesce_window = std::chrono::hours(1);
+    limits.max_queued = 8;
+    limits.max_attachment_width = 0;
+
+    Logger& logger = global_logger_tagged();
+    std::unique_ptr<NotificationPipeline> pipeline = std::make_unique<NotificationPipeline>(
+        [&](NotificationMessage& message){
+            JsonObject json;
+            json["embeds"] = message.embeds();
+            Integration::DiscordWebhook::DiscordWebhookSender::instance().send(
+                logger, url, std::chrono::milliseconds(0),
+                std::move(json), message.files()
+            );
+        },
+        [&]{ return limits; }
+    );
+
+    auto send = [&](const std::string& tag){
+        JsonObject embed;
+        embed["title"] = "Test: " + tag;
+        return pipeline->send(logger, COLOR_BLUE, false, {tag}, std::move(embed), ImageAttachment());
+    };
+    auto embeds = [&](size_t index, const std::string& tag){
+        return count_occurrences(server.request(index), "Test: " + tag);
+    };
+    const std::string DROPPED_NOTE = "4 notification(s) were dropped";
+
+    //  Nothing was sent recently, so these go out right away.
+    TEST_RESULT_EQUAL(send("Notifs"), true);
+    TEST_RESULT_EQUAL(server.wait_for_requests(1), 1);
+    TEST_RESULT_EQUAL(send("Shiny"), true);
+    TEST_RESULT_EQUAL(server.wait_for_requests(2), 2);
+
+    //  A burst on the first channel is held inside its window. The queue only
+    //  has room for 8.
+    size_t accepted = 0;
+    for (size_t c = 0; c < 12; c++){
+        accepted += send("Notifs");
+    }
+    TEST_RESULT_EQUAL(accepted, 8);
+    TEST_RESULT_EQUAL(pipeline->queued(), 8);
+
+    //  Once the window is over, the burst goes out as one message with a note
+    //  about the dropped ones. The limits are picked up on the next send.
+    limits.coalesce_window = std::chrono::milliseconds(0);
+    limits.max_queued = 50;
+    send("Other");
+    TEST_RESULT_EQUAL(server.wait_for_requests(4), 4);
+    size_t burst = embeds(2, "Notifs") != 0 ? 2 : 3;
+    TEST_RESULT_EQUAL(embeds(burst, "Notifs"), 8);
+    TEST_RESULT_EQUAL(count_occurrences(server.request(burst), DROPPED_NOTE), 1);
+    TEST_RESULT_EQUAL(embeds(5 - burst, "Other"), 1);
+
+    //  Flushing ignores the windows, but still splits messages that would
+    //  have too many embeds.
+    limits.coalesce_window = std::chrono::hours(1);
+    for (size_t c = 0; c < 20; c++){
+        send("Notifs");
+    }
+    pipeline->flush();
+    TEST_RESULT_EQUAL(pipeline->queued(), 0);
+    TEST_RESULT_EQUAL(server.wait_for_requests(7), 7);
+    std::vector<size_t> sizes{embeds(4, "Notifs"), embeds(5, "Notifs"), embeds(6, "Notifs")};
+    std::sort(sizes.begin(), sizes.end());
+    TEST_RESULT_EQUAL(sizes[0], 2);
+    TEST_RESULT_EQUAL(sizes[1], NotificationPipeline::MAX_ITEMS_PER_MESSAGE);
+    TEST_RESULT_EQUAL(sizes[2], NotificationPipeline::MAX_ITEMS_PER_MESSAGE);
+    for (size_t c = 4; c < 7; c++){
+        TEST_RESULT_EQUAL(count_occurrences(server.request(c), DROPPED_NOTE), 0);
+    }
+
+    //  Messages are also split before the text of their embeds passes
+    //  Discord's limit. Two of these fit in one message, three don't. The
+    //  first one goes out right away, the rest are held.
+    auto send_large = [&]{
+        JsonObject embed;
+        embed["title"] = "Test: Large";
+        embed["description"] = std::string(2500, 'x');
+        return pipeline->send(logger, COLOR_BLUE, false, {"Large"}, std::move(embed), ImageAttachment());
+    };
+    TEST_RESULT_EQUAL(send_large(), true);
+    TEST_RESULT_EQUAL(server.wait_for_requests(8), 8);
+    for (size_t c = 0; c < 4; c++){
+        send_large();
+    }
+    pipeline->flush();
+    TEST_RESULT_EQUAL(server.wait_for_requests(10), 10);
+    sizes = {embeds(7, "Large"), embeds(8, "Large"), embeds(9, "Large")};
+    std::sort(sizes.begin(), sizes.end());
+    TEST_RESULT_EQUAL(sizes[0], 1);
+    TEST_RESULT_EQUAL(sizes[1], 2);
+    TEST_RESULT_EQUAL(sizes[2], 2);
+
+    //  Notifications still held inside their window go out on shutdown.
+    send("Shutdown");
+    TEST_RESULT_EQUAL(server.wait_for_requests(11), 11);
+    send("Shutdown");
+    send("Shutdown");
+    pipeline.reset();
+    TEST_RESULT_EQUAL(server.wait_for_requests(12), 12);
+    TEST_RESULT_EQUAL(embeds(11, "Shutdown"), 2);
+
+    return 0;
+}
+
+
+
+namespace{
+
+//  Replays a fixed list of spectrums.
+class TestAudioFeed : public AudioFeed{
+public:
+    std::vector<AudioSpectrum> spectrums;   //  Oldest first.
+
+    virtual void reset() override{}
+    virtual std::vector<AudioSpectrum> spectrums_since(uint64_t starting_seqnum) override{
+        std::vector<AudioSpectrum> ret;
+        for (auto iter = spectrums.rbegin(); iter != spectrums.rend() && iter->stamp >= starting_seqnum; ++iter){
+            ret.emplace_back(*iter);
+        }
+        return ret;
+    }
+    virtual std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums) override{
+        std::vector<AudioSpectrum> ret;
+        for (auto iter = spectrums.rbegin(); iter != spectrums.rend() && ret.size() < num_last_spectrums; ++iter){
+            ret.emplace_back(*iter);
+        }
+        return ret;
+    }
+    virtual void add_overlay(uint64_t, size_t, Color) override{}
+
+    //  Append spectrums up to (but not including) "end" and return the new
+    //  ones, newest first.
+    std::vector<AudioSpectrum> advance(uint64_t end, size_t frequencies){
+        uint64_t start = spectrums.size();
+        for (uint64_t stamp = start; stamp < end; stamp++){
+            auto magnitudes = std::make_shared<AlignedVector<float>>(frequencies);
+            for (size_t c = 0; c < frequencies; c++){
+                (*magnitudes)[c] = 1.0f + (float)((stamp * 7 + c) % 13);
+            }
+            spectrums.emplace_back(stamp, 48000, std::move(magnitudes));
+        }
+        return spectrums_since(start);
+    }
+};
+
+}
+
+
+int test_CommonFramework_AudioMatchingEngine([[maybe_unused]] const std::string& test_path){
+    const size_t FREQUENCIES = 64;
+    const size_t WINDOWS = 4;
+
+    AudioTemplate audio_template(FREQUENCIES, WINDOWS);
+    for (size_t w = 0; w < WINDOWS; w++){
+        for (size_t c = 0; c < FREQUENCIES; c++){
+            audio_template.getWindow(w)[c] = 1.0f + (float)((w * 5 + c) % 11);
+        }
+    }
+    SpectrogramMatcher first("First", audio_template, SpectrogramMatcher::Mode::RAW, 48000, 0);
+    SpectrogramMatcher second("Second", audio_template, SpectrogramMatcher::Mode::RAW, 48000, 0);
+    TEST_RESULT_EQUAL(first.numMatchedWindows(), WINDOWS);
+
+    TestAudioFeed feed;
+    AudioMatchingEngine engine;
+    std::vector<AudioMatchingEngine::MatchResult> results;
+
+    //  Warm up the shared history with the first matcher.
+    engine.add_matcher(first);
+    engine.match(feed, first, feed.advance(10, FREQUENCIES), results);
+    TEST_RESULT_EQUAL(results.size(), 10);
+    for (const auto& result : results){
+        TEST_RESULT_EQUAL(result.score == FLT_MAX, result.stamp < WINDOWS - 1);
+    }
+
+    //  The second matcher joins the warm history. It must not be scored
+    //  against anything from before it was added, even though the history
+    //  already has enough windows.
+    engine.add_matcher(second);
+    std::vector<AudioSpectrum> spectrums = feed.advance(16, FREQUENCIES);
+    engine.match(feed, first, spectrums, results);
+    TEST_RESULT_EQUAL(results.size(), 6);
+    for (const auto& result : results){
+        TEST_RESULT_EQUAL(result.score == FLT_MAX, false);
+    }
+    engine.match(feed, second, spectrums, results);
+    TEST_RESULT_EQUAL(results.size(), 6);
+    for (const auto& result : results){
+        TEST_RESULT_EQUAL(result.score == FLT_MAX, result.stamp < 10 + WINDOWS - 1);
+    }
+
+    //  Once both have seen the same spectrums, they score them the same.
+    std::vector<AudioMatchingEngine::MatchResult> first_results;
+    spectrums = feed.advance(20, FREQUENCIES);
+    engine.match(feed, first, spectrums, first_results);
+    engine.match(feed, second, spectrums, results);
+    TEST_RESULT_EQUAL(results.size(), 4);
+    for (size_t c = 0; c < results.size(); c++){
+        TEST_RESULT_EQUAL(results[c].stamp, first_results[c].stamp);
+        TEST_RESULT_EQUAL(results[c].score, first_results[c].score);
+    }
+
+    engine.remove_matcher(second);
+    engine.remove_matcher(first);
+    return 0;
+}
+
+
 }
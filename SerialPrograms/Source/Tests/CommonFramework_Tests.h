@@ -9,12 +9,23 @@
 #ifndef PokemonAutomation_Tests_CommonFramework_Tests_H
 #define PokemonAutomation_Tests_CommonFramework_Tests_H
 
+#include <string>
+
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
 
 int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool target);
 
+//  Send bursts through a NotificationPipeline into the webhook sender, posting
+//  to a local HTTP server, and check the coalescing, dropping, splitting of
+//  large messages and the flush on shutdown.
+int test_CommonFramework_NotificationPipeline(const std::string& test_path);
+
+//  Add a second matcher to an audio matching history that is already warm and
+//  check that it is only scored against spectrums that came in after it.
+int test_CommonFramework_AudioMatchingEngine(const std::string& test_path);
+
 }
 
 #endif
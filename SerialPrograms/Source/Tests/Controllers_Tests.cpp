@@ -0,0 +1,699 @@
+/*  Controllers Tests
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stddef.h>
+#include <memory>
+#include <vector>
+#include <set>
+#include <map>
+#include <algorithm>
+#include <thread>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/RecursiveThrottler.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "Controllers/ControllerTypes.h"
+#include "Controllers/Controller.h"
+#include "Controllers/SynchronizedActionBarrier.h"
+#include "Controllers/Schedulers/SuperscalarScheduler.h"
+#include "Controllers/SerialPABotBase/SerialPABotBase_Routines_NS1_OemControllers.h"
+#include "Controllers_Tests.h"
+#include "TestUtils.h"
+
+#include <iostream>
+using std::cout;
+using std::endl;
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+
+//  The scheduler before it was made allocation-free. Gapping and tracing are
+//  left out since the test never triggers them.
+class ReferenceScheduler{
+public:
+    struct Resource{
+        size_t id;
+        uint64_t value;
+    };
+    using State = std::vector<std::shared_ptr<const Resource>>;
+    struct ScheduleEntry{
+        WallDuration duration;
+        State state;
+    };
+    using Schedule = std::vector<ScheduleEntry>;
+
+public:
+    ReferenceScheduler(){
+        WallClock now = current_time();
+        m_device_issue_time = now;
+        m_device_sent_time = now;
+        m_max_free_time = now;
+    }
+
+    void issue_wait_for_all(Schedule& schedule){
+        m_device_issue_time = std::max(m_device_issue_time, m_max_free_time);
+        m_max_free_time = m_device_issue_time;
+        process_schedule(schedule);
+    }
+    void issue_nop(Schedule& schedule, WallDuration delay){
+        if (delay <= WallDuration::zero()){
+            return;
+        }
+        m_device_issue_time += delay;
+        m_state_changes.insert(m_device_issue_time);
+        m_max_free_time = std::max(m_max_free_time, m_device_issue_time);
+        process_schedule(schedule);
+    }
+    void issue_wait_for_resource(Schedule& schedule, size_t resource_id){
+        auto iter = m_live_commands.find(resource_id);
+        if (iter != m_live_commands.end() && m_device_sent_time < iter->second.free_time){
+            m_device_issue_time = iter->second.free_time;
+        }
+        process_schedule(schedule);
+    }
+    void issue_to_resource(
+        Schedule& schedule,
+        std::shared_ptr<const Resource> resource,
+        WallDuration delay, WallDuration hold, WallDuration cooldown
+    ){
+        auto ret = m_live_commands.try_emplace(resource->id);
+        if (!ret.second){
+            m_device_issue_time = std::max(m_device_issue_time, ret.first->second.free_time);
+            process_schedule(schedule);
+        }
+        Command& command = ret.first->second;
+
+        delay    = std::max(delay, WallDuration::zero());
+        hold     = std::max(hold, WallDuration::zero());
+        cooldown = std::max(cooldown, WallDuration::zero());
+
+        WallClock release_time = m_device_issue_time + hold;
+        WallClock free_time = release_time + cooldown;
+
+        m_state_changes.insert(m_device_issue_time);
+        m_state_changes.insert(release_time);
+
+        command.command = std::move(resource);
+        command.busy_time = m_device_issue_time;
+        command.done_time = release_time;
+        command.free_time = free_time;
+
+        m_device_issue_time += delay;
+        m_max_free_time = std::max(m_max_free_time, free_time);
+        m_max_free_time = std::max(m_max_free_time, m_device_issue_time);
+
+        process_schedule(schedule);
+    }
+
+private:
+    void process_schedule(Schedule& schedule){
+        while (true){
+            if (m_state_changes.empty()){
+                m_device_sent_time = m_device_issue_time;
+                return;
+            }
+            auto iter = m_state_changes.begin();
+            WallClock next_state_change;
+            if (m_device_sent_time < *iter){
+                next_state_change = *iter;
+            }else{
+                auto next = iter;
+                ++next;
+                next_state_change = next == m_state_changes.end()
+                    ? m_device_issue_time
+                    : *next;
+            }
+            next_state_change = std::min(next_state_change, m_device_issue_time);
+
+            WallDuration duration = next_state_change - m_device_sent_time;
+            if (duration == WallDuration::zero()){
+                return;
+            }
+
+            State state;
+            for (auto& item : m_live_commands){
+                if (item.second.busy_time <= m_device_sent_time && m_device_sent_time < item.second.done_time){
+                    state.emplace_back(item.second.command);
+                }
+            }
+            for (auto item = m_live_commands.begin(); item != m_live_commands.end();){
+                if (m_device_sent_time >= item->second.free_time){
+                    item = m_live_commands.erase(item);
+                }else{
+                    ++item;
+                }
+            }
+
+            m_device_sent_time = next_state_change;
+            if (next_state_change > *iter){
+                m_state_changes.erase(iter);
+            }
+
+            ScheduleEntry& entry = schedule.emplace_back();
+            entry.duration = duration;
+            entry.state = std::move(state);
+
+            if (m_device_sent_time >= m_device_issue_time){
+                return;
+            }
+        }
+    }
+
+private:
+    WallClock m_device_issue_time;
+    WallClock m_device_sent_time;
+    WallClock m_max_free_time;
+    std::set<WallClock> m_state_changes;
+
+    struct Command{
+        std::shared_ptr<const Resource> command;
+        WallClock busy_time;
+        WallClock done_time;
+        WallClock free_time;
+    };
+    std::map<size_t, Command> m_live_commands;
+};
+
+
+struct IssueOp{
+    enum Type{
+        NOP,
+        WAIT_FOR_RESOURCE,
+        WAIT_FOR_ALL,
+        RESOURCE,
+    };
+    Type type;
+    size_t id;
+    uint64_t value;
+    WallDuration delay;
+    WallDuration hold;
+    WallDuration cooldown;
+};
+
+//  Mostly presses on a small set of resources so they overlap, with the odd
+//  wait thrown in. Durations are in whole milliseconds so some of them land
+//  on the same timestamp.
+std::vector<IssueOp> make_issue_sequence(uint32_t seed, size_t count, size_t resources){
+    uint32_t state = seed;
+    auto next = [&](uint32_t range){
+        state = state * 1664525 + 1013904223;
+        return (state >> 8) % range;
+    };
+
+    std::vector<IssueOp> ret;
+    for (size_t c = 0; c < count; c++){
+        IssueOp op{};
+        uint32_t kind = next(100);
+        if (kind < 8){
+            op.type = IssueOp::NOP;
+            op.delay = Milliseconds(next(50));
+        }else if (kind < 14){
+            op.type = IssueOp::WAIT_FOR_RESOURCE;
+            op.id = next((uint32_t)resources);
+        }else if (kind < 16){
+            op.type = IssueOp::WAIT_FOR_ALL;
+        }else{
+            op.type = IssueOp::RESOURCE;
+            op.id = next((uint32_t)resources);
+            op.value = next(1 << 16);
+            op.delay = Milliseconds(next(4) == 0 ? 0 : next(100));
+            op.hold = Milliseconds(next(150));
+            op.cooldown = Milliseconds(next(30));
+        }
+        ret.emplace_back(op);
+    }
+    return ret;
+}
+
+void run_new(
+    SuperscalarScheduler& scheduler,
+    SuperscalarScheduler::Schedule& schedule,
+    const IssueOp& op
+){
+    switch (op.type){
+    case IssueOp::NOP:
+        scheduler.issue_nop(schedule, op.delay);
+        return;
+    case IssueOp::WAIT_FOR_RESOURCE:
+        scheduler.issue_wait_for_resource(schedule, op.id);
+        return;
+    case IssueOp::WAIT_FOR_ALL:
+        scheduler.issue_wait_for_all(schedule);
+        return;
+    case IssueOp::RESOURCE:
+        scheduler.issue_to_resource(
+            schedule, SchedulerResource(op.id, op.value),
+            op.delay, op.hold, op.cooldown
+        );
+        return;
+    }
+}
+void run_reference(
+    ReferenceScheduler& scheduler,
+    ReferenceScheduler::Schedule& schedule,
+    const IssueOp& op
+){
+    switch (op.type){
+    case IssueOp::NOP:
+        scheduler.issue_nop(schedule, op.delay);
+        return;
+    case IssueOp::WAIT_FOR_RESOURCE:
+        scheduler.issue_wait_for_resource(schedule, op.id);
+        return;
+    case IssueOp::WAIT_FOR_ALL:
+        scheduler.issue_wait_for_all(schedule);
+        return;
+    case IssueOp::RESOURCE:
+        scheduler.issue_to_resource(
+            schedule, std::make_shared<ReferenceScheduler::Resource>(ReferenceScheduler::Resource{op.id, op.value}),
+            op.delay, op.hold, op.cooldown
+        );
+        return;
+    }
+}
+
+bool same_schedule(
+    const SuperscalarScheduler::Schedule& schedule,
+    const ReferenceScheduler::Schedule& expected
+){
+    if (schedule.size() != expected.size()){
+        cout << "Schedule has " << schedule.size() << " entries, but should have " << expected.size() << endl;
+        return false;
+    }
+    for (size_t c = 0; c < schedule.size(); c++){
+        const SuperscalarScheduler::ScheduleEntry& entry = schedule[c];
+        const ReferenceScheduler::ScheduleEntry& expected_entry = expected[c];
+        if (entry.duration != expected_entry.duration){
+            cout << "Entry " << c << " has the wrong duration." << endl;
+            return false;
+        }
+        if (entry.state.size() != expected_entry.state.size()){
+            cout << "Entry " << c << " has " << entry.state.size()
+                 << " active resources, but should have " << expected_entry.state.size() << endl;
+            return false;
+        }
+        for (size_t i = 0; i < entry.state.size(); i++){
+            if (entry.state[i].id != expected_entry.state[i]->id ||
+                entry.state[i].value != expected_entry.state[i]->value
+            ){
+                cout << "Entry " << c << " has the wrong resource at position " << i << endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+
+//  Records the button commands sent to it instead of sending them.
+class FakeBotBaseConnection : public BotBaseController{
+public:
+    struct Command{
+        uint8_t type;
+        std::vector<uint16_t> milliseconds;
+        std::vector<uint8_t> button3;
+    };
+    std::vector<Command> commands;
+
+    FakeBotBaseConnection(Logger& logger)
+        : m_logger(logger)
+    {}
+
+    virtual void on_cancellable_cancel() override{}
+    virtual void stop(std::string error_message) override{}
+    virtual Logger& logger() override{ return m_logger; }
+    virtual State state() const override{ return State::RUNNING; }
+    virtual size_t queue_limit() const override{ return 64; }
+    virtual void wait_for_all_requests(Cancellable* cancelled) override{}
+    virtual void stop_all_commands() override{}
+    virtual void next_command_interrupt() override{}
+
+    virtual bool try_issue_request(const BotBaseRequest& request, Cancellable* cancelled) override{
+        record(request.message());
+        return true;
+    }
+    virtual void issue_request(const BotBaseRequest& request, Cancellable* cancelled) override{
+        record(request.message());
+    }
+    virtual BotBaseMessage issue_request_and_wait(const BotBaseRequest& request, Cancellable* cancelled) override{
+        record(request.message());
+        return BotBaseMessage();
+    }
+
+private:
+    void record(const BotBaseMessage& message){
+        Command command;
+        command.type = message.type;
+        switch (message.type){
+        case PABB_MSG_COMMAND_NS1_OEM_CONTROLLER_BUTTONS:{
+            pabb_Message_Command_NS1_OemController_Buttons params;
+            message.convert<PABB_MSG_COMMAND_NS1_OEM_CONTROLLER_BUTTONS>(m_logger, params);
+            command.milliseconds.push_back(params.milliseconds);
+            command.button3.push_back(params.buttons.button3);
+            break;
+        }
+        case PABB_MSG_COMMAND_NS1_OEM_CONTROLLER_BUTTONS_BATCH:{
+            pabb_Message_Command_NS1_OemController_ButtonsBatch params;
+            memset(&params, 0, sizeof(params));
+            memcpy(&params, message.body.data(), std::min(message.body.size(), sizeof(params)));
+            size_t expected = offsetof(pabb_Message_Command_NS1_OemController_ButtonsBatch, entries) +
+                params.count * sizeof(pabb_NS1_OemController_ButtonsBatchEntry);
+            if (message.body.size() != expected){
+                //  Leave the entries empty so the test fails.
+                break;
+            }
+            for (uint8_t c = 0; c < params.count; c++){
+                command.milliseconds.push_back(params.entries[c].milliseconds);
+                command.button3.push_back(params.entries[c].buttons.button3);
+            }
+            break;
+        }
+        }
+        commands.push_back(std::move(command));
+    }
+
+private:
+    Logger& m_logger;
+};
+
+pabb_NintendoSwitch_OemController_State0x30_Buttons make_buttons(uint8_t button3){
+    pabb_NintendoSwitch_OemController_State0x30_Buttons buttons;
+    memset(&buttons, 0, sizeof(buttons));
+    buttons.button3 = button3;
+    return buttons;
+}
+
+
+}
+
+
+
+int test_Controllers_SerialPABotBaseBatching([[maybe_unused]] const std::string& test_path){
+    using namespace SerialPABotBase;
+    const int SINGLE = PABB_MSG_COMMAND_NS1_OEM_CONTROLLER_BUTTONS;
+    const int BATCH = PABB_MSG_COMMAND_NS1_OEM_CONTROLLER_BUTTONS_BATCH;
+
+    FakeBotBaseConnection connection(global_logger_command_line());
+
+    //  9 short states: two full batches, then the last one on its own.
+    {
+        ButtonsBatchSender sender(connection, nullptr);
+        for (uint8_t c = 0; c < 9; c++){
+            sender.push(Milliseconds(10 + c), make_buttons(c));
+        }
+        TEST_RESULT_EQUAL(connection.commands.size(), (size_t)2);
+        sender.flush();
+    }
+    TEST_RESULT_EQUAL(connection.commands.size(), (size_t)3);
+    TEST_RESULT_EQUAL((int)connection.commands[0].type, BATCH);
+    TEST_RESULT_EQUAL((int)connection.commands[1].type, BATCH);
+    TEST_RESULT_EQUAL((int)connection.commands[2].type, SINGLE);
+    for (size_t c = 0; c < 9; c++){
+        const FakeBotBaseConnection::Command& command = connection.commands[c / 4];
+        TEST_RESULT_EQUAL(command.milliseconds.size(), c < 8 ? (size_t)4 : (size_t)1);
+        TEST_RESULT_EQUAL(command.milliseconds[c % 4], 10 + c);
+        TEST_RESULT_EQUAL((size_t)command.button3[c % 4], c);
+    }
+
+    //  A long hold flushes what is pending and goes out in 65535ms pieces.
+    //  Zero-length states are dropped.
+    connection.commands.clear();
+    {
+        ButtonsBatchSender sender(connection, nullptr);
+        sender.push(Milliseconds(100), make_buttons(1));
+        sender.push(Milliseconds(0), make_buttons(2));
+        sender.push(Milliseconds(200), make_buttons(3));
+        sender.push(Milliseconds(70000), make_buttons(4));
+        sender.push(Milliseconds(300), make_buttons(5));
+        sender.push(Milliseconds(65535), make_buttons(6));
+        sender.flush();
+    }
+    TEST_RESULT_EQUAL(connection.commands.size(), (size_t)4);
+    TEST_RESULT_EQUAL((int)connection.commands[0].type, BATCH);
+    TEST_RESULT_EQUAL(connection.commands[0].milliseconds.size(), (size_t)2);
+    TEST_RESULT_EQUAL(connection.commands[0].milliseconds[0], 100);
+    TEST_RESULT_EQUAL(connection.commands[0].milliseconds[1], 200);
+    TEST_RESULT_EQUAL((int)connection.commands[0].button3[1], 3);
+    TEST_RESULT_EQUAL((int)connection.commands[1].type, SINGLE);
+    TEST_RESULT_EQUAL(connection.commands[1].milliseconds[0], 65535);
+    TEST_RESULT_EQUAL((int)connection.commands[1].button3[0], 4);
+    TEST_RESULT_EQUAL((int)connection.commands[2].type, SINGLE);
+    TEST_RESULT_EQUAL(connection.commands[2].milliseconds[0], 70000 - 65535);
+    TEST_RESULT_EQUAL((int)connection.commands[2].button3[0], 4);
+    TEST_RESULT_EQUAL((int)connection.commands[3].type, BATCH);
+    TEST_RESULT_EQUAL(connection.commands[3].milliseconds.size(), (size_t)2);
+    TEST_RESULT_EQUAL(connection.commands[3].milliseconds[0], 300);
+    TEST_RESULT_EQUAL(connection.commands[3].milliseconds[1], 65535);
+
+    //  Nothing pending, nothing sent.
+    connection.commands.clear();
+    {
+        ButtonsBatchSender sender(connection, nullptr);
+        sender.push(Milliseconds(0), make_buttons(1));
+        sender.flush();
+    }
+    TEST_RESULT_EQUAL(connection.commands.size(), (size_t)0);
+
+    cout << "SerialPABotBase batching sends the expected commands." << endl;
+    return 0;
+}
+
+
+
+namespace{
+
+//  A controller with a fixed command latency. It records the nop that the
+//  barrier pads its queue with.
+class FakeBarrierController : public AbstractController{
+public:
+    FakeBarrierController(Logger& logger, WallDuration latency)
+        : m_logger(logger)
+        , m_latency(latency)
+    {}
+
+    Milliseconds pad = Milliseconds(-1);
+    WallClock nop_time = WallClock::min();
+
+    virtual Logger& logger() override{ return m_logger; }
+    virtual RecursiveThrottler& logging_throttler() override{ return m_throttler; }
+
+    virtual const char* name() override{ return "FakeBarrierController"; }
+    virtual ControllerClass controller_class() const override{ return ControllerClass::None; }
+    virtual ControllerPerformanceClass performance_class() const override{ return ControllerPerformanceClass::Unknown; }
+    virtual Milliseconds ticksize() const override{ return Milliseconds::zero(); }
+    virtual Milliseconds cooldown() const override{ return Milliseconds::zero(); }
+    virtual Milliseconds timing_variation() const override{ return Milliseconds::zero(); }
+    virtual WallDuration command_latency() const override{ return m_latency; }
+    virtual bool atomic_multibutton() const override{ return true; }
+    virtual bool is_ready() const override{ return true; }
+
+    virtual void cancel_all_commands() override{}
+    virtual void replace_on_next_command() override{}
+    virtual void wait_for_all(Cancellable* cancellable) override{}
+    virtual void issue_barrier(Cancellable* cancellable) override{}
+    virtual void issue_nop(Cancellable* cancellable, Milliseconds duration) override{
+        pad = duration;
+        nop_time = current_time();
+    }
+
+private:
+    Logger& m_logger;
+    RecursiveThrottler m_throttler;
+    WallDuration m_latency;
+};
+
+int64_t to_us(WallDuration duration){
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+}
+
+
+
+int test_Controllers_SynchronizedActionBarrier([[maybe_unused]] const std::string& test_path){
+    Logger& logger = global_logger_command_line();
+
+    //  Large enough that no thread wakes up too late on a loaded machine.
+    const Milliseconds SLACK(200);
+
+    //  One round with 3 controllers of different latencies. Each one must be
+    //  padded so that its action starts at "release + max latency + slack".
+    {
+        const size_t THREADS = 3;
+        SynchronizedActionBarrier barrier(logger, THREADS, SLACK);
+        std::vector<std::unique_ptr<FakeBarrierController>> controllers;
+        for (size_t c = 0; c < THREADS; c++){
+            controllers.emplace_back(new FakeBarrierController(logger, Milliseconds(10 + 20 * c)));
+        }
+        const WallDuration MAX_LATENCY = Milliseconds(50);
+
+        std::vector<WallClock> arrived(THREADS);
+        std::vector<WallClock> starts(THREADS);
+        std::vector<WallClock> action_times(THREADS);
+        std::vector<std::thread> threads;
+        for (size_t c = 0; c < THREADS; c++){
+            threads.emplace_back([&, c]{
+                CancellableHolder<CancellableScope> scope;
+                arrived[c] = current_time();
+                starts[c] = barrier.run(scope, *controllers[c], [&, c]{
+                    action_times[c] = current_time();
+                });
+            });
+        }
+        for (std::thread& thread : threads){
+            thread.join();
+        }
+
+        SynchronizedActionReport report = barrier.last_report();
+        TEST_RESULT_EQUAL(report.participants, THREADS);
+        TEST_RESULT_EQUAL(to_us(report.max_latency), to_us(MAX_LATENCY));
+        TEST_RESULT_EQUAL(report.late, (size_t)0);
+
+        //  The round is released after the last arrival and before anyone
+        //  issues its nop.
+        WallClock release_min = *std::max_element(arrived.begin(), arrived.end());
+        WallClock release_max = WallClock::max();
+        for (const std::unique_ptr<FakeBarrierController>& controller : controllers){
+            release_max = std::min(release_max, controller->nop_time);
+        }
+        WallClock target_min = release_min + MAX_LATENCY + SLACK;
+        WallClock target_max = release_max + MAX_LATENCY + SLACK;
+
+        for (size_t c = 0; c < THREADS; c++){
+            const FakeBarrierController& controller = *controllers[c];
+            //  The nop is rounded to the nearest millisecond.
+            TEST_RESULT_EQUAL(starts[c] + Milliseconds(1) > target_min, true);
+            TEST_RESULT_EQUAL(starts[c] - Milliseconds(1) < target_max, true);
+            TEST_RESULT_EQUAL(controller.pad > Milliseconds::zero(), true);
+
+            //  The pad plus this controller's latency ends at the start time.
+            WallDuration error = controller.nop_time + controller.command_latency() + controller.pad - starts[c];
+            TEST_RESULT_EQUAL(error >= WallDuration::zero(), true);
+            TEST_RESULT_EQUAL(error < Milliseconds(5), true);
+
+            //  The action is issued after the nop.
+            TEST_RESULT_EQUAL(action_times[c] >= controller.nop_time, true);
+        }
+        TEST_RESULT_EQUAL(report.skew <= Milliseconds(1), true);
+        cout << "SynchronizedActionBarrier: pads = "
+             << controllers[0]->pad.count() << ", "
+             << controllers[1]->pad.count() << ", "
+             << controllers[2]->pad.count() << " ms" << endl;
+    }
+
+    //  A cancelled waiter leaves the round without counting as arrived and
+    //  without leaving its latency behind.
+    {
+        SynchronizedActionBarrier barrier(logger, 2, SLACK);
+        FakeBarrierController slow(logger, Milliseconds(500));
+        FakeBarrierController fast0(logger, Milliseconds(10));
+        FakeBarrierController fast1(logger, Milliseconds(20));
+
+        CancellableHolder<CancellableScope> cancelled_scope;
+        bool threw = false;
+        std::thread waiter([&]{
+            try{
+                barrier.run(cancelled_scope, slow, []{});
+            }catch (OperationCancelledException&){
+                threw = true;
+            }
+        });
+        std::this_thread::sleep_for(Milliseconds(50));
+        cancelled_scope.cancel(nullptr);
+        waiter.join();
+        TEST_RESULT_EQUAL(threw, true);
+        TEST_RESULT_EQUAL(slow.pad.count(), -1);
+
+        std::thread other([&]{
+            CancellableHolder<CancellableScope> scope;
+            barrier.run(scope, fast0, []{});
+        });
+        {
+            CancellableHolder<CancellableScope> scope;
+            barrier.run(scope, fast1, []{});
+        }
+        other.join();
+
+        SynchronizedActionReport report = barrier.last_report();
+        TEST_RESULT_EQUAL(report.participants, (size_t)2);
+        TEST_RESULT_EQUAL(to_us(report.max_latency), to_us(Milliseconds(20)));
+        TEST_RESULT_EQUAL(report.late, (size_t)0);
+    }
+
+    cout << "SynchronizedActionBarrier releases and pads as expected." << endl;
+    return 0;
+}
+
+
+
+int test_Controllers_SuperscalarScheduler([[maybe_unused]] const std::string& test_path){
+    //  Never gap. The test would otherwise depend on how fast it runs.
+    const WallDuration FLUSH_THRESHOLD = std::chrono::hours(24);
+    Logger& logger = global_logger_command_line();
+
+    //  Correctness: compare the schedules issue by issue.
+    for (uint32_t seed = 1; seed <= 20; seed++){
+        size_t resources = seed % 2 ? 8 : 40;
+        std::vector<IssueOp> ops = make_issue_sequence(seed, 5000, resources);
+
+        SuperscalarScheduler scheduler(logger, FLUSH_THRESHOLD);
+        ReferenceScheduler reference;
+        SuperscalarScheduler::Schedule schedule;
+        ReferenceScheduler::Schedule expected;
+        for (size_t c = 0; c < ops.size(); c++){
+            schedule.clear();
+            expected.clear();
+            run_new(scheduler, schedule, ops[c]);
+            run_reference(reference, expected, ops[c]);
+            if (!same_schedule(schedule, expected)){
+                cout << "Error: SuperscalarScheduler, seed = " << seed << ", issue " << c << endl;
+                return 1;
+            }
+        }
+    }
+    cout << "SuperscalarScheduler matches the reference." << endl;
+
+    //  Throughput. Schedules are reused as the controllers do.
+    std::vector<IssueOp> ops = make_issue_sequence(12345, 200000, 16);
+    {
+        SuperscalarScheduler scheduler(logger, FLUSH_THRESHOLD);
+        SuperscalarScheduler::Schedule schedule;
+        size_t entries = 0;
+        WallClock start = current_time();
+        for (const IssueOp& op : ops){
+            schedule.clear();
+            run_new(scheduler, schedule, op);
+            entries += schedule.size();
+        }
+        double seconds = std::chrono::duration<double>(current_time() - start).count();
+        cout << "SuperscalarScheduler: " << ops.size() / seconds / 1e6 << " M issues/s (" << entries << " entries)" << endl;
+    }
+    {
+        ReferenceScheduler scheduler;
+        ReferenceScheduler::Schedule schedule;
+        size_t entries = 0;
+        WallClock start = current_time();
+        for (const IssueOp& op : ops){
+            schedule.clear();
+            run_reference(scheduler, schedule, op);
+            entries += schedule.size();
+        }
+        double seconds = std::chrono::duration<double>(current_time() - start).count();
+        cout << "Reference:            " << ops.size() / seconds / 1e6 << " M issues/s (" << entries << " entries)" << endl;
+    }
+
+    return 0;
+}
+
+
+
+}
@@ -0,0 +1,33 @@
+/*  Controllers Tests
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+
+#ifndef PokemonAutomation_Tests_Controllers_Tests_H
+#define PokemonAutomation_Tests_Controllers_Tests_H
+
+#include <string>
+
+namespace PokemonAutomation{
+
+
+//  Run random issue sequences through SuperscalarScheduler and a reference
+//  copy of the original map/set-based scheduler. Check that both produce the
+//  same schedule and print the issue throughput of each.
+int test_Controllers_SuperscalarScheduler(const std::string& test_path);
+
+//  Feed button states through SerialPABotBase::ButtonsBatchSender on a fake
+//  connection. Check how they are packed into batched and single commands.
+int test_Controllers_SerialPABotBaseBatching(const std::string& test_path);
+
+//  Run SynchronizedActionBarrier on several threads with fake controllers.
+//  Check the target time and the pad of each controller, and that a cancelled
+//  waiter doesn't affect the next round.
+int test_Controllers_SynchronizedActionBarrier(const std::string& test_path);
+
+
+}
+
+#endif
@@ -9,10 +9,15 @@
 #include "Common/Cpp/Color.h"
 #include "Common/Cpp/CpuId/CpuId.h"
 #include "Common/Cpp/Time.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "CommonFramework/ImageTypes/BinaryImage.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonFramework/ImageTools/ImageStats.h"
+#include "CommonFramework/ImageTools/SummedAreaTable.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonTools/Images/BinaryImage_FilterRgb32.h"
+#include "CommonTools/Images/BinaryImage_FilterBatch.h"
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrix.h"
 #ifdef PA_AutoDispatch_arm64_20_M1
     #include "Kernels/BinaryMatrix/Kernels_BinaryMatrixTile_64x8_arm64_NEON.h"
@@ -26,7 +31,9 @@
 #include "Kernels/ImageFilters/Kernels_ImageFilter_Basic.h"
 #include "Kernels/ImageFilters/RGB32_Range/Kernels_ImageFilter_RGB32_Range.h"
 #include "Kernels/ImageFilters/RGB32_EuclideanDistance/Kernels_ImageFilter_RGB32_Euclidean.h"
+#include "Kernels/ImageScale/Kernels_ImageScale_Tables.h"
 #include "Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqr.h"
 #include "Kernels/Waterfill/Kernels_Waterfill.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Core_64xH_Default.h"
@@ -34,6 +41,7 @@
 #include "Kernels_Tests.h"
 #include "TestUtils.h"
 
+#include <QImage>
 #include <functional>
 #include <iostream>
 using std::cout;
@@ -45,7 +53,27 @@ namespace PokemonAutomation{
 
 using namespace Kernels;
 
-namespace Kernels{}
+namespace Kernels{
+namespace AbsFFT{
+    void fft_abs_Default(int k, float* abs, float* real);
+    void fft_abs_x86_SSE41(int k, float* abs, float* real);
+    void fft_abs_x86_AVX2(int k, float* abs, float* real);
+    void fft_abs_x86_AVX512(int k, float* abs, float* real);
+    void fft_abs_arm64_NEON(int k, float* abs, float* real);
+}
+namespace ImageScale{
+    void scale_image_nearest_Default(
+        const ScaleAxis& x_axis, const ScaleAxis& y_axis,
+        const uint32_t* src, size_t src_bytes_per_row,
+        uint32_t* dst, size_t dst_bytes_per_row
+    );
+    void scale_image_weighted_Default(
+        const ScaleAxis& x_axis, const ScaleAxis& y_axis,
+        const uint32_t* src, size_t src_bytes_per_row,
+        uint32_t* dst, size_t dst_bytes_per_row
+    );
+}
+}
 
 namespace{
 
@@ -75,6 +103,262 @@ int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image){
 }
 
 
+namespace{
+//  Compare the NEAREST filter against QImage::scaled(). Each source pixel holds
+//  its own coordinates so the sampled positions can be compared directly.
+//  Qt sometimes recomputes its position partway through an image. So allow a
+//  few rows and columns to be one source pixel off.
+int test_kernels_ImageScale_against_Qt(
+    const ImageViewRGB32& image,
+    const std::vector<std::pair<size_t, size_t>>& sizes
+){
+    if (image.width() >= 4096 || image.height() >= 4096){
+        return 0;
+    }
+    ImageRGB32 coordinates(image.width(), image.height());
+    for (size_t r = 0; r < image.height(); r++){
+        for (size_t c = 0; c < image.width(); c++){
+            coordinates.pixel(c, r) = 0xff000000 | (uint32_t)(c << 12) | (uint32_t)r;
+        }
+    }
+
+    for (const auto& size : sizes){
+        const size_t width = size.first;
+        const size_t height = size.second;
+        ImageRGB32 scaled = coordinates.scale_to(width, height);
+        QImage expected = coordinates.to_QImage_ref().scaled(
+            (int)width, (int)height, Qt::IgnoreAspectRatio, Qt::FastTransformation
+        ).convertToFormat(QImage::Format_ARGB32);
+
+        size_t mismatches = 0;
+        for (size_t r = 0; r < height; r++){
+            for (size_t c = 0; c < width; c++){
+                uint32_t x = scaled.pixel(c, r);
+                uint32_t y = (uint32_t)expected.pixel((int)c, (int)r);
+                if (x == y){
+                    continue;
+                }
+                mismatches++;
+                int dx = (int)((x >> 12) & 0xfff) - (int)((y >> 12) & 0xfff);
+                int dy = (int)(x & 0xfff) - (int)(y & 0xfff);
+                if (std::abs(dx) > 1 || std::abs(dy) > 1){
+                    cout << "Error: ImageScale NEAREST " << width << " x " << height
+                         << " samples a different pixel than Qt at (" << c << ", " << r << ")" << endl;
+                    return 1;
+                }
+            }
+        }
+        cout << "ImageScale NEAREST vs Qt " << width << " x " << height
+             << ": " << mismatches << " / " << width * height << " pixels differ" << endl;
+        if (mismatches * 100 > width * height){
+            cout << "Error: ImageScale NEAREST differs from Qt on more than 1% of the pixels." << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+}
+int test_kernels_ImageScale(const ImageViewRGB32& image){
+    const std::vector<std::pair<size_t, size_t>> sizes{
+        {1, 1},
+        {image.width() / 7 + 1, image.height() / 5 + 1},
+        {image.width() / 2, image.height() / 2},
+        {image.width() + 3, image.height() + 1},
+        {image.width() * 2, image.height() / 3 + 1},
+    };
+    const std::vector<std::pair<ImageScaleFilter, const char*>> filters{
+        {ImageScaleFilter::NEAREST, "NEAREST"},
+        {ImageScaleFilter::BILINEAR, "BILINEAR"},
+        {ImageScaleFilter::AREA, "AREA"},
+    };
+
+    for (const auto& filter : filters){
+        for (const auto& size : sizes){
+            const size_t width = size.first;
+            const size_t height = size.second;
+            ImageRGB32 scaled = image.scale_to(width, height, filter.first);
+            ImageRGB32 expected(width, height);
+
+            auto x_axis = ImageScale::get_scale_axis(filter.first, image.width(), width);
+            auto y_axis = ImageScale::get_scale_axis(filter.first, image.height(), height);
+            if (filter.first == ImageScaleFilter::NEAREST){
+                ImageScale::scale_image_nearest_Default(
+                    *x_axis, *y_axis, image.data(), image.bytes_per_row(),
+                    expected.data(), expected.bytes_per_row()
+                );
+            }else{
+                ImageScale::scale_image_weighted_Default(
+                    *x_axis, *y_axis, image.data(), image.bytes_per_row(),
+                    expected.data(), expected.bytes_per_row()
+                );
+            }
+
+            //  Nearest must be exact. The filtered ones may round differently
+            //  depending on the order of the sums.
+            const int tolerance = filter.first == ImageScaleFilter::NEAREST ? 0 : 1;
+            for (size_t r = 0; r < height; r++){
+                for (size_t c = 0; c < width; c++){
+                    uint32_t x = scaled.pixel(c, r);
+                    uint32_t y = expected.pixel(c, r);
+                    for (size_t ch = 0; ch < 4; ch++){
+                        int diff = (int)((x >> (8 * ch)) & 0xff) - (int)((y >> (8 * ch)) & 0xff);
+                        if (std::abs(diff) > tolerance){
+                            cout << "Error: ImageScale " << filter.second << " " << width << " x " << height
+                                 << " mismatch at (" << c << ", " << r << "): 0x" << std::hex << x
+                                 << " vs 0x" << y << std::dec << endl;
+                            return 1;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (filter.first == ImageScaleFilter::NEAREST){
+            int ret = test_kernels_ImageScale_against_Qt(image, sizes);
+            if (ret != 0){
+                return ret;
+            }
+        }
+
+        //  Throughput of the typical template-matching case: shrink a crop.
+        const size_t width = image.width() / 4 + 1;
+        const size_t height = image.height() / 4 + 1;
+        ImageRGB32 output;
+        const int num_iterations = 200;
+        auto time_start = current_time();
+        for (int i = 0; i < num_iterations; i++){
+            image.scale_to(output, width, height, filter.first);
+        }
+        auto time_end = current_time();
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count();
+        cout << "ImageScale " << filter.second << " " << image.width() << " x " << image.height()
+             << " -> " << width << " x " << height << ": " << (double)us / num_iterations << " us" << endl;
+    }
+
+    return 0;
+}
+int test_kernels_SummedAreaTable(const ImageViewRGB32& image){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    if (width == 0 || height == 0){
+        return 0;
+    }
+
+    auto time_start = current_time();
+    SummedAreaTable table(image);
+    auto time_end = current_time();
+    cout << "SummedAreaTable " << width << " x " << height << " first build: "
+         << std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count() << " us" << endl;
+
+    //  Deterministic boxes. Include single pixels and the full image.
+    uint32_t state = 12345;
+    auto next = [&](size_t limit){
+        state = state * 1664525 + 1013904223;
+        return (size_t)(state >> 8) % limit;
+    };
+    std::vector<ImagePixelBox> boxes{
+        {0, 0, width, height},
+        {0, 0, 1, 1},
+        {width - 1, height - 1, width, height},
+    };
+    for (size_t c = 0; c < 1000; c++){
+        size_t x0 = next(width);
+        size_t y0 = next(height);
+        size_t x1 = x0 + 1 + next(width - x0);
+        size_t y1 = y0 + 1 + next(height - y0);
+        boxes.emplace_back(x0, y0, x1, y1);
+    }
+
+    for (const ImagePixelBox& box : boxes){
+        ImageViewRGB32 view = extract_box_reference(image, box);
+        Kernels::PixelSums expected;
+        Kernels::pixel_sum_sqr(
+            expected, view.width(), view.height(),
+            view.data(), view.bytes_per_row(),
+            view.data(), view.bytes_per_row()
+        );
+
+        ImagePixelBox located;
+        if (!table.locate(located, view) ||
+            located.min_x != box.min_x || located.min_y != box.min_y ||
+            located.max_x != box.max_x || located.max_y != box.max_y
+        ){
+            cout << "Error: SummedAreaTable failed to locate box at (" << box.min_x << ", " << box.min_y << ")" << endl;
+            return 1;
+        }
+
+        Kernels::PixelSums actual = table.sums(box);
+        if (actual.count != expected.count ||
+            actual.sumR != expected.sumR || actual.sumG != expected.sumG || actual.sumB != expected.sumB ||
+            actual.sqrR != expected.sqrR || actual.sqrG != expected.sqrG || actual.sqrB != expected.sqrB
+        ){
+            cout << "Error: SummedAreaTable mismatch on box (" << box.min_x << ", " << box.min_y
+                 << ") - (" << box.max_x << ", " << box.max_y << ")" << endl;
+            return 1;
+        }
+
+        ImageStats direct = image_stats(view);
+        ImageStats border = image_border_stats(view);
+        SummedAreaTableScope scope(&table);
+        ImageStats looked_up = image_stats(view);
+        ImageStats looked_up_border = image_border_stats(view);
+        if (direct.count != looked_up.count ||
+            direct.average.to_string() != looked_up.average.to_string() ||
+            direct.stddev.to_string() != looked_up.stddev.to_string() ||
+            border.average.to_string() != looked_up_border.average.to_string() ||
+            border.stddev.to_string() != looked_up_border.stddev.to_string()
+        ){
+            cout << "Error: image_stats() differs with a SummedAreaTable on box (" << box.min_x << ", " << box.min_y
+                 << ") - (" << box.max_x << ", " << box.max_y << ")" << endl;
+            return 1;
+        }
+    }
+
+    //  Rebuilding reuses the memory. This is the per-frame cost.
+    const int num_builds = 20;
+    time_start = current_time();
+    for (int i = 0; i < num_builds; i++){
+        table.build(image);
+    }
+    time_end = current_time();
+    double build_us = (double)std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count() / num_builds;
+    cout << "SummedAreaTable rebuild: " << build_us << " us" << endl;
+
+    //  Measuring a box directly costs about the same wherever it is. The table
+    //  pays off once it replaces this many boxes of each size on a frame.
+    for (double fraction : {1.0, 0.5, 0.25, 0.1, 0.05, 0.02}){
+        size_t box_width = std::max<size_t>((size_t)(width * fraction), 1);
+        size_t box_height = std::max<size_t>((size_t)(height * fraction), 1);
+        ImageViewRGB32 view = image.sub_image(0, 0, box_width, box_height);
+
+        const int num_boxes = 200;
+        time_start = current_time();
+        for (int i = 0; i < num_boxes; i++){
+            image_stats(view);
+        }
+        time_end = current_time();
+        double direct_us = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count() / num_boxes / 1000;
+
+        SummedAreaTableScope scope(&table);
+        time_start = current_time();
+        for (int i = 0; i < num_boxes; i++){
+            image_stats(view);
+        }
+        time_end = current_time();
+        double lookup_us = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count() / num_boxes / 1000;
+
+        cout << "Box " << box_width << " x " << box_height << ": direct = " << direct_us
+             << " us, lookup = " << lookup_us << " us";
+        if (direct_us > lookup_us){
+            cout << ", crossover = " << (size_t)(build_us / (direct_us - lookup_us)) << " boxes per frame";
+        }
+        cout << endl;
+    }
+
+    return 0;
+}
+
+
 int test_kernels_BinaryMatrix(const ImageViewRGB32& image){
 
     if (test_binary_matrix_tile() != 0){
@@ -611,6 +895,96 @@ int test_kernels_CompressRGB32ToBinaryEuclidean(const ImageViewRGB32& image){
 
 
 
+int test_kernels_BinaryFilterBatch(const ImageViewRGB32& image){
+    cout << "Testing BinaryFilterBatch, image size " << image.width() << " x " << image.height() << endl;
+
+    //  A spread of small boxes like a detector would check, plus one large one.
+    const std::vector<std::pair<uint32_t, uint32_t>> filters{
+        {0xff000000, 0xff7f7f7f},
+        {0xff808080, 0xffffffff},
+        {0xff000000, 0xffff7f7f},
+    };
+    BinaryFilterBatch batch;
+    std::vector<ImageFloatBox> boxes;
+    for (size_t c = 0; c < 12; c++){
+        boxes.emplace_back(0.05 + 0.07 * c, 0.1 + 0.05 * (c % 4), 0.05, 0.04);
+    }
+    boxes.emplace_back(0.1, 0.5, 0.8, 0.4);
+    for (size_t c = 0; c < boxes.size(); c++){
+        batch.add(boxes[c], {filters[c % filters.size()], filters[(c + 1) % filters.size()]});
+    }
+
+    //  Correctness. Run twice so the second run reuses the masks.
+    for (size_t run = 0; run < 2; run++){
+        batch.run(image);
+        for (size_t c = 0; c < boxes.size(); c++){
+            ImageViewRGB32 region = extract_box_reference(image, boxes[c]);
+            for (size_t f = 0; f < 2; f++){
+                const std::pair<uint32_t, uint32_t>& filter = filters[(c + f) % filters.size()];
+                PackedBinaryMatrix expected = compress_rgb32_to_binary_range(region, filter.first, filter.second);
+                const PackedBinaryMatrix& mask = batch.mask(c, f);
+                TEST_RESULT_EQUAL(mask.width(), expected.width());
+                TEST_RESULT_EQUAL(mask.height(), expected.height());
+                for (size_t y = 0; y < expected.height(); y++){
+                    for (size_t x = 0; x < expected.width(); x++){
+                        if (mask.get(x, y) != expected.get(x, y)){
+                            cout << "Error: box " << c << ", filter " << f << ", (x,y) = (" << x << ", " << y << ")" << endl;
+                            return 1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    //  A single box over the whole image. Large images are split into strips.
+    BinaryFilterBatch single;
+    single.add(ImageFloatBox(0, 0, 1, 1), {filters[0], filters[1]});
+    single.run(image);
+    for (size_t f = 0; f < 2; f++){
+        PackedBinaryMatrix expected = compress_rgb32_to_binary_range(image, filters[f].first, filters[f].second);
+        const PackedBinaryMatrix& mask = single.mask(0, f);
+        TEST_RESULT_EQUAL(mask.height(), expected.height());
+        for (size_t y = 0; y < expected.height(); y++){
+            for (size_t x = 0; x < expected.width(); x++){
+                if (mask.get(x, y) != expected.get(x, y)){
+                    cout << "Error: single box, filter " << f << ", (x,y) = (" << x << ", " << y << ")" << endl;
+                    return 1;
+                }
+            }
+        }
+    }
+
+    //  Speed.
+    const size_t num_iters = 1000;
+    auto time_start = current_time();
+    for (size_t i = 0; i < num_iters; i++){
+        for (size_t c = 0; c < boxes.size(); c++){
+            ImageViewRGB32 region = extract_box_reference(image, boxes[c]);
+            for (size_t f = 0; f < 2; f++){
+                const std::pair<uint32_t, uint32_t>& filter = filters[(c + f) % filters.size()];
+                PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(region, filter.first, filter.second);
+            }
+        }
+    }
+    auto time_end = current_time();
+    double separate = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count() / (double)num_iters;
+
+    time_start = current_time();
+    for (size_t i = 0; i < num_iters; i++){
+        batch.run(image);
+    }
+    time_end = current_time();
+    double batched = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count() / (double)num_iters;
+
+    cout << "Separate calls: " << separate << " us, batch: " << batched << " us" << endl;
+
+    return 0;
+}
+
+
+
+
 int test_kernels_Waterfill(const ImageViewRGB32& image){
     const size_t width = image.width();
     const size_t height = image.height();
@@ -684,6 +1058,98 @@ int test_kernels_Waterfill(const ImageViewRGB32& image){
     return 0;
 }
 
+
+int test_kernels_AbsFFT([[maybe_unused]] const std::string& test_path){
+    using FFTFunction = void (*)(int k, float* abs, float* real);
+    std::vector<std::pair<std::string, FFTFunction>> implementations;
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        implementations.emplace_back("x86_AVX512", AbsFFT::fft_abs_x86_AVX512);
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        implementations.emplace_back("x86_AVX2", AbsFFT::fft_abs_x86_AVX2);
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        implementations.emplace_back("x86_SSE41", AbsFFT::fft_abs_x86_SSE41);
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        implementations.emplace_back("arm64_NEON", AbsFFT::fft_abs_arm64_NEON);
+    }
+#endif
+    implementations.emplace_back("Default", AbsFFT::fft_abs_Default);
+
+    //  Deterministic noise. Every implementation gets the same input.
+    uint32_t state = 12345;
+    auto next_sample = [&]{
+        state = state * 1664525 + 1013904223;
+        return (float)(state >> 8) / (float)(1 << 24) - 0.5f;
+    };
+
+    //  Correctness: compare each implementation against the default.
+    for (int k = 1; k <= 14; k++){
+        const size_t length = (size_t)1 << k;
+        const size_t buffer_size = std::max<size_t>(length, 64);
+        AlignedVector<float> input(buffer_size);
+        for (size_t i = 0; i < length; i++){
+            input[i] = next_sample();
+        }
+
+        AlignedVector<float> real(buffer_size);
+        AlignedVector<float> expected(buffer_size);
+        memcpy(real.data(), input.data(), length * sizeof(float));
+        AbsFFT::fft_abs_Default(k, expected.data(), real.data());
+        float peak = 0;
+        for (size_t i = 0; i < length / 2; i++){
+            peak = std::max(peak, expected[i]);
+        }
+
+        for (const auto& implementation : implementations){
+            AlignedVector<float> output(buffer_size);
+            memcpy(real.data(), input.data(), length * sizeof(float));
+            implementation.second(k, output.data(), real.data());
+            for (size_t i = 0; i < length / 2; i++){
+                float error = std::abs(output[i] - expected[i]);
+                if (error > 1e-5f * (peak + 1)){
+                    cout << "Error: AbsFFT " << implementation.first << ", k = " << k << ", index " << i
+                        << " is " << output[i] << ", but should be " << expected[i] << endl;
+                    return 1;
+                }
+            }
+        }
+    }
+
+    //  Throughput at the audio pipeline sizes.
+    for (int k : {10, 12, 14}){
+        const size_t length = (size_t)1 << k;
+        AlignedVector<float> input(length);
+        AlignedVector<float> real(length);
+        AlignedVector<float> output(length);
+        for (size_t i = 0; i < length; i++){
+            input[i] = next_sample();
+        }
+        for (const auto& implementation : implementations){
+            const size_t num_iters = ((size_t)1 << 24) >> k;
+            auto time_start = current_time();
+            for (size_t i = 0; i < num_iters; i++){
+                memcpy(real.data(), input.data(), length * sizeof(float));
+                implementation.second(k, output.data(), real.data());
+            }
+            auto time_end = current_time();
+            double us = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count() / 1000. / num_iters;
+            cout << "AbsFFT " << implementation.first << ", length = " << length << ": "
+                << us << " us, " << length / us << " samples/us" << endl;
+        }
+    }
+
+    return 0;
+}
+
 // Additional tests on binary matrix tile implementation
 template<class Tile> int test_binary_matrix_tile_t(){
     size_t num_iters = 100000;
@@ -9,12 +9,20 @@
 #ifndef PokemonAutomation_Tests_Kernels_Tests_H
 #define PokemonAutomation_Tests_Kernels_Tests_H
 
+#include <string>
+
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
 
 int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image);
 
+int test_kernels_ImageScale(const ImageViewRGB32& image);
+
+//  Check SummedAreaTable lookups against the direct sums, and print how many
+//  boxes per frame it takes for building the table to pay off.
+int test_kernels_SummedAreaTable(const ImageViewRGB32& image);
+
 int test_kernels_BinaryMatrix(const ImageViewRGB32& image);
 
 int test_kernels_FilterRGB32Range(const ImageViewRGB32& image);
@@ -29,8 +37,16 @@ int test_kernels_FilterByMask(const ImageViewRGB32& image);
 
 int test_kernels_CompressRGB32ToBinaryEuclidean(const ImageViewRGB32& image);
 
+//  Check BinaryFilterBatch against one compress_rgb32_to_binary_range() call
+//  per box and filter, and time both.
+int test_kernels_BinaryFilterBatch(const ImageViewRGB32& image);
+
 int test_kernels_Waterfill(const ImageViewRGB32& image);
 
+//  Compare each AbsFFT implementation that the CPU supports against the
+//  default one, and print their throughput. "test_path" is not used.
+int test_kernels_AbsFFT(const std::string& test_path);
+
 
 }
 
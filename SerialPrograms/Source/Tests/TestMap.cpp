@@ -7,6 +7,7 @@
 
 #include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "CommonFramework_Tests.h"
+#include "Controllers_Tests.h"
 #include "Kernels_Tests.h"
 #include "NintendoSwitch_Tests.h"
 #include "PokemonLA_Tests.h"
@@ -221,14 +222,23 @@ int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::s
 
 const std::map<std::string, TestFunction> TEST_MAP = {
     {"Kernels_ImageScaleBrightness", std::bind(image_void_detector_helper, test_kernels_ImageScaleBrightness, _1)},
+    {"Kernels_ImageScale", std::bind(image_void_detector_helper, test_kernels_ImageScale, _1)},
+    {"Kernels_SummedAreaTable", std::bind(image_void_detector_helper, test_kernels_SummedAreaTable, _1)},
     {"Kernels_BinaryMatrix", std::bind(image_void_detector_helper, test_kernels_BinaryMatrix, _1)},
     {"Kernels_FilterRGB32Range", std::bind(image_void_detector_helper, test_kernels_FilterRGB32Range, _1)},
     {"Kernels_FilterRGB32Euclidean", std::bind(image_void_detector_helper, test_kernels_FilterRGB32Euclidean, _1)},
     {"Kernels_ToBlackWhiteRGB32Range", std::bind(image_void_detector_helper, test_kernels_ToBlackWhiteRGB32Range, _1)},
     {"Kernels_FilterByMask", std::bind(image_void_detector_helper, test_kernels_FilterByMask, _1)},
     {"Kernels_CompressRGB32ToBinaryEuclidean", std::bind(image_void_detector_helper, test_kernels_CompressRGB32ToBinaryEuclidean, _1)},
+    {"Kernels_BinaryFilterBatch", std::bind(image_void_detector_helper, test_kernels_BinaryFilterBatch, _1)},
     {"Kernels_Waterfill", std::bind(image_void_detector_helper, test_kernels_Waterfill, _1)},
+    {"Kernels_AbsFFT", test_kernels_AbsFFT},
+    {"Controllers_SuperscalarScheduler", test_Controllers_SuperscalarScheduler},
+    {"Controllers_SerialPABotBaseBatching", test_Controllers_SerialPABotBaseBatching},
+    {"Controllers_SynchronizedActionBarrier", test_Controllers_SynchronizedActionBarrier},
     {"CommonFramework_BlackBorderDetector", std::bind(image_bool_detector_helper, test_CommonFramework_BlackBorderDetector, _1)},
+    {"CommonFramework_NotificationPipeline", test_CommonFramework_NotificationPipeline},
+    {"CommonFramework_AudioMatchingEngine", test_CommonFramework_AudioMatchingEngine},
     {"NintendoSwitch_UpdatePopupDetector", std::bind(image_bool_detector_helper, test_NintendoSwitch_UpdatePopupDetector, _1)},
     {"PokemonSwSh_YCommMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_YCommMenuDetector, _1)},
     {"PokemonSwSh_MaxLair_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_MaxLair_BattleMenuDetector, _1)},
@@ -45,6 +45,8 @@ file(GLOB LIBRARY_SOURCES
     ../Common/Cpp/Concurrency/SpinPause.h
     ../Common/Cpp/Concurrency/Thread.cpp
     ../Common/Cpp/Concurrency/Thread.h
+    ../Common/Cpp/Concurrency/ThreadAffinity.cpp
+    ../Common/Cpp/Concurrency/ThreadAffinity.h
     ../Common/Cpp/Concurrency/Watchdog.cpp
     ../Common/Cpp/Concurrency/Watchdog.h
     ../Common/Cpp/Containers/AlignedMalloc.cpp
@@ -162,6 +164,7 @@ file(GLOB LIBRARY_SOURCES
     ../Common/Cpp/Rectangle.h
     ../Common/Cpp/Rectangle.tpp
     ../Common/Cpp/RecursiveThrottler.h
+    ../Common/Cpp/RoundTripTracker.h
     ../Common/Cpp/SIMDDebuggers.h
     ../Common/Cpp/SerialConnection/SerialConnection.cpp
     ../Common/Cpp/SerialConnection/SerialConnection.h
@@ -290,6 +293,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/AudioPipeline/Spectrum/FFTStreamer.h
     Source/CommonFramework/AudioPipeline/Spectrum/Spectrograph.cpp
     Source/CommonFramework/AudioPipeline/Spectrum/Spectrograph.h
+    Source/CommonFramework/AudioPipeline/Spectrum/SpectrumBands.cpp
+    Source/CommonFramework/AudioPipeline/Spectrum/SpectrumBands.h
     Source/CommonFramework/AudioPipeline/Tools/AudioFormatUtils.cpp
     Source/CommonFramework/AudioPipeline/Tools/AudioFormatUtils.h
     Source/CommonFramework/AudioPipeline/Tools/AudioNormalization.h
@@ -346,6 +351,10 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/ImageTools/ImageDiff.h
     Source/CommonFramework/ImageTools/ImageStats.cpp
     Source/CommonFramework/ImageTools/ImageStats.h
+    Source/CommonFramework/ImageTools/SummedAreaTable.cpp
+    Source/CommonFramework/ImageTools/SummedAreaTable.h
+    Source/CommonFramework/ImageTools/TileChangeMap.cpp
+    Source/CommonFramework/ImageTools/TileChangeMap.h
     Source/CommonFramework/ImageTypes/BinaryImage.cpp
     Source/CommonFramework/ImageTypes/BinaryImage.h
     Source/CommonFramework/ImageTypes/ImageHSV32.cpp
@@ -374,12 +383,16 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/Notifications/EventNotificationsTable.h
     Source/CommonFramework/Notifications/MessageAttachment.cpp
     Source/CommonFramework/Notifications/MessageAttachment.h
+    Source/CommonFramework/Notifications/NotificationPipeline.cpp
+    Source/CommonFramework/Notifications/NotificationPipeline.h
     Source/CommonFramework/Notifications/ProgramInfo.h
     Source/CommonFramework/Notifications/ProgramNotifications.cpp
     Source/CommonFramework/Notifications/ProgramNotifications.h
     Source/CommonFramework/Notifications/SenderNotificationTable.cpp
     Source/CommonFramework/Notifications/SenderNotificationTable.h
     Source/CommonFramework/Options/CheckForUpdatesOption.h
+    Source/CommonFramework/Options/ConsolePartitionOption.cpp
+    Source/CommonFramework/Options/ConsolePartitionOption.h
     Source/CommonFramework/Options/Environment/PerformanceOptions.h
     Source/CommonFramework/Options/Environment/ProcessPriorityOption.h
     Source/CommonFramework/Options/Environment/ProcessorLevelOption.cpp
@@ -449,6 +462,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/Tools/GlobalThreadPools.h
     Source/CommonFramework/Tools/ProgramEnvironment.cpp
     Source/CommonFramework/Tools/ProgramEnvironment.h
+    Source/CommonFramework/Tools/ResourceWarmup.cpp
+    Source/CommonFramework/Tools/ResourceWarmup.h
     Source/CommonFramework/Tools/StatAccumulator.cpp
     Source/CommonFramework/Tools/StatAccumulator.h
     Source/CommonFramework/Tools/VideoStream.cpp
@@ -469,6 +484,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/VideoPipeline/CameraInfo.h
     Source/CommonFramework/VideoPipeline/Stats/CpuUtilizationStats.cpp
     Source/CommonFramework/VideoPipeline/Stats/CpuUtilizationStats.h
+    Source/CommonFramework/VideoPipeline/Stats/FrameLatencyStats.cpp
+    Source/CommonFramework/VideoPipeline/Stats/FrameLatencyStats.h
     Source/CommonFramework/VideoPipeline/Stats/MemoryUtilizationStats.cpp
     Source/CommonFramework/VideoPipeline/Stats/MemoryUtilizationStats.h
     Source/CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.cpp
@@ -520,6 +537,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonTools/Async/InterruptableCommands.tpp
     Source/CommonTools/Async/SuperControlSession.h
     Source/CommonTools/Async/SuperControlSession.tpp
+    Source/CommonTools/Audio/AudioMatchingEngine.cpp
+    Source/CommonTools/Audio/AudioMatchingEngine.h
     Source/CommonTools/Audio/AudioPerSpectrumDetectorBase.cpp
     Source/CommonTools/Audio/AudioPerSpectrumDetectorBase.h
     Source/CommonTools/Audio/AudioTemplateCache.cpp
@@ -550,6 +569,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonTools/ImageMatch/SubObjectTemplateMatcher.h
     Source/CommonTools/ImageMatch/WaterfillTemplateMatcher.cpp
     Source/CommonTools/ImageMatch/WaterfillTemplateMatcher.h
+    Source/CommonTools/Images/BinaryImage_FilterBatch.cpp
+    Source/CommonTools/Images/BinaryImage_FilterBatch.h
     Source/CommonTools/Images/BinaryImage_FilterRgb32.cpp
     Source/CommonTools/Images/BinaryImage_FilterRgb32.h
     Source/CommonTools/Images/ColorClustering.cpp
@@ -582,12 +603,16 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonTools/OCR/OCR_DictionaryMatcher.h
     Source/CommonTools/OCR/OCR_DictionaryOCR.cpp
     Source/CommonTools/OCR/OCR_DictionaryOCR.h
+    Source/CommonTools/OCR/OCR_GlyphClassifier.cpp
+    Source/CommonTools/OCR/OCR_GlyphClassifier.h
     Source/CommonTools/OCR/OCR_LargeDictionaryMatcher.cpp
     Source/CommonTools/OCR/OCR_LargeDictionaryMatcher.h
     Source/CommonTools/OCR/OCR_NumberReader.cpp
     Source/CommonTools/OCR/OCR_NumberReader.h
     Source/CommonTools/OCR/OCR_RawOCR.cpp
     Source/CommonTools/OCR/OCR_RawOCR.h
+    Source/CommonTools/OCR/OCR_ResultCache.cpp
+    Source/CommonTools/OCR/OCR_ResultCache.h
     Source/CommonTools/OCR/OCR_Routines.cpp
     Source/CommonTools/OCR/OCR_Routines.h
     Source/CommonTools/OCR/OCR_SmallDictionaryMatcher.cpp
@@ -654,6 +679,10 @@ file(GLOB LIBRARY_SOURCES
     Source/Controllers/ControllerState.h
     Source/Controllers/ControllerStateTable.cpp
     Source/Controllers/ControllerStateTable.h
+    Source/Controllers/ControllerTrace.cpp
+    Source/Controllers/ControllerTrace.h
+    Source/Controllers/ControllerTraceAnalysis.cpp
+    Source/Controllers/ControllerTraceAnalysis.h
     Source/Controllers/ControllerTypeStrings.cpp
     Source/Controllers/ControllerTypeStrings.h
     Source/Controllers/ControllerTypes.h
@@ -708,6 +737,8 @@ file(GLOB LIBRARY_SOURCES
     Source/Controllers/StandardHid/StandardHid_Keyboard_KeyMappings.h
     Source/Controllers/StandardHid/StandardHid_Keyboard_SerialPABotBase.cpp
     Source/Controllers/StandardHid/StandardHid_Keyboard_SerialPABotBase.h
+    Source/Controllers/SynchronizedActionBarrier.cpp
+    Source/Controllers/SynchronizedActionBarrier.h
     Source/Integrations/DiscordIntegrationSettings.cpp
     Source/Integrations/DiscordIntegrationSettings.h
     Source/Integrations/DiscordIntegrationTable.cpp
@@ -734,9 +765,13 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/AbsFFT/Kernels_AbsFFT.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_Default.h
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_arm64_NEON.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_x86_AVX2.h
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_x86_AVX512.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_x86_SSE41.h
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_BaseTransform_arm64_NEON.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_BaseTransform_x86_AVX2.h
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_BaseTransform_x86_AVX512.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_BaseTransform_x86_SSE41.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_BitReverse.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Butterflies.h
@@ -744,7 +779,9 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/AbsFFT/Kernels_AbsFFT_ComplexToAbs.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_ComplexVector.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_Default.cpp
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_arm64_NEON.cpp
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_x86_AVX2.cpp
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_x86_AVX512.cpp
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_x86_SSE41.cpp
     Source/Kernels/AbsFFT/Kernels_AbsFFT_FullTransform.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_FullTransform.tpp
@@ -835,6 +872,15 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/ImageFilters/RGB32_Range/Kernels_ImageFilter_RGB32_Range_x64_AVX2.cpp
     Source/Kernels/ImageFilters/RGB32_Range/Kernels_ImageFilter_RGB32_Range_x64_AVX512.cpp
     Source/Kernels/ImageFilters/RGB32_Range/Kernels_ImageFilter_RGB32_Range_x64_SSE42.cpp
+    Source/Kernels/ImageScale/Kernels_ImageScale.cpp
+    Source/Kernels/ImageScale/Kernels_ImageScale.h
+    Source/Kernels/ImageScale/Kernels_ImageScale_Default.cpp
+    Source/Kernels/ImageScale/Kernels_ImageScale_Routines.h
+    Source/Kernels/ImageScale/Kernels_ImageScale_Tables.cpp
+    Source/Kernels/ImageScale/Kernels_ImageScale_Tables.h
+    Source/Kernels/ImageScale/Kernels_ImageScale_x64_AVX2.cpp
+    Source/Kernels/ImageScale/Kernels_ImageScale_x64_AVX512.cpp
+    Source/Kernels/ImageScale/Kernels_ImageScale_x64_SSE41.cpp
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.cpp
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_Default.cpp
@@ -842,6 +888,17 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_AVX2.cpp
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_AVX512.cpp
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_SSE41.cpp
+    Source/Kernels/ImageStats/Kernels_ImagePixelIntegral.cpp
+    Source/Kernels/ImageStats/Kernels_ImagePixelIntegral.h
+    Source/Kernels/ImageStats/Kernels_ImagePixelIntegral_Default.cpp
+    Source/Kernels/ImageStats/Kernels_ImagePixelIntegral_x64_AVX2.cpp
+    Source/Kernels/ImageStats/Kernels_ImagePixelIntegral_x64_SSE41.cpp
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumAbsDiff.cpp
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumAbsDiff.h
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumAbsDiff_Default.cpp
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumAbsDiff_x64_AVX2.cpp
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumAbsDiff_x64_AVX512.cpp
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumAbsDiff_x64_SSE41.cpp
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr.cpp
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr.h
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.cpp
@@ -906,6 +963,8 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/Waterfill/Kernels_Waterfill_Types.h
     Source/ML/DataLabeling/ML_AnnotationIO.cpp
     Source/ML/DataLabeling/ML_AnnotationIO.h
+    Source/ML/DataLabeling/ML_EmbeddingStore.cpp
+    Source/ML/DataLabeling/ML_EmbeddingStore.h
     Source/ML/DataLabeling/ML_ObjectAnnotation.cpp
     Source/ML/DataLabeling/ML_ObjectAnnotation.h
     Source/ML/DataLabeling/ML_SegmentAnythingModel.cpp
@@ -985,6 +1044,8 @@ file(GLOB LIBRARY_SOURCES
     Source/NintendoSwitch/Controllers/SysbotBase/SysbotBase_SelectorWidget.h
     Source/NintendoSwitch/DevPrograms/BoxDraw.cpp
     Source/NintendoSwitch/DevPrograms/BoxDraw.h
+    Source/NintendoSwitch/DevPrograms/ControllerTraceAnalyzer.cpp
+    Source/NintendoSwitch/DevPrograms/ControllerTraceAnalyzer.h
     Source/NintendoSwitch/DevPrograms/JoyconProgram.cpp
     Source/NintendoSwitch/DevPrograms/JoyconProgram.h
     Source/NintendoSwitch/DevPrograms/TestDudunsparceFormDetector.cpp
@@ -993,6 +1054,8 @@ file(GLOB LIBRARY_SOURCES
     Source/NintendoSwitch/DevPrograms/TestProgramComputer.h
     Source/NintendoSwitch/DevPrograms/TestProgramSwitch.cpp
     Source/NintendoSwitch/DevPrograms/TestProgramSwitch.h
+    Source/NintendoSwitch/Framework/NintendoSwitch_HeadlessProgramRunner.cpp
+    Source/NintendoSwitch/Framework/NintendoSwitch_HeadlessProgramRunner.h
     Source/NintendoSwitch/Framework/NintendoSwitch_MultiSwitchProgramOption.cpp
     Source/NintendoSwitch/Framework/NintendoSwitch_MultiSwitchProgramOption.h
     Source/NintendoSwitch/Framework/NintendoSwitch_MultiSwitchProgramSession.cpp
@@ -1134,6 +1197,8 @@ file(GLOB LIBRARY_SOURCES
     Source/Pokemon/Inference/Pokemon_PokeballNameReader.h
     Source/Pokemon/Inference/Pokemon_ReadHpBar.cpp
     Source/Pokemon/Inference/Pokemon_ReadHpBar.h
+    Source/Pokemon/Inference/Pokemon_TrainGlyphOCR.cpp
+    Source/Pokemon/Inference/Pokemon_TrainGlyphOCR.h
     Source/Pokemon/Inference/Pokemon_TrainIVCheckerOCR.cpp
     Source/Pokemon/Inference/Pokemon_TrainIVCheckerOCR.h
     Source/Pokemon/Inference/Pokemon_TrainPokemonOCR.cpp
@@ -2519,6 +2584,8 @@ file(GLOB LIBRARY_SOURCES
     Source/Tests/CommandLineTests.h
     Source/Tests/CommonFramework_Tests.cpp
     Source/Tests/CommonFramework_Tests.h
+    Source/Tests/Controllers_Tests.cpp
+    Source/Tests/Controllers_Tests.h
     Source/Tests/Kernels_Tests.cpp
     Source/Tests/Kernels_Tests.h
     Source/Tests/NintendoSwitch_Tests.cpp